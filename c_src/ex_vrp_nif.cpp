@@ -14,22 +14,37 @@
 #include "pyvrp/Solution.h"
 #include "pyvrp/search/Exchange.h"
 #include "pyvrp/search/LocalSearch.h"
+#include "pyvrp/search/OrOptReverse.h"
 #include "pyvrp/search/PerturbationManager.h"
 #include "pyvrp/search/RelocateWithDepot.h"
 #include "pyvrp/search/SwapRoutes.h"
 #include "pyvrp/search/SwapStar.h"
 #include "pyvrp/search/SwapTails.h"
+#include "pyvrp/search/TwoOpt.h"
 #include "pyvrp/search/primitives.h"
 
+#include "exvrp/IteratedLocalSearch.h"
+#include "exvrp/Neighbourhood.h"
+#include "exvrp/Population.h"
+#include "exvrp/ProblemDataIO.h"
+#include "exvrp/Reclaimer.h"
+
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <numeric>
 #include <optional>
 #include <set>
 #include <sstream>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 using namespace pyvrp;
@@ -56,6 +71,71 @@ std::string decode_binary_to_string([[maybe_unused]] ErlNifEnv *env,
 // Resource Types
 // -----------------------------------------------------------------------------
 
+// Resource destructors run wherever the BEAM garbage collects the owning
+// process, usually on a normal scheduler. Resources whose contents are large
+// hand them to exvrp::reclaimer(), which destroys them on its own thread. The
+// sizes below are rough estimates of the memory that destruction frees.
+//
+// The reclaimer's thread is created through enif_thread_create, so that the
+// VM knows about it. Fine 0.1 installs no unload callback of its own, so the
+// thread is stopped and joined from the library's static teardown instead,
+// which runs when the VM unloads the library, before its code is unmapped.
+
+static void *start_reclaimer_thread(void *(*func)(void *), void *arg)
+{
+    auto tid = std::make_unique<ErlNifTid>();
+    char name[] = "exvrp_reclaimer";
+    if (enif_thread_create(name, tid.get(), func, arg, nullptr) != 0)
+        return nullptr;
+
+    return tid.release();
+}
+
+static void join_reclaimer_thread(void *handle)
+{
+    std::unique_ptr<ErlNifTid> tid(static_cast<ErlNifTid *>(handle));
+    enif_thread_join(*tid, nullptr);
+}
+
+static struct ReclaimerLifetime
+{
+    ReclaimerLifetime()
+    {
+        exvrp::reclaimer().setThreadFunctions(
+            {start_reclaimer_thread, join_reclaimer_thread});
+    }
+
+    ~ReclaimerLifetime() { exvrp::reclaimer().stop(); }
+} const reclaimer_lifetime;
+
+static size_t estimated_bytes(ProblemData const &data)
+{
+    auto const dim = data.numLocations();
+    auto const matrixBytes = dim * dim * (sizeof(Distance) + sizeof(Duration));
+    return data.numProfiles() * matrixBytes
+           + dim * sizeof(ProblemData::Client);
+}
+
+static size_t estimated_bytes(Solution const &solution)
+{
+    auto const &neighbours = solution.neighbours();
+    auto bytes = neighbours.size() * sizeof(neighbours.front());
+
+    for (auto const &route : solution.routes())
+        bytes += sizeof(Route)
+                 + route.size()
+                       * (sizeof(size_t) + sizeof(Route::ScheduledVisit));
+
+    return bytes;
+}
+
+// Releasing the last reference to problem data frees all of it; releasing
+// any other reference frees nothing.
+static size_t released_bytes(std::shared_ptr<ProblemData> const &data)
+{
+    return data && data.use_count() == 1 ? estimated_bytes(*data) : 0;
+}
+
 // Wrap ProblemData in a shared_ptr for resource management
 struct ProblemDataResource
 {
@@ -65,6 +145,12 @@ struct ProblemDataResource
         : data(std::move(d))
     {
     }
+
+    ~ProblemDataResource()
+    {
+        auto const bytes = released_bytes(data);
+        exvrp::reclaimer().reclaim(std::move(data), bytes);
+    }
 };
 
 // Wrap Solution for resource management
@@ -77,6 +163,16 @@ struct SolutionResource
         : solution(std::move(s)), problemData(std::move(pd))
     {
     }
+
+    ~SolutionResource()
+    {
+        auto const bytes
+            = estimated_bytes(solution) + released_bytes(problemData);
+        if (bytes >= exvrp::reclaimer().threshold())
+            exvrp::reclaimer().reclaim(
+                std::pair(std::move(solution), std::move(problemData)),
+                bytes);
+    }
 };
 
 // Wrap CostEvaluator for resource management
@@ -277,9 +373,36 @@ struct LoadSegmentResource
     explicit LoadSegmentResource(const LoadSegment &s) : segment(s) {}
 };
 
+// Creates the segment-reversing node operator of the given name, or returns
+// nullptr if there is no such operator.
+static std::unique_ptr<search::NodeOperator>
+make_reversing_operator(std::string const &name, ProblemData const &data)
+{
+    if (name == "two_opt")
+        return std::make_unique<search::TwoOpt>(data);
+
+    if (name == "or_opt_reverse2")
+        return std::make_unique<search::OrOptReverse<2>>(data);
+
+    if (name == "or_opt_reverse3")
+        return std::make_unique<search::OrOptReverse<3>>(data);
+
+    return nullptr;
+}
+
 // Wrap LocalSearch for resource management - allows reuse across iterations
 struct LocalSearchResource
 {
+    // The parts that are costly to destroy, for the reclaimer. Member order
+    // matters: the LocalSearch is destroyed first, because clearing its
+    // routes still reads the problem data.
+    struct Remains
+    {
+        std::shared_ptr<ProblemData> problemData;
+        search::SearchSpace::Neighbours neighbours;
+        std::unique_ptr<search::LocalSearch> ls;
+    };
+
     std::shared_ptr<ProblemData> problemData;
 
     // Owned data
@@ -300,12 +423,35 @@ struct LocalSearchResource
     std::unique_ptr<search::RelocateWithDepot> relocateDepot;
     std::unique_ptr<search::SwapRoutes> swapRoutes;
 
+    // Node operators added on top of the defaults (see create_local_search)
+    std::vector<std::unique_ptr<search::NodeOperator>> extraNodeOps;
+
+    // Operator names, in the order the operators were added (for profiles)
+    std::vector<std::string> nodeOpNames;
+    std::vector<std::string> routeOpNames;
+
+    // Search statistics accumulated over all runs (for throughput metrics)
+    std::atomic<size_t> numRuns = 0;
+    std::atomic<size_t> numMoves = 0;
+    std::atomic<size_t> numImproving = 0;
+    std::atomic<size_t> numUpdates = 0;
+
+    void recordRun()
+    {
+        auto const stats = ls->statistics();
+        numRuns++;
+        numMoves += stats.numMoves;
+        numImproving += stats.numImproving;
+        numUpdates += stats.numUpdates;
+    }
+
     // The local search object (must be last - uses references to above)
     std::unique_ptr<search::LocalSearch> ls;
 
     LocalSearchResource(std::shared_ptr<ProblemData> pd,
                         search::SearchSpace::Neighbours n,
-                        uint32_t seed)
+                        uint32_t seed,
+                        std::vector<std::string> const &extraOps = {})
         : problemData(std::move(pd)),
           perturbParams(1, 25),
           perturbManager(perturbParams),
@@ -329,19 +475,34 @@ struct LocalSearchResource
         ls->addNodeOperator(*exchange11);
         ls->addNodeOperator(*exchange21);
         ls->addNodeOperator(*exchange22);
+        nodeOpNames = {"exchange10",
+                       "exchange20",
+                       "exchange11",
+                       "exchange21",
+                       "exchange22"};
 
         if (search::supports<search::SwapTails>(data))
         {
             swapTails = std::make_unique<search::SwapTails>(data);
             ls->addNodeOperator(*swapTails);
+            nodeOpNames.emplace_back("swap_tails");
         }
 
         if (search::supports<search::RelocateWithDepot>(data))
         {
             relocateDepot = std::make_unique<search::RelocateWithDepot>(data);
             ls->addNodeOperator(*relocateDepot);
+            nodeOpNames.emplace_back("relocate_with_depot");
         }
 
+        for (auto const &name : extraOps)
+            if (auto op = make_reversing_operator(name, data))
+            {
+                extraNodeOps.push_back(std::move(op));
+                ls->addNodeOperator(*extraNodeOps.back());
+                nodeOpNames.push_back(name);
+            }
+
         // TODO: SwapStar is PyVRP's most powerful route operator for
         // inter-route optimization. Currently disabled because it's O(V²×N)
         // per pass and needs a per-iteration timeout to prevent hanging on
@@ -354,8 +515,68 @@ struct LocalSearchResource
         {
             swapRoutes = std::make_unique<search::SwapRoutes>(data);
             ls->addRouteOperator(*swapRoutes);
+            routeOpNames.emplace_back("swap_routes");
+        }
+    }
+
+    ~LocalSearchResource()
+    {
+        auto const &data = *problemData;
+        auto bytes = data.numLocations() * sizeof(search::Route::Node)
+                     + data.numVehicles() * sizeof(search::Route)
+                     + released_bytes(problemData);
+
+        // Our neighbours, and the search space's copy of them.
+        for (auto const &clientNeighbours : neighbours)
+            bytes += 2 * clientNeighbours.size() * sizeof(size_t);
+
+        exvrp::reclaimer().reclaim(
+            Remains{
+                std::move(problemData), std::move(neighbours), std::move(ls)},
+            bytes);
+    }
+};
+
+// Persistent re-optimisation session: the current plan together with a
+// LocalSearch bound to the session's problem data. Inserting new clients
+// appends them to the problem data, which rebuilds the LocalSearch around the
+// extended instance (carrying over the RNG state and neighbourhood).
+struct SessionResource
+{
+    std::unique_ptr<LocalSearchResource> search;
+    std::unique_ptr<Solution> solution;  // current plan
+    std::vector<size_t> locked;          // clients locked in place
+    std::vector<size_t> removed;         // cancelled clients
+
+    SessionResource(std::shared_ptr<ProblemData> pd,
+                    search::SearchSpace::Neighbours n,
+                    Solution const &sol,
+                    uint32_t seed)
+        : search(std::make_unique<LocalSearchResource>(
+              std::move(pd), std::move(n), seed)),
+          solution(std::make_unique<Solution>(sol))
+    {
+    }
+
+    // The LocalSearchResource defers its own contents; the plan can be large
+    // as well.
+    ~SessionResource()
+    {
+        if (solution)
+        {
+            auto const bytes = estimated_bytes(*solution);
+            exvrp::reclaimer().reclaim(std::move(solution), bytes);
         }
     }
+
+    // Clients the search must leave where they are: the locked prefixes, and
+    // the removed clients, which must stay out of the plan.
+    std::vector<size_t> frozen() const
+    {
+        std::vector<size_t> clients = locked;
+        clients.insert(clients.end(), removed.begin(), removed.end());
+        return clients;
+    }
 };
 
 // Type aliases for templated operator resources (macros don't like angle
@@ -393,6 +614,7 @@ FINE_RESOURCE(DynamicBitsetResource);
 FINE_RESOURCE(DurationSegmentResource);
 FINE_RESOURCE(LoadSegmentResource);
 FINE_RESOURCE(LocalSearchResource);
+FINE_RESOURCE(SessionResource);
 
 // -----------------------------------------------------------------------------
 // Forward Declarations: Helper Functions
@@ -1130,10 +1352,11 @@ decode_same_vehicle_group([[maybe_unused]] ErlNifEnv *env, ERL_NIF_TERM term)
 // -----------------------------------------------------------------------------
 
 /**
- * Create ProblemData from Elixir Model struct.
+ * Decode ProblemData from an Elixir Model struct. Only uses the given
+ * environment, so this also works on process-independent environments.
  */
-fine::Ok<fine::ResourcePtr<ProblemDataResource>>
-create_problem_data([[maybe_unused]] ErlNifEnv *env, fine::Term model_term)
+static std::shared_ptr<ProblemData> decode_problem_data(ErlNifEnv *env,
+                                                        ERL_NIF_TERM model_term)
 {
     // Decode the model map
     ERL_NIF_TERM clients_term, depots_term, vehicle_types_term;
@@ -1184,6 +1407,22 @@ create_problem_data([[maybe_unused]] ErlNifEnv *env, fine::Term model_term)
     bool has_same_vehicle_groups
         = enif_get_map_value(env, model_term, key, &same_vehicle_groups_term);
 
+    // Get hard time windows flag (optional)
+    ERL_NIF_TERM hard_time_windows_term;
+    key = enif_make_atom(env, "hard_time_windows");
+    bool const hard_time_windows
+        = enif_get_map_value(env, model_term, key, &hard_time_windows_term)
+          && enif_is_identical(hard_time_windows_term,
+                               enif_make_atom(env, "true"));
+
+    // Get time window tightening flag (optional)
+    ERL_NIF_TERM tighten_time_windows_term;
+    key = enif_make_atom(env, "tighten_time_windows");
+    bool const tighten_time_windows
+        = enif_get_map_value(env, model_term, key, &tighten_time_windows_term)
+          && enif_is_identical(tighten_time_windows_term,
+                               enif_make_atom(env, "true"));
+
     // Decode depots
     std::vector<ProblemData::Depot> depots;
     unsigned depots_len;
@@ -1346,16 +1585,25 @@ create_problem_data([[maybe_unused]] ErlNifEnv *env, fine::Term model_term)
     }
 
     // Create ProblemData
-    auto problem_data
-        = std::make_shared<ProblemData>(std::move(clients),
-                                        std::move(depots),
-                                        std::move(vehicle_types),
-                                        std::move(dist_matrices),
-                                        std::move(dur_matrices),
-                                        std::move(client_groups),
-                                        std::move(same_vehicle_groups));
+    return std::make_shared<ProblemData>(std::move(clients),
+                                         std::move(depots),
+                                         std::move(vehicle_types),
+                                         std::move(dist_matrices),
+                                         std::move(dur_matrices),
+                                         std::move(client_groups),
+                                         std::move(same_vehicle_groups),
+                                         hard_time_windows,
+                                         tighten_time_windows);
+}
 
-    return fine::Ok(fine::make_resource<ProblemDataResource>(problem_data));
+/**
+ * Create ProblemData from Elixir Model struct.
+ */
+fine::Ok<fine::ResourcePtr<ProblemDataResource>>
+create_problem_data([[maybe_unused]] ErlNifEnv *env, fine::Term model_term)
+{
+    return fine::Ok(fine::make_resource<ProblemDataResource>(
+        decode_problem_data(env, model_term)));
 }
 
 FINE_NIF(create_problem_data, 0);
@@ -1505,6 +1753,48 @@ solution_unassigned([[maybe_unused]] ErlNifEnv *env,
 
 FINE_NIF(solution_unassigned, 0);
 
+/**
+ * Get the Zobrist hash of the solution's arcs. Solutions with the same
+ * neighbours (predecessor and successor of each client) have the same hash.
+ */
+uint64_t solution_hash([[maybe_unused]] ErlNifEnv *env,
+                       fine::ResourcePtr<SolutionResource> solution_resource)
+{
+    return solution_resource->solution.hash();
+}
+
+FINE_NIF(solution_hash, 0);
+
+/**
+ * Get the broken pairs distance between the solution and each solution of
+ * the given pool, in order. All solutions must be of the same problem data
+ * (or at least of data with the same number of locations). Runs on a dirty
+ * scheduler, since the pool can be large.
+ */
+std::vector<double> solution_broken_pairs_distances(
+    [[maybe_unused]] ErlNifEnv *env,
+    fine::ResourcePtr<SolutionResource> solution_resource,
+    std::vector<fine::ResourcePtr<SolutionResource>> pool_resources)
+{
+    auto const &solution = solution_resource->solution;
+    auto const numLocs = solution.neighbours().size();
+
+    std::vector<pyvrp::Solution const *> pool;
+    pool.reserve(pool_resources.size());
+    for (auto const &resource : pool_resources)
+    {
+        if (resource->solution.neighbours().size() != numLocs)
+            throw std::invalid_argument(
+                "Solutions must have the same number of locations.");
+
+        pool.push_back(&resource->solution);
+    }
+
+    return exvrp::brokenPairsDistances(solution, pool);
+}
+
+FINE_NIF(solution_broken_pairs_distances, ERL_NIF_DIRTY_JOB_CPU_BOUND);
+
 /**
  * Get distance of a specific route in the solution.
  */
@@ -2641,6 +2931,18 @@ int64_t problem_data_num_profiles_nif(
 
 FINE_NIF(problem_data_num_profiles_nif, 0);
 
+/**
+ * Serialise ProblemData to a binary dump, for the standalone exvrp_solve CLI.
+ */
+std::string problem_data_dump_nif(
+    [[maybe_unused]] ErlNifEnv *env,
+    fine::ResourcePtr<ProblemDataResource> problem_resource)
+{
+    return exvrp::serialise(*problem_resource->data);
+}
+
+FINE_NIF(problem_data_dump_nif, ERL_NIF_DIRTY_JOB_CPU_BOUND);
+
 // -----------------------------------------------------------------------------
 // ProblemData - Data Extraction for Neighbourhood Computation
 // -----------------------------------------------------------------------------
@@ -2787,210 +3089,6 @@ FINE_NIF(problem_data_groups_nif, 0);
 // LocalSearch
 // -----------------------------------------------------------------------------
 
-/**
- * Compute proximity-based neighbours matching PyVRP's compute_neighbours.
- *
- * Proximity is based on Vidal et al. (2013) hybrid genetic algorithm paper.
- * This considers edge costs, time window penalties, and prizes.
- */
-pyvrp::search::SearchSpace::Neighbours
-build_neighbours(ProblemData const &data,
-                 size_t numNeighbours = 60,
-                 double weightWaitTime = 0.2,
-                 double weightTimeWarp = 1.0,
-                 bool symmetricProximity = true)
-{
-    size_t const numLocs = data.numLocations();
-    size_t const numDepots = data.numDepots();
-    size_t const numClients = data.numClients();
-    pyvrp::search::SearchSpace::Neighbours neighbours(numLocs);
-
-    // Step 1: Collect unique (unitDistCost, unitDurCost, profile) combinations
-    std::set<std::tuple<Cost, Cost, size_t>> uniqueEdgeCosts;
-    for (auto const &vt : data.vehicleTypes())
-    {
-        uniqueEdgeCosts.insert(
-            {vt.unitDistanceCost, vt.unitDurationCost, vt.profile});
-    }
-
-    // Step 2: Compute minimum edge cost matrix across all vehicle types
-    std::vector<std::vector<double>> edgeCosts(
-        numLocs, std::vector<double>(numLocs, 0.0));
-    bool first = true;
-    for (auto const &[unitDist, unitDur, profile] : uniqueEdgeCosts)
-    {
-        auto const &distMat = data.distanceMatrix(profile);
-        auto const &durMat = data.durationMatrix(profile);
-        for (size_t i = 0; i < numLocs; ++i)
-        {
-            for (size_t j = 0; j < numLocs; ++j)
-            {
-                double cost = static_cast<double>(unitDist.get())
-                                  * static_cast<double>(distMat(i, j).get())
-                              + static_cast<double>(unitDur.get())
-                                    * static_cast<double>(durMat(i, j).get());
-                if (first)
-                {
-                    edgeCosts[i][j] = cost;
-                }
-                else
-                {
-                    edgeCosts[i][j] = std::min(edgeCosts[i][j], cost);
-                }
-            }
-        }
-        first = false;
-    }
-
-    // Step 3: Compute minimum duration matrix across all profiles (store as
-    // double)
-    std::vector<std::vector<double>> minDuration(numLocs,
-                                                 std::vector<double>(numLocs));
-    for (size_t i = 0; i < numLocs; ++i)
-    {
-        for (size_t j = 0; j < numLocs; ++j)
-        {
-            double minDur
-                = static_cast<double>(data.durationMatrix(0)(i, j).get());
-            for (size_t p = 1; p < data.numProfiles(); ++p)
-            {
-                minDur = std::min(
-                    minDur,
-                    static_cast<double>(data.durationMatrix(p)(i, j).get()));
-            }
-            minDuration[i][j] = minDur;
-        }
-    }
-
-    // Step 4: Extract client time windows and service durations (store as
-    // double) Clients start at index numDepots in location array
-    std::vector<double> early(numLocs, 0.0);
-    std::vector<double> late(numLocs, 0.0);
-    std::vector<double> service(numLocs, 0.0);
-    std::vector<double> prize(numLocs, 0.0);
-
-    auto const &clients = data.clients();
-    for (size_t c = 0; c < numClients; ++c)
-    {
-        size_t loc = numDepots + c;
-        early[loc] = static_cast<double>(clients[c].twEarly.get());
-        late[loc] = static_cast<double>(clients[c].twLate.get());
-        service[loc] = static_cast<double>(clients[c].serviceDuration.get());
-        prize[loc] = static_cast<double>(clients[c].prize.get());
-    }
-
-    // Step 5: Add time window penalties and subtract prizes
-    // min_wait[i][j] = early[j] - minDuration[i][j] - service[i] - late[i]
-    // min_tw[i][j] = early[i] + service[i] + minDuration[i][j] - late[j]
-    for (size_t i = 0; i < numLocs; ++i)
-    {
-        for (size_t j = 0; j < numLocs; ++j)
-        {
-            // Subtract prize for visiting j
-            edgeCosts[i][j] -= prize[j];
-
-            // Wait time penalty (arriving too early at j)
-            double minWait
-                = early[j] - minDuration[i][j] - service[i] - late[i];
-            if (minWait > 0)
-            {
-                edgeCosts[i][j] += weightWaitTime * minWait;
-            }
-
-            // Time warp penalty (arriving too late at j)
-            double minTw = early[i] + service[i] + minDuration[i][j] - late[j];
-            if (minTw > 0)
-            {
-                edgeCosts[i][j] += weightTimeWarp * minTw;
-            }
-        }
-    }
-
-    // Step 6: Symmetrize proximity if requested
-    if (symmetricProximity)
-    {
-        for (size_t i = 0; i < numLocs; ++i)
-        {
-            for (size_t j = i + 1; j < numLocs; ++j)
-            {
-                double minVal = std::min(edgeCosts[i][j], edgeCosts[j][i]);
-                edgeCosts[i][j] = minVal;
-                edgeCosts[j][i] = minVal;
-            }
-        }
-    }
-
-    // Step 7: Handle mutually exclusive groups - high proximity for same-group
-    // clients
-    for (auto const &group : data.groups())
-    {
-        if (group.mutuallyExclusive)
-        {
-            auto const &groupClients = group.clients();
-            for (size_t ci : groupClients)
-            {
-                for (size_t cj : groupClients)
-                {
-                    if (ci != cj)
-                    {
-                        // Use max double (not infinity) to order before depots
-                        edgeCosts[ci][cj] = std::numeric_limits<double>::max();
-                    }
-                }
-            }
-        }
-    }
-
-    // Step 8: Set diagonal and depot entries to infinity
-    for (size_t i = 0; i < numLocs; ++i)
-    {
-        edgeCosts[i][i] = std::numeric_limits<double>::infinity();  // Self
-    }
-    for (size_t d = 0; d < numDepots; ++d)
-    {
-        for (size_t j = 0; j < numLocs; ++j)
-        {
-            edgeCosts[d][j]
-                = std::numeric_limits<double>::infinity();  // Depots have no
-                                                            // neighbours
-            edgeCosts[j][d]
-                = std::numeric_limits<double>::infinity();  // Clients don't
-                                                            // neighbour depots
-        }
-    }
-
-    // Step 9: For each client, find k nearest by proximity
-    size_t k = std::min(numNeighbours, numClients - 1);
-    for (size_t i = numDepots; i < numLocs; ++i)
-    {
-        std::vector<std::pair<double, size_t>> proximities;
-        for (size_t j = numDepots; j < numLocs; ++j)
-        {
-            if (i != j)
-            {
-                proximities.emplace_back(edgeCosts[i][j], j);
-            }
-        }
-
-        // Partial sort: only sort the first k elements - O(n log k) instead of
-        // O(n log n)
-        if (!proximities.empty())
-        {
-            size_t k_actual = std::min(k, proximities.size());
-            std::partial_sort(proximities.begin(),
-                              proximities.begin() + k_actual,
-                              proximities.end());
-
-            for (size_t n = 0; n < k_actual; ++n)
-            {
-                neighbours[i].push_back(proximities[n].second);
-            }
-        }
-    }
-
-    return neighbours;
-}
-
 /**
  * Perform local search on a solution.
  */
@@ -3025,7 +3123,7 @@ local_search_nif([[maybe_unused]] ErlNifEnv *env,
     }
 
     // Build neighbourhood
-    auto neighbours = build_neighbours(problem_data);
+    auto neighbours = exvrp::computeNeighbours(problem_data);
 
     // Create perturbation manager with default params
     pyvrp::search::PerturbationParams perturbParams(1, 25);
@@ -3107,7 +3205,7 @@ fine::Ok<fine::ResourcePtr<SolutionResource>> local_search_search_only_nif(
     }
 
     // Build neighbourhood
-    auto neighbours = build_neighbours(problem_data);
+    auto neighbours = exvrp::computeNeighbours(problem_data);
 
     // Create perturbation manager (won't be used but required for LocalSearch
     // constructor)
@@ -3255,7 +3353,7 @@ fine::Ok<fine::ResourcePtr<SolutionResource>> local_search_with_operators_nif(
     }
 
     // Build neighbourhood
-    auto neighbours = build_neighbours(problem_data);
+    auto neighbours = exvrp::computeNeighbours(problem_data);
 
     // Create perturbation manager with default params
     pyvrp::search::PerturbationParams perturbParams(1, 25);
@@ -3279,6 +3377,7 @@ fine::Ok<fine::ResourcePtr<SolutionResource>> local_search_with_operators_nif(
         relocate_depot_ops;
     std::vector<std::unique_ptr<pyvrp::search::SwapStar>> swap_star_ops;
     std::vector<std::unique_ptr<pyvrp::search::SwapRoutes>> swap_routes_ops;
+    std::vector<std::unique_ptr<pyvrp::search::NodeOperator>> reversing_ops;
 
     // Add specified node operators
     for (const auto &op_name : node_ops)
@@ -3350,6 +3449,11 @@ fine::Ok<fine::ResourcePtr<SolutionResource>> local_search_with_operators_nif(
                     problem_data));
             ls.addNodeOperator(*relocate_depot_ops.back());
         }
+        else if (auto op = make_reversing_operator(op_name, problem_data))
+        {
+            reversing_ops.push_back(std::move(op));
+            ls.addNodeOperator(*reversing_ops.back());
+        }
     }
 
     // Add specified route operators
@@ -3457,7 +3561,7 @@ fine::Term local_search_stats_nif(
     }
 
     // Build neighbourhood
-    auto neighbours = build_neighbours(problem_data);
+    auto neighbours = exvrp::computeNeighbours(problem_data);
 
     // Create perturbation manager with default params
     pyvrp::search::PerturbationParams perturbParams(1, 25);
@@ -3487,6 +3591,7 @@ fine::Term local_search_stats_nif(
         relocate_depot_ops;
     std::vector<std::unique_ptr<pyvrp::search::SwapStar>> swap_star_ops;
     std::vector<std::unique_ptr<pyvrp::search::SwapRoutes>> swap_routes_ops;
+    std::vector<std::unique_ptr<pyvrp::search::NodeOperator>> reversing_ops;
 
     for (const auto &op_name : node_ops)
     {
@@ -3579,6 +3684,12 @@ fine::Term local_search_stats_nif(
             node_operator_ptrs.push_back(
                 {op_name, relocate_depot_ops.back().get()});
         }
+        else if (auto op = make_reversing_operator(op_name, problem_data))
+        {
+            reversing_ops.push_back(std::move(op));
+            ls.addNodeOperator(*reversing_ops.back());
+            node_operator_ptrs.push_back({op_name, reversing_ops.back().get()});
+        }
     }
 
     for (const auto &op_name : route_ops)
@@ -3712,21 +3823,41 @@ FINE_NIF(local_search_stats_nif, 0);
  *
  * The seed initializes the RNG which is stored and reused across calls,
  * matching PyVRP's behavior where one RNG is created at algorithm start.
+ *
+ * Options:
+ * - :node_operators - list of atom names of segment-reversing operators to
+ *   add to the defaults: [:two_opt, :or_opt_reverse2, :or_opt_reverse3]
  */
 fine::ResourcePtr<LocalSearchResource>
 create_local_search_nif([[maybe_unused]] ErlNifEnv *env,
                         fine::ResourcePtr<ProblemDataResource> problem_resource,
-                        int64_t seed)
+                        int64_t seed,
+                        fine::Term opts_term)
 {
     auto &problem_data = *problem_resource->data;
 
+    std::vector<std::string> extra_ops;
+    ERL_NIF_TERM value;
+    ERL_NIF_TERM key = enif_make_atom(env, "node_operators");
+    if (enif_get_map_value(env, opts_term, key, &value))
+    {
+        ERL_NIF_TERM head, tail = value;
+        while (enif_get_list_cell(env, tail, &head, &tail))
+        {
+            char buf[64];
+            if (enif_get_atom(env, head, buf, sizeof(buf), ERL_NIF_LATIN1))
+                extra_ops.emplace_back(buf);
+        }
+    }
+
     // Build neighbours (the expensive O(n²) computation)
-    auto neighbours = build_neighbours(problem_data);
+    auto neighbours = exvrp::computeNeighbours(problem_data);
 
     return fine::make_resource<LocalSearchResource>(
         problem_resource->data,
         std::move(neighbours),
-        static_cast<uint32_t>(seed));
+        static_cast<uint32_t>(seed),
+        extra_ops);
 }
 
 FINE_NIF(create_local_search_nif, ERL_NIF_DIRTY_JOB_CPU_BOUND);
@@ -3753,6 +3884,7 @@ fine::Ok<fine::ResourcePtr<SolutionResource>> local_search_run_nif(
     // Run local search (operator() = perturbation + search + intensify loop)
     Solution improved = (*ls_resource->ls)(
         solution_resource->solution, cost_evaluator, false, timeout_ms);
+    ls_resource->recordRun();
 
     return fine::Ok(fine::make_resource<SolutionResource>(
         std::move(improved), ls_resource->problemData));
@@ -3781,6 +3913,7 @@ fine::Ok<fine::ResourcePtr<SolutionResource>> local_search_search_run_nif(
     // Run search only (no perturbation), with optional timeout
     Solution improved = ls_resource->ls->search(
         solution_resource->solution, cost_evaluator, timeout_ms);
+    ls_resource->recordRun();
 
     return fine::Ok(fine::make_resource<SolutionResource>(
         std::move(improved), ls_resource->problemData));
@@ -3788,6 +3921,1319 @@ fine::Ok<fine::ResourcePtr<SolutionResource>> local_search_search_run_nif(
 
 FINE_NIF(local_search_search_run_nif, ERL_NIF_DIRTY_JOB_CPU_BOUND);
 
+/**
+ * Read the search statistics of a persistent LocalSearch resource, summed
+ * over all runs since it was created.
+ * Returns: %{runs: n, moves: n, improving: n, updates: n}
+ */
+fine::Term
+local_search_counters_nif([[maybe_unused]] ErlNifEnv *env,
+                          fine::ResourcePtr<LocalSearchResource> ls_resource)
+{
+    std::pair<char const *, size_t> const counters[] = {
+        {"runs", ls_resource->numRuns.load()},
+        {"moves", ls_resource->numMoves.load()},
+        {"improving", ls_resource->numImproving.load()},
+        {"updates", ls_resource->numUpdates.load()},
+    };
+
+    ERL_NIF_TERM result = enif_make_new_map(env);
+    for (auto const &[name, value] : counters)
+        enif_make_map_put(env,
+                          result,
+                          enif_make_atom(env, name),
+                          enif_make_uint64(env, value),
+                          &result);
+
+    return fine::Term(result);
+}
+
+FINE_NIF(local_search_counters_nif, 0);
+
+/**
+ * Enable or disable profiling on a persistent LocalSearch resource. While
+ * enabled, the time spent per search phase and per operator evaluation is
+ * accumulated until read with local_search_profile_nif.
+ */
+fine::Ok<> local_search_set_profiling_nif(
+    [[maybe_unused]] ErlNifEnv *env,
+    fine::ResourcePtr<LocalSearchResource> ls_resource,
+    bool enabled)
+{
+    ls_resource->ls->setProfiling(enabled);
+    return fine::Ok<>();
+}
+
+FINE_NIF(local_search_set_profiling_nif, 0);
+
+/**
+ * Read the profile of a persistent LocalSearch resource.
+ * Returns: %{phases: %{phase => timing}, operators: %{operator => timing}},
+ * where each timing is %{count: n, time_ns: n}.
+ */
+fine::Term
+local_search_profile_nif([[maybe_unused]] ErlNifEnv *env,
+                         fine::ResourcePtr<LocalSearchResource> ls_resource)
+{
+    using search::SearchProfile;
+    auto const &profile = ls_resource->ls->profile();
+
+    auto const make_timing = [&](SearchProfile::Timing const &timing)
+    {
+        ERL_NIF_TERM map = enif_make_new_map(env);
+        enif_make_map_put(env,
+                          map,
+                          enif_make_atom(env, "count"),
+                          enif_make_uint64(env, timing.count),
+                          &map);
+        enif_make_map_put(env,
+                          map,
+                          enif_make_atom(env, "time_ns"),
+                          enif_make_uint64(env, timing.nanoseconds),
+                          &map);
+        return map;
+    };
+
+    ERL_NIF_TERM phases = enif_make_new_map(env);
+    for (size_t idx = 0; idx != SearchProfile::NUM_PHASES; ++idx)
+    {
+        auto const phase = static_cast<SearchProfile::Phase>(idx);
+        enif_make_map_put(env,
+                          phases,
+                          enif_make_atom(env, SearchProfile::phaseName(phase)),
+                          make_timing(profile.phases[idx]),
+                          &phases);
+    }
+
+    ERL_NIF_TERM operators = enif_make_new_map(env);
+    auto const put_operators = [&](auto const &names, auto const &timings)
+    {
+        for (size_t idx = 0; idx != timings.size(); ++idx)
+            enif_make_map_put(env,
+                              operators,
+                              enif_make_atom(env, names[idx].c_str()),
+                              make_timing(timings[idx]),
+                              &operators);
+    };
+
+    put_operators(ls_resource->nodeOpNames, profile.nodeOperators);
+    put_operators(ls_resource->routeOpNames, profile.routeOperators);
+
+    ERL_NIF_TERM result = enif_make_new_map(env);
+    enif_make_map_put(
+        env, result, enif_make_atom(env, "phases"), phases, &result);
+    enif_make_map_put(
+        env, result, enif_make_atom(env, "operators"), operators, &result);
+
+    return fine::Term(result);
+}
+
+FINE_NIF(local_search_profile_nif, 0);
+
+/**
+ * Reset the profile of a persistent LocalSearch resource to zero.
+ */
+fine::Ok<> local_search_reset_profile_nif(
+    [[maybe_unused]] ErlNifEnv *env,
+    fine::ResourcePtr<LocalSearchResource> ls_resource)
+{
+    ls_resource->ls->resetProfile();
+    return fine::Ok<>();
+}
+
+FINE_NIF(local_search_reset_profile_nif, 0);
+
+// Returns the clients in the first prefix_lengths[idx] visits of each route
+// idx of the given solution. Routes without a length are not locked.
+static std::vector<size_t>
+locked_prefix_clients(Solution const &solution,
+                      std::vector<int64_t> const &prefix_lengths)
+{
+    auto const &routes = solution.routes();
+    if (prefix_lengths.size() > routes.size())
+        throw std::invalid_argument("More prefix lengths than routes.");
+
+    std::vector<size_t> clients;
+    for (size_t idx = 0; idx != prefix_lengths.size(); ++idx)
+    {
+        if (prefix_lengths[idx] < 0)
+            throw std::invalid_argument("Prefix length must be >= 0.");
+
+        auto const visits = routes[idx].visits();
+        auto const length = std::min(static_cast<size_t>(prefix_lengths[idx]),
+                                     visits.size());
+        clients.insert(clients.end(), visits.begin(), visits.begin() + length);
+    }
+
+    return clients;
+}
+
+/**
+ * Lock a prefix of each route of the given solution in the persistent
+ * LocalSearch resource.
+ *
+ * Entry idx of prefix_lengths gives the number of leading visits of route idx
+ * that are locked in place. Subsequent runs do not move or remove these
+ * clients, nor insert other clients before or between them. Replaces any
+ * existing locks; an empty list unlocks all clients.
+ */
+fine::Ok<> local_search_lock_prefixes_nif(
+    [[maybe_unused]] ErlNifEnv *env,
+    fine::ResourcePtr<LocalSearchResource> ls_resource,
+    fine::ResourcePtr<SolutionResource> solution_resource,
+    std::vector<int64_t> prefix_lengths)
+{
+    ls_resource->ls->setLocked(
+        locked_prefix_clients(solution_resource->solution, prefix_lengths));
+
+    return fine::Ok<>();
+}
+
+FINE_NIF(local_search_lock_prefixes_nif, 0);
+
+// -----------------------------------------------------------------------------
+// Re-optimisation Session NIFs
+// -----------------------------------------------------------------------------
+
+/**
+ * Extends a neighbourhood structure computed by computeNeighbours to clients
+ * appended at the end of the given data. New clients get a full neighbour
+ * list; existing clients only re-rank their current neighbours together with
+ * the new clients. As in computeNeighbours, clients only neighbour clients
+ * they can share a route with. This is O(n * (k + m)) rather than the O(n²)
+ * rebuild.
+ */
+static pyvrp::search::SearchSpace::Neighbours
+extend_neighbours(ProblemData const &data,
+                  pyvrp::search::SearchSpace::Neighbours neighbours,
+                  std::vector<bool> const &excluded = {},
+                  size_t numNeighbours = 60)
+{
+    size_t const numLocs = data.numLocations();
+    size_t const numDepots = data.numDepots();
+    size_t const firstNew = neighbours.size();
+    neighbours.resize(numLocs);
+
+    if (data.numClients() == 0 || firstNew == numLocs)
+        return neighbours;
+
+    exvrp::Proximity const proximity(data);
+    exvrp::Reachability const reachability(data);
+    size_t const k = std::min(numNeighbours, data.numClients() - 1);
+    std::vector<std::pair<double, size_t>> proximities;
+
+    auto const assign = [&](size_t client)
+    {
+        size_t const kActual = std::min(k, proximities.size());
+        std::partial_sort(proximities.begin(),
+                          proximities.begin() + kActual,
+                          proximities.end());
+
+        neighbours[client].clear();
+        for (size_t n = 0; n < kActual; ++n)
+            neighbours[client].push_back(proximities[n].second);
+    };
+
+    for (size_t i = firstNew; i < numLocs; ++i)
+    {
+        proximities.clear();
+        for (size_t j = numDepots; j < numLocs; ++j)
+            if (i != j && (j >= excluded.size() || !excluded[j])
+                && reachability.canNeighbour(i, j))
+                proximities.emplace_back(proximity(i, j), j);
+
+        assign(i);
+    }
+
+    for (size_t i = numDepots; i < firstNew; ++i)
+    {
+        if (i < excluded.size() && excluded[i])
+            continue;
+
+        proximities.clear();
+        for (auto const j : neighbours[i])
+            proximities.emplace_back(proximity(i, j), j);
+
+        for (size_t j = firstNew; j < numLocs; ++j)
+            if (reachability.canNeighbour(i, j))
+                proximities.emplace_back(proximity(i, j), j);
+
+        assign(i);
+    }
+
+    return neighbours;
+}
+
+/**
+ * Patches a neighbourhood structure after the given clients changed, e.g.
+ * their time windows or travel times. Changed clients get a full neighbour
+ * list. Other clients whose list contains a changed or excluded client are
+ * recomputed in full, since that client may have dropped out of their list;
+ * the rest only re-rank against the changed clients. Excluded clients get no
+ * neighbours and are not anyone's neighbour. This costs O(m * n) for m changed
+ * clients, rather than the O(n²) rebuild.
+ */
+static pyvrp::search::SearchSpace::Neighbours
+patch_neighbours(ProblemData const &data,
+                 pyvrp::search::SearchSpace::Neighbours neighbours,
+                 std::vector<size_t> const &changed,
+                 std::vector<bool> const &excluded,
+                 size_t numNeighbours = 60)
+{
+    size_t const numLocs = data.numLocations();
+    size_t const numDepots = data.numDepots();
+
+    if (data.numClients() == 0 || changed.empty())
+        return neighbours;
+
+    std::vector<bool> isChanged(numLocs, false);
+    for (auto const client : changed)
+        isChanged[client] = true;
+
+    exvrp::Proximity const proximity(data);
+    exvrp::Reachability const reachability(data);
+    size_t const k = std::min(numNeighbours, data.numClients() - 1);
+    std::vector<std::pair<double, size_t>> proximities;
+
+    auto const assign = [&](size_t client)
+    {
+        size_t const kActual = std::min(k, proximities.size());
+        std::partial_sort(proximities.begin(),
+                          proximities.begin() + kActual,
+                          proximities.end());
+
+        neighbours[client].clear();
+        for (size_t n = 0; n < kActual; ++n)
+            neighbours[client].push_back(proximities[n].second);
+    };
+
+    auto const rebuild = [&](size_t i)
+    {
+        proximities.clear();
+        if (!excluded[i])
+            for (size_t j = numDepots; j < numLocs; ++j)
+                if (i != j && !excluded[j] && reachability.canNeighbour(i, j))
+                    proximities.emplace_back(proximity(i, j), j);
+
+        assign(i);
+    };
+
+    for (auto const client : changed)
+        rebuild(client);
+
+    for (size_t i = numDepots; i < numLocs; ++i)
+    {
+        if (isChanged[i] || excluded[i])
+            continue;
+
+        auto const &current = neighbours[i];
+        auto const stale = [&](size_t j)
+        { return isChanged[j] || excluded[j]; };
+        if (std::any_of(current.begin(), current.end(), stale))
+        {
+            rebuild(i);
+            continue;
+        }
+
+        // Neighbour lists are sorted by increasing proximity, so a changed
+        // client only enters the list if it is closer than the last entry.
+        double const worst = current.size() < k
+                                 ? std::numeric_limits<double>::infinity()
+                                 : proximity(i, current.back());
+
+        proximities.clear();
+        for (auto const j : changed)
+            if (j != i && !excluded[j] && reachability.canNeighbour(i, j))
+            {
+                auto const prox = proximity(i, j);
+                if (prox < worst)
+                    proximities.emplace_back(prox, j);
+            }
+
+        if (proximities.empty())
+            continue;
+
+        for (auto const j : current)
+            proximities.emplace_back(proximity(i, j), j);
+
+        assign(i);
+    }
+
+    return neighbours;
+}
+
+// Extends a square matrix by the rows (new location -> all locations) and
+// columns (all locations -> new location) of appended locations. Missing
+// columns mirror the rows; missing rows fall back to the given function.
+template <typename T, typename Fallback>
+static Matrix<T> extend_matrix(SharedMatrix<T> const &matrix,
+                               size_t numLocs,
+                               Matrix<T> const *rows,
+                               Matrix<T> const *cols,
+                               Fallback fallback)
+{
+    size_t const numOld = matrix.numRows();
+    size_t const numNew = numLocs - numOld;
+
+    for (auto const *mat : {rows, cols})
+        if (mat && (mat->numRows() != numNew || mat->numCols() != numLocs))
+        {
+            std::ostringstream msg;
+            msg << "Expected " << numNew << " rows of length " << numLocs
+                << " per profile for the new clients";
+            throw std::invalid_argument(msg.str());
+        }
+
+    // Rows are copied in bulk from the shared storage, unless some of its
+    // rows or columns were updated since.
+    Matrix<T> extended(numLocs, numLocs);
+    for (size_t i = 0; i != numOld; ++i)
+        if (matrix.numPatches() == 0)
+            std::copy_n(matrix.base().data() + i * numOld,
+                        numOld,
+                        extended.data() + i * numLocs);
+        else
+            for (size_t j = 0; j != numOld; ++j)
+                extended(i, j) = matrix(i, j);
+
+    // Columns first, so that rows take precedence for new-to-new entries.
+    for (size_t loc = numOld; loc != numLocs; ++loc)
+        for (size_t other = 0; other != numLocs; ++other)
+        {
+            auto const *src = cols ? cols : rows;
+            extended(other, loc) = src ? (*src)(loc - numOld, other)
+                                       : fallback(other, loc);
+        }
+
+    for (size_t loc = numOld; loc != numLocs; ++loc)
+        for (size_t other = 0; other != numLocs; ++other)
+            extended(loc, other)
+                = rows ? (*rows)(loc - numOld, other) : fallback(loc, other);
+
+    return extended;
+}
+
+/**
+ * Returns new problem data with the clients in the given update map appended
+ * after the existing locations. All existing location indices are unchanged.
+ *
+ * The update map has a ``clients`` list, and optionally per-profile
+ * ``distance_rows``/``distance_cols`` and ``duration_rows``/``duration_cols``
+ * lists. Rows give the travel from each new client to every location, and
+ * columns the travel from every location to each new client. Columns default
+ * to the rows; without rows, Euclidean distances are used (unit speed), as in
+ * create_problem_data.
+ */
+static std::shared_ptr<ProblemData>
+extend_problem_data(ErlNifEnv *env,
+                    ProblemData const &data,
+                    ERL_NIF_TERM update_term)
+{
+    ERL_NIF_TERM clients_term;
+    if (!enif_get_map_value(
+            env, update_term, enif_make_atom(env, "clients"), &clients_term))
+    {
+        throw std::runtime_error("Update missing clients field");
+    }
+
+    auto const originalClients = data.originalClients();
+    std::vector<ProblemData::Client> clients(originalClients.begin(),
+                                             originalClients.end());
+    std::vector<ProblemData::ClientGroup> groups = data.groups();
+
+    unsigned clients_len;
+    if (!enif_get_list_length(env, clients_term, &clients_len))
+    {
+        throw std::runtime_error("Expected list for clients");
+    }
+    clients.reserve(clients.size() + clients_len);
+
+    ERL_NIF_TERM head, tail = clients_term;
+    for (unsigned i = 0; i < clients_len; i++)
+    {
+        enif_get_list_cell(env, tail, &head, &tail);
+        auto client = decode_client(env, head);
+
+        if (client.group)
+        {
+            if (client.group.value() >= groups.size())
+                throw std::out_of_range("Client group index out of range");
+
+            groups[client.group.value()].addClient(data.numDepots()
+                                                   + clients.size());
+        }
+
+        clients.push_back(std::move(client));
+    }
+
+    auto const get_matrices = [&](char const *name, auto decode)
+    {
+        std::vector<decltype(decode(env, ERL_NIF_TERM{}))> matrices;
+
+        ERL_NIF_TERM list;
+        if (!enif_get_map_value(
+                env, update_term, enif_make_atom(env, name), &list))
+            return matrices;
+
+        ERL_NIF_TERM item, rest = list;
+        while (enif_get_list_cell(env, rest, &item, &rest))
+            matrices.push_back(decode(env, item));
+
+        if (!matrices.empty() && matrices.size() != data.numProfiles())
+            throw std::invalid_argument(
+                std::string("Expected one entry per profile for ") + name);
+
+        return matrices;
+    };
+
+    auto const distRows = get_matrices("distance_rows", decode_distance_matrix);
+    auto const distCols = get_matrices("distance_cols", decode_distance_matrix);
+    auto const durRows = get_matrices("duration_rows", decode_duration_matrix);
+    auto const durCols = get_matrices("duration_cols", decode_duration_matrix);
+
+    size_t const numLocs = data.numDepots() + clients.size();
+    auto const coords = [&](size_t idx) -> std::pair<int64_t, int64_t>
+    {
+        if (idx < data.numDepots())
+        {
+            auto const &depot = data.depots()[idx];
+            return {static_cast<int64_t>(depot.x),
+                    static_cast<int64_t>(depot.y)};
+        }
+
+        auto const &client = clients[idx - data.numDepots()];
+        return {static_cast<int64_t>(client.x), static_cast<int64_t>(client.y)};
+    };
+
+    auto const euclidean = [&](size_t from, size_t to)
+    {
+        auto const [x1, y1] = coords(from);
+        auto const [x2, y2] = coords(to);
+        return euclidean_distance(x1, y1, x2, y2);
+    };
+
+    auto const opt = [](auto const &matrices, size_t profile)
+    { return matrices.empty() ? nullptr : &matrices[profile]; };
+
+    std::vector<Matrix<Distance>> distMats;
+    std::vector<Matrix<Duration>> durMats;
+    for (size_t profile = 0; profile != data.numProfiles(); ++profile)
+    {
+        distMats.push_back(
+            extend_matrix(data.distanceMatrix(profile),
+                          numLocs,
+                          opt(distRows, profile),
+                          opt(distCols, profile),
+                          [&](size_t from, size_t to)
+                          { return Distance(euclidean(from, to)); }));
+
+        durMats.push_back(
+            extend_matrix(data.durationMatrix(profile),
+                          numLocs,
+                          opt(durRows, profile),
+                          opt(durCols, profile),
+                          [&](size_t from, size_t to)
+                          { return Duration(euclidean(from, to)); }));
+    }
+
+    return std::make_shared<ProblemData>(std::move(clients),
+                                         data.depots(),
+                                         data.vehicleTypes(),
+                                         std::move(distMats),
+                                         std::move(durMats),
+                                         std::move(groups),
+                                         data.sameVehicleGroups(),
+                                         data.hardTimeWindows(),
+                                         data.tightenTimeWindows());
+}
+
+/**
+ * Returns new problem data with the changes in the given update map applied.
+ * Location indices are unchanged, and the unchanged clients and travel are
+ * shared with the given data rather than copied.
+ *
+ * The update map optionally has the following lists:
+ *
+ * - ``clients``: ``{idx, client}`` tuples that replace the client at location
+ *   index ``idx``, e.g. to change its time window.
+ * - ``remove``: client indices of cancelled clients. These are kept in the
+ *   data (so indices stay stable), but become optional without a prize.
+ * - ``distance_rows``/``duration_rows``: ``{profile, idx, values}`` tuples
+ *   with the travel from location ``idx`` to every location.
+ * - ``distance_cols``/``duration_cols``: ``{profile, idx, values}`` tuples
+ *   with the travel from every location to location ``idx``.
+ *
+ * The changed clients (including removed ones) are appended to ``changed``,
+ * and the removed clients to ``removed``.
+ */
+static std::shared_ptr<ProblemData>
+update_problem_data(ErlNifEnv *env,
+                    ProblemData const &data,
+                    ERL_NIF_TERM update_term,
+                    std::vector<size_t> &changed,
+                    std::vector<size_t> &removed)
+{
+    auto const get_list = [&](char const *name)
+    {
+        std::vector<ERL_NIF_TERM> items;
+
+        ERL_NIF_TERM list;
+        if (!enif_get_map_value(
+                env, update_term, enif_make_atom(env, name), &list))
+            return items;
+
+        ERL_NIF_TERM item, rest = list;
+        while (enif_get_list_cell(env, rest, &item, &rest))
+            items.push_back(item);
+
+        return items;
+    };
+
+    auto const get_index = [&](ERL_NIF_TERM term, size_t bound)
+    {
+        int64_t idx;
+        if (!nif_get_int64(env, term, &idx) || idx < 0
+            || static_cast<size_t>(idx) >= bound)
+            throw std::out_of_range("Index out of range in update");
+
+        return static_cast<size_t>(idx);
+    };
+
+    auto const get_client_index = [&](ERL_NIF_TERM term)
+    {
+        auto const idx = get_index(term, data.numLocations());
+        if (idx < data.numDepots())
+            throw std::out_of_range("Update refers to a depot, not a client");
+
+        return idx;
+    };
+
+    std::vector<std::pair<size_t, ProblemData::Client>> clients;
+    for (auto const item : get_list("clients"))
+    {
+        int arity;
+        ERL_NIF_TERM const *elems;
+        if (!enif_get_tuple(env, item, &arity, &elems) || arity != 2)
+            throw std::invalid_argument("Expected {idx, client} tuples");
+
+        auto const idx = get_client_index(elems[0]);
+        clients.emplace_back(idx, decode_client(env, elems[1]));
+        changed.push_back(idx);
+    }
+
+    for (auto const item : get_list("remove"))
+    {
+        auto const idx = get_client_index(item);
+        auto const &client = data.originalClients()[idx - data.numDepots()];
+        clients.emplace_back(idx,
+                             ProblemData::Client(client.x,
+                                                 client.y,
+                                                 client.delivery,
+                                                 client.pickup,
+                                                 client.serviceDuration,
+                                                 client.twEarly,
+                                                 client.twLate,
+                                                 client.releaseTime,
+                                                 Cost(0),
+                                                 false,
+                                                 client.group,
+                                                 client.name));
+        changed.push_back(idx);
+        removed.push_back(idx);
+    }
+
+    // Each row or column is stored on top of the shared matrix it updates,
+    // so nothing else of that matrix is copied.
+    auto const update_travel
+        = [&](auto &updates, char const *name, bool isRow)
+    {
+        using T = typename std::decay_t<decltype(updates)>::value_type;
+
+        for (auto const item : get_list(name))
+        {
+            int arity;
+            ERL_NIF_TERM const *elems;
+            if (!enif_get_tuple(env, item, &arity, &elems) || arity != 3)
+                throw std::invalid_argument(
+                    std::string("Expected {profile, idx, values} tuples for ")
+                    + name);
+
+            auto const profile = get_index(elems[0], data.numProfiles());
+            auto const idx = get_index(elems[1], data.numLocations());
+
+            unsigned length;
+            if (!enif_get_list_length(env, elems[2], &length)
+                || length != data.numLocations())
+                throw std::invalid_argument(
+                    std::string("Expected one value per location for ")
+                    + name);
+
+            auto &update = updates.emplace_back(T{profile, idx, isRow, {}});
+            update.values.reserve(length);
+
+            ERL_NIF_TERM value, rest = elems[2];
+            while (enif_get_list_cell(env, rest, &value, &rest))
+            {
+                int64_t val;
+                if (!nif_get_int64(env, value, &val))
+                    throw std::invalid_argument(
+                        std::string("Expected integer values for ") + name);
+
+                update.values.emplace_back(val);
+            }
+
+            if (idx >= data.numDepots())
+                changed.push_back(idx);
+        }
+    };
+
+    // Columns first, so that rows take precedence where they cross.
+    std::vector<ProblemData::TravelUpdate<Distance>> distances;
+    update_travel(distances, "distance_cols", false);
+    update_travel(distances, "distance_rows", true);
+
+    std::vector<ProblemData::TravelUpdate<Duration>> durations;
+    update_travel(durations, "duration_cols", false);
+    update_travel(durations, "duration_rows", true);
+
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+
+    return std::make_shared<ProblemData>(
+        data.update(clients, std::move(distances), std::move(durations)));
+}
+
+// Rebuilds the given solution against other problem data with the same
+// depots, vehicle types and (at least the same) client indices. Excluded
+// clients are dropped from the solution, as are routes left empty.
+static Solution rebind_solution(Solution const &solution,
+                                ProblemData const &data,
+                                std::vector<bool> const &excluded = {})
+{
+    std::vector<Route> routes;
+    routes.reserve(solution.numRoutes());
+
+    auto const isExcluded = [&](size_t client)
+    { return client < excluded.size() && excluded[client]; };
+
+    for (auto const &route : solution.routes())
+    {
+        std::vector<Trip> trips;
+        trips.reserve(route.numTrips());
+
+        size_t numVisits = 0;
+        for (auto const &trip : route.trips())
+        {
+            std::vector<size_t> visits;
+            std::copy_if(trip.visits().begin(),
+                         trip.visits().end(),
+                         std::back_inserter(visits),
+                         [&](size_t client) { return !isExcluded(client); });
+
+            numVisits += visits.size();
+            trips.emplace_back(data,
+                               std::move(visits),
+                               trip.vehicleType(),
+                               trip.startDepot(),
+                               trip.endDepot());
+        }
+
+        if (numVisits > 0)
+            routes.emplace_back(data, std::move(trips), route.vehicleType());
+    }
+
+    return Solution(data, std::move(routes));
+}
+
+/**
+ * Create a re-optimisation session around the given plan.
+ *
+ * The session owns a LocalSearch bound to the plan's problem data and keeps
+ * the plan resident, so that new clients can be inserted incrementally.
+ */
+fine::ResourcePtr<SessionResource>
+create_session_nif([[maybe_unused]] ErlNifEnv *env,
+                   fine::ResourcePtr<SolutionResource> solution_resource,
+                   int64_t seed)
+{
+    auto const &problem_data = solution_resource->problemData;
+
+    return fine::make_resource<SessionResource>(
+        problem_data,
+        exvrp::computeNeighbours(*problem_data),
+        solution_resource->solution,
+        static_cast<uint32_t>(seed));
+}
+
+FINE_NIF(create_session_nif, ERL_NIF_DIRTY_JOB_CPU_BOUND);
+
+/**
+ * Lock a prefix of each route of the session's current plan.
+ *
+ * See local_search_lock_prefixes_nif. The locks are kept by the session and
+ * respected by all subsequent inserts.
+ */
+fine::Ok<>
+session_lock_prefixes_nif([[maybe_unused]] ErlNifEnv *env,
+                          fine::ResourcePtr<SessionResource> session_resource,
+                          std::vector<int64_t> prefix_lengths)
+{
+    auto &session = *session_resource;
+
+    session.locked = locked_prefix_clients(*session.solution, prefix_lengths);
+    session.search->ls->setLocked(session.frozen());
+
+    return fine::Ok<>();
+}
+
+FINE_NIF(session_lock_prefixes_nif, 0);
+
+/**
+ * Apply changes to existing clients and travel times to the session's plan.
+ *
+ * Builds a new problem data version that shares all unchanged matrices with
+ * the current one (see update_problem_data), patches the neighbour lists of
+ * the affected clients only, rebinds the session's search to the new version,
+ * and re-optimises around the changed clients.
+ * Removed clients are dropped from the plan and kept out of it. The timeout
+ * covers the whole call. Returns the updated problem data and plan, which
+ * also becomes the session's current plan.
+ */
+fine::Ok<std::tuple<fine::ResourcePtr<ProblemDataResource>,
+                    fine::ResourcePtr<SolutionResource>>>
+session_update_nif([[maybe_unused]] ErlNifEnv *env,
+                   fine::ResourcePtr<SessionResource> session_resource,
+                   fine::Term update_term,
+                   fine::ResourcePtr<CostEvaluatorResource> evaluator_resource,
+                   int64_t timeout_ms)
+{
+    auto const start = std::chrono::steady_clock::now();
+
+    auto &session = *session_resource;
+    auto const &old_data = *session.search->problemData;
+    auto const &old_neighbours = session.search->neighbours;
+
+    std::vector<size_t> changed;
+    std::vector<size_t> removed;
+    auto problem_data
+        = update_problem_data(env, old_data, update_term, changed, removed);
+
+    for (auto const client : removed)
+        if (std::find(session.locked.begin(), session.locked.end(), client)
+            != session.locked.end())
+            throw std::invalid_argument("Cannot remove a locked client.");
+
+    std::vector<bool> excluded(problem_data->numLocations(), false);
+    for (auto const client : session.removed)
+        excluded[client] = true;
+
+    auto all_removed = session.removed;
+    for (auto const client : removed)
+        if (!excluded[client])
+            all_removed.push_back(client);
+
+    for (auto const client : removed)
+        excluded[client] = true;
+
+    // Removed clients leave a gap in the plan that their former neighbours
+    // may be able to close, so those are searched as well.
+    auto clients = changed;
+    for (auto const client : removed)
+        for (auto const other : old_neighbours[client])
+            if (!excluded[other])
+                clients.push_back(other);
+
+    auto neighbours
+        = patch_neighbours(*problem_data, old_neighbours, changed, excluded);
+
+    // The new version has the same depots, vehicle types and groups, so the
+    // search and its operators are rebound to it rather than rebuilt.
+    auto &search = *session.search;
+    search.ls->setData(*problem_data, neighbours);
+    search.neighbours = std::move(neighbours);
+
+    auto old_problem_data = std::exchange(search.problemData, problem_data);
+    auto const bytes = released_bytes(old_problem_data);
+    exvrp::reclaimer().reclaim(std::move(old_problem_data), bytes);
+
+    auto const plan
+        = rebind_solution(*session.solution, *problem_data, excluded);
+
+    int64_t remaining_ms = 0;
+    if (timeout_ms > 0)
+    {
+        auto const elapsed
+            = std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - start)
+                  .count();
+        remaining_ms = std::max<int64_t>(timeout_ms - elapsed, 1);
+    }
+
+    auto frozen = session.locked;
+    frozen.insert(frozen.end(), all_removed.begin(), all_removed.end());
+
+    search.ls->setLocked(frozen);
+    search.ls->shuffle(search.rng);
+    Solution improved = search.ls->insert(
+        plan, clients, evaluator_resource->evaluator, remaining_ms);
+
+    session.solution = std::make_unique<Solution>(improved);
+    session.removed = std::move(all_removed);
+
+    return fine::Ok(std::make_tuple(
+        fine::make_resource<ProblemDataResource>(problem_data),
+        fine::make_resource<SolutionResource>(std::move(improved),
+                                              problem_data)));
+}
+
+FINE_NIF(session_update_nif, ERL_NIF_DIRTY_JOB_CPU_BOUND);
+
+/**
+ * Insert new clients into the session's plan.
+ *
+ * Appends the clients to the problem data, inserts them into the resident
+ * plan, and re-optimises with only the new clients and their neighbours
+ * marked as promising. The timeout covers the whole call, including the
+ * problem data and neighbourhood updates. Returns the extended problem data
+ * and the updated plan, which also becomes the session's current plan.
+ */
+fine::Ok<std::tuple<fine::ResourcePtr<ProblemDataResource>,
+                    fine::ResourcePtr<SolutionResource>>>
+session_insert_nif([[maybe_unused]] ErlNifEnv *env,
+                   fine::ResourcePtr<SessionResource> session_resource,
+                   fine::Term update_term,
+                   fine::ResourcePtr<CostEvaluatorResource> evaluator_resource,
+                   int64_t timeout_ms)
+{
+    auto const start = std::chrono::steady_clock::now();
+
+    auto &session = *session_resource;
+    auto const &old_data = *session.search->problemData;
+
+    auto problem_data = extend_problem_data(env, old_data, update_term);
+
+    std::vector<bool> excluded(problem_data->numLocations(), false);
+    for (auto const client : session.removed)
+        excluded[client] = true;
+
+    auto neighbours = extend_neighbours(
+        *problem_data, session.search->neighbours, excluded);
+
+    auto search = std::make_unique<LocalSearchResource>(
+        problem_data, std::move(neighbours), 0);
+    search->rng = session.search->rng;
+
+    std::vector<size_t> clients(problem_data->numLocations()
+                                - old_data.numLocations());
+    std::iota(clients.begin(), clients.end(), old_data.numLocations());
+
+    auto const plan = rebind_solution(*session.solution, *problem_data);
+
+    // Whatever remains of the budget goes to the search itself.
+    int64_t remaining_ms = 0;
+    if (timeout_ms > 0)
+    {
+        auto const elapsed
+            = std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - start)
+                  .count();
+        remaining_ms = std::max<int64_t>(timeout_ms - elapsed, 1);
+    }
+
+    search->ls->setLocked(session.frozen());
+    search->ls->shuffle(search->rng);
+    Solution improved = search->ls->insert(
+        plan, clients, evaluator_resource->evaluator, remaining_ms);
+
+    session.search = std::move(search);
+    session.solution = std::make_unique<Solution>(improved);
+
+    return fine::Ok(std::make_tuple(
+        fine::make_resource<ProblemDataResource>(problem_data),
+        fine::make_resource<SolutionResource>(std::move(improved),
+                                              problem_data)));
+}
+
+FINE_NIF(session_insert_nif, ERL_NIF_DIRTY_JOB_CPU_BOUND);
+
+// -----------------------------------------------------------------------------
+// Batch Solve
+// -----------------------------------------------------------------------------
+
+// A single instance of a batch solve: the packed model and its budget, and
+// after solving, either the result or the error message.
+struct BatchJob
+{
+    ErlNifBinary model;  // model in external term format
+    exvrp::SolveParams params;
+
+    std::shared_ptr<ProblemData> data;
+    std::optional<exvrp::SolveResult> result;
+    std::string error;
+};
+
+// Reads the boolean, integer or number field name of the given map into out,
+// if the field exists. Leaves out unchanged otherwise (e.g. when map is nil).
+template <typename T>
+static void
+get_solve_param(ErlNifEnv *env, ERL_NIF_TERM map, char const *name, T &out)
+{
+    ERL_NIF_TERM value;
+    if (!enif_get_map_value(env, map, enif_make_atom(env, name), &value))
+        return;
+
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        if (enif_is_identical(value, enif_make_atom(env, "true")))
+            out = true;
+        else if (enif_is_identical(value, enif_make_atom(env, "false")))
+            out = false;
+        else
+            throw std::invalid_argument(std::string(name)
+                                        + " must be a boolean.");
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        if (!get_number_as_double(env, value, &out))
+            throw std::invalid_argument(std::string(name)
+                                        + " must be a number.");
+    }
+    else
+    {
+        int64_t val;
+        if (!nif_get_int64(env, value, &val) || val < 0)
+            throw std::invalid_argument(std::string(name)
+                                        + " must be a non-negative integer.");
+        out = static_cast<T>(val);
+    }
+}
+
+// Decodes the solve parameters of a native solve. The ILS, HGS,
+// decomposition and penalty parameters are the Elixir Params structs (or nil
+// for the defaults).
+static exvrp::SolveParams decode_solve_params(ErlNifEnv *env,
+                                              ERL_NIF_TERM term)
+{
+    exvrp::SolveParams params;
+
+    ERL_NIF_TERM algorithm;
+    if (enif_get_map_value(
+            env, term, enif_make_atom(env, "algorithm"), &algorithm))
+    {
+        char buf[8];
+        if (!enif_get_atom(env, algorithm, buf, sizeof(buf), ERL_NIF_LATIN1)
+            || (std::string(buf) != "ils" && std::string(buf) != "hgs"))
+            throw std::invalid_argument("algorithm must be :ils or :hgs.");
+
+        params.algorithm = std::string(buf) == "hgs" ? exvrp::Algorithm::HGS
+                                                     : exvrp::Algorithm::ILS;
+    }
+
+    get_solve_param(env, term, "seed", params.seed);
+    get_solve_param(env, term, "max_iterations", params.maxIterations);
+    get_solve_param(env, term, "max_runtime_ms", params.maxRuntimeMs);
+
+    ERL_NIF_TERM ils;
+    if (enif_get_map_value(env, term, enif_make_atom(env, "ils_params"), &ils))
+    {
+        auto &ilsParams = params.ils;
+        get_solve_param(
+            env, ils, "max_no_improvement", ilsParams.maxNoImprovement);
+        get_solve_param(env, ils, "history_size", ilsParams.historySize);
+        get_solve_param(env, ils, "skip_seen", ilsParams.skipSeen);
+        get_solve_param(env, ils, "elite_size", ilsParams.eliteSize);
+        get_solve_param(
+            env, ils, "min_elite_distance", ilsParams.minEliteDistance);
+        get_solve_param(env, ils, "relink_steps", ilsParams.relinkSteps);
+    }
+
+    ERL_NIF_TERM dec;
+    if (enif_get_map_value(
+            env, term, enif_make_atom(env, "decomposition_params"), &dec))
+    {
+        auto &decParams = params.decomposition;
+        get_solve_param(env, dec, "interval", decParams.interval);
+        get_solve_param(env, dec, "cluster_size", decParams.clusterSize);
+        get_solve_param(env, dec, "max_iterations", decParams.maxIterations);
+        get_solve_param(env, dec, "max_runtime_ms", decParams.maxRuntimeMs);
+        get_solve_param(env, dec, "num_threads", decParams.numThreads);
+    }
+
+    ERL_NIF_TERM hgs;
+    if (enif_get_map_value(env, term, enif_make_atom(env, "hgs_params"), &hgs))
+    {
+        auto &hgsParams = params.hgs;
+        auto &popParams = hgsParams.population;
+        get_solve_param(env, hgs, "min_pop_size", popParams.minPopSize);
+        get_solve_param(env, hgs, "generation_size", popParams.generationSize);
+        get_solve_param(env, hgs, "num_elite", popParams.numElite);
+        get_solve_param(env, hgs, "num_close", popParams.numClose);
+        get_solve_param(env, hgs, "lb_diversity", popParams.lbDiversity);
+        get_solve_param(env, hgs, "ub_diversity", popParams.ubDiversity);
+        get_solve_param(
+            env, hgs, "repair_probability", hgsParams.repairProbability);
+        get_solve_param(env,
+                        hgs,
+                        "num_iters_no_improvement",
+                        hgsParams.numItersNoImprovement);
+
+        if (popParams.minPopSize == 0)
+            throw std::invalid_argument("min_pop_size must be positive.");
+    }
+
+    ERL_NIF_TERM pen;
+    if (enif_get_map_value(
+            env, term, enif_make_atom(env, "penalty_params"), &pen))
+    {
+        auto &penParams = params.penalty;
+        get_solve_param(env,
+                        pen,
+                        "solutions_between_updates",
+                        penParams.solutionsBetweenUpdates);
+        get_solve_param(
+            env, pen, "penalty_increase", penParams.penaltyIncrease);
+        get_solve_param(
+            env, pen, "penalty_decrease", penParams.penaltyDecrease);
+        get_solve_param(env, pen, "target_feasible", penParams.targetFeasible);
+        get_solve_param(env, pen, "feas_tolerance", penParams.feasTolerance);
+        get_solve_param(env, pen, "min_penalty", penParams.minPenalty);
+        get_solve_param(env, pen, "max_penalty", penParams.maxPenalty);
+    }
+
+    return params;
+}
+
+// Unpacks and solves a single batch job. Runs on a worker thread, so it only
+// uses the given process-independent environment, which it clears afterwards.
+static void solve_batch_job(ErlNifEnv *env, BatchJob &job)
+{
+    try
+    {
+        ERL_NIF_TERM model_term;
+        if (!enif_binary_to_term(env,
+                                 job.model.data,
+                                 job.model.size,
+                                 &model_term,
+                                 ERL_NIF_BIN2TERM_SAFE))
+            throw std::invalid_argument("Invalid packed model.");
+
+        job.data = decode_problem_data(env, model_term);
+        job.result = exvrp::solve(*job.data, job.params);
+    }
+    catch (std::exception const &e)
+    {
+        job.error = e.what();
+    }
+
+    enif_clear_env(env);
+}
+
+// Encodes the result of a native solve as a map, with the best solution bound
+// to the given problem data.
+static ERL_NIF_TERM encode_solve_result(ErlNifEnv *env,
+                                        exvrp::SolveResult const &result,
+                                        std::shared_ptr<ProblemData> data)
+{
+    auto const solution
+        = fine::make_resource<SolutionResource>(*result.best, data);
+    auto const &sol = solution->solution;
+
+    ERL_NIF_TERM map = enif_make_new_map(env);
+    auto const put = [&](char const *key, ERL_NIF_TERM value)
+    { enif_make_map_put(env, map, enif_make_atom(env, key), value, &map); };
+    auto const boolean = [&](bool value)
+    { return enif_make_atom(env, value ? "true" : "false"); };
+    auto const cost = [&](Cost value)
+    {
+        return value == std::numeric_limits<Cost>::max()
+                   ? enif_make_atom(env, "infinity")
+                   : enif_make_int64(env, static_cast<int64_t>(value));
+    };
+
+    put("solution", fine::encode(env, solution));
+    put("problem_data",
+        fine::encode(env, fine::make_resource<ProblemDataResource>(data)));
+    put("routes", solution_routes(env, solution));
+    put("distance", enif_make_int64(env, sol.distance().get()));
+    put("duration", enif_make_int64(env, sol.duration().get()));
+    put("num_clients", enif_make_int64(env, sol.numClients()));
+    put("is_feasible", boolean(sol.isFeasible()));
+    put("is_complete", boolean(sol.isComplete()));
+    put("num_iterations", enif_make_int64(env, result.numIterations));
+    put("runtime", enif_make_int64(env, result.runtimeMs));
+    put("improvements", enif_make_int64(env, result.improvements));
+    put("restarts", enif_make_int64(env, result.restarts));
+    put("decompositions", enif_make_int64(env, result.decompositions));
+    put("decomposition_improvements",
+        enif_make_int64(env, result.decompositionImprovements));
+    put("initial_cost", cost(result.initialCost));
+    put("final_cost", cost(result.finalCost));
+
+    return map;
+}
+
+// Encodes the outcome of a batch job as {:ok, map} or {:error, message}.
+static ERL_NIF_TERM encode_batch_job(ErlNifEnv *env, BatchJob &job)
+{
+    if (!job.result)
+        return enif_make_tuple2(env,
+                                enif_make_atom(env, "error"),
+                                fine::encode(env, job.error));
+
+    return enif_make_tuple2(env,
+                            enif_make_atom(env, "ok"),
+                            encode_solve_result(env, *job.result, job.data));
+}
+
+/**
+ * Solve many independent instances natively, on a pool of worker threads.
+ *
+ * Each instance is a {packed_model, params} tuple, where packed_model is a
+ * Model struct in external term format (:erlang.term_to_binary/1), and params
+ * a map with the instance's seed, budget and ILS/penalty parameters. Workers
+ * unpack and decode the models themselves, so decoding runs in parallel, too.
+ * The calling (dirty) scheduler thread works through the instances as well.
+ *
+ * Returns a list with, per instance and in order, {:ok, result_map} or
+ * {:error, message}. A failing instance does not affect the others.
+ */
+fine::Ok<fine::Term>
+solve_batch_nif([[maybe_unused]] ErlNifEnv *env,
+                fine::Term instances_term,
+                int64_t num_workers)
+{
+    if (num_workers < 1)
+        throw std::invalid_argument("num_workers must be positive.");
+
+    unsigned num_instances;
+    if (!enif_get_list_length(env, instances_term, &num_instances))
+        throw std::invalid_argument("Expected a list of instances.");
+
+    std::vector<BatchJob> jobs(num_instances);
+    ERL_NIF_TERM head, tail = instances_term;
+    for (auto &job : jobs)
+    {
+        enif_get_list_cell(env, tail, &head, &tail);
+
+        int arity;
+        ERL_NIF_TERM const *elems;
+        if (!enif_get_tuple(env, head, &arity, &elems) || arity != 2
+            || !enif_inspect_binary(env, elems[0], &job.model))
+            throw std::invalid_argument(
+                "Expected {packed_model, params} instances.");
+
+        job.params = decode_solve_params(env, elems[1]);
+    }
+
+    std::atomic<size_t> next = 0;
+    auto const work = [&]()
+    {
+        ErlNifEnv *worker_env = enif_alloc_env();
+        for (size_t idx = next++; idx < jobs.size(); idx = next++)
+            solve_batch_job(worker_env, jobs[idx]);
+        enif_free_env(worker_env);
+    };
+
+    auto const num_threads
+        = std::min(static_cast<size_t>(num_workers), jobs.size());
+
+    std::vector<std::thread> workers;
+    for (size_t idx = 1; idx < num_threads; ++idx)
+    {
+        try
+        {
+            workers.emplace_back(work);
+        }
+        catch (std::system_error const &)
+        {
+            break;  // continue with the workers we have
+        }
+    }
+
+    work();
+    for (auto &worker : workers)
+        worker.join();
+
+    std::vector<ERL_NIF_TERM> results;
+    results.reserve(jobs.size());
+    for (auto &job : jobs)
+        results.push_back(encode_batch_job(env, job));
+
+    return fine::Ok(fine::Term(
+        enif_make_list_from_array(env, results.data(), results.size())));
+}
+
+FINE_NIF(solve_batch_nif, ERL_NIF_DIRTY_JOB_CPU_BOUND);
+
+/**
+ * Solve the given problem data natively with a single start, on the calling
+ * dirty scheduler. The params map is as for a batch instance, and can also
+ * select the algorithm (:ils or :hgs) and the :hgs_params. The hybrid genetic
+ * search keeps its population, crossover and diversity computations in native
+ * code throughout.
+ *
+ * Returns {:ok, result_map}, with the same result map as a batch instance.
+ */
+fine::Ok<fine::Term>
+solve_native_nif([[maybe_unused]] ErlNifEnv *env,
+                 fine::ResourcePtr<ProblemDataResource> problem_resource,
+                 fine::Term params_term)
+{
+    auto const params = decode_solve_params(env, params_term);
+    auto const result = exvrp::solve(*problem_resource->data, params);
+    return fine::Ok(fine::Term(
+        encode_solve_result(env, result, problem_resource->data)));
+}
+
+FINE_NIF(solve_native_nif, ERL_NIF_DIRTY_JOB_CPU_BOUND);
+
+/**
+ * Read the counters of the reclaimer that destroys large resources off the
+ * schedulers, and its current threshold.
+ * Returns: %{deferred: n, deferred_bytes: n, pending: n, pending_bytes: n,
+ *            threshold: n}
+ */
+fine::Term reclaim_stats_nif([[maybe_unused]] ErlNifEnv *env)
+{
+    auto &reclaimer = exvrp::reclaimer();
+    auto const stats = reclaimer.stats();
+    std::pair<char const *, size_t> const counters[] = {
+        {"deferred", stats.numDeferred},
+        {"deferred_bytes", stats.deferredBytes},
+        {"pending", stats.numPending},
+        {"pending_bytes", stats.pendingBytes},
+        {"threshold", reclaimer.threshold()},
+    };
+
+    ERL_NIF_TERM result = enif_make_new_map(env);
+    for (auto const &[name, value] : counters)
+        enif_make_map_put(env,
+                          result,
+                          enif_make_atom(env, name),
+                          enif_make_uint64(env, value),
+                          &result);
+
+    return fine::Term(result);
+}
+
+FINE_NIF(reclaim_stats_nif, 0);
+
+/**
+ * Set the estimated size in bytes from which resources are destroyed by the
+ * reclaimer's thread instead of the scheduler that releases them.
+ */
+fine::Atom set_reclaim_threshold_nif([[maybe_unused]] ErlNifEnv *env,
+                                     int64_t threshold)
+{
+    if (threshold < 0)
+        throw std::invalid_argument("threshold must be non-negative.");
+
+    exvrp::reclaimer().setThreshold(static_cast<size_t>(threshold));
+    return fine::Atom("ok");
+}
+
+FINE_NIF(set_reclaim_threshold_nif, 0);
+
 // -----------------------------------------------------------------------------
 // search::Route NIFs
 // -----------------------------------------------------------------------------
@@ -0,0 +1,227 @@
+#include "Crossover.h"
+#include "RouteTrips.h"
+
+#include "DynamicBitset.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+using exvrp::RouteTrips;
+using pyvrp::CostEvaluator;
+using pyvrp::DynamicBitset;
+using pyvrp::ProblemData;
+using pyvrp::RandomNumberGenerator;
+using pyvrp::Solution;
+
+namespace
+{
+using Centre = std::pair<pyvrp::Coordinate, pyvrp::Coordinate>;
+using Routes = std::vector<pyvrp::Route>;
+
+// Returns the indices of the given routes, ordered by the polar angle of
+// their centroids around the given centre.
+std::vector<size_t> byPolarAngle(Routes const &routes,
+                                 Centre const &centre)
+{
+    std::vector<double> angles;
+    angles.reserve(routes.size());
+    for (auto const &route : routes)
+    {
+        auto const &[x, y] = route.centroid();
+        angles.push_back(std::atan2(y.get() - centre.second.get(),
+                                    x.get() - centre.first.get()));
+    }
+
+    std::vector<size_t> order(routes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&](size_t a, size_t b) { return angles[a] < angles[b]; });
+
+    return order;
+}
+
+// Marks the clients of the numRoutes routes starting at the given position
+// in the given route order, wrapping around.
+DynamicBitset selectClients(Routes const &routes,
+                            std::vector<size_t> const &order,
+                            size_t start,
+                            size_t numRoutes,
+                            size_t numLocations)
+{
+    DynamicBitset selected(numLocations);
+    for (size_t offset = 0; offset != numRoutes; ++offset)
+    {
+        auto const &route = routes[order[(start + offset) % order.size()]];
+        for (auto const client : route)
+            selected[client] = true;
+    }
+
+    return selected;
+}
+
+// Removes the marked clients from the trips of the given route.
+void removeClients(RouteTrips &route, DynamicBitset const &marked)
+{
+    for (auto &trip : route.trips)
+        std::erase_if(trip.visits,
+                      [&](size_t client) { return marked[client]; });
+}
+}  // namespace
+
+Solution exvrp::selectiveRouteExchange(Parents const &parents,
+                                       ProblemData const &data,
+                                       CostEvaluator const &costEvaluator,
+                                       RandomNumberGenerator &rng)
+{
+    auto const &[parentA, parentB] = parents;
+    auto const &routesA = parentA->routes();
+    auto const &routesB = parentB->routes();
+
+    if (routesA.empty())
+        return *parentB;
+
+    if (routesB.empty())
+        return *parentA;
+
+    auto const nRoutesA = routesA.size();
+    auto const nRoutesB = routesB.size();
+    auto const numLocs = data.numLocations();
+
+    auto const orderA = byPolarAngle(routesA, data.centroid());
+    auto const orderB = byPolarAngle(routesB, data.centroid());
+
+    size_t const numMoved = 1 + rng.randint(std::min(nRoutesA, nRoutesB));
+    size_t const startA = rng.randint(nRoutesA);
+    size_t startB = rng.randint(nRoutesB);
+
+    auto const selectedA
+        = selectClients(routesA, orderA, startA, numMoved, numLocs);
+    auto selectedB = selectClients(routesB, orderB, startB, numMoved, numLocs);
+
+    // Shift the window of B's routes, first left and then right, while that
+    // reduces the number of clients selected in only one of the parents.
+    auto mismatch = (selectedA ^ selectedB).count();
+    for (auto const step : {nRoutesB - 1, size_t(1)})
+        while (true)
+        {
+            auto const next = (startB + step) % nRoutesB;
+            auto selected
+                = selectClients(routesB, orderB, next, numMoved, numLocs);
+
+            auto const nextMismatch = (selectedA ^ selected).count();
+            if (nextMismatch >= mismatch)
+                break;
+
+            startB = next;
+            selectedB = std::move(selected);
+            mismatch = nextMismatch;
+        }
+
+    auto const selectedBNotA = selectedB & ~selectedA;
+
+    // Routes of both offspring, per position in A's route order. Inserted
+    // routes of B keep their trips where the vehicle type of A's route can
+    // make them.
+    std::vector<RouteTrips> routes1;
+    std::vector<RouteTrips> routes2;
+    routes1.reserve(nRoutesA);
+    routes2.reserve(nRoutesA);
+
+    for (size_t pos = 0; pos != nRoutesA; ++pos)
+    {
+        auto const &routeA = routesA[orderA[pos]];
+        auto const offset = (pos + nRoutesA - startA) % nRoutesA;
+        if (offset < numMoved)  // selected, so replaced by a route of B
+        {
+            auto const &routeB = routesB[orderB[(startB + offset) % nRoutesB]];
+            routes1.push_back(tripsOf(routeB, data, routeA.vehicleType()));
+            removeClients(routes2.emplace_back(routes1.back()), selectedBNotA);
+        }
+        else
+        {
+            routes2.push_back(tripsOf(routeA));
+            removeClients(routes1.emplace_back(routes2.back()), selectedB);
+        }
+    }
+
+    auto offspring1 = toSolution(routes1, data);
+    auto offspring2 = toSolution(routes2, data);
+
+    auto const cost1 = costEvaluator.penalisedCost(offspring1);
+    auto const cost2 = costEvaluator.penalisedCost(offspring2);
+    return cost1 <= cost2 ? offspring1 : offspring2;
+}
+
+Solution exvrp::orderedCrossover(Parents const &parents,
+                                 ProblemData const &data,
+                                 RandomNumberGenerator &rng)
+{
+    auto const &[parentA, parentB] = parents;
+    auto const &routesA = parentA->routes();
+    auto const &routesB = parentB->routes();
+
+    if (routesA.empty())
+        return *parentB;
+
+    if (routesB.empty())
+        return *parentA;
+
+    auto const &routeA = routesA[0];
+    auto const tourA = routeA.visits();
+    auto const tourB = routesB[0].visits();
+
+    if (tourA.empty())
+        return *parentB;
+
+    size_t start = rng.randint(tourA.size());
+    size_t end = rng.randint(tourA.size());
+    if (start > end)
+        std::swap(start, end);
+
+    DynamicBitset inSlice(data.numLocations());
+    for (auto idx = start; idx <= end; ++idx)
+        inSlice[tourA[idx]] = true;
+
+    // B's other clients, in B's order starting after the slice's end.
+    std::vector<size_t> rest;
+    for (size_t offset = 0; offset != tourB.size(); ++offset)
+    {
+        auto const client = tourB[(end + 1 + offset) % tourB.size()];
+        if (!inSlice[client])
+            rest.push_back(client);
+    }
+
+    // The offspring may be shorter than A when B misses some of A's clients,
+    // so the slice moves towards the front if it would no longer fit.
+    auto const sliceSize = end - start + 1;
+    auto const size = sliceSize + rest.size();
+    auto const offStart = std::min(start, size - sliceSize);
+
+    std::vector<size_t> tour(size);
+    for (size_t idx = 0; idx != sliceSize; ++idx)
+        tour[offStart + idx] = tourA[start + idx];
+
+    for (size_t idx = 0; idx != rest.size(); ++idx)
+        tour[(offStart + sliceSize + idx) % size] = rest[idx];
+
+    // The offspring keeps A's trips, each with as many visits as in A, so the
+    // reloads stay at the same positions of the tour. Trips at the end become
+    // shorter or empty when the offspring is shorter than A, and the last
+    // trip gets any clients of B that A does not visit.
+    auto offspring = tripsOf(routeA);
+    size_t pos = 0;
+    for (auto &trip : offspring.trips)
+    {
+        auto const num = std::min(trip.visits.size(), size - pos);
+        trip.visits.assign(tour.begin() + pos, tour.begin() + pos + num);
+        pos += num;
+    }
+
+    auto &last = offspring.trips.back().visits;
+    last.insert(last.end(), tour.begin() + pos, tour.end());
+
+    return toSolution({offspring}, data);
+}
@@ -0,0 +1,55 @@
+#ifndef EXVRP_CROSSOVER_H
+#define EXVRP_CROSSOVER_H
+
+#include "CostEvaluator.h"
+#include "ProblemData.h"
+#include "RandomNumberGenerator.h"
+#include "Solution.h"
+
+#include <utility>
+
+namespace exvrp
+{
+using Parents = std::pair<pyvrp::Solution const *, pyvrp::Solution const *>;
+
+/**
+ * Selective route exchange (SREX) crossover of Nagata and Kobayashi (2010),
+ * as in PyVRP's HGS.
+ *
+ * Both parents' routes are ordered by the polar angle of their centroids
+ * around the centroid of all clients. A random number of consecutive routes,
+ * starting at a random route of each parent, is selected, and the window in
+ * the second parent is shifted to overlap the first parent's selection as
+ * much as possible. Two offspring are formed from the first parent by
+ * replacing its selected routes with those of the second parent: one removes
+ * the second parent's clients from the first parent's other routes, the
+ * other leaves those routes intact and drops the duplicate clients from the
+ * inserted routes instead. The offspring with the lowest penalised cost is
+ * returned.
+ *
+ * Offspring routes keep the vehicle types of the first parent's routes, and
+ * the trips and reload depots of the routes they come from, unless that
+ * vehicle type cannot reload there (see :func:`tripsOf`).
+ * Clients the offspring lose are left unassigned, for the local search that
+ * educates the offspring to insert again.
+ */
+pyvrp::Solution
+selectiveRouteExchange(Parents const &parents,
+                       pyvrp::ProblemData const &data,
+                       pyvrp::CostEvaluator const &costEvaluator,
+                       pyvrp::RandomNumberGenerator &rng);
+
+/**
+ * Ordered crossover (OX) of the giant tours of two single-route parents, as
+ * in PyVRP's HGS for instances with a single vehicle. The offspring visits a
+ * random slice of the first parent's route in the same positions, and the
+ * second parent's remaining clients in its order, starting after the slice.
+ * The offspring keeps the trips of the first parent's route, each with as
+ * many visits as in that route.
+ */
+pyvrp::Solution orderedCrossover(Parents const &parents,
+                                 pyvrp::ProblemData const &data,
+                                 pyvrp::RandomNumberGenerator &rng);
+}  // namespace exvrp
+
+#endif  // EXVRP_CROSSOVER_H
@@ -0,0 +1,346 @@
+#include "Decomposition.h"
+
+#include "Matrix.h"
+#include "RandomNumberGenerator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <system_error>
+#include <thread>
+
+using pyvrp::CostEvaluator;
+using pyvrp::Distance;
+using pyvrp::Duration;
+using pyvrp::Matrix;
+using pyvrp::ProblemData;
+using pyvrp::Solution;
+
+namespace
+{
+auto constexpr npos = std::numeric_limits<size_t>::max();
+
+// A cluster's subproblem. Its locations and vehicle types map back to the
+// global ones through locations and vehicleTypes.
+struct Subproblem
+{
+    std::vector<size_t> locations;
+    std::vector<size_t> vehicleTypes;
+    std::unique_ptr<ProblemData> data;
+    std::unique_ptr<Solution> initial;  // the cluster's routes
+    std::optional<exvrp::SolveResult> result;
+};
+
+ProblemData::VehicleType withNumAvailable(ProblemData::VehicleType const &type,
+                                          size_t numAvailable)
+{
+    auto const keep = std::nullopt;
+    return type.replace(numAvailable,
+                        keep,
+                        keep,
+                        keep,
+                        keep,
+                        keep,
+                        keep,
+                        keep,
+                        keep,
+                        keep,
+                        keep,
+                        keep,
+                        keep,
+                        keep,
+                        keep,
+                        keep,
+                        keep,
+                        keep,
+                        keep,
+                        keep);
+}
+
+// Maps the given route's trips to other location and vehicle type indices.
+// Depots keep their indices.
+pyvrp::Route mapRoute(pyvrp::Route const &route,
+                      ProblemData const &data,
+                      std::vector<size_t> const &locations,
+                      size_t vehicleType)
+{
+    std::vector<pyvrp::Trip> trips;
+    for (auto const &trip : route.trips())
+    {
+        std::vector<size_t> visits;
+        visits.reserve(trip.size());
+        for (auto const client : trip)
+            visits.push_back(locations[client]);
+
+        trips.emplace_back(data,
+                           std::move(visits),
+                           vehicleType,
+                           trip.startDepot(),
+                           trip.endDepot());
+    }
+
+    return {data, std::move(trips), vehicleType};
+}
+
+// Builds the subproblem of the given cluster of routes: all depots, the
+// clients of the routes, and as many vehicles of each type as the routes use.
+Subproblem makeSubproblem(Solution const &solution,
+                          ProblemData const &data,
+                          std::vector<size_t> const &cluster)
+{
+    auto const &routes = solution.routes();
+    auto const numDepots = data.numDepots();
+
+    Subproblem sub;
+    std::vector<size_t> toSub(data.numLocations(), npos);
+    for (size_t depot = 0; depot != numDepots; ++depot)
+    {
+        toSub[depot] = depot;
+        sub.locations.push_back(depot);
+    }
+
+    std::vector<size_t> subType(data.numVehicleTypes(), npos);
+    std::vector<size_t> numUsed;
+    for (auto const idx : cluster)
+    {
+        for (auto const client : routes[idx])
+        {
+            toSub[client] = sub.locations.size();
+            sub.locations.push_back(client);
+        }
+
+        auto const type = routes[idx].vehicleType();
+        if (subType[type] == npos)
+        {
+            subType[type] = sub.vehicleTypes.size();
+            sub.vehicleTypes.push_back(type);
+            numUsed.push_back(0);
+        }
+
+        numUsed[subType[type]]++;
+    }
+
+    // The original clients, so that the subproblem tightens the time windows
+    // for its own vehicle types.
+    std::vector<ProblemData::Client> clients;
+    clients.reserve(sub.locations.size() - numDepots);
+    for (size_t idx = numDepots; idx != sub.locations.size(); ++idx)
+    {
+        auto const client = sub.locations[idx] - numDepots;
+        clients.push_back(data.originalClients()[client]);
+    }
+
+    std::vector<ProblemData::VehicleType> vehicleTypes;
+    for (size_t idx = 0; idx != sub.vehicleTypes.size(); ++idx)
+        vehicleTypes.push_back(
+            withNumAvailable(data.vehicleType(sub.vehicleTypes[idx]),
+                             numUsed[idx]));
+
+    auto const dim = sub.locations.size();
+    std::vector<Matrix<Distance>> distMats;
+    std::vector<Matrix<Duration>> durMats;
+    for (size_t profile = 0; profile != data.numProfiles(); ++profile)
+    {
+        auto const &distMat = data.distanceMatrix(profile);
+        auto const &durMat = data.durationMatrix(profile);
+
+        Matrix<Distance> subDist(dim, dim);
+        Matrix<Duration> subDur(dim, dim);
+        for (size_t from = 0; from != dim; ++from)
+            for (size_t to = 0; to != dim; ++to)
+            {
+                auto const i = sub.locations[from];
+                auto const j = sub.locations[to];
+                subDist(from, to) = distMat(i, j);
+                subDur(from, to) = durMat(i, j);
+            }
+
+        distMats.push_back(std::move(subDist));
+        durMats.push_back(std::move(subDur));
+    }
+
+    // Groups are not supported, so the subproblem has none.
+    sub.data = std::make_unique<ProblemData>(
+        std::move(clients),
+        data.depots(),
+        std::move(vehicleTypes),
+        std::move(distMats),
+        std::move(durMats),
+        std::vector<ProblemData::ClientGroup>{},
+        std::vector<ProblemData::SameVehicleGroup>{},
+        data.hardTimeWindows(),
+        data.tightenTimeWindows());
+
+    std::vector<pyvrp::Route> subRoutes;
+    for (auto const idx : cluster)
+        subRoutes.push_back(mapRoute(routes[idx],
+                                     *sub.data,
+                                     toSub,
+                                     subType[routes[idx].vehicleType()]));
+
+    sub.initial = std::make_unique<Solution>(*sub.data, std::move(subRoutes));
+    return sub;
+}
+}  // namespace
+
+std::vector<std::vector<size_t>> exvrp::clusterRoutes(Solution const &solution,
+                                                      ProblemData const &data,
+                                                      size_t clusterSize,
+                                                      size_t offset)
+{
+    auto const &routes = solution.routes();
+    auto const &[centreX, centreY] = data.centroid();
+
+    std::vector<size_t> order;
+    std::vector<double> angles(routes.size());
+    for (size_t idx = 0; idx != routes.size(); ++idx)
+    {
+        if (routes[idx].empty())
+            continue;
+
+        auto const &[x, y] = routes[idx].centroid();
+        angles[idx] = std::atan2(y.get() - centreY.get(),
+                                 x.get() - centreX.get());
+        order.push_back(idx);
+    }
+
+    if (order.empty())
+        return {};
+
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&](size_t a, size_t b) { return angles[a] < angles[b]; });
+    std::rotate(
+        order.begin(), order.begin() + offset % order.size(), order.end());
+
+    std::vector<std::vector<size_t>> clusters;
+    size_t numClients = 0;
+    for (auto const idx : order)
+    {
+        if (clusters.empty() || numClients >= clusterSize)
+        {
+            clusters.emplace_back();
+            numClients = 0;
+        }
+
+        clusters.back().push_back(idx);
+        numClients += routes[idx].size();
+    }
+
+    // A small last cluster joins the one before it.
+    if (clusters.size() >= 2 && 2 * numClients < clusterSize)
+    {
+        auto const last = std::move(clusters.back());
+        clusters.pop_back();
+        auto &prev = clusters.back();
+        prev.insert(prev.end(), last.begin(), last.end());
+    }
+
+    return clusters;
+}
+
+Solution exvrp::decompose(Solution const &solution,
+                          ProblemData const &data,
+                          CostEvaluator const &costEvaluator,
+                          SolveParams const &params,
+                          uint32_t seed,
+                          int64_t timeout_ms)
+{
+    auto const &decomp = params.decomposition;
+    if (data.numGroups() > 0 || data.numSameVehicleGroups() > 0
+        || solution.numRoutes() == 0)
+        return solution;
+
+    pyvrp::RandomNumberGenerator rng(seed);
+    auto const offset = rng.randint(solution.numRoutes());
+    auto const clusters
+        = clusterRoutes(solution, data, decomp.clusterSize, offset);
+
+    if (clusters.size() < 2)
+        return solution;
+
+    std::vector<Subproblem> subproblems;
+    subproblems.reserve(clusters.size());
+    for (auto const &cluster : clusters)
+        subproblems.push_back(makeSubproblem(solution, data, cluster));
+
+    SolveParams subParams = params;
+    subParams.algorithm = Algorithm::ILS;
+    subParams.maxIterations = decomp.maxIterations;
+    subParams.maxRuntimeMs = decomp.maxRuntimeMs;
+    if (timeout_ms > 0 && (subParams.maxRuntimeMs <= 0
+                           || timeout_ms < subParams.maxRuntimeMs))
+        subParams.maxRuntimeMs = timeout_ms;
+    subParams.decomposition.interval = 0;  // no nested decomposition
+    subParams.profile = false;
+
+    std::atomic<size_t> next = 0;
+    auto const work = [&]()
+    {
+        for (size_t idx = next++; idx < subproblems.size(); idx = next++)
+        {
+            auto &sub = subproblems[idx];
+            auto jobParams = subParams;
+            jobParams.seed = seed + idx + 1;
+
+            try
+            {
+                sub.result = solve(*sub.data, jobParams, sub.initial.get());
+            }
+            catch (std::exception const &)
+            {
+                // The cluster keeps its routes.
+            }
+        }
+    };
+
+    auto numThreads = decomp.numThreads;
+    if (numThreads == 0)
+        numThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    numThreads = std::min(numThreads, subproblems.size());
+
+    std::vector<std::thread> workers;
+    for (size_t idx = 1; idx < numThreads; ++idx)
+    {
+        try
+        {
+            workers.emplace_back(work);
+        }
+        catch (std::system_error const &)
+        {
+            break;  // continue with the workers we have
+        }
+    }
+
+    work();
+    for (auto &worker : workers)
+        worker.join();
+
+    // Stitch the improved clusters back together with the others.
+    auto const &routes = solution.routes();
+    std::vector<pyvrp::Route> stitched;
+    stitched.reserve(routes.size());
+    for (size_t idx = 0; idx != clusters.size(); ++idx)
+    {
+        auto const &sub = subproblems[idx];
+        if (sub.result
+            && costEvaluator.cost(*sub.result->best)
+                   < costEvaluator.cost(*sub.initial))
+        {
+            for (auto const &route : sub.result->best->routes())
+                stitched.push_back(
+                    mapRoute(route,
+                             data,
+                             sub.locations,
+                             sub.vehicleTypes[route.vehicleType()]));
+        }
+        else
+            for (auto const routeIdx : clusters[idx])
+                stitched.push_back(routes[routeIdx]);
+    }
+
+    return {data, std::move(stitched)};
+}
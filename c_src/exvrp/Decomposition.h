@@ -0,0 +1,72 @@
+#ifndef EXVRP_DECOMPOSITION_H
+#define EXVRP_DECOMPOSITION_H
+
+#include "IteratedLocalSearch.h"
+
+#include "CostEvaluator.h"
+#include "ProblemData.h"
+#include "Solution.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace exvrp
+{
+/**
+ * Partitions the non-empty routes of the given solution into clusters of
+ * about ``clusterSize`` clients each. Routes are ordered by the polar angle of
+ * their centroid around the centre of the clients, as in the crossover,
+ * starting from the route at the given offset (modulo the number of routes),
+ * and consecutive routes are grouped. Different offsets thus give different
+ * cluster boundaries. Returns the route indices of each cluster.
+ */
+std::vector<std::vector<size_t>> clusterRoutes(pyvrp::Solution const &solution,
+                                               pyvrp::ProblemData const &data,
+                                               size_t clusterSize,
+                                               size_t offset);
+
+/**
+ * Improves the given solution by route-based decomposition, for very large
+ * instances where most improving moves are local anyway.
+ *
+ * Partitions the routes with :func:`clusterRoutes`, and builds a subproblem
+ * for each cluster with its clients, all depots, and as many vehicles of each
+ * type as the cluster's routes use. The subproblems are solved in parallel by
+ * short ILS runs (see ``params.decomposition``) that start from the cluster's
+ * routes. Each cluster whose subproblem solution is cheaper by the given
+ * cost evaluator gets the improved routes; the others keep their routes.
+ *
+ * Returns the solution unchanged if the routes form fewer than two clusters,
+ * or if the data has client groups or same-vehicle groups, which can span
+ * several clusters. Clients that the solution does not visit are not part of
+ * any subproblem.
+ *
+ * Parameters
+ * ----------
+ * solution
+ *     The solution to improve.
+ * data
+ *     The problem data of the solution.
+ * costEvaluator
+ *     Cost evaluator that compares subproblem solutions with the routes they
+ *     replace.
+ * params
+ *     Parameters of the subproblem solves: their ILS and penalty parameters,
+ *     and the ``decomposition`` parameters.
+ * seed
+ *     Seed for the cluster boundaries and the subproblem solves.
+ * timeout_ms
+ *     Maximum runtime of each subproblem solve, in milliseconds. Subproblem
+ *     solves run for the smaller of this and
+ *     ``params.decomposition.maxRuntimeMs``. Zero means no timeout.
+ */
+pyvrp::Solution decompose(pyvrp::Solution const &solution,
+                          pyvrp::ProblemData const &data,
+                          pyvrp::CostEvaluator const &costEvaluator,
+                          SolveParams const &params,
+                          uint32_t seed,
+                          int64_t timeout_ms = 0);
+}  // namespace exvrp
+
+#endif  // EXVRP_DECOMPOSITION_H
@@ -0,0 +1,165 @@
+#include "EliteArchive.h"
+#include "RouteTrips.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <optional>
+
+using exvrp::EliteArchive;
+using pyvrp::Cost;
+using pyvrp::CostEvaluator;
+using pyvrp::ProblemData;
+using pyvrp::Solution;
+
+EliteArchive::EliteArchive(size_t capacity, double minDistance)
+    : capacity_(capacity), minDistance_(minDistance)
+{
+    items_.reserve(capacity);
+}
+
+bool EliteArchive::add(SolutionPtr const &solution, Cost cost)
+{
+    assert(solution->isFeasible());
+
+    if (capacity_ == 0)
+        return false;
+
+    if (items_.size() == capacity_ && cost >= items_.back().cost)
+        return false;
+
+    // Find the closest archived solution, if any is too similar. Equal
+    // hashes almost surely mean the same solution, which is never added.
+    auto closest = items_.end();
+    auto closestDist = std::numeric_limits<double>::max();
+    for (auto it = items_.begin(); it != items_.end(); ++it)
+    {
+        if (it->solution->hash() == solution->hash())
+            return false;
+
+        auto const dist = brokenPairsDistance(*solution, *it->solution);
+        if (dist < minDistance_ && dist < closestDist)
+        {
+            closest = it;
+            closestDist = dist;
+        }
+    }
+
+    if (closest != items_.end())
+    {
+        if (cost >= closest->cost)
+            return false;
+
+        items_.erase(closest);
+    }
+    else if (items_.size() == capacity_)
+        items_.pop_back();
+
+    auto const pos = std::upper_bound(
+        items_.begin(),
+        items_.end(),
+        cost,
+        [](Cost cost, Item const &item) { return cost < item.cost; });
+    items_.insert(pos, {solution, cost});
+    return true;
+}
+
+EliteArchive::SolutionPtr const &EliteArchive::operator[](size_t idx) const
+{
+    return items_[idx].solution;
+}
+
+size_t EliteArchive::size() const { return items_.size(); }
+
+void EliteArchive::clear() { items_.clear(); }
+
+Solution exvrp::pathRelink(Solution const &initial,
+                           Solution const &guide,
+                           ProblemData const &data,
+                           DefaultLocalSearch &ls,
+                           CostEvaluator const &costEvaluator,
+                           pyvrp::RandomNumberGenerator &rng,
+                           size_t numSteps,
+                           int64_t timeout_ms)
+{
+    auto const npos = std::numeric_limits<size_t>::max();
+    auto const numDepots = data.numDepots();
+
+    // The route and trip of each client in the intermediate solution.
+    struct Location
+    {
+        size_t route = npos;
+        size_t trip = npos;
+    };
+
+    std::vector<RouteTrips> routes;
+    std::vector<Location> where(data.numLocations());
+    for (auto const &route : initial.routes())
+    {
+        auto const &trips = routes.emplace_back(tripsOf(route)).trips;
+        for (size_t trip = 0; trip != trips.size(); ++trip)
+            for (auto const client : trips[trip].visits)
+                where[client] = {routes.size() - 1, trip};
+    }
+
+    // Clients in both solutions, but with different neighbours.
+    auto const &initNeighbours = initial.neighbours();
+    auto const &guideNeighbours = guide.neighbours();
+    std::vector<size_t> moves;
+    for (size_t client = numDepots; client != data.numLocations(); ++client)
+        if (initNeighbours[client] && guideNeighbours[client]
+            && initNeighbours[client] != guideNeighbours[client])
+            moves.push_back(client);
+
+    if (moves.empty())
+        return ls.educate(initial, costEvaluator, timeout_ms);
+
+    std::shuffle(moves.begin(), moves.end(), rng);
+    numSteps = std::clamp<size_t>(numSteps, 1, moves.size());
+
+    // Moves the client directly after pred, or directly before succ, in the
+    // trip of that other client.
+    auto const visitsAt = [&](Location const &loc) -> std::vector<size_t> &
+    { return routes[loc.route].trips[loc.trip].visits; };
+
+    auto const move = [&](size_t client, size_t other, bool after)
+    {
+        auto &from = visitsAt(where[client]);
+        from.erase(std::find(from.begin(), from.end(), client));
+
+        auto &to = visitsAt(where[other]);
+        auto const pos = std::find(to.begin(), to.end(), other);
+        to.insert(after ? pos + 1 : pos, client);
+        where[client] = where[other];
+    };
+
+    std::optional<Solution> best;
+    Cost bestCost = std::numeric_limits<Cost>::max();
+
+    for (size_t step = 0; step != numSteps; ++step)
+    {
+        auto const begin = step * moves.size() / numSteps;
+        auto const end = (step + 1) * moves.size() / numSteps;
+        for (auto idx = begin; idx != end; ++idx)
+        {
+            auto const client = moves[idx];
+            auto const [pred, succ] = *guideNeighbours[client];
+
+            if (pred >= numDepots && where[pred].route != npos)
+                move(client, pred, true);
+            else if (succ >= numDepots && where[succ].route != npos)
+                move(client, succ, false);
+        }
+
+        auto polished
+            = ls.educate(toSolution(routes, data), costEvaluator, timeout_ms);
+        auto const cost = costEvaluator.penalisedCost(polished);
+        if (cost < bestCost)
+        {
+            best.emplace(std::move(polished));
+            bestCost = cost;
+        }
+    }
+
+    return *best;
+}
@@ -0,0 +1,97 @@
+#ifndef EXVRP_ELITEARCHIVE_H
+#define EXVRP_ELITEARCHIVE_H
+
+#include "IteratedLocalSearch.h"
+
+#include "CostEvaluator.h"
+#include "Measure.h"
+#include "ProblemData.h"
+#include "RandomNumberGenerator.h"
+#include "Solution.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace exvrp
+{
+/**
+ * A small, bounded archive of diverse, high-quality feasible solutions, for
+ * the path-relinking restarts of the native ILS.
+ *
+ * A solution within ``minDistance`` (broken pairs distance) of an archived
+ * solution competes with that solution only: it replaces it if it is
+ * cheaper, and is rejected otherwise. A solution far from all archived
+ * solutions is added while the archive is not full, and replaces the most
+ * expensive solution once it is. Solutions are kept ordered by cost.
+ *
+ * Parameters
+ * ----------
+ * capacity
+ *     Maximum number of solutions in the archive. Zero disables the archive.
+ * minDistance
+ *     Broken pairs distance below which two solutions are considered too
+ *     similar to both be kept.
+ */
+class EliteArchive
+{
+public:
+    using SolutionPtr = std::shared_ptr<pyvrp::Solution const>;
+
+private:
+    struct Item
+    {
+        SolutionPtr solution;
+        pyvrp::Cost cost;
+    };
+
+    size_t capacity_;
+    double minDistance_;
+    std::vector<Item> items_;  // ordered by cost
+
+public:
+    EliteArchive(size_t capacity, double minDistance);
+
+    /**
+     * Offers the given feasible solution with the given cost to the archive.
+     * Returns whether the solution was added.
+     */
+    bool add(SolutionPtr const &solution, pyvrp::Cost cost);
+
+    /**
+     * Returns the solution at the given index. Index zero is the cheapest.
+     */
+    SolutionPtr const &operator[](size_t idx) const;
+
+    size_t size() const;
+
+    void clear();
+};
+
+/**
+ * Path relinking from the initial solution towards the guiding solution.
+ *
+ * The clients whose predecessor or successor differ between the two
+ * solutions are moved, in random order, to follow their predecessor in the
+ * guiding solution (or to precede their successor, if the predecessor is a
+ * depot), in the same trip as that neighbour, so that the trips of
+ * multi-trip routes are kept. The moves are split into ``numSteps`` batches,
+ * and after each batch, the intermediate solution is polished with the given
+ * local search. Returns the best polished intermediate solution, by
+ * penalised cost.
+ *
+ * Each local search call gets the given timeout (in milliseconds, zero means
+ * no timeout).
+ */
+pyvrp::Solution pathRelink(pyvrp::Solution const &initial,
+                           pyvrp::Solution const &guide,
+                           pyvrp::ProblemData const &data,
+                           DefaultLocalSearch &ls,
+                           pyvrp::CostEvaluator const &costEvaluator,
+                           pyvrp::RandomNumberGenerator &rng,
+                           size_t numSteps,
+                           int64_t timeout_ms = 0);
+}  // namespace exvrp
+
+#endif  // EXVRP_ELITEARCHIVE_H
@@ -0,0 +1,183 @@
+#include "GeneticAlgorithm.h"
+#include "Crossover.h"
+#include "Neighbourhood.h"
+#include "Population.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using pyvrp::Cost;
+using pyvrp::ProblemData;
+using pyvrp::Solution;
+
+exvrp::SolveResult exvrp::solveGenetic(ProblemData const &data,
+                                       SolveParams const &params)
+{
+    using Clock = std::chrono::steady_clock;
+    using SolutionPtr = Population::SolutionPtr;
+    auto const start = Clock::now();
+
+    auto const elapsedMs = [&]()
+    {
+        auto const elapsed = Clock::now() - start;
+        return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)
+            .count();
+    };
+
+    // Remaining time budget for a single LocalSearch call (0 means no
+    // timeout).
+    auto const remainingMs = [&]() -> int64_t
+    {
+        if (params.maxRuntimeMs <= 0)
+            return 0;
+        return std::max<int64_t>(params.maxRuntimeMs - elapsedMs(), 1);
+    };
+
+    auto const isDone = [&](size_t iteration)
+    {
+        if (iteration >= params.maxIterations)
+            return true;
+        return params.maxRuntimeMs > 0 && elapsedMs() >= params.maxRuntimeMs;
+    };
+
+    // Returns the milliseconds since the previous call (or the start).
+    auto lap = start;
+    auto const lapMs = [&]()
+    {
+        auto const now = Clock::now();
+        auto const elapsed = now - lap;
+        lap = now;
+        return std::chrono::duration<double, std::milli>(elapsed).count();
+    };
+
+    SolveResult result;
+
+    auto penaltyManager = PenaltyManager::initFrom(data, params.penalty);
+    result.timings.penaltyInitMs = lapMs();
+
+    auto const neighbours = computeNeighbours(data);
+    result.timings.neighboursMs = lapMs();
+
+    DefaultLocalSearch ls(data, neighbours, params.seed);
+    result.timings.localSearchMs = lapMs();
+
+    Solution const empty(data, std::vector<std::vector<size_t>>{});
+    auto const initial = std::make_shared<Solution const>(
+        ls.search(empty, penaltyManager.maxCostEvaluator(), remainingMs()));
+    result.timings.initialSolutionMs = lapMs();
+
+    ls.setProfiling(params.profile);
+
+    pyvrp::RandomNumberGenerator rng(params.seed);
+    auto costEvaluator = penaltyManager.costEvaluator();
+    auto const infinity = std::numeric_limits<Cost>::max();
+
+    result.initialCost = costEvaluator.penalisedCost(*initial);
+
+    SolutionPtr best = initial;
+    Cost bestCost = costEvaluator.cost(*initial);
+    Cost bestPenalisedCost = result.initialCost;
+    size_t itersNoImprovement = 0;
+
+    Population population(params.hgs.population);
+
+    // Adds the candidate to the population, and tracks the best solution like
+    // the ILS does: feasible always beats infeasible, and while all are
+    // infeasible, the best tracks progress towards feasibility.
+    auto const add = [&](SolutionPtr const &candidate)
+    {
+        population.add(candidate, costEvaluator);
+
+        auto const candCost = costEvaluator.penalisedCost(*candidate);
+        auto const candObjCost = costEvaluator.cost(*candidate);
+
+        if (candObjCost < bestCost)
+        {
+            best = candidate;
+            bestCost = candObjCost;
+            bestPenalisedCost = candCost;
+            itersNoImprovement = 0;
+            result.improvements++;
+        }
+        else if (bestCost == infinity && candObjCost == infinity
+                 && candCost < bestPenalisedCost)
+        {
+            best = candidate;
+            bestPenalisedCost = candCost;
+            result.improvements++;
+        }
+    };
+
+    // Fills the population with educated random solutions, as PyVRP's HGS
+    // does. Budgets are checked, but initialisation is not an iteration.
+    auto const initialise = [&]()
+    {
+        auto const popSize = params.hgs.population.minPopSize;
+        while (population.size() < popSize && !isDone(0))
+        {
+            Solution const random(data, rng);
+            add(std::make_shared<Solution const>(
+                ls.educate(random, costEvaluator, remainingMs())));
+        }
+    };
+
+    add(initial);
+    initialise();
+
+    for (; !isDone(result.numIterations); ++result.numIterations)
+    {
+        if (itersNoImprovement >= params.hgs.numItersNoImprovement)
+        {
+            population.clear();
+            initialise();
+            itersNoImprovement = 0;
+            result.restarts++;
+
+            if (population.size() == 0)  // ran out of time while restarting
+                break;
+        }
+
+        auto const [first, second] = population.select(rng, costEvaluator);
+        Parents const parents = {first.get(), second.get()};
+        auto const offspring
+            = data.numVehicles() == 1
+                  ? orderedCrossover(parents, data, rng)
+                  : selectiveRouteExchange(parents, data, costEvaluator, rng);
+
+        auto const educated = std::make_shared<Solution const>(
+            ls.educate(offspring, costEvaluator, remainingMs()));
+
+        itersNoImprovement++;
+        add(educated);
+
+        if (!educated->isFeasible()
+            && rng.rand() < params.hgs.repairProbability)
+        {
+            auto const repaired = std::make_shared<Solution const>(ls.educate(
+                *educated, penaltyManager.maxCostEvaluator(), remainingMs()));
+
+            if (repaired->isFeasible())
+                add(repaired);
+        }
+
+        if (penaltyManager.registerSolution(*educated))
+            costEvaluator = penaltyManager.costEvaluator();
+    }
+
+    result.timings.ilsMs = lapMs();
+
+    if (params.profile)
+    {
+        result.profile = ls.profile();
+        result.nodeOperatorNames = ls.nodeOperatorNames();
+        result.routeOperatorNames = ls.routeOperatorNames();
+    }
+
+    result.best = best;
+    result.finalCost = bestCost;
+    result.runtimeMs = elapsedMs();
+    return result;
+}
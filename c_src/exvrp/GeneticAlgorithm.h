@@ -0,0 +1,28 @@
+#ifndef EXVRP_GENETICALGORITHM_H
+#define EXVRP_GENETICALGORITHM_H
+
+#include "IteratedLocalSearch.h"
+
+#include "ProblemData.h"
+
+namespace exvrp
+{
+/**
+ * Native port of PyVRP's hybrid genetic search (HGS) for a single start.
+ * Builds the neighbourhood and an initial solution as :func:`solve` does, and
+ * seeds the population with it and with educated random solutions. Each
+ * iteration then selects two parents from the population, recombines them
+ * with :func:`selectiveRouteExchange` (or :func:`orderedCrossover` if there
+ * is only one vehicle), educates the offspring with the same local search as
+ * the ILS, and adds it to the population. Infeasible offspring are repaired
+ * with some probability. The population restarts after
+ * ``numItersNoImprovement`` iterations without a new best solution.
+ *
+ * The whole search runs on the calling thread: selection, crossover and
+ * diversity computations never leave native code.
+ */
+SolveResult solveGenetic(pyvrp::ProblemData const &data,
+                         SolveParams const &params);
+}  // namespace exvrp
+
+#endif  // EXVRP_GENETICALGORITHM_H
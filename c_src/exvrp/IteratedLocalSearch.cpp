@@ -0,0 +1,389 @@
+#include "IteratedLocalSearch.h"
+#include "Decomposition.h"
+#include "EliteArchive.h"
+#include "GeneticAlgorithm.h"
+#include "Neighbourhood.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+using exvrp::DefaultLocalSearch;
+using pyvrp::Cost;
+using pyvrp::CostEvaluator;
+using pyvrp::ProblemData;
+using pyvrp::Solution;
+
+namespace
+{
+using SolutionPtr = std::shared_ptr<Solution const>;
+
+// Late acceptance history, matching ExVrp.IteratedLocalSearch.RingBuffer:
+// skip() advances the index without storing, keeping the old element. Also
+// counts the hashes of the stored solutions, for contains().
+class History
+{
+    std::vector<SolutionPtr> buffer_;
+    std::unordered_map<size_t, size_t> hashCounts_;
+    size_t idx_ = 0;
+
+public:
+    explicit History(size_t size) : buffer_(std::max<size_t>(size, 1)) {}
+
+    SolutionPtr const &peek() const
+    {
+        return buffer_[idx_ % buffer_.size()];
+    }
+
+    bool contains(Solution const &solution) const
+    {
+        return hashCounts_.contains(solution.hash());
+    }
+
+    void append(SolutionPtr solution)
+    {
+        auto &slot = buffer_[idx_++ % buffer_.size()];
+        if (slot)
+        {
+            auto const it = hashCounts_.find(slot->hash());
+            if (--it->second == 0)
+                hashCounts_.erase(it);
+        }
+
+        hashCounts_[solution->hash()]++;
+        slot = std::move(solution);
+    }
+
+    void skip() { idx_++; }
+
+    void clear()
+    {
+        std::fill(buffer_.begin(), buffer_.end(), nullptr);
+        hashCounts_.clear();
+        idx_ = 0;
+    }
+};
+}  // namespace
+
+DefaultLocalSearch::DefaultLocalSearch(
+    ProblemData const &data,
+    pyvrp::search::SearchSpace::Neighbours neighbours,
+    uint32_t seed)
+    : perturbParams_(1, 25),
+      perturbManager_(perturbParams_),
+      rng_(seed),
+      exchange10_(data),
+      exchange20_(data),
+      exchange11_(data),
+      exchange21_(data),
+      exchange22_(data),
+      ls_(data, std::move(neighbours), perturbManager_)
+{
+    ls_.addNodeOperator(exchange10_);
+    ls_.addNodeOperator(exchange20_);
+    ls_.addNodeOperator(exchange11_);
+    ls_.addNodeOperator(exchange21_);
+    ls_.addNodeOperator(exchange22_);
+    nodeOpNames_ = {"exchange10",
+                    "exchange20",
+                    "exchange11",
+                    "exchange21",
+                    "exchange22"};
+
+    if (pyvrp::search::supports<pyvrp::search::SwapTails>(data))
+    {
+        swapTails_ = std::make_unique<pyvrp::search::SwapTails>(data);
+        ls_.addNodeOperator(*swapTails_);
+        nodeOpNames_.emplace_back("swap_tails");
+    }
+
+    if (pyvrp::search::supports<pyvrp::search::RelocateWithDepot>(data))
+    {
+        relocateDepot_
+            = std::make_unique<pyvrp::search::RelocateWithDepot>(data);
+        ls_.addNodeOperator(*relocateDepot_);
+        nodeOpNames_.emplace_back("relocate_with_depot");
+    }
+
+    if (pyvrp::search::supports<pyvrp::search::SwapRoutes>(data))
+    {
+        swapRoutes_ = std::make_unique<pyvrp::search::SwapRoutes>(data);
+        ls_.addRouteOperator(*swapRoutes_);
+        routeOpNames_.emplace_back("swap_routes");
+    }
+}
+
+Solution DefaultLocalSearch::operator()(Solution const &solution,
+                                        CostEvaluator const &costEvaluator,
+                                        int64_t timeout_ms)
+{
+    ls_.shuffle(rng_);
+    return ls_(solution, costEvaluator, false, timeout_ms);
+}
+
+Solution DefaultLocalSearch::educate(Solution const &solution,
+                                     CostEvaluator const &costEvaluator,
+                                     int64_t timeout_ms)
+{
+    ls_.shuffle(rng_);
+    return ls_(solution, costEvaluator, true, timeout_ms);
+}
+
+Solution DefaultLocalSearch::search(Solution const &solution,
+                                    CostEvaluator const &costEvaluator,
+                                    int64_t timeout_ms)
+{
+    ls_.shuffle(rng_);
+    return ls_.search(solution, costEvaluator, timeout_ms);
+}
+
+void DefaultLocalSearch::setProfiling(bool enabled)
+{
+    ls_.setProfiling(enabled);
+}
+
+pyvrp::search::SearchProfile const &DefaultLocalSearch::profile() const
+{
+    return ls_.profile();
+}
+
+std::vector<std::string> const &DefaultLocalSearch::nodeOperatorNames() const
+{
+    return nodeOpNames_;
+}
+
+std::vector<std::string> const &DefaultLocalSearch::routeOperatorNames() const
+{
+    return routeOpNames_;
+}
+
+exvrp::SolveResult exvrp::solve(ProblemData const &data,
+                                SolveParams const &params,
+                                Solution const *initialSolution)
+{
+    if (params.algorithm == Algorithm::HGS)
+        return solveGenetic(data, params);
+
+    using Clock = std::chrono::steady_clock;
+    auto const start = Clock::now();
+
+    auto const elapsedMs = [&]()
+    {
+        auto const elapsed = Clock::now() - start;
+        return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)
+            .count();
+    };
+
+    // Remaining time budget for a single LocalSearch call (0 means no
+    // timeout), like ExVrp.IteratedLocalSearch's remaining_timeout_ms.
+    auto const remainingMs = [&]() -> int64_t
+    {
+        if (params.maxRuntimeMs <= 0)
+            return 0;
+        return std::max<int64_t>(params.maxRuntimeMs - elapsedMs(), 1);
+    };
+
+    auto const isDone = [&](size_t iteration)
+    {
+        if (iteration >= params.maxIterations)
+            return true;
+        return params.maxRuntimeMs > 0 && elapsedMs() >= params.maxRuntimeMs;
+    };
+
+    // Returns the milliseconds since the previous call (or the start).
+    auto lap = start;
+    auto const lapMs = [&]()
+    {
+        auto const now = Clock::now();
+        auto const elapsed = now - lap;
+        lap = now;
+        return std::chrono::duration<double, std::milli>(elapsed).count();
+    };
+
+    SolveResult result;
+
+    auto penaltyManager = PenaltyManager::initFrom(data, params.penalty);
+    result.timings.penaltyInitMs = lapMs();
+
+    auto const neighbours = computeNeighbours(data);
+    result.timings.neighboursMs = lapMs();
+
+    DefaultLocalSearch ls(data, neighbours, params.seed);
+    result.timings.localSearchMs = lapMs();
+
+    Solution const empty(data, std::vector<std::vector<size_t>>{});
+    auto const initial = std::make_shared<Solution const>(
+        initialSolution ? *initialSolution
+                        : ls.search(empty,
+                                    penaltyManager.maxCostEvaluator(),
+                                    remainingMs()));
+    result.timings.initialSolutionMs = lapMs();
+
+    // Profile the ILS loop only, like ExVrp.IteratedLocalSearch's telemetry.
+    ls.setProfiling(params.profile);
+
+    auto costEvaluator = penaltyManager.costEvaluator();
+    auto const infinity = std::numeric_limits<Cost>::max();
+
+    result.initialCost = costEvaluator.penalisedCost(*initial);
+
+    SolutionPtr best = initial;
+    Cost bestCost = costEvaluator.cost(*initial);
+    Cost bestPenalisedCost = result.initialCost;
+
+    SolutionPtr current = initial;
+    Cost currentCost = result.initialCost;
+
+    History history(params.ils.historySize);
+    size_t itersNoImprovement = 0;
+
+    // Only used by path relinking, so that it does not change the search
+    // without an elite archive.
+    EliteArchive elite(params.ils.eliteSize, params.ils.minEliteDistance);
+    pyvrp::RandomNumberGenerator rng(params.seed);
+
+    for (; !isDone(result.numIterations); ++result.numIterations)
+    {
+        if (itersNoImprovement >= params.ils.maxNoImprovement)
+        {
+            // If the best is still infeasible, restart from a fresh initial
+            // solution with a different seed rather than cycling from the
+            // same infeasible state.
+            if (bestCost == infinity)
+            {
+                auto const seed = params.seed + result.restarts + 1;
+                DefaultLocalSearch restartLs(data, neighbours, seed);
+                current = std::make_shared<Solution const>(restartLs.search(
+                    empty, penaltyManager.maxCostEvaluator(), remainingMs()));
+            }
+            else if (elite.size() >= 2)
+            {
+                // Relink a random archived solution towards the cheapest.
+                auto const from = 1 + rng.randint(elite.size() - 1);
+                current = std::make_shared<Solution const>(
+                    pathRelink(*elite[from],
+                               *elite[0],
+                               data,
+                               ls,
+                               costEvaluator,
+                               rng,
+                               params.ils.relinkSteps,
+                               remainingMs()));
+
+                auto const objCost = costEvaluator.cost(*current);
+                if (objCost < bestCost)
+                {
+                    best = current;
+                    bestCost = objCost;
+                    bestPenalisedCost = costEvaluator.penalisedCost(*current);
+                    result.improvements++;
+                }
+
+                if (objCost != infinity)
+                    elite.add(current, objCost);
+
+                result.relinks++;
+            }
+            else
+                current = best;
+
+            currentCost = costEvaluator.penalisedCost(*current);
+            history.clear();
+            itersNoImprovement = 0;
+            result.restarts++;
+        }
+
+        auto const interval = params.decomposition.interval;
+        if (interval > 0 && result.numIterations > 0
+            && result.numIterations % interval == 0 && bestCost != infinity)
+        {
+            auto const seed = params.seed + result.numIterations / interval;
+            auto const improved = std::make_shared<Solution const>(decompose(
+                *best, data, costEvaluator, params, seed, remainingMs()));
+            result.decompositions++;
+
+            auto const objCost = costEvaluator.cost(*improved);
+            if (objCost < bestCost)
+            {
+                best = improved;
+                bestCost = objCost;
+                bestPenalisedCost = costEvaluator.penalisedCost(*improved);
+                current = improved;
+                currentCost = bestPenalisedCost;
+                itersNoImprovement = 0;
+                result.improvements++;
+                result.decompositionImprovements++;
+            }
+        }
+
+        auto const candidate = std::make_shared<Solution const>(
+            ls(*current, costEvaluator, remainingMs()));
+        auto const candCost = costEvaluator.penalisedCost(*candidate);
+        auto const candObjCost = costEvaluator.cost(*candidate);
+
+        // Feasible always beats infeasible. When both are infeasible, the
+        // best tracks progress towards feasibility, but without resetting the
+        // restart counter.
+        auto const prevBestCost = bestCost;
+        itersNoImprovement++;
+        if (candObjCost < bestCost)
+        {
+            best = candidate;
+            bestCost = candObjCost;
+            bestPenalisedCost = candCost;
+            itersNoImprovement = 0;
+            result.improvements++;
+        }
+        else if (bestCost == infinity && candObjCost == infinity
+                 && candCost < bestPenalisedCost)
+        {
+            best = candidate;
+            bestPenalisedCost = candCost;
+            result.improvements++;
+        }
+
+        if (candObjCost != infinity)
+            elite.add(candidate, candObjCost);
+
+        auto const late = history.peek();
+        auto const lateCost = costEvaluator.penalisedCost(late ? *late : *best);
+
+        // Late acceptance, but always accept the first feasible solution.
+        // With skipSeen, late acceptance skips solutions already seen.
+        auto const firstFeasible
+            = prevBestCost == infinity && candObjCost != infinity;
+        auto const seen = params.ils.skipSeen
+                          && (candidate->hash() == current->hash()
+                              || history.contains(*candidate));
+        if (firstFeasible || (candCost < lateCost && !seen)
+            || candCost < currentCost)
+        {
+            current = candidate;
+            currentCost = candCost;
+        }
+
+        if (!late || currentCost < lateCost)
+            history.append(current);
+        else
+            history.skip();
+
+        if (penaltyManager.registerSolution(*candidate))
+            costEvaluator = penaltyManager.costEvaluator();
+    }
+
+    result.timings.ilsMs = lapMs();
+
+    if (params.profile)
+    {
+        result.profile = ls.profile();
+        result.nodeOperatorNames = ls.nodeOperatorNames();
+        result.routeOperatorNames = ls.routeOperatorNames();
+    }
+
+    result.best = best;
+    result.finalCost = bestCost;
+    result.runtimeMs = elapsedMs();
+    return result;
+}
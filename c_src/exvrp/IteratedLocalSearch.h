@@ -0,0 +1,291 @@
+#ifndef EXVRP_ITERATEDLOCALSEARCH_H
+#define EXVRP_ITERATEDLOCALSEARCH_H
+
+#include "PenaltyManager.h"
+#include "Population.h"
+
+#include "CostEvaluator.h"
+#include "ProblemData.h"
+#include "RandomNumberGenerator.h"
+#include "Solution.h"
+#include "search/Exchange.h"
+#include "search/LocalSearch.h"
+#include "search/PerturbationManager.h"
+#include "search/RelocateWithDepot.h"
+#include "search/SearchSpace.h"
+#include "search/SwapRoutes.h"
+#include "search/SwapTails.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace exvrp
+{
+/**
+ * A LocalSearch with PyVRP's default operators, together with the RNG that
+ * shuffles it. This is the same configuration as the NIF's persistent
+ * LocalSearch resource.
+ */
+class DefaultLocalSearch
+{
+    pyvrp::search::PerturbationParams perturbParams_;
+    pyvrp::search::PerturbationManager perturbManager_;
+    pyvrp::RandomNumberGenerator rng_;
+
+    pyvrp::search::Exchange<1, 0> exchange10_;
+    pyvrp::search::Exchange<2, 0> exchange20_;
+    pyvrp::search::Exchange<1, 1> exchange11_;
+    pyvrp::search::Exchange<2, 1> exchange21_;
+    pyvrp::search::Exchange<2, 2> exchange22_;
+    std::unique_ptr<pyvrp::search::SwapTails> swapTails_;
+    std::unique_ptr<pyvrp::search::RelocateWithDepot> relocateDepot_;
+    std::unique_ptr<pyvrp::search::SwapRoutes> swapRoutes_;
+
+    // Operator names, in the order the operators were added (for profiles)
+    std::vector<std::string> nodeOpNames_;
+    std::vector<std::string> routeOpNames_;
+
+    pyvrp::search::LocalSearch ls_;  // must be last: uses the above
+
+public:
+    DefaultLocalSearch(pyvrp::ProblemData const &data,
+                       pyvrp::search::SearchSpace::Neighbours neighbours,
+                       uint32_t seed);
+
+    /**
+     * Shuffles the search order, and runs perturbation, search and
+     * intensification on the given solution.
+     */
+    pyvrp::Solution operator()(pyvrp::Solution const &solution,
+                               pyvrp::CostEvaluator const &costEvaluator,
+                               int64_t timeout_ms = 0);
+
+    /**
+     * Shuffles the search order, and runs search and intensification without
+     * perturbation on the given solution. This educates the offspring of the
+     * hybrid genetic search.
+     */
+    pyvrp::Solution educate(pyvrp::Solution const &solution,
+                            pyvrp::CostEvaluator const &costEvaluator,
+                            int64_t timeout_ms = 0);
+
+    /**
+     * Shuffles the search order, and runs a plain search without
+     * perturbation on the given solution.
+     */
+    pyvrp::Solution search(pyvrp::Solution const &solution,
+                           pyvrp::CostEvaluator const &costEvaluator,
+                           int64_t timeout_ms = 0);
+
+    /**
+     * Enables or disables profiling of the underlying LocalSearch.
+     */
+    void setProfiling(bool enabled);
+
+    /**
+     * Returns the profile of the underlying LocalSearch.
+     */
+    pyvrp::search::SearchProfile const &profile() const;
+
+    /**
+     * Returns the names of the node operators, in the order of the profile's
+     * node operator timings.
+     */
+    std::vector<std::string> const &nodeOperatorNames() const;
+
+    /**
+     * Returns the names of the route operators, in the order of the profile's
+     * route operator timings.
+     */
+    std::vector<std::string> const &routeOperatorNames() const;
+};
+
+/**
+ * Parameters for iterated local search. These mirror the fields and defaults
+ * of ``ExVrp.IteratedLocalSearch.Params``.
+ *
+ * Parameters
+ * ----------
+ * skipSeen
+ *     Whether late acceptance skips candidates that are already in its
+ *     history (or are the current solution), by solution hash. Such
+ *     candidates are still accepted when they improve on the current
+ *     solution.
+ * eliteSize
+ *     Size of the archive of diverse feasible solutions that restarts relink
+ *     from. Zero restarts from the best solution, as the Elixir ILS does.
+ * minEliteDistance
+ *     Broken pairs distance below which two solutions are too similar to
+ *     both be in the elite archive.
+ * relinkSteps
+ *     Number of intermediate solutions that path relinking polishes.
+ */
+struct IlsParams
+{
+    size_t maxNoImprovement = 5'000;
+    size_t historySize = 500;
+    bool skipSeen = false;
+    size_t eliteSize = 0;
+    double minEliteDistance = 0.05;
+    size_t relinkSteps = 4;
+};
+
+/**
+ * Parameters for hybrid genetic search. These mirror the fields and defaults
+ * of ``ExVrp.GeneticAlgorithm.Params``.
+ *
+ * Parameters
+ * ----------
+ * repairProbability
+ *     Probability of repairing an infeasible offspring, by educating it again
+ *     with the maximum penalties.
+ * numItersNoImprovement
+ *     Number of iterations without improvement of the best solution before
+ *     the population is restarted.
+ */
+struct HgsParams
+{
+    PopulationParams population = {};
+    double repairProbability = 0.8;
+    size_t numItersNoImprovement = 20'000;
+};
+
+/**
+ * Parameters for route-based decomposition. These mirror the fields and
+ * defaults of ``ExVrp.Decomposition.Params``.
+ *
+ * Parameters
+ * ----------
+ * interval
+ *     Number of ILS iterations between decomposition rounds. Zero, the
+ *     default, disables decomposition.
+ * clusterSize
+ *     Target number of clients per subproblem.
+ * maxIterations
+ *     Maximum number of ILS iterations per subproblem.
+ * maxRuntimeMs
+ *     Maximum runtime per subproblem in milliseconds, capped by the remaining
+ *     runtime of the solve. Zero means no limit of its own.
+ * numThreads
+ *     Number of threads that solve the subproblems. Zero uses all hardware
+ *     threads.
+ */
+struct DecompositionParams
+{
+    size_t interval = 0;
+    size_t clusterSize = 300;
+    size_t maxIterations = 500;
+    int64_t maxRuntimeMs = 1'000;
+    size_t numThreads = 0;
+};
+
+/**
+ * The search algorithm of a native solve.
+ */
+enum class Algorithm
+{
+    ILS,  // iterated local search with late acceptance
+    HGS,  // hybrid genetic search
+};
+
+/**
+ * Parameters for a single native solve.
+ *
+ * Parameters
+ * ----------
+ * algorithm
+ *     The search algorithm to run after constructing the initial solution.
+ * seed
+ *     Seed for the local search RNG.
+ * maxIterations
+ *     Maximum number of ILS or HGS iterations.
+ * maxRuntimeMs
+ *     Maximum runtime in milliseconds, including the construction of the
+ *     initial solution. Zero means no runtime limit.
+ * profile
+ *     Whether to profile the local search used by the ILS or HGS loop.
+ */
+struct SolveParams
+{
+    Algorithm algorithm = Algorithm::ILS;
+    uint32_t seed = 42;
+    size_t maxIterations = 10'000;
+    int64_t maxRuntimeMs = 0;
+    IlsParams ils = {};
+    HgsParams hgs = {};
+    DecompositionParams decomposition = {};
+    PenaltyParams penalty = {};
+    bool profile = false;
+};
+
+/**
+ * Wall-clock time spent per stage of a native solve, in milliseconds.
+ */
+struct SolveTimings
+{
+    double penaltyInitMs = 0;      // initial penalties from the data
+    double neighboursMs = 0;       // granular neighbourhood
+    double localSearchMs = 0;      // operators and LocalSearch setup
+    double initialSolutionMs = 0;  // search on the empty solution
+    double ilsMs = 0;              // the ILS or HGS loop, with restarts
+};
+
+/**
+ * Result of a native solve.
+ */
+struct SolveResult
+{
+    std::shared_ptr<pyvrp::Solution const> best;
+    size_t numIterations = 0;
+    int64_t runtimeMs = 0;
+    size_t improvements = 0;
+    size_t restarts = 0;
+    size_t relinks = 0;  // restarts by path relinking
+    size_t decompositions = 0;  // decomposition rounds
+    size_t decompositionImprovements = 0;  // rounds that improved the best
+    pyvrp::Cost initialCost = 0;  // penalised cost of the initial solution
+    pyvrp::Cost finalCost = 0;    // cost of the best solution
+    SolveTimings timings = {};
+
+    // Profile of the search loop's local search, if profiling was enabled,
+    // with the names of its operators.
+    pyvrp::search::SearchProfile profile = {};
+    std::vector<std::string> nodeOperatorNames;
+    std::vector<std::string> routeOperatorNames;
+};
+
+/**
+ * Native port of ``ExVrp.Solver.solve/2`` for a single start: builds the
+ * neighbourhood and an initial solution, and then runs iterated local search
+ * with late acceptance hill-climbing, restarts, and penalty management, as
+ * ``ExVrp.IteratedLocalSearch`` does. Progress callbacks are not supported.
+ *
+ * With a positive ``eliteSize``, the ILS also keeps an :class:`EliteArchive`
+ * of the feasible candidates, and a restart with a feasible best solution
+ * relinks a random archived solution towards the cheapest one (see
+ * :func:`pathRelink`) instead of restarting from the best solution.
+ *
+ * With a positive decomposition ``interval``, every so many iterations the
+ * ILS also improves its best (feasible) solution with :func:`decompose`.
+ *
+ * With ``Algorithm::HGS``, runs :func:`solveGenetic` instead.
+ *
+ * Parameters
+ * ----------
+ * data
+ *     The problem data to solve.
+ * params
+ *     Parameters of the solve.
+ * initial
+ *     Optional initial solution for the ILS, instead of one constructed from
+ *     the empty solution. Ignored by the hybrid genetic search.
+ */
+SolveResult solve(pyvrp::ProblemData const &data,
+                  SolveParams const &params,
+                  pyvrp::Solution const *initial = nullptr);
+}  // namespace exvrp
+
+#endif  // EXVRP_ITERATEDLOCALSEARCH_H
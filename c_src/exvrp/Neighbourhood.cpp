@@ -0,0 +1,203 @@
+#include "Neighbourhood.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using pyvrp::Cost;
+using pyvrp::ProblemData;
+
+namespace
+{
+// Distances at or above this value mark arcs that may not be travelled.
+constexpr int64_t UNREACHABLE = 1'000'000'000;
+
+constexpr size_t BLOCK_SIZE = 64;
+}  // namespace
+
+exvrp::Reachability::Reachability(ProblemData const &data) : data_(data)
+{
+    std::map<std::pair<size_t, size_t>, size_t> classes;
+    for (auto const &vt : data.vehicleTypes())
+        classes.try_emplace({vt.profile, vt.startDepot}, classes.size());
+
+    numBlocks_ = (classes.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    reach_.resize(data.numLocations() * numBlocks_);
+
+    for (size_t client = data.numDepots(); client != data.numLocations();
+         ++client)
+    {
+        auto *reach = reach_.data() + client * numBlocks_;
+        size_t numReaching = 0;
+
+        for (auto const &[key, idx] : classes)
+        {
+            auto const &[profile, depot] = key;
+            auto const &distMat = data.distanceMatrix(profile);
+            if (distMat(depot, client).get() < UNREACHABLE)
+            {
+                reach[idx / BLOCK_SIZE] |= uint64_t(1) << idx % BLOCK_SIZE;
+                numReaching++;
+            }
+        }
+
+        if (numReaching == 0)  // then treat the client as reachable by all
+            std::fill(reach, reach + numBlocks_, ~uint64_t(0));
+
+        restricted_ |= numReaching != 0 && numReaching != classes.size();
+    }
+}
+
+bool exvrp::Reachability::restricted() const { return restricted_; }
+
+bool exvrp::Reachability::canNeighbour(size_t client1, size_t client2) const
+{
+    return canShareRoute(client1, client2)
+           && (data_.isArcCompatible(client1, client2)
+               || data_.isArcCompatible(client2, client1));
+}
+
+bool exvrp::Reachability::canShareRoute(size_t client1, size_t client2) const
+{
+    if (!restricted_)
+        return true;
+
+    auto const *reach1 = reach_.data() + client1 * numBlocks_;
+    auto const *reach2 = reach_.data() + client2 * numBlocks_;
+    for (size_t block = 0; block != numBlocks_; ++block)
+        if (reach1[block] & reach2[block])
+            return true;
+
+    return false;
+}
+
+exvrp::Proximity::Proximity(ProblemData const &data,
+                            double weightWaitTime,
+                            double weightTimeWarp)
+    : data_(data),
+      weightWaitTime_(weightWaitTime),
+      weightTimeWarp_(weightTimeWarp)
+{
+    // Vehicle types with the same unit costs and profile have the same edge
+    // costs, so we only need to consider each such combination once.
+    std::set<std::tuple<Cost, Cost, size_t>> unique;
+    for (auto const &vt : data.vehicleTypes())
+    {
+        auto const key = std::make_tuple(
+            vt.unitDistanceCost, vt.unitDurationCost, vt.profile);
+        if (unique.insert(key).second)
+            edgeCosts_.push_back(
+                {static_cast<double>(vt.unitDistanceCost.get()),
+                 static_cast<double>(vt.unitDurationCost.get()),
+                 vt.profile});
+    }
+}
+
+double exvrp::Proximity::edge(size_t from, size_t to) const
+{
+    auto cost = std::numeric_limits<double>::infinity();
+    for (auto const &[unitDist, unitDur, profile] : edgeCosts_)
+    {
+        auto const dist = data_.distanceMatrix(profile)(from, to).get();
+        auto const dur = data_.durationMatrix(profile)(from, to).get();
+        cost = std::min(cost,
+                        unitDist * static_cast<double>(dist)
+                            + unitDur * static_cast<double>(dur));
+    }
+
+    auto minDur = std::numeric_limits<double>::infinity();
+    for (size_t profile = 0; profile != data_.numProfiles(); ++profile)
+    {
+        auto const dur = data_.durationMatrix(profile)(from, to).get();
+        minDur = std::min(minDur, static_cast<double>(dur));
+    }
+
+    ProblemData::Client const &fromData = data_.location(from);
+    ProblemData::Client const &toData = data_.location(to);
+    auto const earlyFrom = static_cast<double>(fromData.twEarly.get());
+    auto const lateFrom = static_cast<double>(fromData.twLate.get());
+    auto const service = static_cast<double>(fromData.serviceDuration.get());
+    auto const earlyTo = static_cast<double>(toData.twEarly.get());
+    auto const lateTo = static_cast<double>(toData.twLate.get());
+
+    cost -= static_cast<double>(toData.prize.get());
+
+    // Wait time penalty (arriving too early at to).
+    auto const minWait = earlyTo - minDur - service - lateFrom;
+    if (minWait > 0)
+        cost += weightWaitTime_ * minWait;
+
+    // Time warp penalty (arriving too late at to).
+    auto const minTw = earlyFrom + service + minDur - lateTo;
+    if (minTw > 0)
+        cost += weightTimeWarp_ * minTw;
+
+    return cost;
+}
+
+double exvrp::Proximity::operator()(size_t i, size_t j, bool symmetric) const
+{
+    ProblemData::Client const &iData = data_.location(i);
+    ProblemData::Client const &jData = data_.location(j);
+    if (iData.group && iData.group == jData.group
+        && data_.group(iData.group.value()).mutuallyExclusive)
+        // Use max double (not infinity) to order before depots.
+        return std::numeric_limits<double>::max();
+
+    return symmetric ? std::min(edge(i, j), edge(j, i)) : edge(i, j);
+}
+
+pyvrp::search::SearchSpace::Neighbours
+exvrp::computeNeighbours(ProblemData const &data,
+                         size_t numNeighbours,
+                         double weightWaitTime,
+                         double weightTimeWarp,
+                         bool symmetricProximity)
+{
+    size_t const numLocs = data.numLocations();
+    size_t const numDepots = data.numDepots();
+    size_t const numClients = data.numClients();
+    pyvrp::search::SearchSpace::Neighbours neighbours(numLocs);
+
+    // For each client, find the k nearest by proximity among the clients it
+    // can neighbour. Other pairs can never be combined by a move, so they
+    // would only take up evaluations. Depots have no neighbours, and clients
+    // do not neighbour depots.
+    Proximity const proximity(data, weightWaitTime, weightTimeWarp);
+    Reachability const reachability(data);
+    size_t k = std::min(numNeighbours, numClients - 1);
+    std::vector<std::pair<double, size_t>> proximities;
+    for (size_t i = numDepots; i < numLocs; ++i)
+    {
+        proximities.clear();
+        for (size_t j = numDepots; j < numLocs; ++j)
+        {
+            if (i != j && reachability.canNeighbour(i, j))
+            {
+                proximities.emplace_back(
+                    proximity(i, j, symmetricProximity), j);
+            }
+        }
+
+        // Partial sort: only sort the first k elements - O(n log k) instead of
+        // O(n log n)
+        if (!proximities.empty())
+        {
+            size_t k_actual = std::min(k, proximities.size());
+            std::partial_sort(proximities.begin(),
+                              proximities.begin() + k_actual,
+                              proximities.end());
+
+            for (size_t n = 0; n < k_actual; ++n)
+            {
+                neighbours[i].push_back(proximities[n].second);
+            }
+        }
+    }
+
+    return neighbours;
+}
@@ -0,0 +1,132 @@
+#ifndef EXVRP_NEIGHBOURHOOD_H
+#define EXVRP_NEIGHBOURHOOD_H
+
+#include "ProblemData.h"
+#include "search/SearchSpace.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace exvrp
+{
+/**
+ * Which clients can share a route. A vehicle type cannot visit a client at
+ * unreachable distance (at least 1e9) from its start depot in the vehicle
+ * type's profile, e.g. a client outside the zones a cargo bike may enter. Two
+ * clients can share a route if some vehicle type can visit both.
+ *
+ * Vehicle types with the same profile and start depot reach the same clients,
+ * so we track reachability per such pair. Clients that no vehicle type can
+ * reach are treated as reachable by all, so they keep their neighbours.
+ *
+ * With hard time windows, two clients can also only neighbour each other if
+ * one can directly follow the other, see ``ProblemData::isArcCompatible``.
+ */
+class Reachability
+{
+    pyvrp::ProblemData const &data_;
+    size_t numBlocks_ = 0;
+    std::vector<uint64_t> reach_;  // per location, bitset over (profile, depot)
+    bool restricted_ = false;
+
+public:
+    explicit Reachability(pyvrp::ProblemData const &data);
+
+    /**
+     * Returns whether some vehicle type cannot reach some client.
+     */
+    bool restricted() const;
+
+    /**
+     * Returns whether some vehicle type can visit both given clients.
+     */
+    bool canShareRoute(size_t client1, size_t client2) const;
+
+    /**
+     * Returns whether the given clients may be neighbours: they can share a
+     * route, and one can be visited directly after the other.
+     */
+    bool canNeighbour(size_t client1, size_t client2) const;
+};
+
+/**
+ * Proximity between clients, based on Vidal et al. (2013) hybrid genetic
+ * algorithm paper. The proximity of client ``to`` to client ``from`` is the
+ * cheapest edge cost over the vehicle types, plus weighted penalties for the
+ * minimal wait time and time warp between the two, less the prize of ``to``.
+ * Lower is closer.
+ *
+ * Parameters
+ * ----------
+ * data
+ *     Problem data instance.
+ * weightWaitTime
+ *     Weight of the minimal wait time between two clients.
+ * weightTimeWarp
+ *     Weight of the minimal time warp between two clients.
+ */
+class Proximity
+{
+    struct EdgeCost
+    {
+        double unitDistance;
+        double unitDuration;
+        size_t profile;
+    };
+
+    pyvrp::ProblemData const &data_;
+    double weightWaitTime_;
+    double weightTimeWarp_;
+    std::vector<EdgeCost> edgeCosts_;  // unique per vehicle type
+
+public:
+    explicit Proximity(pyvrp::ProblemData const &data,
+                       double weightWaitTime = 0.2,
+                       double weightTimeWarp = 1.0);
+
+    /**
+     * Returns the proximity of client ``to`` to client ``from``.
+     */
+    double edge(size_t from, size_t to) const;
+
+    /**
+     * Returns the proximity between the given clients: the smaller of the
+     * proximities in both directions if ``symmetric``, or that of ``j`` to
+     * ``i`` otherwise. Clients of the same mutually exclusive group are
+     * maximally far apart (but closer than any depot).
+     */
+    double operator()(size_t i, size_t j, bool symmetric = true) const;
+};
+
+/**
+ * Computes proximity-based neighbours matching PyVRP's compute_neighbours.
+ *
+ * Proximity is computed by :class:`Proximity`, which considers edge costs,
+ * time window penalties, and prizes. Depots have
+ * no neighbours, and clients do not neighbour depots. Clients only neighbour
+ * clients they can share a route with, and, with hard time windows, that
+ * they can be visited consecutively with. See :class:`Reachability`.
+ *
+ * Parameters
+ * ----------
+ * data
+ *     Problem data instance.
+ * numNeighbours
+ *     Number of neighbours to keep for each client.
+ * weightWaitTime
+ *     Weight of the minimal wait time between two clients.
+ * weightTimeWarp
+ *     Weight of the minimal time warp between two clients.
+ * symmetricProximity
+ *     Whether to make the proximity between two clients symmetric.
+ */
+pyvrp::search::SearchSpace::Neighbours
+computeNeighbours(pyvrp::ProblemData const &data,
+                  size_t numNeighbours = 60,
+                  double weightWaitTime = 0.2,
+                  double weightTimeWarp = 1.0,
+                  bool symmetricProximity = true);
+}  // namespace exvrp
+
+#endif  // EXVRP_NEIGHBOURHOOD_H
@@ -0,0 +1,148 @@
+#include "PenaltyManager.h"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <tuple>
+
+using exvrp::PenaltyManager;
+using pyvrp::Cost;
+using pyvrp::CostEvaluator;
+using pyvrp::ProblemData;
+
+PenaltyManager::PenaltyManager(std::vector<double> loadPenalties,
+                               double twPenalty,
+                               double distPenalty,
+                               PenaltyParams params)
+    : params_(params),
+      loadPenalties_(std::move(loadPenalties)),
+      twPenalty_(clip(twPenalty)),
+      distPenalty_(clip(distPenalty))
+{
+    for (auto &penalty : loadPenalties_)
+        penalty = clip(penalty);
+}
+
+double PenaltyManager::clip(double penalty) const
+{
+    return std::min(std::max(penalty, params_.minPenalty), params_.maxPenalty);
+}
+
+double PenaltyManager::compute(double penalty) const
+{
+    auto const feasRate = static_cast<double>(numFeasible_)
+                          / static_cast<double>(numRegistered_);
+
+    if (feasRate < params_.targetFeasible - params_.feasTolerance)
+        return clip(penalty * params_.penaltyIncrease);
+
+    if (feasRate > params_.targetFeasible + params_.feasTolerance)
+        return clip(penalty * params_.penaltyDecrease);
+
+    return clip(penalty);
+}
+
+PenaltyManager PenaltyManager::initFrom(ProblemData const &data,
+                                        PenaltyParams params)
+{
+    auto const numLocs = data.numLocations();
+
+    // Minimum edge cost over the distinct vehicle type cost structures, and
+    // minimum distance and duration over the profiles.
+    std::set<std::tuple<Cost, Cost, size_t>> edgeCosts;
+    for (auto const &vehType : data.vehicleTypes())
+        edgeCosts.insert({vehType.unitDistanceCost,
+                          vehType.unitDurationCost,
+                          vehType.profile});
+
+    double sumCost = 0;
+    double sumDist = 0;
+    double sumDur = 0;
+    for (size_t i = 0; i != numLocs; ++i)
+        for (size_t j = 0; j != numLocs; ++j)
+        {
+            auto minCost = std::numeric_limits<double>::max();
+            for (auto const &[unitDist, unitDur, profile] : edgeCosts)
+            {
+                auto const dist = data.distanceMatrix(profile)(i, j).get();
+                auto const dur = data.durationMatrix(profile)(i, j).get();
+                auto const cost = unitDist.get() * dist + unitDur.get() * dur;
+                minCost = std::min(minCost, static_cast<double>(cost));
+            }
+
+            auto minDist = data.distanceMatrix(0)(i, j).get();
+            auto minDur = data.durationMatrix(0)(i, j).get();
+            for (size_t profile = 1; profile != data.numProfiles(); ++profile)
+            {
+                minDist = std::min(minDist,
+                                   data.distanceMatrix(profile)(i, j).get());
+                minDur = std::min(minDur,
+                                  data.durationMatrix(profile)(i, j).get());
+            }
+
+            sumCost += edgeCosts.empty() ? 0 : minCost;
+            sumDist += static_cast<double>(minDist);
+            sumDur += static_cast<double>(minDur);
+        }
+
+    auto const numEdges = static_cast<double>(numLocs * numLocs);
+    auto const avgCost = sumCost / numEdges;
+    auto const avgDist = sumDist / numEdges;
+    auto const avgDur = sumDur / numEdges;
+
+    auto twPenalty = avgCost / std::max(avgDur, 1.0);
+    auto const distPenalty = avgCost / std::max(avgDist, 1.0);
+
+    // For prize-collecting problems, the time warp penalty must be high enough
+    // relative to the prizes, or the search prefers keeping clients with time
+    // warp over removing them. This assumes a typical time warp of an hour.
+    Cost maxPrize = 0;
+    for (auto const &client : data.clients())
+        maxPrize = std::max(maxPrize, client.prize);
+
+    if (maxPrize > 0)
+        twPenalty = std::max(twPenalty, maxPrize.get() / 3600.0);
+
+    // The load penalty starts at its maximum, and adapts during the search.
+    std::vector<double> loadPenalties(data.numLoadDimensions(),
+                                      params.maxPenalty);
+
+    return {std::move(loadPenalties), twPenalty, distPenalty, params};
+}
+
+bool PenaltyManager::registerSolution(pyvrp::Solution const &solution)
+{
+    numRegistered_++;
+    numFeasible_ += solution.isFeasible();
+
+    if (numRegistered_ < params_.solutionsBetweenUpdates)
+        return false;
+
+    auto const prevLoad = loadPenalties_;
+    auto const prevTw = twPenalty_;
+    auto const prevDist = distPenalty_;
+
+    for (auto &penalty : loadPenalties_)
+        penalty = compute(penalty);
+
+    twPenalty_ = compute(twPenalty_);
+    distPenalty_ = compute(distPenalty_);
+
+    numRegistered_ = 0;
+    numFeasible_ = 0;
+
+    return loadPenalties_ != prevLoad || twPenalty_ != prevTw
+           || distPenalty_ != prevDist;
+}
+
+CostEvaluator PenaltyManager::costEvaluator() const
+{
+    return {loadPenalties_, twPenalty_, distPenalty_};
+}
+
+CostEvaluator PenaltyManager::maxCostEvaluator() const
+{
+    std::vector<double> loadPenalties(loadPenalties_.size(),
+                                      params_.maxPenalty);
+    return {std::move(loadPenalties), params_.maxPenalty, params_.maxPenalty};
+}
@@ -0,0 +1,85 @@
+#ifndef EXVRP_PENALTYMANAGER_H
+#define EXVRP_PENALTYMANAGER_H
+
+#include "CostEvaluator.h"
+#include "ProblemData.h"
+#include "Solution.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace exvrp
+{
+/**
+ * Parameters for penalty management. These mirror the fields and defaults of
+ * ``ExVrp.PenaltyManager.Params``.
+ */
+struct PenaltyParams
+{
+    size_t solutionsBetweenUpdates = 100;
+    double penaltyIncrease = 1.25;
+    double penaltyDecrease = 0.85;
+    double targetFeasible = 0.65;
+    double feasTolerance = 0.05;
+    double minPenalty = 0.1;
+    double maxPenalty = 100'000.0;
+};
+
+/**
+ * Native port of ``ExVrp.PenaltyManager``. Tracks the feasibility of
+ * registered solutions, and adjusts the penalty weights to target the
+ * configured feasibility rate.
+ *
+ * As in the Elixir implementation, a solution's overall feasibility is
+ * registered for every penalty term.
+ */
+class PenaltyManager
+{
+    PenaltyParams params_;
+
+    std::vector<double> loadPenalties_;
+    double twPenalty_;
+    double distPenalty_;
+
+    size_t numRegistered_ = 0;
+    size_t numFeasible_ = 0;
+
+    // Clips the given penalty to the configured bounds.
+    double clip(double penalty) const;
+
+    // Returns the updated penalty for the current feasibility rate.
+    double compute(double penalty) const;
+
+public:
+    PenaltyManager(std::vector<double> loadPenalties,
+                   double twPenalty,
+                   double distPenalty,
+                   PenaltyParams params = {});
+
+    /**
+     * Creates a penalty manager with initial penalties computed from the
+     * average edge cost, distance and duration of the given data, matching
+     * ``ExVrp.PenaltyManager.init_from/2``.
+     */
+    static PenaltyManager initFrom(pyvrp::ProblemData const &data,
+                                   PenaltyParams params = {});
+
+    /**
+     * Registers the feasibility of the given solution. Returns whether the
+     * penalties were updated as a result.
+     */
+    bool registerSolution(pyvrp::Solution const &solution);
+
+    /**
+     * Returns a cost evaluator for the current penalty values.
+     */
+    [[nodiscard]] pyvrp::CostEvaluator costEvaluator() const;
+
+    /**
+     * Returns a cost evaluator that uses the maximum penalty values.
+     */
+    [[nodiscard]] pyvrp::CostEvaluator maxCostEvaluator() const;
+};
+}  // namespace exvrp
+
+#endif  // EXVRP_PENALTYMANAGER_H
@@ -0,0 +1,272 @@
+#include "Population.h"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+using exvrp::Population;
+using pyvrp::CostEvaluator;
+using pyvrp::Solution;
+
+double exvrp::brokenPairsDistance(Solution const &first, Solution const &second)
+{
+    auto const &fNeighbours = first.neighbours();
+    auto const &sNeighbours = second.neighbours();
+    assert(fNeighbours.size() == sNeighbours.size());
+
+    // Returns the number of neighbours of the first pair that are not in the
+    // second pair, in either direction, so that a reversed route breaks no
+    // pairs.
+    auto const numBroken = [](auto const &fPair, auto const &sPair)
+    {
+        auto const inSecond = [&](size_t neighbour)
+        { return neighbour == sPair.first || neighbour == sPair.second; };
+
+        return !inSecond(fPair.first) + !inSecond(fPair.second);
+    };
+
+    size_t numBrokenPairs = 0;
+    for (size_t loc = 0; loc != fNeighbours.size(); ++loc)
+    {
+        auto const &fPair = fNeighbours[loc];
+        auto const &sPair = sNeighbours[loc];
+
+        if (fPair == sPair)  // also covers depots, and clients that are
+            continue;        // missing from both solutions
+
+        // Both arcs are broken if the client is only in one of the two. We
+        // count each arc from both its ends, and from both solutions, to make
+        // the distance symmetric.
+        if (!fPair || !sPair)
+            numBrokenPairs += 4;
+        else
+            numBrokenPairs += numBroken(*fPair, *sPair)
+                              + numBroken(*sPair, *fPair);
+    }
+
+    auto const numClients = first.numClients() + first.numMissingClients();
+    return numBrokenPairs / (4.0 * std::max<size_t>(numClients, 1));
+}
+
+std::vector<double>
+exvrp::brokenPairsDistances(Solution const &solution,
+                            std::vector<Solution const *> const &pool)
+{
+    std::vector<double> distances;
+    distances.reserve(pool.size());
+    for (auto const *other : pool)
+        distances.push_back(brokenPairsDistance(solution, *other));
+
+    return distances;
+}
+
+double
+Population::SubPopulation::Item::avgDistanceClosest(size_t numClose) const
+{
+    auto const num = std::min(numClose, proximity.size());
+    if (num == 0)
+        return 0;
+
+    double sum = 0;
+    for (size_t idx = 0; idx != num; ++idx)
+        sum += proximity[idx].first;
+
+    return sum / num;
+}
+
+Population::SubPopulation::SubPopulation(PopulationParams const &params)
+    : params_(params)
+{
+}
+
+void Population::SubPopulation::add(SolutionPtr solution,
+                                    CostEvaluator const &costEvaluator)
+{
+    Item item = {solution, 0, {}};
+    item.proximity.reserve(items_.size());
+
+    for (auto &other : items_)
+    {
+        auto const dist = brokenPairsDistance(*solution, *other.solution);
+        auto const entry = std::make_pair(dist, solution.get());
+        auto const pos = std::upper_bound(
+            other.proximity.begin(), other.proximity.end(), entry);
+        other.proximity.insert(pos, entry);
+
+        item.proximity.emplace_back(dist, other.solution.get());
+    }
+
+    std::sort(item.proximity.begin(), item.proximity.end());
+    items_.push_back(std::move(item));
+
+    if (items_.size() > params_.minPopSize + params_.generationSize)
+        purge(costEvaluator);
+}
+
+void Population::SubPopulation::remove(size_t idx)
+{
+    auto const *solution = items_[idx].solution.get();
+    for (auto &other : items_)
+        std::erase_if(other.proximity,
+                      [&](auto const &entry)
+                      { return entry.second == solution; });
+
+    items_.erase(items_.begin() + idx);
+}
+
+void Population::SubPopulation::purge(CostEvaluator const &costEvaluator)
+{
+    // First remove duplicates, which are at distance zero of another item.
+    auto const isDuplicate = [](Item const &item)
+    { return !item.proximity.empty() && item.proximity.front().first == 0; };
+
+    while (items_.size() > params_.minPopSize)
+    {
+        auto const it = std::find_if(items_.begin(), items_.end(), isDuplicate);
+        if (it == items_.end())
+            break;
+
+        remove(std::distance(items_.begin(), it));
+    }
+
+    // Then remove the items with the worst biased fitness.
+    while (items_.size() > params_.minPopSize)
+    {
+        updateFitness(costEvaluator);
+        auto const worst = std::max_element(
+            items_.begin(),
+            items_.end(),
+            [](Item const &a, Item const &b) { return a.fitness < b.fitness; });
+
+        remove(std::distance(items_.begin(), worst));
+    }
+}
+
+void Population::SubPopulation::updateFitness(
+    CostEvaluator const &costEvaluator)
+{
+    if (items_.empty())
+        return;
+
+    std::vector<pyvrp::Cost> costs;
+    costs.reserve(items_.size());
+    for (auto const &item : items_)
+        costs.push_back(costEvaluator.penalisedCost(*item.solution));
+
+    std::vector<size_t> byCost(items_.size());
+    std::iota(byCost.begin(), byCost.end(), 0);
+    std::stable_sort(byCost.begin(),
+                     byCost.end(),
+                     [&](size_t a, size_t b) { return costs[a] < costs[b]; });
+
+    // Higher average distance to the closest items is better, so we sort on
+    // its negation.
+    std::vector<std::pair<double, size_t>> diversity;
+    diversity.reserve(items_.size());
+    for (size_t costRank = 0; costRank != byCost.size(); ++costRank)
+    {
+        auto const &item = items_[byCost[costRank]];
+        auto const dist = item.avgDistanceClosest(params_.numClose);
+        diversity.emplace_back(-dist, costRank);
+    }
+
+    std::stable_sort(diversity.begin(), diversity.end());
+
+    double const size = items_.size();
+    auto const numElite = std::min<double>(params_.numElite, size);
+    auto const divWeight = 1 - numElite / size;
+
+    for (size_t divRank = 0; divRank != diversity.size(); ++divRank)
+    {
+        auto const costRank = diversity[divRank].second;
+        auto &item = items_[byCost[costRank]];
+        item.fitness = (costRank + divWeight * divRank) / (2 * size);
+    }
+}
+
+void Population::SubPopulation::clear() { items_.clear(); }
+
+size_t Population::SubPopulation::size() const { return items_.size(); }
+
+Population::SolutionPtr const &
+Population::SubPopulation::solution(size_t idx) const
+{
+    return items_[idx].solution;
+}
+
+double Population::SubPopulation::fitness(size_t idx) const
+{
+    return items_[idx].fitness;
+}
+
+Population::Population(PopulationParams params)
+    : params_(params), feasible_(params_), infeasible_(params_)
+{
+}
+
+Population::SolutionPtr
+Population::tournament(pyvrp::RandomNumberGenerator &rng) const
+{
+    assert(size() > 0);
+
+    auto const sample = [&]()
+    {
+        auto const idx = rng.randint(size());
+        return idx < feasible_.size()
+                   ? std::make_pair(feasible_.solution(idx),
+                                    feasible_.fitness(idx))
+                   : std::make_pair(
+                         infeasible_.solution(idx - feasible_.size()),
+                         infeasible_.fitness(idx - feasible_.size()));
+    };
+
+    auto const first = sample();
+    auto const second = sample();
+    return first.second <= second.second ? first.first : second.first;
+}
+
+void Population::add(SolutionPtr solution, CostEvaluator const &costEvaluator)
+{
+    if (solution->isFeasible())
+        feasible_.add(std::move(solution), costEvaluator);
+    else
+        infeasible_.add(std::move(solution), costEvaluator);
+}
+
+std::pair<Population::SolutionPtr, Population::SolutionPtr>
+Population::select(pyvrp::RandomNumberGenerator &rng,
+                   CostEvaluator const &costEvaluator)
+{
+    static constexpr size_t MAX_TRIES = 10;
+
+    feasible_.updateFitness(costEvaluator);
+    infeasible_.updateFitness(costEvaluator);
+
+    auto const first = tournament(rng);
+    auto second = tournament(rng);
+
+    auto diversity = brokenPairsDistance(*first, *second);
+    for (size_t tries = 1; tries != MAX_TRIES; ++tries)
+    {
+        if (params_.lbDiversity <= diversity
+            && diversity <= params_.ubDiversity)
+            break;
+
+        second = tournament(rng);
+        diversity = brokenPairsDistance(*first, *second);
+    }
+
+    return {first, second};
+}
+
+void Population::clear()
+{
+    feasible_.clear();
+    infeasible_.clear();
+}
+
+size_t Population::numFeasible() const { return feasible_.size(); }
+
+size_t Population::numInfeasible() const { return infeasible_.size(); }
+
+size_t Population::size() const { return numFeasible() + numInfeasible(); }
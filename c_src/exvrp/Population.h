@@ -0,0 +1,172 @@
+#ifndef EXVRP_POPULATION_H
+#define EXVRP_POPULATION_H
+
+#include "CostEvaluator.h"
+#include "ProblemData.h"
+#include "RandomNumberGenerator.h"
+#include "Solution.h"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace exvrp
+{
+/**
+ * Parameters for the population of the hybrid genetic search. These mirror
+ * the fields and defaults of ``ExVrp.GeneticAlgorithm.Params``.
+ *
+ * Parameters
+ * ----------
+ * minPopSize
+ *     Number of solutions each subpopulation keeps after a purge.
+ * generationSize
+ *     Number of solutions added to a subpopulation before it is purged back
+ *     to ``minPopSize``.
+ * numElite
+ *     Number of best solutions that are protected from being purged for their
+ *     lack of diversity.
+ * numClose
+ *     Number of closest solutions over which a solution's diversity
+ *     contribution is averaged.
+ * lbDiversity
+ *     Lower bound on the broken pairs distance of two selected parents.
+ * ubDiversity
+ *     Upper bound on the broken pairs distance of two selected parents.
+ */
+struct PopulationParams
+{
+    size_t minPopSize = 25;
+    size_t generationSize = 40;
+    size_t numElite = 4;
+    size_t numClose = 5;
+    double lbDiversity = 0.1;
+    double ubDiversity = 0.5;
+};
+
+/**
+ * Computes the symmetric broken pairs distance between the two given
+ * solutions: the fraction of client predecessor and successor arcs of the one
+ * solution that are not in the other, averaged over both directions of
+ * comparison. Arcs are undirected, so a route and its reverse are at zero
+ * distance. Returns a value in [0, 1], where zero means the solutions visit
+ * all clients in the same way.
+ */
+double brokenPairsDistance(pyvrp::Solution const &first,
+                           pyvrp::Solution const &second);
+
+/**
+ * Computes the broken pairs distance between the given solution and each
+ * solution of the given pool, in order.
+ */
+std::vector<double>
+brokenPairsDistances(pyvrp::Solution const &solution,
+                     std::vector<pyvrp::Solution const *> const &pool);
+
+/**
+ * Native port of PyVRP's HGS population. Feasible and infeasible solutions
+ * are kept in separate subpopulations. Each solution has a biased fitness
+ * that combines its rank in penalised cost with its rank in diversity, the
+ * average broken pairs distance to its closest other solutions. When a
+ * subpopulation grows past ``minPopSize + generationSize`` solutions, it is
+ * purged back to ``minPopSize``: first of duplicates, then of the solutions
+ * with the worst fitness.
+ */
+class Population
+{
+public:
+    using SolutionPtr = std::shared_ptr<pyvrp::Solution const>;
+
+private:
+    class SubPopulation
+    {
+        struct Item
+        {
+            SolutionPtr solution;
+            double fitness = 0;
+
+            // Distance to each other solution, sorted in increasing order.
+            std::vector<std::pair<double, pyvrp::Solution const *>> proximity;
+
+            // Average distance to the numClose closest other solutions.
+            double avgDistanceClosest(size_t numClose) const;
+        };
+
+        PopulationParams const &params_;
+        std::vector<Item> items_;
+
+        // Removes the item at the given index, and its proximity entries.
+        void remove(size_t idx);
+
+        // Removes items until the subpopulation has minPopSize items.
+        void purge(pyvrp::CostEvaluator const &costEvaluator);
+
+    public:
+        explicit SubPopulation(PopulationParams const &params);
+
+        void add(SolutionPtr solution,
+                 pyvrp::CostEvaluator const &costEvaluator);
+
+        void updateFitness(pyvrp::CostEvaluator const &costEvaluator);
+
+        void clear();
+
+        size_t size() const;
+
+        SolutionPtr const &solution(size_t idx) const;
+
+        double fitness(size_t idx) const;
+    };
+
+    PopulationParams params_;
+    SubPopulation feasible_;
+    SubPopulation infeasible_;
+
+    // Picks the fittest of two uniformly sampled solutions.
+    SolutionPtr tournament(pyvrp::RandomNumberGenerator &rng) const;
+
+public:
+    explicit Population(PopulationParams params = {});
+
+    Population(Population const &other) = delete;
+    Population &operator=(Population const &other) = delete;
+
+    /**
+     * Adds the given solution to the feasible or infeasible subpopulation,
+     * purging it if it has grown too large.
+     */
+    void add(SolutionPtr solution, pyvrp::CostEvaluator const &costEvaluator);
+
+    /**
+     * Selects two parents by binary tournament on the biased fitness. The
+     * second parent is re-drawn a few times while its broken pairs distance
+     * to the first is outside the configured diversity bounds.
+     */
+    std::pair<SolutionPtr, SolutionPtr>
+    select(pyvrp::RandomNumberGenerator &rng,
+           pyvrp::CostEvaluator const &costEvaluator);
+
+    /**
+     * Removes all solutions from the population.
+     */
+    void clear();
+
+    /**
+     * Returns the number of feasible solutions in the population.
+     */
+    size_t numFeasible() const;
+
+    /**
+     * Returns the number of infeasible solutions in the population.
+     */
+    size_t numInfeasible() const;
+
+    /**
+     * Returns the total number of solutions in the population.
+     */
+    size_t size() const;
+};
+}  // namespace exvrp
+
+#endif  // EXVRP_POPULATION_H
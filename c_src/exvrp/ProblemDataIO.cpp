@@ -0,0 +1,736 @@
+#include "ProblemDataIO.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using pyvrp::Coordinate;
+using pyvrp::Cost;
+using pyvrp::Distance;
+using pyvrp::Duration;
+using pyvrp::Load;
+using pyvrp::Matrix;
+using pyvrp::SharedMatrix;
+using pyvrp::ProblemData;
+
+namespace
+{
+// Magic bytes and format version at the start of every dump. The version
+// must be bumped whenever the layout below changes.
+constexpr std::string_view MAGIC = "EXVRPPD";
+constexpr uint64_t VERSION = 3;
+
+class Writer
+{
+    std::string out_;
+
+public:
+    void u64(uint64_t value)
+    {
+        for (size_t byte = 0; byte != 8; ++byte)
+            out_.push_back(static_cast<char>((value >> (8 * byte)) & 0xFF));
+    }
+
+    void i64(int64_t value) { u64(static_cast<uint64_t>(value)); }
+
+    void f64(double value) { u64(std::bit_cast<uint64_t>(value)); }
+
+    void str(std::string_view value)
+    {
+        u64(value.size());
+        out_.append(value);
+    }
+
+    template <typename T> void measures(std::vector<T> const &values)
+    {
+        u64(values.size());
+        for (auto const value : values)
+            i64(value.get());
+    }
+
+    void indices(std::vector<size_t> const &values)
+    {
+        u64(values.size());
+        for (auto const value : values)
+            u64(value);
+    }
+
+    template <typename T> void matrix(SharedMatrix<T> const &matrix)
+    {
+        u64(matrix.numRows());
+        u64(matrix.numCols());
+        for (size_t row = 0; row != matrix.numRows(); ++row)
+            for (size_t col = 0; col != matrix.numCols(); ++col)
+                i64(matrix(row, col).get());
+    }
+
+    std::string release() { return std::move(out_); }
+
+    explicit Writer(std::string_view magic) { out_.append(magic); }
+};
+
+class Reader
+{
+    std::string_view in_;
+    size_t pos_ = 0;
+
+    void require(size_t numBytes) const
+    {
+        if (in_.size() - pos_ < numBytes)
+            throw std::invalid_argument("Truncated problem data dump.");
+    }
+
+    // Returns a size that is used to allocate, checked against the number of
+    // remaining bytes so that a corrupt dump cannot trigger huge allocations.
+    size_t count(size_t bytesPerElement)
+    {
+        auto const size = u64();
+        if (size > (in_.size() - pos_) / bytesPerElement)
+            throw std::invalid_argument("Truncated problem data dump.");
+        return size;
+    }
+
+public:
+    explicit Reader(std::string_view in) : in_(in) {}
+
+    void skip(size_t numBytes)
+    {
+        require(numBytes);
+        pos_ += numBytes;
+    }
+
+    uint64_t u64()
+    {
+        require(8);
+        uint64_t value = 0;
+        for (size_t byte = 0; byte != 8; ++byte)
+            value |= static_cast<uint64_t>(
+                         static_cast<unsigned char>(in_[pos_ + byte]))
+                     << (8 * byte);
+
+        pos_ += 8;
+        return value;
+    }
+
+    int64_t i64() { return static_cast<int64_t>(u64()); }
+
+    double f64() { return std::bit_cast<double>(u64()); }
+
+    bool flag() { return u64() != 0; }
+
+    std::string str()
+    {
+        auto const size = count(1);
+        std::string value(in_.substr(pos_, size));
+        pos_ += size;
+        return value;
+    }
+
+    template <typename T> std::vector<T> measures()
+    {
+        std::vector<T> values(count(8));
+        for (auto &value : values)
+            value = T(i64());
+        return values;
+    }
+
+    std::vector<size_t> indices()
+    {
+        std::vector<size_t> values(count(8));
+        for (auto &value : values)
+            value = u64();
+        return values;
+    }
+
+    template <typename T> Matrix<T> matrix()
+    {
+        auto const numRows = u64();
+        auto const numCols = u64();
+        if (numCols != 0 && numRows > (in_.size() - pos_) / 8 / numCols)
+            throw std::invalid_argument("Truncated problem data dump.");
+
+        std::vector<T> data(numRows * numCols);
+        for (auto &value : data)
+            value = T(i64());
+        return Matrix<T>(std::move(data), numRows, numCols);
+    }
+
+    bool done() const { return pos_ == in_.size(); }
+};
+
+// ---------------------------------------------------------------------------
+// VRPLIB
+// ---------------------------------------------------------------------------
+
+using Section = std::vector<std::vector<std::string>>;
+
+struct Instance
+{
+    std::map<std::string, std::string> specs;  // upper-case key -> value
+    std::map<std::string, Section> sections;   // upper-case name -> rows
+};
+
+std::string trim(std::string const &str)
+{
+    auto const first = str.find_first_not_of(" \t\r");
+    if (first == std::string::npos)
+        return "";
+
+    auto const last = str.find_last_not_of(" \t\r");
+    return str.substr(first, last - first + 1);
+}
+
+std::string upper(std::string str)
+{
+    std::transform(str.begin(),
+                   str.end(),
+                   str.begin(),
+                   [](unsigned char chr) { return std::toupper(chr); });
+    return str;
+}
+
+bool endsWith(std::string const &str, std::string_view suffix)
+{
+    return str.size() >= suffix.size()
+           && str.compare(str.size() - suffix.size(), suffix.size(), suffix)
+                  == 0;
+}
+
+Instance parseVrplib(std::istream &in)
+{
+    Instance instance;
+    Section *section = nullptr;
+
+    for (std::string raw; std::getline(in, raw);)
+    {
+        auto const line = trim(raw);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        auto const upperLine = upper(line);
+        if (upperLine == "EOF")
+            break;
+
+        if (endsWith(upperLine, "_SECTION"))
+        {
+            auto const name = upperLine.substr(0, line.size() - 8);
+            section = &instance.sections[name];
+            continue;
+        }
+
+        auto const colon = line.find(':');
+        if (colon != std::string::npos)
+        {
+            auto const key = upper(trim(line.substr(0, colon)));
+            instance.specs[key] = trim(line.substr(colon + 1));
+            section = nullptr;
+            continue;
+        }
+
+        if (section)
+        {
+            std::istringstream tokens(line);
+            auto &row = section->emplace_back();
+            for (std::string token; tokens >> token;)
+                row.push_back(token);
+        }
+    }
+
+    return instance;
+}
+
+double number(std::string const &token)
+{
+    size_t end = 0;
+    double value = 0;
+
+    try
+    {
+        value = std::stod(token, &end);
+    }
+    catch (std::exception const &)
+    {
+        end = 0;
+    }
+
+    if (end != token.size())
+        throw std::invalid_argument("Invalid number in VRPLIB instance: "
+                                    + token);
+    return value;
+}
+
+int64_t applyRounding(double value, exvrp::RoundFunc func)
+{
+    if (func == exvrp::RoundFunc::ROUND)
+        return std::llround(value);
+
+    if (func == exvrp::RoundFunc::DIMACS)
+        return static_cast<int64_t>(std::trunc(10 * value));
+
+    if (func == exvrp::RoundFunc::EXACT)
+        return std::llround(1000 * value);
+
+    return static_cast<int64_t>(std::trunc(value));  // NONE and TRUNC
+}
+
+// Reads a section of "<1-based location> <values...>" rows into per-location
+// value lists.
+std::map<size_t, std::vector<double>> locationValues(Instance const &instance,
+                                                     std::string const &name)
+{
+    std::map<size_t, std::vector<double>> values;
+
+    auto const it = instance.sections.find(name);
+    if (it == instance.sections.end())
+        return values;
+
+    for (auto const &row : it->second)
+    {
+        if (row.size() < 2)
+            throw std::invalid_argument("Malformed " + name + "_SECTION.");
+
+        auto &rowValues = values[static_cast<size_t>(number(row[0])) - 1];
+        for (size_t idx = 1; idx != row.size(); ++idx)
+            rowValues.push_back(number(row[idx]));
+    }
+
+    return values;
+}
+}  // namespace
+
+std::string exvrp::serialise(ProblemData const &data)
+{
+    Writer out(MAGIC);
+    out.u64(VERSION);
+
+    out.u64(data.numDepots());
+    for (auto const &depot : data.depots())
+    {
+        out.f64(depot.x.get());
+        out.f64(depot.y.get());
+        out.i64(depot.twEarly.get());
+        out.i64(depot.twLate.get());
+        out.i64(depot.serviceDuration.get());
+        out.i64(depot.reloadCost.get());
+        out.str(depot.name);
+    }
+
+    out.u64(data.numClients());
+    for (auto const &client : data.originalClients())
+    {
+        out.f64(client.x.get());
+        out.f64(client.y.get());
+        out.measures(client.delivery);
+        out.measures(client.pickup);
+        out.i64(client.serviceDuration.get());
+        out.i64(client.twEarly.get());
+        out.i64(client.twLate.get());
+        out.i64(client.releaseTime.get());
+        out.i64(client.prize.get());
+        out.u64(client.required);
+        out.u64(client.group.has_value());
+        out.u64(client.group.value_or(0));
+        out.str(client.name);
+    }
+
+    out.u64(data.numVehicleTypes());
+    for (auto const &vehType : data.vehicleTypes())
+    {
+        out.u64(vehType.numAvailable);
+        out.measures(vehType.capacity);
+        out.u64(vehType.startDepot);
+        out.u64(vehType.endDepot);
+        out.i64(vehType.fixedCost.get());
+        out.i64(vehType.twEarly.get());
+        out.i64(vehType.twLate.get());
+        out.i64(vehType.shiftDuration.get());
+        out.i64(vehType.maxDistance.get());
+        out.i64(vehType.unitDistanceCost.get());
+        out.i64(vehType.unitDurationCost.get());
+        out.u64(vehType.profile);
+        out.i64(vehType.startLate.get());
+        out.measures(vehType.initialLoad);
+        out.indices(vehType.reloadDepots);
+        out.u64(vehType.maxReloads);
+        out.i64(vehType.maxOvertime.get());
+        out.i64(vehType.unitOvertimeCost.get());
+        out.str(vehType.name);
+
+        out.u64(vehType.forbiddenWindows.size());
+        for (auto const &[start, end] : vehType.forbiddenWindows)
+        {
+            out.i64(start.get());
+            out.i64(end.get());
+        }
+    }
+
+    out.u64(data.numProfiles());
+    for (size_t profile = 0; profile != data.numProfiles(); ++profile)
+    {
+        out.matrix(data.distanceMatrix(profile));
+        out.matrix(data.durationMatrix(profile));
+    }
+
+    out.u64(data.numGroups());
+    for (auto const &group : data.groups())
+    {
+        out.indices(group.clients());
+        out.u64(group.required);
+        out.str(group.name);
+    }
+
+    out.u64(data.numSameVehicleGroups());
+    for (auto const &group : data.sameVehicleGroups())
+    {
+        out.indices(group.clients());
+        out.str(group.name);
+    }
+
+    out.u64(data.hardTimeWindows());
+    out.u64(data.tightenTimeWindows());
+    return out.release();
+}
+
+bool exvrp::isDump(std::string_view bytes)
+{
+    return bytes.substr(0, MAGIC.size()) == MAGIC;
+}
+
+ProblemData exvrp::deserialise(std::string_view dump)
+{
+    if (!isDump(dump))
+        throw std::invalid_argument("Not a problem data dump.");
+
+    Reader in(dump);
+    in.skip(MAGIC.size());
+
+    if (auto const version = in.u64(); version != VERSION)
+        throw std::invalid_argument("Unsupported problem data dump version "
+                                    + std::to_string(version) + ".");
+
+    std::vector<ProblemData::Depot> depots;
+    for (size_t idx = in.u64(); idx != 0; --idx)
+    {
+        Coordinate const x = in.f64();
+        Coordinate const y = in.f64();
+        Duration const twEarly = in.i64();
+        Duration const twLate = in.i64();
+        Duration const serviceDuration = in.i64();
+        Cost const reloadCost = in.i64();
+        depots.emplace_back(
+            x, y, twEarly, twLate, serviceDuration, reloadCost, in.str());
+    }
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t idx = in.u64(); idx != 0; --idx)
+    {
+        Coordinate const x = in.f64();
+        Coordinate const y = in.f64();
+        auto delivery = in.measures<Load>();
+        auto pickup = in.measures<Load>();
+        Duration const serviceDuration = in.i64();
+        Duration const twEarly = in.i64();
+        Duration const twLate = in.i64();
+        Duration const releaseTime = in.i64();
+        Cost const prize = in.i64();
+        bool const required = in.flag();
+        bool const hasGroup = in.flag();
+        size_t const group = in.u64();
+        clients.emplace_back(x,
+                             y,
+                             std::move(delivery),
+                             std::move(pickup),
+                             serviceDuration,
+                             twEarly,
+                             twLate,
+                             releaseTime,
+                             prize,
+                             required,
+                             hasGroup ? std::optional(group) : std::nullopt,
+                             in.str());
+    }
+
+    std::vector<ProblemData::VehicleType> vehicleTypes;
+    for (size_t idx = in.u64(); idx != 0; --idx)
+    {
+        size_t const numAvailable = in.u64();
+        auto capacity = in.measures<Load>();
+        size_t const startDepot = in.u64();
+        size_t const endDepot = in.u64();
+        Cost const fixedCost = in.i64();
+        Duration const twEarly = in.i64();
+        Duration const twLate = in.i64();
+        Duration const shiftDuration = in.i64();
+        Distance const maxDistance = in.i64();
+        Cost const unitDistanceCost = in.i64();
+        Cost const unitDurationCost = in.i64();
+        size_t const profile = in.u64();
+        Duration const startLate = in.i64();
+        auto initialLoad = in.measures<Load>();
+        auto reloadDepots = in.indices();
+        size_t const maxReloads = in.u64();
+        Duration const maxOvertime = in.i64();
+        Cost const unitOvertimeCost = in.i64();
+        auto name = in.str();
+
+        std::vector<std::pair<Duration, Duration>> forbiddenWindows;
+        for (size_t window = in.u64(); window != 0; --window)
+        {
+            Duration const start = in.i64();
+            forbiddenWindows.emplace_back(start, in.i64());
+        }
+
+        vehicleTypes.emplace_back(numAvailable,
+                                  std::move(capacity),
+                                  startDepot,
+                                  endDepot,
+                                  fixedCost,
+                                  twEarly,
+                                  twLate,
+                                  shiftDuration,
+                                  maxDistance,
+                                  unitDistanceCost,
+                                  unitDurationCost,
+                                  profile,
+                                  startLate,
+                                  std::move(initialLoad),
+                                  std::move(reloadDepots),
+                                  maxReloads,
+                                  maxOvertime,
+                                  unitOvertimeCost,
+                                  std::move(name),
+                                  std::move(forbiddenWindows));
+    }
+
+    std::vector<Matrix<Distance>> distMats;
+    std::vector<Matrix<Duration>> durMats;
+    for (size_t idx = in.u64(); idx != 0; --idx)
+    {
+        distMats.push_back(in.matrix<Distance>());
+        durMats.push_back(in.matrix<Duration>());
+    }
+
+    std::vector<ProblemData::ClientGroup> groups;
+    for (size_t idx = in.u64(); idx != 0; --idx)
+    {
+        auto groupClients = in.indices();
+        bool const required = in.flag();
+        groups.emplace_back(std::move(groupClients), required, in.str());
+    }
+
+    std::vector<ProblemData::SameVehicleGroup> sameVehicleGroups;
+    for (size_t idx = in.u64(); idx != 0; --idx)
+    {
+        auto groupClients = in.indices();
+        sameVehicleGroups.emplace_back(std::move(groupClients), in.str());
+    }
+
+    bool const hardTimeWindows = in.flag();
+    bool const tightenTimeWindows = in.flag();
+
+    if (!in.done())
+        throw std::invalid_argument("Trailing bytes in problem data dump.");
+
+    return {std::move(clients),
+            std::move(depots),
+            std::move(vehicleTypes),
+            std::move(distMats),
+            std::move(durMats),
+            std::move(groups),
+            std::move(sameVehicleGroups),
+            hardTimeWindows,
+            tightenTimeWindows};
+}
+
+ProblemData exvrp::readVrplib(std::istream &in, RoundFunc round)
+{
+    auto const instance = parseVrplib(in);
+
+    for (auto const *name : {"VEHICLES_DEPOT",
+                             "VEHICLES_ALLOWED_CLIENTS",
+                             "VEHICLES_RELOAD_DEPOT",
+                             "VEHICLES_MAX_DURATION",
+                             "VEHICLES_MAX_DISTANCE",
+                             "VEHICLES_FIXED_COST",
+                             "VEHICLES_UNIT_DISTANCE_COST",
+                             "MUTUALLY_EXCLUSIVE_GROUP",
+                             "CAPACITY"})
+        if (instance.sections.contains(name))
+            throw std::invalid_argument(std::string(name)
+                                        + "_SECTION is not supported.");
+
+    auto const spec = [&](std::string const &key) -> std::optional<double>
+    {
+        auto const it = instance.specs.find(key);
+        if (it == instance.specs.end())
+            return std::nullopt;
+        return number(it->second);
+    };
+
+    auto const dimensionSpec = spec("DIMENSION");
+    if (!dimensionSpec || *dimensionSpec < 1)
+        throw std::invalid_argument("VRPLIB instance has no DIMENSION.");
+    auto const dimension = static_cast<size_t>(*dimensionSpec);
+
+    // Depots must be the first locations, as in ProblemData.
+    size_t numDepots = 0;
+    if (auto const it = instance.sections.find("DEPOT");
+        it != instance.sections.end())
+        for (auto const &row : it->second)
+        {
+            auto const depot = number(row.at(0));
+            if (depot < 0)  // -1 terminates the section
+                break;
+            if (static_cast<size_t>(depot) != ++numDepots)
+                throw std::invalid_argument("Depots must be the first "
+                                            "locations.");
+        }
+
+    numDepots = std::max<size_t>(numDepots, 1);
+    if (numDepots > dimension)
+        throw std::invalid_argument("More depots than locations.");
+
+    auto const rnd = [&](double value) { return applyRounding(value, round); };
+
+    // Coordinates, and the distance matrix, which doubles as duration matrix.
+    std::vector<std::pair<double, double>> coords(dimension, {0, 0});
+    for (auto const &[loc, values] : locationValues(instance, "NODE_COORD"))
+        if (loc < dimension && values.size() >= 2)
+            coords[loc] = {values[0], values[1]};
+
+    auto const edgeWeightType = instance.specs.contains("EDGE_WEIGHT_TYPE")
+                                    ? upper(instance.specs.at(
+                                        "EDGE_WEIGHT_TYPE"))
+                                    : "EXPLICIT";
+
+    std::vector<Distance> distances;
+    distances.reserve(dimension * dimension);
+    if (edgeWeightType == "EUC_2D")
+    {
+        for (auto const &[x1, y1] : coords)
+            for (auto const &[x2, y2] : coords)
+            {
+                auto const dx = x2 - x1;
+                auto const dy = y2 - y1;
+                distances.emplace_back(rnd(std::sqrt(dx * dx + dy * dy)));
+            }
+    }
+    else if (edgeWeightType == "EXPLICIT")
+    {
+        if (auto const it = instance.sections.find("EDGE_WEIGHT");
+            it != instance.sections.end())
+            for (auto const &row : it->second)
+                for (auto const &token : row)
+                    distances.emplace_back(rnd(number(token)));
+
+        if (distances.size() != dimension * dimension)
+            throw std::invalid_argument("EDGE_WEIGHT_SECTION must be a full "
+                                        "matrix.");
+    }
+    else
+        throw std::invalid_argument("Unsupported edge weight type: "
+                                    + edgeWeightType);
+
+    std::vector<Duration> durations;
+    durations.reserve(distances.size());
+    for (auto const dist : distances)
+        durations.emplace_back(dist.get());
+
+    // Per-location client data.
+    auto demands = locationValues(instance, "DEMAND");
+    if (demands.empty())
+        demands = locationValues(instance, "LINEHAUL");
+    auto const backhauls = locationValues(instance, "BACKHAUL");
+    auto const serviceTimes = locationValues(instance, "SERVICE_TIME");
+    auto const timeWindows = locationValues(instance, "TIME_WINDOW");
+    auto const releaseTimes = locationValues(instance, "RELEASE_TIME");
+    auto const prizes = locationValues(instance, "PRIZE");
+    auto const uniformServiceTime = spec("SERVICE_TIME");
+
+    auto const first = [&](auto const &values, size_t loc, double fallback)
+    {
+        auto const it = values.find(loc);
+        return it == values.end() || it->second.empty() ? fallback
+                                                        : it->second[0];
+    };
+
+    auto const loads = [&](auto const &values, size_t loc)
+    {
+        std::vector<Load> result;
+        if (auto const it = values.find(loc); it != values.end())
+            for (auto const value : it->second)
+                result.emplace_back(rnd(value));
+
+        if (result.empty())
+            result.emplace_back(0);
+        return result;
+    };
+
+    auto const window = [&](size_t loc) -> std::pair<Duration, Duration>
+    {
+        auto const it = timeWindows.find(loc);
+        if (it == timeWindows.end() || it->second.size() < 2)
+            return {0, std::numeric_limits<Duration>::max()};
+        return {rnd(it->second[0]), rnd(it->second[1])};
+    };
+
+    std::vector<ProblemData::Depot> depots;
+    for (size_t loc = 0; loc != numDepots; ++loc)
+        depots.emplace_back(rnd(coords[loc].first), rnd(coords[loc].second));
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t loc = numDepots; loc != dimension; ++loc)
+    {
+        auto const [twEarly, twLate] = window(loc);
+        Cost const prize = rnd(first(prizes, loc, 0));
+        auto const serviceTime
+            = first(serviceTimes, loc, uniformServiceTime.value_or(0));
+
+        clients.emplace_back(rnd(coords[loc].first),
+                             rnd(coords[loc].second),
+                             loads(demands, loc),
+                             loads(backhauls, loc),
+                             rnd(serviceTime),
+                             twEarly,
+                             twLate,
+                             rnd(first(releaseTimes, loc, 0)),
+                             prize,
+                             prize == 0);
+    }
+
+    // A homogeneous fleet at the first depot, with that depot's time window.
+    auto const numClients = dimension - numDepots;
+    auto const numVehicles = spec("VEHICLES").value_or(numClients);
+    auto const capacity = spec("CAPACITY");
+    auto const [twEarly, twLate] = window(0);
+
+    std::vector<ProblemData::VehicleType> vehicleTypes;
+    vehicleTypes.emplace_back(
+        static_cast<size_t>(numVehicles),
+        std::vector<Load>{capacity ? rnd(*capacity) : int64_t(1) << 44},
+        0,
+        0,
+        0,
+        twEarly,
+        twLate);
+
+    std::vector<Matrix<Distance>> distMats;
+    distMats.emplace_back(std::move(distances), dimension, dimension);
+    std::vector<Matrix<Duration>> durMats;
+    durMats.emplace_back(std::move(durations), dimension, dimension);
+
+    return {std::move(clients),
+            std::move(depots),
+            std::move(vehicleTypes),
+            std::move(distMats),
+            std::move(durMats)};
+}
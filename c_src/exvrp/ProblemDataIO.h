@@ -0,0 +1,61 @@
+#ifndef EXVRP_PROBLEMDATAIO_H
+#define EXVRP_PROBLEMDATAIO_H
+
+#include "ProblemData.h"
+
+#include <istream>
+#include <string>
+#include <string_view>
+
+namespace exvrp
+{
+/**
+ * Serialises the given problem data to a self-contained binary dump. The
+ * dump stores every field of the clients, depots, vehicle types, groups and
+ * matrices, so that deserialising it gives data equal to the original. All
+ * integers are stored as 64-bit little-endian values.
+ */
+std::string serialise(pyvrp::ProblemData const &data);
+
+/**
+ * Deserialises a dump produced by ``serialise()``. Raises an
+ * ``std::invalid_argument`` if the dump is malformed, or if the resulting
+ * data is invalid.
+ */
+pyvrp::ProblemData deserialise(std::string_view dump);
+
+/**
+ * Returns whether the given bytes start like a dump produced by
+ * ``serialise()``.
+ */
+bool isDump(std::string_view bytes);
+
+/**
+ * Rounding applied to the numbers of a VRPLIB instance, matching the
+ * ``:round_func`` options of ``ExVrp.Read.read/2``.
+ */
+enum class RoundFunc
+{
+    NONE,    // truncate
+    ROUND,   // round to nearest
+    TRUNC,   // truncate
+    DIMACS,  // scale by 10, and truncate
+    EXACT,   // scale by 1000, and round
+};
+
+/**
+ * Reads a VRPLIB instance, like ``ExVrp.Read.read/2``. Supports the common
+ * CVRP, VRPTW and prize-collecting subset of the format: EUC_2D or explicit
+ * full-matrix edge weights; node coordinate, demand, backhaul, depot,
+ * service time, time window, release time and prize sections; and a scalar
+ * capacity for a homogeneous fleet at the first depot.
+ *
+ * Raises an ``std::invalid_argument`` for instances outside this subset.
+ * Those can be dumped from Elixir with ``Native.problem_data_dump/1``
+ * instead.
+ */
+pyvrp::ProblemData readVrplib(std::istream &in,
+                              RoundFunc round = RoundFunc::NONE);
+}  // namespace exvrp
+
+#endif  // EXVRP_PROBLEMDATAIO_H
@@ -0,0 +1,132 @@
+#include "Reclaimer.h"
+
+#include <system_error>
+#include <thread>
+
+using exvrp::Reclaimer;
+
+namespace
+{
+void *startThread(void *(*func)(void *), void *arg)
+{
+    try
+    {
+        return new std::thread(func, arg);
+    }
+    catch (std::system_error const &)
+    {
+        return nullptr;
+    }
+}
+
+void joinThread(void *handle)
+{
+    auto *thread = static_cast<std::thread *>(handle);
+    thread->join();
+    delete thread;
+}
+}  // namespace
+
+Reclaimer::Reclaimer(size_t threshold)
+    : threshold_(threshold), threads_{startThread, joinThread}
+{
+}
+
+Reclaimer::~Reclaimer() { stop(); }
+
+std::unique_ptr<Reclaimer::Item> Reclaimer::push(std::unique_ptr<Item> item,
+                                                 size_t bytes)
+{
+    std::lock_guard lock(mutex_);
+    if (stop_)
+        return item;
+
+    if (!thread_)
+    {
+        thread_ = threads_.start(&Reclaimer::threadMain, this);
+        if (!thread_)
+            return item;  // no thread, so the caller destroys the item
+    }
+
+    queue_.emplace_back(std::move(item), bytes);
+    stats_.numDeferred++;
+    stats_.deferredBytes += bytes;
+    stats_.numPending++;
+    stats_.pendingBytes += bytes;
+
+    wakeup_.notify_one();
+    return nullptr;
+}
+
+void Reclaimer::run()
+{
+    std::unique_lock lock(mutex_);
+    while (true)
+    {
+        wakeup_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+        if (queue_.empty())  // then we are stopping
+            return;
+
+        auto [item, bytes] = std::move(queue_.front());
+        queue_.pop_front();
+        busy_ = true;
+
+        lock.unlock();
+        item.reset();
+        lock.lock();
+
+        busy_ = false;
+        stats_.numPending--;
+        stats_.pendingBytes -= bytes;
+        if (queue_.empty())
+            idle_.notify_all();
+    }
+}
+
+void *Reclaimer::threadMain(void *reclaimer)
+{
+    static_cast<Reclaimer *>(reclaimer)->run();
+    return nullptr;
+}
+
+void Reclaimer::drain()
+{
+    std::unique_lock lock(mutex_);
+    idle_.wait(lock, [&] { return queue_.empty() && !busy_; });
+}
+
+void Reclaimer::stop()
+{
+    void *thread = nullptr;
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+        std::swap(thread, thread_);
+    }
+
+    wakeup_.notify_one();
+    if (thread)  // the thread destroys the pending objects before it exits
+        threads_.join(thread);
+}
+
+void Reclaimer::setThreadFunctions(ThreadFunctions threads)
+{
+    std::lock_guard lock(mutex_);
+    threads_ = threads;
+}
+
+size_t Reclaimer::threshold() const { return threshold_; }
+
+void Reclaimer::setThreshold(size_t threshold) { threshold_ = threshold; }
+
+Reclaimer::Stats Reclaimer::stats()
+{
+    std::lock_guard lock(mutex_);
+    return stats_;
+}
+
+Reclaimer &exvrp::reclaimer()
+{
+    static Reclaimer instance(1 << 20);
+    return instance;
+}
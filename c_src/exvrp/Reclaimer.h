@@ -0,0 +1,151 @@
+#ifndef EXVRP_RECLAIMER_H
+#define EXVRP_RECLAIMER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace exvrp
+{
+/**
+ * Destroys large objects on a background thread, so that the thread that
+ * releases them (e.g. a BEAM scheduler running a resource destructor) does
+ * not block on tearing them down.
+ *
+ * Objects whose estimated size is at least the threshold are queued for the
+ * background thread, which is started on first use. Smaller objects are
+ * destroyed right away, since queueing them costs about as much as freeing
+ * them. If the background thread cannot be started, or the reclaimer is
+ * stopped, all objects are destroyed right away.
+ *
+ * The background thread is a ``std::thread`` by default. Embedders that want
+ * the thread to be created by their own runtime, such as the NIF through
+ * ``enif_thread_create``, install their own :class:`ThreadFunctions`.
+ *
+ * Parameters
+ * ----------
+ * threshold
+ *     Estimated size in bytes from which objects are deferred.
+ */
+class Reclaimer
+{
+public:
+    /**
+     * Counters of the deferred objects. Pending objects are deferred, but not
+     * yet destroyed.
+     */
+    struct Stats
+    {
+        size_t numDeferred = 0;
+        size_t deferredBytes = 0;
+        size_t numPending = 0;
+        size_t pendingBytes = 0;
+    };
+
+    /**
+     * Starts and joins the background thread. ``start`` runs ``func(arg)`` on
+     * a new thread, and returns a handle that is later passed to ``join``, or
+     * null if no thread could be started.
+     */
+    struct ThreadFunctions
+    {
+        void *(*start)(void *(*func)(void *), void *arg);
+        void (*join)(void *handle);
+    };
+
+private:
+    struct Item
+    {
+        virtual ~Item() = default;
+    };
+
+    template <typename T> struct Holder : Item
+    {
+        T object;
+
+        explicit Holder(T &&object) : object(std::move(object)) {}
+    };
+
+    std::atomic<size_t> threshold_;
+
+    std::mutex mutex_;
+    std::condition_variable wakeup_;  // new items, or stopping
+    std::condition_variable idle_;    // the queue is empty
+    std::deque<std::pair<std::unique_ptr<Item>, size_t>> queue_;
+    bool busy_ = false;  // the thread is destroying an item
+    bool stop_ = false;
+    Stats stats_;
+    ThreadFunctions threads_;
+    void *thread_ = nullptr;  // handle of the running thread, if any
+
+    // Queues the given item, or returns it if there is no thread to destroy
+    // it. Starts the thread if it is not running yet.
+    std::unique_ptr<Item> push(std::unique_ptr<Item> item, size_t bytes);
+
+    void run();
+
+    static void *threadMain(void *reclaimer);
+
+public:
+    explicit Reclaimer(size_t threshold);
+
+    /**
+     * Stops the reclaimer, see :meth:`stop`.
+     */
+    ~Reclaimer();
+
+    Reclaimer(Reclaimer const &) = delete;
+    Reclaimer &operator=(Reclaimer const &) = delete;
+
+    /**
+     * Takes ownership of the given object, and destroys it on the background
+     * thread if its estimated size is at least the threshold, or right away
+     * otherwise.
+     */
+    template <typename T> void reclaim(T object, size_t bytes);
+
+    /**
+     * Waits until all pending objects are destroyed.
+     */
+    void drain();
+
+    /**
+     * Destroys the pending objects, and stops and joins the background thread.
+     * Objects that are reclaimed afterwards are destroyed right away.
+     */
+    void stop();
+
+    /**
+     * Sets the functions that start and join the background thread. Must be
+     * called before the first object is deferred.
+     */
+    void setThreadFunctions(ThreadFunctions threads);
+
+    size_t threshold() const;
+
+    void setThreshold(size_t threshold);
+
+    Stats stats();
+};
+
+/**
+ * Returns the process-wide reclaimer that the NIF's resources use. Its
+ * threshold defaults to 1 MiB.
+ */
+Reclaimer &reclaimer();
+
+template <typename T> void Reclaimer::reclaim(T object, size_t bytes)
+{
+    if (bytes < threshold())
+        return;  // object is destroyed here
+
+    auto item = std::make_unique<Holder<T>>(std::move(object));
+    push(std::move(item), bytes);  // destroys the item if it was not queued
+}
+}  // namespace exvrp
+
+#endif  // EXVRP_RECLAIMER_H
@@ -0,0 +1,93 @@
+#include "RouteTrips.h"
+
+#include <algorithm>
+
+using exvrp::RouteTrips;
+using exvrp::TripVisits;
+using pyvrp::ProblemData;
+using pyvrp::Solution;
+
+RouteTrips exvrp::tripsOf(pyvrp::Route const &route)
+{
+    RouteTrips result = {route.vehicleType(), {}};
+    result.trips.reserve(route.numTrips());
+    for (auto const &trip : route.trips())
+        result.trips.push_back(
+            {trip.visits(), trip.startDepot(), trip.endDepot()});
+
+    return result;
+}
+
+RouteTrips exvrp::tripsOf(pyvrp::Route const &route,
+                          ProblemData const &data,
+                          size_t vehicleType)
+{
+    if (route.vehicleType() == vehicleType)
+        return tripsOf(route);
+
+    auto const &vehType = data.vehicleType(vehicleType);
+    auto const &reloads = vehType.reloadDepots;
+    auto const &trips = route.trips();
+
+    bool canReload = trips.size() <= vehType.maxTrips();
+    for (size_t idx = 0; canReload && idx + 1 < trips.size(); ++idx)
+    {
+        auto const depot = trips[idx].endDepot();
+        canReload = std::find(reloads.begin(), reloads.end(), depot)
+                    != reloads.end();
+    }
+
+    if (canReload)
+    {
+        auto result = tripsOf(route);
+        result.vehicleType = vehicleType;
+        result.trips.front().startDepot = vehType.startDepot;
+        result.trips.back().endDepot = vehType.endDepot;
+        return result;
+    }
+
+    return {vehicleType,
+            {{route.visits(), vehType.startDepot, vehType.endDepot}}};
+}
+
+Solution exvrp::toSolution(std::vector<RouteTrips> const &routes,
+                           ProblemData const &data)
+{
+    std::vector<pyvrp::Route> solRoutes;
+    for (auto const &route : routes)
+    {
+        if (route.trips.empty())
+            continue;
+
+        std::vector<TripVisits> kept;
+        for (auto const &trip : route.trips)
+        {
+            if (!trip.visits.empty())
+            {
+                auto &added = kept.emplace_back(trip);
+                if (kept.size() == 1)  // first kept trip starts the route
+                    added.startDepot = route.trips.front().startDepot;
+            }
+            else if (!kept.empty())
+                kept.back().endDepot = trip.endDepot;
+        }
+
+        if (kept.empty())
+            continue;
+
+        kept.back().endDepot = route.trips.back().endDepot;
+
+        std::vector<pyvrp::Trip> trips;
+        trips.reserve(kept.size());
+        for (auto const &trip : kept)
+            trips.emplace_back(data,
+                               trip.visits,
+                               route.vehicleType,
+                               trip.startDepot,
+                               trip.endDepot);
+
+        solRoutes.emplace_back(data, std::move(trips), route.vehicleType);
+    }
+
+    return {data, std::move(solRoutes)};
+}
@@ -0,0 +1,57 @@
+#ifndef EXVRP_ROUTETRIPS_H
+#define EXVRP_ROUTETRIPS_H
+
+#include "ProblemData.h"
+#include "Solution.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace exvrp
+{
+/**
+ * A trip's visits, with the depots it starts and ends at.
+ */
+struct TripVisits
+{
+    std::vector<size_t> visits;
+    size_t startDepot;
+    size_t endDepot;
+};
+
+/**
+ * A route's trips, with the vehicle type of the route. This is an editable
+ * form of a route for the crossover and path relinking, which move clients
+ * between trips and then rebuild the routes with :func:`toSolution`.
+ */
+struct RouteTrips
+{
+    size_t vehicleType;
+    std::vector<TripVisits> trips;
+};
+
+/**
+ * Returns the trips of the given route.
+ */
+RouteTrips tripsOf(pyvrp::Route const &route);
+
+/**
+ * Returns the trips of the given route for a vehicle of the given type. The
+ * route's trips and reload depots are kept if that vehicle type can use
+ * them, and the route then starts and ends at the vehicle type's depots.
+ * Otherwise, all visits go into a single trip.
+ */
+RouteTrips tripsOf(pyvrp::Route const &route,
+                   pyvrp::ProblemData const &data,
+                   size_t vehicleType);
+
+/**
+ * Rebuilds a solution from the given routes' trips. Trips that became empty
+ * are dropped, and their neighbouring trips are joined at the depots they
+ * leave open. Routes without visits are dropped as well.
+ */
+pyvrp::Solution toSolution(std::vector<RouteTrips> const &routes,
+                           pyvrp::ProblemData const &data);
+}  // namespace exvrp
+
+#endif  // EXVRP_ROUTETRIPS_H
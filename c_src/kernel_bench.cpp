@@ -0,0 +1,618 @@
+/**
+ * Standalone micro-benchmark for the core solver kernels. Times segment
+ * merges, route updates, operator evaluations (including reload depot
+ * insertion at a local optimum of an instance with eight reload depots, and
+ * tail swaps between routes of four different profiles),
+ * solution conversion, neighbourhood computation and cost evaluation over a
+ * range of instance sizes, and reports nanoseconds per operation.
+ *
+ * Each kernel is calibrated to run for a fixed time per sample, and sampled
+ * several times. The reported ns/op is the median over the samples, which is
+ * robust against the occasional interrupted sample; the minimum is reported
+ * alongside it.
+ *
+ * Build: make bench
+ * Run:   ./kernel_bench [--json] [--filter <substring>] [--sizes 50,200]
+ *                       [--min-time-ms <ms>] [--samples <n>]
+ */
+#include "exvrp/IteratedLocalSearch.h"
+#include "exvrp/Neighbourhood.h"
+#include "pyvrp/CostEvaluator.h"
+#include "pyvrp/DurationSegment.h"
+#include "pyvrp/LoadSegment.h"
+#include "pyvrp/ProblemData.h"
+#include "pyvrp/RandomNumberGenerator.h"
+#include "pyvrp/Route.h"
+#include "pyvrp/Solution.h"
+#include "pyvrp/search/Exchange.h"
+#include "pyvrp/search/RelocateWithDepot.h"
+#include "pyvrp/search/Route.h"
+#include "pyvrp/search/Solution.h"
+#include "pyvrp/search/SwapStar.h"
+#include "pyvrp/search/SwapTails.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace pyvrp;
+
+// ---------------------------------------------------------------------------
+// Harness
+// ---------------------------------------------------------------------------
+
+namespace
+{
+struct Options
+{
+    bool json = false;
+    std::string filter;
+    std::vector<size_t> sizes = {50, 200, 800};
+    double minTimeMs = 20;  // per sample
+    size_t numSamples = 7;
+};
+
+struct Measurement
+{
+    std::string name;
+    size_t size;
+    double nsPerOp;     // median over samples
+    double minNsPerOp;  // minimum over samples
+    size_t opsPerSample;
+};
+
+// Prevents the compiler from optimising away the computation of value.
+template <typename T> inline void doNotOptimize(T const &value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+// A batch runs a number of operations of a kernel, and returns that number.
+using Batch = std::function<size_t()>;
+
+void measure(std::string name,
+             size_t size,
+             Batch const &batch,
+             Options const &options,
+             std::vector<Measurement> &results)
+{
+    if (name.find(options.filter) == std::string::npos)
+        return;
+
+    using Clock = std::chrono::steady_clock;
+
+    // Runs the given number of batches, and returns the number of operations
+    // and elapsed nanoseconds.
+    auto const run = [&](size_t numBatches)
+    {
+        size_t ops = 0;
+        auto const start = Clock::now();
+        for (size_t idx = 0; idx != numBatches; ++idx)
+            ops += batch();
+
+        auto const elapsed = Clock::now() - start;
+        auto const ns
+            = std::chrono::duration<double, std::nano>(elapsed).count();
+        return std::make_pair(ops, ns);
+    };
+
+    // Calibrate: double the number of batches until a sample takes at least
+    // the minimum time. This also warms up caches and branch predictors.
+    size_t numBatches = 1;
+    while (run(numBatches).second < options.minTimeMs * 1e6)
+        numBatches *= 2;
+
+    std::vector<double> samples;
+    size_t opsPerSample = 0;
+    for (size_t idx = 0; idx != options.numSamples; ++idx)
+    {
+        auto const [ops, ns] = run(numBatches);
+        samples.push_back(ns / static_cast<double>(ops));
+        opsPerSample = ops;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    results.push_back({std::move(name),
+                       size,
+                       samples[samples.size() / 2],
+                       samples.front(),
+                       opsPerSample});
+}
+
+// ---------------------------------------------------------------------------
+// Instances
+// ---------------------------------------------------------------------------
+
+// Random instance with the given number of clients, one depot, time windows
+// and a single load dimension. Deterministic for a given size. With more than
+// one profile, each profile has its own vehicle type, and its distances and
+// durations are 10% longer than those of the previous profile.
+ProblemData makeInstance(size_t numClients,
+                         size_t numReloadDepots = 0,
+                         size_t numProfiles = 1)
+{
+    RandomNumberGenerator rng(numClients);
+
+    std::vector<std::pair<int64_t, int64_t>> coords = {{500, 500}};
+    for (size_t idx = 0; idx != numClients; ++idx)
+        coords.emplace_back(rng.randint(1'000), rng.randint(1'000));
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t idx = 1; idx <= numClients; ++idx)
+    {
+        Duration const twEarly(rng.randint(20'000));
+        Duration const twWidth(2'000 + rng.randint(6'000));
+        clients.emplace_back(coords[idx].first,
+                             coords[idx].second,
+                             std::vector<Load>{Load(1 + rng.randint(10))},
+                             std::vector<Load>{},
+                             Duration(10),
+                             twEarly,
+                             twEarly + twWidth);
+    }
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(500, 500, Duration(0), Duration(40'000));
+
+    // Reload depots on a circle around the main depot, with increasing
+    // reload costs. Depots are the first locations.
+    std::vector<size_t> reloadDepots;
+    for (size_t idx = 0; idx != numReloadDepots; ++idx)
+    {
+        auto const angle = 2 * M_PI * idx / numReloadDepots;
+        auto const x = 500 + std::lround(350 * std::cos(angle));
+        auto const y = 500 + std::lround(350 * std::sin(angle));
+        coords.insert(coords.begin() + idx + 1, {x, y});
+        depots.emplace_back(
+            x, y, Duration(0), Duration(40'000), Duration(0), Cost(idx));
+        reloadDepots.push_back(idx + 1);
+    }
+
+    // Enough vehicles for routes of about ten clients.
+    std::vector<ProblemData::VehicleType> vehicleTypes;
+    for (size_t profile = 0; profile != numProfiles; ++profile)
+        vehicleTypes.emplace_back(numClients / 5 / numProfiles + 1,
+                                  std::vector<Load>{60},
+                                  0,
+                                  0,
+                                  Cost(0),
+                                  Duration(0),
+                                  Duration(40'000),
+                                  std::numeric_limits<Duration>::max(),
+                                  std::numeric_limits<Distance>::max(),
+                                  Cost(1),
+                                  Cost(0),
+                                  profile,
+                                  std::nullopt,
+                                  std::vector<Load>{},
+                                  reloadDepots);
+
+    auto const size = coords.size();
+    std::vector<Matrix<Distance>> distMats;
+    std::vector<Matrix<Duration>> durMats;
+    for (size_t profile = 0; profile != numProfiles; ++profile)
+    {
+        std::vector<Distance> distances;
+        std::vector<Duration> durations;
+        for (size_t i = 0; i != size; ++i)
+            for (size_t j = 0; j != size; ++j)
+            {
+                auto const dx = coords[i].first - coords[j].first;
+                auto const dy = coords[i].second - coords[j].second;
+                auto const dist = std::sqrt(dx * dx + dy * dy);
+                auto const scaled = std::lround(dist * (10 + profile) / 10);
+                distances.emplace_back(scaled);
+                durations.emplace_back(scaled);
+            }
+
+        distMats.emplace_back(std::move(distances), size, size);
+        durMats.emplace_back(std::move(durations), size, size);
+    }
+
+    return {std::move(clients),
+            std::move(depots),
+            std::move(vehicleTypes),
+            std::move(distMats),
+            std::move(durMats)};
+}
+
+// Solution that visits the clients in order of index, in routes of the given
+// size. The routes cycle through the vehicle types.
+Solution makeSolution(ProblemData const &data, size_t routeSize = 10)
+{
+    std::vector<std::vector<size_t>> visits;
+    for (size_t client = data.numDepots(); client != data.numLocations();
+         ++client)
+    {
+        if ((client - data.numDepots()) % routeSize == 0)
+            visits.emplace_back();
+        visits.back().push_back(client);
+    }
+
+    std::vector<Route> routes;
+    for (size_t idx = 0; idx != visits.size(); ++idx)
+        routes.emplace_back(data, visits[idx], idx % data.numVehicleTypes());
+
+    return {data, routes};
+}
+
+CostEvaluator makeCostEvaluator(ProblemData const &data)
+{
+    return {std::vector<double>(data.numLoadDimensions(), 20.0), 6.0, 6.0};
+}
+
+// The solution of makeSolution(), improved by local search.
+Solution makeLocalOptimum(ProblemData const &data)
+{
+    exvrp::DefaultLocalSearch ls(data, exvrp::computeNeighbours(data), 1);
+    return ls.search(makeSolution(data), makeCostEvaluator(data));
+}
+
+// ---------------------------------------------------------------------------
+// Kernels
+// ---------------------------------------------------------------------------
+
+void benchSegments(ProblemData const &data,
+                   Options const &options,
+                   std::vector<Measurement> &results)
+{
+    auto const size = data.numClients();
+    auto const &durations = data.durationMatrix(0);
+
+    std::vector<DurationSegment> durSegments;
+    std::vector<LoadSegment> loadSegments;
+    for (auto const &client : data.clients())
+    {
+        durSegments.emplace_back(client);
+        loadSegments.emplace_back(client, 0);
+    }
+
+    measure(
+        "duration_segment_merge",
+        size,
+        [&]()
+        {
+            DurationSegment acc = durSegments[0];
+            for (size_t idx = 1; idx != durSegments.size(); ++idx)
+            {
+                // Segment idx is of location idx + 1 (after the depot).
+                auto const edge = durations(idx, idx + 1);
+                acc = DurationSegment::merge(edge, acc, durSegments[idx]);
+            }
+
+            doNotOptimize(acc);
+            return durSegments.size() - 1;
+        },
+        options,
+        results);
+
+    measure(
+        "load_segment_merge",
+        size,
+        [&]()
+        {
+            LoadSegment acc = loadSegments[0];
+            for (size_t idx = 1; idx != loadSegments.size(); ++idx)
+                acc = LoadSegment::merge(acc, loadSegments[idx]);
+
+            doNotOptimize(acc);
+            return loadSegments.size() - 1;
+        },
+        options,
+        results);
+}
+
+void benchRouteUpdate(ProblemData const &data,
+                      Options const &options,
+                      std::vector<Measurement> &results)
+{
+    // A single route visiting all clients, so that the size is the route
+    // length.
+    std::vector<search::Route::Node> nodes;
+    nodes.reserve(data.numLocations());
+    for (size_t loc = 0; loc != data.numLocations(); ++loc)
+        nodes.emplace_back(loc);
+
+    search::Route route(data, 0, 0);
+    for (size_t client = data.numDepots(); client != data.numLocations();
+         ++client)
+        route.push_back(&nodes[client]);
+
+    measure(
+        "search_route_update",
+        data.numClients(),
+        [&]()
+        {
+            route.update();
+            doNotOptimize(route);
+            return size_t(1);
+        },
+        options,
+        results);
+}
+
+// Evaluates the operator on all client-neighbour pairs, either in the poor
+// solution of makeSolution(), or in a local optimum, where few moves improve
+// as during most of the search.
+template <typename Op>
+void benchNodeOperator(std::string name,
+                       ProblemData const &data,
+                       Options const &options,
+                       std::vector<Measurement> &results,
+                       bool localOptimum = false)
+{
+    auto const costEvaluator = makeCostEvaluator(data);
+    auto const neighbours = exvrp::computeNeighbours(data);
+
+    auto const solution
+        = localOptimum ? makeLocalOptimum(data) : makeSolution(data);
+
+    search::Solution searchSolution(data);
+    searchSolution.load(solution);
+
+    Op op(data);
+    op.init(solution);
+
+    measure(
+        std::move(name),
+        data.numClients(),
+        [&]()
+        {
+            size_t ops = 0;
+            for (size_t client = data.numDepots();
+                 client != data.numLocations();
+                 ++client)
+            {
+                auto *U = &searchSolution.nodes[client];
+                for (auto const v : neighbours[client])
+                {
+                    auto *V = &searchSolution.nodes[v];
+                    doNotOptimize(op.evaluate(U, V, costEvaluator));
+                    ops++;
+                }
+            }
+
+            return ops;
+        },
+        options,
+        results);
+}
+
+void benchSwapStar(ProblemData const &data,
+                   Options const &options,
+                   std::vector<Measurement> &results)
+{
+    auto const solution = makeSolution(data);
+    auto const costEvaluator = makeCostEvaluator(data);
+
+    search::Solution searchSolution(data);
+    searchSolution.load(solution);
+
+    std::vector<search::Route *> routes;
+    for (auto &route : searchSolution.routes)
+        if (!route.empty())
+            routes.push_back(&route);
+
+    search::SwapStar swapStar(data, 1.0);  // evaluate all route pairs
+    swapStar.init(solution);
+
+    // Each evaluation follows an update of both routes, so that SWAP*'s
+    // caches are recomputed as they are after an applied move.
+    measure(
+        "swap_star_evaluate",
+        data.numClients(),
+        [&]()
+        {
+            for (size_t idx = 0; idx + 1 < routes.size(); ++idx)
+            {
+                swapStar.update(routes[idx]);
+                swapStar.update(routes[idx + 1]);
+                doNotOptimize(swapStar.evaluate(
+                    routes[idx], routes[idx + 1], costEvaluator));
+            }
+
+            return routes.size() - 1;
+        },
+        options,
+        results);
+}
+
+void benchSolution(ProblemData const &data,
+                   Options const &options,
+                   std::vector<Measurement> &results)
+{
+    auto const solution = makeSolution(data);
+    auto const other = makeSolution(data, 9);
+    auto const costEvaluator = makeCostEvaluator(data);
+
+    search::Solution searchSolution(data);
+
+    // Load skips routes that did not change, so alternate between two
+    // solutions that share no routes.
+    measure(
+        "solution_load",
+        data.numClients(),
+        [&]()
+        {
+            searchSolution.load(solution);
+            doNotOptimize(searchSolution);
+            searchSolution.load(other);
+            doNotOptimize(searchSolution);
+            return size_t(2);
+        },
+        options,
+        results);
+
+    measure(
+        "solution_unload",
+        data.numClients(),
+        [&]()
+        {
+            auto const unloaded = searchSolution.unload();
+            doNotOptimize(unloaded);
+            return size_t(1);
+        },
+        options,
+        results);
+
+    measure(
+        "penalised_cost",
+        data.numClients(),
+        [&]()
+        {
+            doNotOptimize(costEvaluator.penalisedCost(solution));
+            return size_t(1);
+        },
+        options,
+        results);
+}
+
+void benchNeighbours(ProblemData const &data,
+                     Options const &options,
+                     std::vector<Measurement> &results)
+{
+    measure(
+        "compute_neighbours",
+        data.numClients(),
+        [&]()
+        {
+            auto const neighbours = exvrp::computeNeighbours(data);
+            doNotOptimize(neighbours);
+            return size_t(1);
+        },
+        options,
+        results);
+}
+
+// ---------------------------------------------------------------------------
+// Output
+// ---------------------------------------------------------------------------
+
+void printTable(std::vector<Measurement> const &results)
+{
+    printf("%-28s %8s %14s %14s %12s\n",
+           "kernel",
+           "size",
+           "ns/op",
+           "min ns/op",
+           "ops/sample");
+
+    for (auto const &result : results)
+        printf("%-28s %8zu %14.2f %14.2f %12zu\n",
+               result.name.c_str(),
+               result.size,
+               result.nsPerOp,
+               result.minNsPerOp,
+               result.opsPerSample);
+}
+
+void printJson(std::vector<Measurement> const &results)
+{
+    printf("{\n  \"benchmarks\": [\n");
+    for (size_t idx = 0; idx != results.size(); ++idx)
+    {
+        auto const &result = results[idx];
+        printf("    {\"name\": \"%s\", \"size\": %zu, \"ns_per_op\": %.3f, "
+               "\"min_ns_per_op\": %.3f, \"ops_per_sample\": %zu}%s\n",
+               result.name.c_str(),
+               result.size,
+               result.nsPerOp,
+               result.minNsPerOp,
+               result.opsPerSample,
+               idx + 1 == results.size() ? "" : ",");
+    }
+    printf("  ]\n}\n");
+}
+
+std::vector<size_t> parseSizes(std::string const &arg)
+{
+    std::vector<size_t> sizes;
+    std::stringstream stream(arg);
+    for (std::string size; std::getline(stream, size, ',');)
+        sizes.push_back(std::strtoul(size.c_str(), nullptr, 10));
+
+    return sizes;
+}
+
+Options parseOptions(int argc, char **argv)
+{
+    Options options;
+    for (int idx = 1; idx < argc; ++idx)
+    {
+        std::string const arg = argv[idx];
+        bool const hasValue = idx + 1 < argc;
+
+        if (arg == "--json")
+            options.json = true;
+        else if (arg == "--filter" && hasValue)
+            options.filter = argv[++idx];
+        else if (arg == "--sizes" && hasValue)
+            options.sizes = parseSizes(argv[++idx]);
+        else if (arg == "--min-time-ms" && hasValue)
+            options.minTimeMs = std::atof(argv[++idx]);
+        else if (arg == "--samples" && hasValue)
+            options.numSamples = std::max(std::atoi(argv[++idx]), 1);
+        else
+        {
+            fprintf(stderr,
+                    "Usage: %s [--json] [--filter <substring>] "
+                    "[--sizes 50,200] [--min-time-ms <ms>] [--samples <n>]\n",
+                    argv[0]);
+            std::exit(1);
+        }
+    }
+
+    return options;
+}
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// Main
+// ---------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+    auto const options = parseOptions(argc, argv);
+
+    std::vector<Measurement> results;
+    for (auto const size : options.sizes)
+    {
+        if (size < 2)
+            continue;
+
+        auto const data = makeInstance(size);
+
+        benchSegments(data, options, results);
+        benchRouteUpdate(data, options, results);
+        benchNodeOperator<search::Exchange<1, 0>>(
+            "exchange10_evaluate", data, options, results);
+        benchNodeOperator<search::Exchange<1, 1>>(
+            "exchange11_evaluate", data, options, results);
+        benchNodeOperator<search::Exchange<2, 2>>(
+            "exchange22_evaluate", data, options, results);
+        benchSwapStar(data, options, results);
+
+        auto const reloadData = makeInstance(size, 8);
+        benchNodeOperator<search::RelocateWithDepot>(
+            "relocate_with_depot_evaluate", reloadData, options, results, true);
+
+        auto const profileData = makeInstance(size, 0, 4);
+        benchNodeOperator<search::SwapTails>(
+            "swap_tails_evaluate_profiles", profileData, options, results);
+        benchSolution(data, options, results);
+        benchNeighbours(data, options, results);
+    }
+
+    if (options.json)
+        printJson(results);
+    else
+        printTable(results);
+
+    return 0;
+}
@@ -10,6 +10,7 @@ using pyvrp::Duration;
 using pyvrp::Load;
 using pyvrp::Matrix;
 using pyvrp::ProblemData;
+using pyvrp::SharedMatrix;
 
 namespace
 {
@@ -51,6 +52,104 @@ bool hasTimeWindow(auto const &arg)
 
     return hasTw;
 }
+
+// Moves each of the given matrices into its own shared, immutable matrix.
+template <typename T> auto share(std::vector<Matrix<T>> matrices)
+{
+    std::vector<SharedMatrix<T>> shared;
+    shared.reserve(matrices.size());
+
+    for (auto &matrix : matrices)
+        shared.emplace_back(std::move(matrix));
+
+    return shared;
+}
+
+// Stores the given clients in a single block, and returns pointers that share
+// ownership of it, so that the clients stay contiguous in memory.
+auto share(std::vector<ProblemData::Client> clients)
+{
+    using Clients = std::vector<ProblemData::Client>;
+    auto const block = std::make_shared<Clients const>(std::move(clients));
+
+    std::vector<std::shared_ptr<ProblemData::Client const>> shared;
+    shared.reserve(block->size());
+
+    for (auto const &client : *block)
+        shared.emplace_back(block, &client);
+
+    return shared;
+}
+
+template <typename T> auto copy(std::vector<SharedMatrix<T>> const &shared)
+{
+    std::vector<Matrix<T>> matrices;
+    matrices.reserve(shared.size());
+
+    for (auto const &matrix : shared)
+        matrices.push_back(matrix.dense());
+
+    return matrices;
+}
+
+// Applies the given travel updates, in order, to the given shared matrices.
+template <typename T>
+void patch(std::vector<SharedMatrix<T>> &matrices,
+           std::vector<ProblemData::TravelUpdate<T>> &updates)
+{
+    for (auto &update : updates)
+    {
+        if (update.profile >= matrices.size())
+            throw std::out_of_range("Profile index out of range.");
+
+        auto &matrix = matrices[update.profile];
+        auto const loc = update.location;
+        auto &values = update.values;
+        matrix = update.isRow ? matrix.withRow(loc, std::move(values))
+                              : matrix.withCol(loc, std::move(values));
+    }
+}
+
+// Returns whether vehicle type a is at least as good as vehicle type b on
+// every route: both have the same depots, profile, reload options, forbidden
+// windows and name, and a has no less capacity, no tighter time or distance
+// limits, and no higher costs. Any route is then no more costly with a than
+// with b.
+bool dominates(ProblemData::VehicleType const &a,
+               ProblemData::VehicleType const &b)
+{
+    auto const geq = [](auto const &lhs, auto const &rhs)
+    {
+        return std::equal(lhs.begin(),
+                          lhs.end(),
+                          rhs.begin(),
+                          rhs.end(),
+                          [](auto lhs, auto rhs) { return lhs >= rhs; });
+    };
+
+    // clang-format off
+    return a.startDepot == b.startDepot
+        && a.endDepot == b.endDepot
+        && a.profile == b.profile
+        && a.reloadDepots == b.reloadDepots
+        && a.forbiddenWindows == b.forbiddenWindows
+        && std::strcmp(a.name, b.name) == 0
+        && geq(a.capacity, b.capacity)
+        && geq(b.initialLoad, a.initialLoad)
+        && a.maxReloads >= b.maxReloads
+        && a.twEarly <= b.twEarly
+        && a.startLate >= b.startLate
+        && a.twLate >= b.twLate
+        && a.shiftDuration >= b.shiftDuration
+        && a.maxDuration >= b.maxDuration
+        && a.maxDistance >= b.maxDistance
+        && a.fixedCost <= b.fixedCost
+        && a.unitDistanceCost <= b.unitDistanceCost
+        && a.unitDurationCost <= b.unitDurationCost
+        && a.unitOvertimeCost <= b.unitOvertimeCost;
+    // clang-format on
+}
+
 }  // namespace
 
 ProblemData::Client::Client(Coordinate x,
@@ -584,11 +683,6 @@ bool ProblemData::VehicleType::operator==(VehicleType const &other) const
     // clang-format on
 }
 
-std::vector<ProblemData::Client> const &ProblemData::clients() const
-{
-    return clients_;
-}
-
 std::vector<ProblemData::Depot> const &ProblemData::depots() const
 {
     return depots_;
@@ -610,14 +704,14 @@ std::vector<ProblemData::VehicleType> const &ProblemData::vehicleTypes() const
     return vehicleTypes_;
 }
 
-std::vector<Matrix<Distance>> const &ProblemData::distanceMatrices() const
+std::vector<Matrix<Distance>> ProblemData::distanceMatrices() const
 {
-    return dists_;
+    return copy(dists_);
 }
 
-std::vector<Matrix<Duration>> const &ProblemData::durationMatrices() const
+std::vector<Matrix<Duration>> ProblemData::durationMatrices() const
 {
-    return durs_;
+    return copy(durs_);
 }
 
 ProblemData::ClientGroup const &ProblemData::group(size_t group) const
@@ -663,6 +757,13 @@ size_t ProblemData::numVehicleTypes() const { return vehicleTypes_.size(); }
 
 size_t ProblemData::numVehicles() const { return numVehicles_; }
 
+std::vector<size_t> const &
+ProblemData::vehicleTypeDominators(size_t vehicleType) const
+{
+    assert(vehicleType < dominators_.size());
+    return dominators_[vehicleType];
+}
+
 size_t ProblemData::numProfiles() const
 {
     assert(dists_.size() == durs_.size());
@@ -837,13 +938,81 @@ ProblemData ProblemData::replace(
     std::optional<std::vector<ClientGroup>> &groups,
     std::optional<std::vector<SameVehicleGroup>> &sameVehicleGroups) const
 {
-    return {clients.value_or(clients_),
+    // Unchanged clients keep their tightened windows and compatible arcs if
+    // the depots, vehicle types and matrices are kept as well.
+    auto const keepWindows = !depots && !vehicleTypes && !distMats && !durMats
+                          && (!clients || clients->size() == numClients());
+
+    return {clients ? share(*clients) : originalClients_,
             depots.value_or(depots_),
             vehicleTypes.value_or(vehicleTypes_),
-            distMats.value_or(dists_),
-            durMats.value_or(durs_),
+            distMats ? share(*distMats) : dists_,
+            durMats ? share(*durMats) : durs_,
             groups.value_or(groups_),
-            sameVehicleGroups.value_or(sameVehicleGroups_)};
+            sameVehicleGroups.value_or(sameVehicleGroups_),
+            hardTimeWindows_,
+            tightenTimeWindows_,
+            keepWindows ? this : nullptr};
+}
+
+ProblemData ProblemData::update(
+    std::vector<std::pair<size_t, Client>> const &clients,
+    std::vector<TravelUpdate<Distance>> distances,
+    std::vector<TravelUpdate<Duration>> durations) const
+{
+    auto newClients = originalClients_;
+    for (auto const &[idx, client] : clients)
+    {
+        if (idx < numDepots() || idx >= numLocations())
+            throw std::out_of_range("Client index out of range.");
+
+        if (client.group != clients_[idx - numDepots()]->group)
+            throw std::invalid_argument("Client group cannot be updated.");
+
+        newClients[idx - numDepots()] = std::make_shared<Client const>(client);
+    }
+
+    std::vector<size_t> changedTravel;
+    for (auto const &update : distances)
+        changedTravel.push_back(update.location);
+    for (auto const &update : durations)
+        changedTravel.push_back(update.location);
+
+    auto newDists = dists_;
+    patch(newDists, distances);
+
+    auto newDurs = durs_;
+    patch(newDurs, durations);
+
+    // Unchanged clients keep their tightened windows and compatible arcs,
+    // unless their travel changed.
+    return {std::move(newClients),
+            depots_,
+            vehicleTypes_,
+            std::move(newDists),
+            std::move(newDurs),
+            groups_,
+            sameVehicleGroups_,
+            hardTimeWindows_,
+            tightenTimeWindows_,
+            this,
+            changedTravel};
+}
+
+bool ProblemData::operator==(ProblemData const &other) const
+{
+    // clang-format off
+    return centroid_ == other.centroid_
+        && dists_ == other.dists_
+        && durs_ == other.durs_
+        && std::ranges::equal(originalClients(), other.originalClients())
+        && depots_ == other.depots_
+        && vehicleTypes_ == other.vehicleTypes_
+        && groups_ == other.groups_
+        && sameVehicleGroups_ == other.sameVehicleGroups_
+        && hardTimeWindows_ == other.hardTimeWindows_
+        && tightenTimeWindows_ == other.tightenTimeWindows_;
+    // clang-format on
 }
 
 ProblemData::ProblemData(std::vector<Client> clients,
@@ -852,10 +1021,36 @@ ProblemData::ProblemData(std::vector<Client> clients,
                          std::vector<Matrix<Distance>> distMats,
                          std::vector<Matrix<Duration>> durMats,
                          std::vector<ClientGroup> groups,
-                         std::vector<SameVehicleGroup> sameVehicleGroups)
+                         std::vector<SameVehicleGroup> sameVehicleGroups,
+                         bool hardTimeWindows,
+                         bool tightenTimeWindows)
+    : ProblemData(share(std::move(clients)),
+                  std::move(depots),
+                  std::move(vehicleTypes),
+                  share(std::move(distMats)),
+                  share(std::move(durMats)),
+                  std::move(groups),
+                  std::move(sameVehicleGroups),
+                  hardTimeWindows,
+                  tightenTimeWindows)
+{
+}
+
+ProblemData::ProblemData(SharedClients clients,
+                         std::vector<Depot> depots,
+                         std::vector<VehicleType> vehicleTypes,
+                         std::vector<SharedMatrix<Distance>> distMats,
+                         std::vector<SharedMatrix<Duration>> durMats,
+                         std::vector<ClientGroup> groups,
+                         std::vector<SameVehicleGroup> sameVehicleGroups,
+                         bool hardTimeWindows,
+                         bool tightenTimeWindows,
+                         ProblemData const *previous,
+                         std::vector<size_t> const &changedTravel)
     : dists_(std::move(distMats)),
       durs_(std::move(durMats)),
-      clients_(std::move(clients)),
+      originalClients_(std::move(clients)),
+      clients_(originalClients_),
       depots_(std::move(depots)),
       vehicleTypes_(std::move(vehicleTypes)),
       groups_(std::move(groups)),
@@ -872,19 +1067,190 @@ ProblemData::ProblemData(std::vector<Client> clients,
               // but the client constructor already ensures those are of equal
               // size (within a single client).
               ? (vehicleTypes_.empty() ? 0 : vehicleTypes_[0].capacity.size())
-              : clients_[0].delivery.size()),
+              : clients_[0]->delivery.size()),
       hasTimeWindows_(
-          std::any_of(clients_.begin(), clients_.end(), hasTimeWindow<Client>)
+          std::ranges::any_of(originalClients(), hasTimeWindow<Client>)
           || std::any_of(depots_.begin(), depots_.end(), hasTimeWindow<Depot>)
           || std::any_of(vehicleTypes_.begin(),
                          vehicleTypes_.end(),
-                         hasTimeWindow<VehicleType>))
+                         hasTimeWindow<VehicleType>)),
+      hardTimeWindows_(hardTimeWindows),
+      tightenTimeWindows_(tightenTimeWindows)
 {
     for (auto const &client : clients_)
     {
-        centroid_.first += static_cast<double>(client.x) / numClients();
-        centroid_.second += static_cast<double>(client.y) / numClients();
+        centroid_.first += static_cast<double>(client->x) / numClients();
+        centroid_.second += static_cast<double>(client->y) / numClients();
     }
 
     validate();
+
+    // Vehicle types that dominate each other are equivalent. Of those, only
+    // the one with the lowest index dominates the others, so that the
+    // relation stays acyclic.
+    dominators_.resize(vehicleTypes_.size());
+    for (size_t type = 0; type != vehicleTypes_.size(); ++type)
+        for (size_t other = 0; other != vehicleTypes_.size(); ++other)
+        {
+            auto const &vehType = vehicleTypes_[type];
+            auto const &otherType = vehicleTypes_[other];
+
+            if (other != type && dominates(otherType, vehType)
+                && (other < type || !dominates(vehType, otherType)))
+                dominators_[type].push_back(other);
+        }
+
+    std::vector<bool> travelChanged(previous ? numLocations() : 0, false);
+    for (auto const loc : changedTravel)
+        travelChanged[loc] = true;
+
+    if (tightenTimeWindows_ && hasTimeWindows_)
+        tightenClientWindows(previous, travelChanged);
+
+    if (hardTimeWindows_)
+        computeCompatibleArcs(previous, travelChanged);
+}
+
+void ProblemData::tightenClientWindows(ProblemData const *previous,
+                                       std::vector<bool> const &travelChanged)
+{
+    // Depot travel enters every client's window.
+    if (previous
+        && std::any_of(travelChanged.begin(),
+                       travelChanged.begin() + numDepots(),
+                       [](bool changed) { return changed; }))
+        previous = nullptr;
+
+    auto const numLocs = numLocations();
+    auto const unreachable = [&](size_t profile, size_t from, size_t to)
+    { return distanceMatrix(profile)(from, to) >= 1'000'000'000; };
+
+    // Beyond the client's own time window, a vehicle type that can reach the
+    // client cannot arrive before leaving its start depot, and must still be
+    // able to return to its end depot afterwards. This uses the direct travel
+    // durations, assuming those satisfy the triangle inequality.
+    SharedClients clients;
+    clients.reserve(numClients());
+    for (size_t client = numDepots(); client != numLocs; ++client)
+    {
+        auto const &original = originalClients_[client - numDepots()];
+        Client const &clientData = *original;
+
+        // Same client, depots, vehicle types and travel, so the same
+        // tightened window.
+        if (previous && !travelChanged[client])
+        {
+            auto const &prevOriginal
+                = previous->originalClients_[client - numDepots()];
+            if (prevOriginal == original || *prevOriginal == clientData)
+            {
+                clients.push_back(previous->clients_[client - numDepots()]);
+                continue;
+            }
+        }
+
+        auto const maxDur = std::numeric_limits<Duration>::max();
+        auto earliest = maxDur;
+        auto latest = std::numeric_limits<Duration>::min();
+        for (auto const &vehType : vehicleTypes_)
+        {
+            auto const profile = vehType.profile;
+            auto const start = vehType.startDepot;
+            auto const end = vehType.endDepot;
+            if (unreachable(profile, start, client))
+                continue;
+
+            auto const &durMat = durationMatrix(profile);
+            auto const toClient = durMat(start, client);
+            auto const depart
+                = std::max(vehType.twEarly, depots_[start].twEarly);
+            if (toClient < maxDur - depart)
+                earliest = std::min(earliest, depart + toClient);
+
+            // Written as subtractions from the return time, which is at most
+            // the maximum duration, to avoid overflow.
+            auto const ret = std::min(vehType.twLate, depots_[end].twLate);
+            latest = std::max(latest,
+                              ret - durMat(client, end)
+                                  - clientData.serviceDuration);
+        }
+
+        auto const twEarly = std::max(clientData.twEarly, earliest);
+        auto const twLate = std::min(clientData.twLate, latest);
+
+        // No vehicle type can reach the client in time, so it cannot be
+        // visited without time warp anyway. Keep its own window.
+        if (earliest == maxDur || twEarly > twLate
+            || clientData.releaseTime > twLate)
+            clients.push_back(original);
+        else
+            clients.push_back(
+                std::make_shared<Client const>(clientData.x,
+                                               clientData.y,
+                                               clientData.delivery,
+                                               clientData.pickup,
+                                               clientData.serviceDuration,
+                                               twEarly,
+                                               twLate,
+                                               clientData.releaseTime,
+                                               clientData.prize,
+                                               clientData.required,
+                                               clientData.group,
+                                               clientData.name));
+    }
+
+    clients_ = std::move(clients);
+}
+
+void ProblemData::computeCompatibleArcs(ProblemData const *previous,
+                                        std::vector<bool> const &travelChanged)
+{
+    auto const numLocs = numLocations();
+    auto const update = [&](size_t from, size_t to)
+    {
+        ProblemData::Client const &fromData = location(from);
+        ProblemData::Client const &toData = location(to);
+
+        auto minDur = std::numeric_limits<int64_t>::max();
+        for (auto const &durMat : durs_)
+            minDur = std::min(minDur, durMat(from, to).get());
+
+        // Written as a subtraction from the latest start, which is at most
+        // the maximum duration, to avoid overflow.
+        auto const latest = toData.twLate.get();
+        auto const earliest = fromData.twEarly.get();
+        auto const service = fromData.serviceDuration.get();
+        compatibleArcs_[from * numLocs + to]
+            = from == to || minDur <= latest - earliest - service;
+    };
+
+    if (!previous || previous->compatibleArcs_.size() != numLocs * numLocs)
+    {
+        compatibleArcs_.assign(numLocs * numLocs, true);
+        for (size_t from = numDepots(); from != numLocs; ++from)
+            for (size_t to = numDepots(); to != numLocs; ++to)
+                update(from, to);
+
+        return;
+    }
+
+    // Only arcs from or to clients whose windows or travel changed can
+    // differ from those of the previous data. Arcs between two such clients
+    // are recomputed twice, which is harmless.
+    compatibleArcs_ = previous->compatibleArcs_;
+    for (size_t client = numDepots(); client != numLocs; ++client)
+    {
+        Client const &clientData = location(client);
+        Client const &prevData = previous->location(client);
+        if (!travelChanged[client] && clientData.twEarly == prevData.twEarly
+            && clientData.twLate == prevData.twLate
+            && clientData.serviceDuration == prevData.serviceDuration)
+            continue;
+
+        for (size_t other = numDepots(); other != numLocs; ++other)
+        {
+            update(client, other);
+            update(other, client);
+        }
+    }
 }
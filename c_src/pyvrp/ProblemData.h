@@ -3,11 +3,14 @@
 
 #include "Matrix.h"
 #include "Measure.h"
+#include "SharedMatrix.h"
 
 #include <cassert>
 #include <iosfwd>
 #include <limits>
+#include <memory>
 #include <optional>
+#include <ranges>
 #include <string>
 #include <vector>
 
@@ -36,6 +39,9 @@ advancePastForbidden(Duration now,
  *     distance_matrices: list[numpy.ndarray[int]],
  *     duration_matrices: list[numpy.ndarray[int]],
  *     groups: list[ClientGroup] = [],
+ *     same_vehicle_groups: list[SameVehicleGroup] = [],
+ *     hard_time_windows: bool = False,
+ *     tighten_time_windows: bool = False,
  * )
  *
  * Creates a problem data instance. This instance contains all information
@@ -66,6 +72,20 @@ advancePastForbidden(Duration now,
  *     List of client groups. Client groups have certain restrictions - see the
  *     definition for details. By default there are no groups, and empty groups
  *     must not be passed.
+ * same_vehicle_groups
+ *     List of same-vehicle groups. By default there are none.
+ * hard_time_windows
+ *     Whether client time windows must never be violated. The search then
+ *     never creates arcs that no solution without time warp can contain; see
+ *     :meth:`~is_arc_compatible`. Default ``False``, in which case time
+ *     windows are only enforced through the time warp penalty.
+ * tighten_time_windows
+ *     Whether client time windows are tightened to the service starts that
+ *     the vehicle shifts allow; see :meth:`~original_clients`. This is
+ *     independent of ``hard_time_windows``, and is only sound when costs and
+ *     penalties do not depend on the original window bounds: time warp is
+ *     then counted against the tightened windows, which can move it between
+ *     clients and depots, or change its amount. Default ``False``.
  *
  * Raises
  * ------
@@ -672,10 +692,16 @@ private:
         inline operator Depot const &() const;
     };
 
+    // Matrices are by far the largest part of the data, followed by the
+    // clients. Both are immutable and shared between instances, so that
+    // updates need not copy them.
+    using SharedClients = std::vector<std::shared_ptr<Client const>>;
+
     std::pair<Coordinate, Coordinate> centroid_;   // Center of client locations
-    std::vector<Matrix<Distance>> const dists_;    // Distance matrices
-    std::vector<Matrix<Duration>> const durs_;     // Duration matrices
-    std::vector<Client> const clients_;            // Client information
+    std::vector<SharedMatrix<Distance>> const dists_;  // Distance matrices
+    std::vector<SharedMatrix<Duration>> const durs_;   // Duration matrices
+    SharedClients const originalClients_;          // Client information
+    SharedClients clients_;                        // With tightened windows
     std::vector<Depot> const depots_;              // Depot information
     std::vector<VehicleType> const vehicleTypes_;  // Vehicle type information
     std::vector<ClientGroup> const groups_;        // Client groups
@@ -685,9 +711,47 @@ private:
     size_t const numVehicles_;
     size_t const numLoadDimensions_;
     bool const hasTimeWindows_;
+    bool const hardTimeWindows_;
+    bool const tightenTimeWindows_;
+
+    // Vehicle types dominating each vehicle type.
+    std::vector<std::vector<size_t>> dominators_;
+
+    // Compatible arcs between all locations, in row-major order. Only
+    // computed with hard time windows.
+    std::vector<bool> compatibleArcs_;
+
+    // Tightens the time windows in clients_ to the earliest and latest service
+    // starts that the vehicle types reaching each client allow. Clients that
+    // are unchanged from the given previous data, which must have the same
+    // depots and vehicle types, keep their windows unless their travel rows
+    // or columns changed, or those of a depot did.
+    void tightenClientWindows(ProblemData const *previous,
+                              std::vector<bool> const &travelChanged);
+
+    // Computes compatibleArcs_ from the (tightened) client time windows. With
+    // previous data, only the arcs of clients whose windows or travel rows or
+    // columns changed are recomputed.
+    void computeCompatibleArcs(ProblemData const *previous,
+                               std::vector<bool> const &travelChanged);
+
+    // The given previous data, if any, has the same depots, vehicle types and
+    // number of locations. Locations whose travel rows or columns differ from
+    // it are listed in changedTravel.
+    ProblemData(SharedClients clients,
+                std::vector<Depot> depots,
+                std::vector<VehicleType> vehicleTypes,
+                std::vector<SharedMatrix<Distance>> distMats,
+                std::vector<SharedMatrix<Duration>> durMats,
+                std::vector<ClientGroup> groups,
+                std::vector<SameVehicleGroup> sameVehicleGroups,
+                bool hardTimeWindows,
+                bool tightenTimeWindows,
+                ProblemData const *previous = nullptr,
+                std::vector<size_t> const &changedTravel = {});
 
 public:
-    bool operator==(ProblemData const &other) const = default;
+    bool operator==(ProblemData const &other) const;
 
     /**
      * Returns location data for the location at the given index. This can
@@ -702,9 +766,30 @@ public:
     [[nodiscard]] inline Location location(size_t idx) const;
 
     /**
-     * Returns a list of all clients in the problem instance.
+     * Returns a list of all clients in the problem instance. With time window
+     * tightening, their windows are tightened to the service starts that the
+     * vehicle types can actually achieve; see :meth:`~original_clients` for
+     * the clients as given.
+     *
+     * .. note::
+     *
+     *    This returns a read-only view of clients that are shared with other
+     *    instances. No client is copied.
+     */
+    [[nodiscard]] inline auto clients() const;
+
+    /**
+     * Returns a list of all clients in the problem instance, with the time
+     * windows they were given. With time window tightening, a client's window
+     * is tightened when a vehicle cannot arrive before its shift starts plus
+     * the travel duration from the start depot, or must leave it too late to
+     * return to the end depot before the shift ends. This assumes travel
+     * durations satisfy the triangle inequality. When no vehicle type can
+     * reach the client, or when the tightened window would be empty, its
+     * window is kept. Without tightening, the clients are the same as
+     * :meth:`~clients`, so that the time warp penalty is unaffected.
      */
-    [[nodiscard]] std::vector<Client> const &clients() const;
+    [[nodiscard]] inline auto originalClients() const;
 
     /**
      * Returns a list of all depots in the problem instance.
@@ -732,22 +817,20 @@ public:
      *
      * .. note::
      *
-     *    This method returns a read-only view of the underlying data. No
-     *    matrices are copied, but the resulting data cannot be modified in any
-     *    way!
+     *    This method copies the underlying matrices. Use
+     *    :meth:`~distance_matrix` for a read-only view of a single matrix.
      */
-    [[nodiscard]] std::vector<Matrix<Distance>> const &distanceMatrices() const;
+    [[nodiscard]] std::vector<Matrix<Distance>> distanceMatrices() const;
 
     /**
      * Returns a list of all duration matrices in the problem instance.
      *
      * .. note::
      *
-     *    This method returns a read-only view of the underlying data. No
-     *    matrices are copied, but the resulting data cannot be modified in any
-     *    way!
+     *    This method copies the underlying matrices. Use
+     *    :meth:`~duration_matrix` for a read-only view of a single matrix.
      */
-    [[nodiscard]] std::vector<Matrix<Duration>> const &durationMatrices() const;
+    [[nodiscard]] std::vector<Matrix<Duration>> durationMatrices() const;
 
     /**
      * Center point of all client locations (excluding depots).
@@ -799,7 +882,7 @@ public:
      * profile
      *     Routing profile whose associated distance matrix to retrieve.
      */
-    [[nodiscard]] inline Matrix<Distance> const &
+    [[nodiscard]] inline SharedMatrix<Distance> const &
     distanceMatrix(size_t profile) const;
 
     /**
@@ -817,7 +900,7 @@ public:
      * profile
      *     Routing profile whose associated duration matrix to retrieve.
      */
-    [[nodiscard]] inline Matrix<Duration> const &
+    [[nodiscard]] inline SharedMatrix<Duration> const &
     durationMatrix(size_t profile) const;
 
     /**
@@ -827,6 +910,37 @@ public:
      */
     [[nodiscard]] inline bool hasTimeWindows() const;
 
+    /**
+     * Whether client time windows are hard constraints in this instance.
+     */
+    [[nodiscard]] inline bool hardTimeWindows() const;
+
+    /**
+     * Whether client time windows are tightened in this instance; see
+     * :meth:`~original_clients`.
+     */
+    [[nodiscard]] inline bool tightenTimeWindows() const;
+
+    /**
+     * Returns whether a route may travel directly from one location to the
+     * other without time warp. With hard time windows, an arc between two
+     * clients is incompatible when the earliest possible service start at the
+     * first client, plus its service and the shortest travel duration of any
+     * profile, exceeds the latest possible service start at the second. These
+     * are the time windows of :meth:`~clients`, tightened if enabled. Arcs
+     * from or to depots, and all arcs without hard time windows, are
+     * compatible.
+     *
+     * Parameters
+     * ----------
+     * origin
+     *     Location the arc starts at.
+     * destination
+     *     Location the arc ends at.
+     */
+    [[nodiscard]] inline bool isArcCompatible(size_t origin,
+                                              size_t destination) const;
+
     /**
      * Number of clients in this problem instance.
      */
@@ -863,6 +977,23 @@ public:
      */
     [[nodiscard]] size_t numVehicles() const;
 
+    /**
+     * Returns the vehicle types that dominate the given vehicle type. A type
+     * dominates another if it has the same depots, profile, reload depots,
+     * forbidden windows and name, and is at least as good in all other
+     * respects: no less capacity or maximum reloads, no smaller shift time
+     * window, duration or distance limits, and no higher costs. Any route is
+     * then no more costly with the dominating type. Of several equivalent
+     * types, the one with the lowest index dominates the others.
+     *
+     * Parameters
+     * ----------
+     * vehicle_type
+     *     Vehicle type whose dominating types to retrieve.
+     */
+    [[nodiscard]] std::vector<size_t> const &
+    vehicleTypeDominators(size_t vehicleType) const;
+
     /**
      * Number of routing profiles in this problem instance.
      */
@@ -908,13 +1039,61 @@ public:
         std::optional<std::vector<ClientGroup>> &groups,
         std::optional<std::vector<SameVehicleGroup>> &sameVehicleGroups) const;
 
+    /**
+     * New travel distances or durations of a routing profile, either from the
+     * given location to every location (a row), or from every location to it
+     * (a column).
+     */
+    template <typename T> struct TravelUpdate
+    {
+        size_t profile;
+        size_t location;
+        bool isRow;
+        std::vector<T> values;
+    };
+
+    /**
+     * Returns a new ProblemData instance with the same data as this instance,
+     * except for the given clients and travel rows and columns. Clients are
+     * keyed by their location index. Unlike :meth:`~replace`, the unchanged
+     * clients and matrix entries are shared with this instance rather than
+     * copied, so an update takes time linear in the number of locations.
+     * Travel updates are applied in order, so a later update takes precedence
+     * where a row and column cross.
+     *
+     * .. note::
+     *
+     *    A replacement client must be in the same client group as the client
+     *    it replaces.
+     *
+     * Parameters
+     * ----------
+     * clients
+     *    Pairs of location index and new client data.
+     * distances
+     *    New distance rows and columns.
+     * durations
+     *    New duration rows and columns.
+     *
+     * Returns
+     * -------
+     * ProblemData
+     *    A new ProblemData instance with the updated data.
+     */
+    ProblemData
+    update(std::vector<std::pair<size_t, Client>> const &clients,
+           std::vector<TravelUpdate<Distance>> distances,
+           std::vector<TravelUpdate<Duration>> durations) const;
+
     ProblemData(std::vector<Client> clients,
                 std::vector<Depot> depots,
                 std::vector<VehicleType> vehicleTypes,
                 std::vector<Matrix<Distance>> distMats,
                 std::vector<Matrix<Duration>> durMats,
                 std::vector<ClientGroup> groups = {},
-                std::vector<SameVehicleGroup> sameVehicleGroups = {});
+                std::vector<SameVehicleGroup> sameVehicleGroups = {},
+                bool hardTimeWindows = false,
+                bool tightenTimeWindows = false);
 
     ProblemData() = delete;
 };
@@ -928,22 +1107,46 @@ ProblemData::Location ProblemData::location(size_t idx) const
     assert(idx < numLocations());
     return idx < depots_.size()
                ? Location{.depot = &depots_[idx]}
-               : Location{.client = &clients_[idx - depots_.size()]};
+               : Location{.client = clients_[idx - depots_.size()].get()};
 }
 
-Matrix<Distance> const &ProblemData::distanceMatrix(size_t profile) const
+auto ProblemData::clients() const
+{
+    return std::views::transform(clients_, [](auto const &client) -> auto &
+                                 { return *client; });
+}
+
+auto ProblemData::originalClients() const
+{
+    return std::views::transform(originalClients_,
+                                 [](auto const &client) -> auto &
+                                 { return *client; });
+}
+
+SharedMatrix<Distance> const &ProblemData::distanceMatrix(size_t profile) const
 {
     assert(profile < dists_.size());
     return dists_[profile];
 }
 
-Matrix<Duration> const &ProblemData::durationMatrix(size_t profile) const
+SharedMatrix<Duration> const &ProblemData::durationMatrix(size_t profile) const
 {
     assert(profile < durs_.size());
     return durs_[profile];
 }
 
 bool ProblemData::hasTimeWindows() const { return hasTimeWindows_; }
+
+bool ProblemData::hardTimeWindows() const { return hardTimeWindows_; }
+
+bool ProblemData::tightenTimeWindows() const { return tightenTimeWindows_; }
+
+bool ProblemData::isArcCompatible(size_t origin, size_t destination) const
+{
+    auto const numLocs = depots_.size() + clients_.size();
+    assert(origin < numLocs && destination < numLocs);
+    return !hardTimeWindows_ || compatibleArcs_[origin * numLocs + destination];
+}
 }  // namespace pyvrp
 
 #endif  // PYVRP_PROBLEMDATA_H
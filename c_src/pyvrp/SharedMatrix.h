@@ -0,0 +1,236 @@
+#ifndef PYVRP_SHAREDMATRIX_H
+#define PYVRP_SHAREDMATRIX_H
+
+#include "Matrix.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace pyvrp
+{
+/**
+ * Read-only matrix whose storage is shared between copies. Replacing a single
+ * row or column returns a new matrix that shares this storage, and stores
+ * only the new row or column on top of it: such an update takes O(n) time
+ * and memory, rather than the O(n^2) of copying the matrix. Once the updated
+ * rows and columns make up a sizable part of the matrix, they are folded into
+ * new dense storage, so that lookups stay cheap.
+ */
+template <typename T> class SharedMatrix
+{
+    // Rows and columns that replace those of the dense storage, in order of
+    // their updates. Where a row and column cross, the later update takes
+    // precedence. Each row and column refers to its latest update, as one
+    // plus the index in lines, or zero if it is not updated.
+    struct Patches
+    {
+        std::vector<std::shared_ptr<std::vector<T> const>> lines;
+        std::vector<uint32_t> rowLines;
+        std::vector<uint32_t> colLines;
+    };
+
+    std::shared_ptr<Matrix<T> const> base_;
+    std::shared_ptr<Patches const> patches_;  // null if there are none
+    T const *data_;                           // base_->data()
+    size_t cols_;
+
+    T patched(size_t row, size_t col) const;
+
+    SharedMatrix withLine(size_t idx, std::vector<T> values, bool isRow) const;
+
+public:
+    explicit SharedMatrix(Matrix<T> matrix);
+
+    /**
+     * Compares the contents of the two matrices. Copies of the same matrix
+     * compare equal without looking at their contents.
+     */
+    bool operator==(SharedMatrix const &other) const;
+
+    [[nodiscard]] inline T operator()(size_t row, size_t col) const;
+
+    [[nodiscard]] size_t numRows() const;
+
+    [[nodiscard]] size_t numCols() const;
+
+    /**
+     * Returns the number of row and column updates that are stored on top of
+     * the dense storage.
+     */
+    [[nodiscard]] size_t numPatches() const;
+
+    /**
+     * Returns the dense storage that this matrix shares. This equals the
+     * matrix only if there are no patches.
+     */
+    [[nodiscard]] Matrix<T> const &base() const;
+
+    /**
+     * Returns a dense copy of this matrix.
+     */
+    [[nodiscard]] Matrix<T> dense() const;
+
+    /**
+     * Returns a new matrix with the given row replaced by the given values.
+     */
+    [[nodiscard]] SharedMatrix withRow(size_t row,
+                                       std::vector<T> values) const;
+
+    /**
+     * Returns a new matrix with the given column replaced by the given values.
+     */
+    [[nodiscard]] SharedMatrix withCol(size_t col,
+                                       std::vector<T> values) const;
+};
+
+template <typename T>
+SharedMatrix<T>::SharedMatrix(Matrix<T> matrix)
+    : base_(std::make_shared<Matrix<T> const>(std::move(matrix))),
+      data_(base_->data()),
+      cols_(base_->numCols())
+{
+}
+
+template <typename T>
+bool SharedMatrix<T>::operator==(SharedMatrix const &other) const
+{
+    if (base_ == other.base_ && patches_ == other.patches_)
+        return true;
+
+    if (numRows() != other.numRows() || numCols() != other.numCols())
+        return false;
+
+    for (size_t row = 0; row != numRows(); ++row)
+        for (size_t col = 0; col != numCols(); ++col)
+            if ((*this)(row, col) != other(row, col))
+                return false;
+
+    return true;
+}
+
+template <typename T>
+T SharedMatrix<T>::operator()(size_t row, size_t col) const
+{
+    if (!patches_) [[likely]]
+        return data_[cols_ * row + col];
+
+    return patched(row, col);
+}
+
+template <typename T> T SharedMatrix<T>::patched(size_t row, size_t col) const
+{
+    auto const rowLine = patches_->rowLines[row];
+    auto const colLine = patches_->colLines[col];
+
+    if (rowLine == 0 && colLine == 0)
+        return data_[cols_ * row + col];
+
+    return rowLine > colLine ? (*patches_->lines[rowLine - 1])[col]
+                             : (*patches_->lines[colLine - 1])[row];
+}
+
+template <typename T> size_t SharedMatrix<T>::numRows() const
+{
+    return base_->numRows();
+}
+
+template <typename T> size_t SharedMatrix<T>::numCols() const { return cols_; }
+
+template <typename T> size_t SharedMatrix<T>::numPatches() const
+{
+    return patches_ ? patches_->lines.size() : 0;
+}
+
+template <typename T> Matrix<T> const &SharedMatrix<T>::base() const
+{
+    return *base_;
+}
+
+template <typename T> Matrix<T> SharedMatrix<T>::dense() const
+{
+    auto matrix = *base_;
+    if (!patches_)
+        return matrix;
+
+    // Lines are in order of their updates, so applying them in that order
+    // lets later updates overwrite earlier ones where they cross. Lines that
+    // a later update of the same row or column replaced are skipped.
+    std::vector<size_t> rows(patches_->lines.size(), numRows());
+    std::vector<size_t> cols(patches_->lines.size(), numCols());
+    for (size_t row = 0; row != numRows(); ++row)
+        if (patches_->rowLines[row])
+            rows[patches_->rowLines[row] - 1] = row;
+    for (size_t col = 0; col != numCols(); ++col)
+        if (patches_->colLines[col])
+            cols[patches_->colLines[col] - 1] = col;
+
+    for (size_t idx = 0; idx != patches_->lines.size(); ++idx)
+    {
+        auto const &values = *patches_->lines[idx];
+        if (rows[idx] != numRows())
+            std::copy(values.begin(), values.end(), &matrix(rows[idx], 0));
+        else if (cols[idx] != numCols())
+            for (size_t row = 0; row != numRows(); ++row)
+                matrix(row, cols[idx]) = values[row];
+    }
+
+    return matrix;
+}
+
+template <typename T>
+SharedMatrix<T> SharedMatrix<T>::withRow(size_t row,
+                                         std::vector<T> values) const
+{
+    return withLine(row, std::move(values), true);
+}
+
+template <typename T>
+SharedMatrix<T> SharedMatrix<T>::withCol(size_t col,
+                                         std::vector<T> values) const
+{
+    return withLine(col, std::move(values), false);
+}
+
+template <typename T>
+SharedMatrix<T>
+SharedMatrix<T>::withLine(size_t idx, std::vector<T> values, bool isRow) const
+{
+    if (idx >= (isRow ? numRows() : numCols()))
+        throw std::out_of_range("Row or column index out of range.");
+
+    if (values.size() != (isRow ? numCols() : numRows()))
+        throw std::invalid_argument("Row or column length does not match the "
+                                    "matrix shape.");
+
+    // Folding the updates into dense storage takes O(n^2) time, but happens
+    // at most once every n / 8 updates, so updates take amortised O(n) time.
+    if (8 * (numPatches() + 1) > std::max(numRows(), numCols()))
+    {
+        auto matrix = dense();
+        for (size_t other = 0; other != values.size(); ++other)
+            (isRow ? matrix(idx, other) : matrix(other, idx)) = values[other];
+
+        return SharedMatrix(std::move(matrix));
+    }
+
+    auto patches = patches_ ? std::make_shared<Patches>(*patches_)
+                            : std::make_shared<Patches>(Patches{
+                                  {},
+                                  std::vector<uint32_t>(numRows(), 0),
+                                  std::vector<uint32_t>(numCols(), 0)});
+
+    patches->lines.push_back(
+        std::make_shared<std::vector<T> const>(std::move(values)));
+    auto &lines = isRow ? patches->rowLines : patches->colLines;
+    lines[idx] = patches->lines.size();
+
+    auto matrix = *this;
+    matrix.patches_ = std::move(patches);
+    return matrix;
+}
+}  // namespace pyvrp
+
+#endif  // PYVRP_SHAREDMATRIX_H
@@ -70,6 +70,8 @@ Routes const &Solution::routes() const { return routes_; }
 
 Neighbours const &Solution::neighbours() const { return neighbours_; }
 
+size_t Solution::hash() const { return hash_; }
+
 bool Solution::isFeasible() const
 {
     // clang-format off
@@ -137,6 +139,26 @@ void Solution::makeNeighbours()
         }
 }
 
+void Solution::makeHash()
+{
+    hash_ = 0;
+    for (auto const &route : routes_)
+        for (auto const &trip : route.trips())
+        {
+            if (trip.empty())
+                continue;
+
+            auto prev = trip.startDepot();
+            for (auto const client : trip)
+            {
+                hash_ ^= arcKey(prev, client);
+                prev = client;
+            }
+
+            hash_ ^= arcKey(prev, trip.endDepot());
+        }
+}
+
 bool Solution::operator==(Solution const &other) const
 {
     // clang-format off
@@ -352,6 +374,7 @@ Solution::Solution(ProblemData const &data, std::vector<Route> routes)
         }
 
     makeNeighbours();
+    makeHash();
     evaluate(data);
 }
 
@@ -388,6 +411,7 @@ Solution::Solution(size_t numClients,
       routes_(std::move(routes)),
       neighbours_(std::move(neighbours))
 {
+    makeHash();
 }
 
 std::ostream &operator<<(std::ostream &out, Solution const &sol)
@@ -61,6 +61,7 @@ class Solution
     Duration timeWarp_ = 0;         // Total time warp over all routes
     bool isGroupFeas_ = true;       // Is feasible w.r.t. client groups?
     size_t numSVGViolations_ = 0;   // Number of same-vehicle group violations
+    size_t hash_ = 0;               // Zobrist hash of the arcs in the routes
 
     Routes routes_;
     Neighbours neighbours_;  // client [pred, succ] pairs, null if unassigned
@@ -68,6 +69,9 @@ class Solution
     // Determines the [pred, succ] pairs for assigned clients.
     void makeNeighbours();
 
+    // Determines the hash of the arcs in the routes.
+    void makeHash();
+
     // Evaluates this solution's characteristics.
     void evaluate(ProblemData const &data);
 
@@ -130,6 +134,24 @@ public:
      */
     [[nodiscard]] Neighbours const &neighbours() const;
 
+    /**
+     * Zobrist hash of this solution's arcs: the XOR of :meth:`arc_key` over
+     * all arcs between consecutive visits of each trip, including those from
+     * and to depots. Arcs between two depots (empty trips) are left out.
+     *
+     * Solutions with the same :meth:`neighbours` have the same hash,
+     * regardless of route order. The search solution maintains the same hash
+     * while it is being modified.
+     */
+    [[nodiscard]] size_t hash() const;
+
+    /**
+     * Pseudo-random key of the arc from ``from`` to ``to``, for
+     * :meth:`hash`. Keys are computed rather than stored, so that hashing
+     * needs no table of size quadratic in the number of locations.
+     */
+    [[nodiscard]] static inline size_t arcKey(size_t from, size_t to);
+
     /**
      * Whether this solution is feasible.
      */
@@ -287,6 +309,16 @@ public:
              Routes routes,
              Neighbours neighbours);
 };
+
+size_t Solution::arcKey(size_t from, size_t to)
+{
+    // SplitMix64 finaliser of the arc's (from, to) pair.
+    uint64_t key = (static_cast<uint64_t>(from) << 32) ^ to;
+    key += 0x9e3779b97f4a7c15;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111eb;
+    return static_cast<size_t>(key ^ (key >> 31));
+}
 }  // namespace pyvrp
 
 std::ostream &operator<<(std::ostream &out, pyvrp::Solution const &sol);
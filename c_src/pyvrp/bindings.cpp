@@ -428,14 +428,18 @@ PYBIND11_MODULE(_pyvrp, m)
                       std::vector<Matrix<pyvrp::Distance>>,
                       std::vector<Matrix<pyvrp::Duration>>,
                       std::vector<ProblemData::ClientGroup>,
-                      std::vector<ProblemData::SameVehicleGroup>>(),
+                      std::vector<ProblemData::SameVehicleGroup>,
+                      bool,
+                      bool>(),
              py::arg("clients"),
              py::arg("depots"),
              py::arg("vehicle_types"),
              py::arg("distance_matrices"),
              py::arg("duration_matrices"),
              py::arg("groups") = py::list(),
-             py::arg("same_vehicle_groups") = py::list())
+             py::arg("same_vehicle_groups") = py::list(),
+             py::arg("hard_time_windows") = false,
+             py::arg("tighten_time_windows") = false)
         .def("replace",
              &ProblemData::replace,
              py::arg("clients") = py::none(),
@@ -491,10 +495,24 @@ PYBIND11_MODULE(_pyvrp, m)
             py::arg("idx"),
             py::return_value_policy::reference_internal,
             DOC(pyvrp, ProblemData, location))
-        .def("clients",
-             &ProblemData::clients,
-             py::return_value_policy::reference_internal,
-             DOC(pyvrp, ProblemData, clients))
+        .def(
+            "clients",
+            [](ProblemData const &data)
+            {
+                auto const clients = data.clients();
+                return std::vector<ProblemData::Client>(clients.begin(),
+                                                        clients.end());
+            },
+            DOC(pyvrp, ProblemData, clients))
+        .def(
+            "original_clients",
+            [](ProblemData const &data)
+            {
+                auto const clients = data.originalClients();
+                return std::vector<ProblemData::Client>(clients.begin(),
+                                                        clients.end());
+            },
+            DOC(pyvrp, ProblemData, originalClients))
         .def("depots",
              &ProblemData::depots,
              py::return_value_policy::reference_internal,
@@ -538,29 +556,46 @@ PYBIND11_MODULE(_pyvrp, m)
              py::arg("vehicle_type"),
              py::return_value_policy::reference_internal,
              DOC(pyvrp, ProblemData, vehicleType))
-        .def("distance_matrix",
-             &ProblemData::distanceMatrix,
-             py::arg("profile"),
-             py::return_value_policy::reference_internal,
-             DOC(pyvrp, ProblemData, distanceMatrix))
-        .def("duration_matrix",
-             &ProblemData::durationMatrix,
-             py::arg("profile"),
-             py::return_value_policy::reference_internal,
-             DOC(pyvrp, ProblemData, durationMatrix))
+        .def(
+            "distance_matrix",
+            [](ProblemData const &data, size_t profile)
+            { return data.distanceMatrix(profile).dense(); },
+            py::arg("profile"),
+            DOC(pyvrp, ProblemData, distanceMatrix))
+        .def(
+            "duration_matrix",
+            [](ProblemData const &data, size_t profile)
+            { return data.durationMatrix(profile).dense(); },
+            py::arg("profile"),
+            DOC(pyvrp, ProblemData, durationMatrix))
         .def("has_time_windows",
              &ProblemData::hasTimeWindows,
              DOC(pyvrp, ProblemData, hasTimeWindows))
+        .def_property_readonly("hard_time_windows",
+                               &ProblemData::hardTimeWindows,
+                               DOC(pyvrp, ProblemData, hardTimeWindows))
+        .def_property_readonly("tighten_time_windows",
+                               &ProblemData::tightenTimeWindows,
+                               DOC(pyvrp, ProblemData, tightenTimeWindows))
+        .def("is_arc_compatible",
+             &ProblemData::isArcCompatible,
+             py::arg("origin"),
+             py::arg("destination"),
+             DOC(pyvrp, ProblemData, isArcCompatible))
         .def(py::self == py::self)  // this is __eq__
         .def(py::pickle(
             [](ProblemData const &data) {  // __getstate__
-                return py::make_tuple(data.clients(),
+                auto const clients = data.originalClients();
+                return py::make_tuple(std::vector<ProblemData::Client>(
+                                          clients.begin(), clients.end()),
                                       data.depots(),
                                       data.vehicleTypes(),
                                       data.distanceMatrices(),
                                       data.durationMatrices(),
                                       data.groups(),
-                                      data.sameVehicleGroups());
+                                      data.sameVehicleGroups(),
+                                      data.hardTimeWindows(),
+                                      data.tightenTimeWindows());
             },
             [](py::tuple t) {  // __setstate__
                 using Clients = std::vector<ProblemData::Client>;
@@ -577,7 +612,9 @@ PYBIND11_MODULE(_pyvrp, m)
                                  t[3].cast<DistMats>(),
                                  t[4].cast<DurMats>(),
                                  t[5].cast<Groups>(),
-                                 t[6].cast<SameVehGroups>());
+                                 t[6].cast<SameVehGroups>(),
+                                 t[7].cast<bool>(),
+                                 t[8].cast<bool>());
 
                 return data;
             }));
@@ -35,6 +35,9 @@ template <size_t N, size_t M> class Exchange : public NodeOperator
     // Tests if the segments of U and V are adjacent in the same route
     bool adjacent(Route::Node *U, Route::Node *V) const;
 
+    // Tests if the move creates an arc that is not time window compatible
+    bool createsIncompatibleArc(Route::Node *U, Route::Node *V) const;
+
     // Special case that's applied when M == 0
     Cost evalRelocateMove(Route::Node *U,
                           Route::Node *V,
@@ -51,6 +54,9 @@ public:
                   CostEvaluator const &costEvaluator) override;
 
     void apply(Route::Node *U, Route::Node *V) const override;
+
+    // Relocating U's segment inserts it after V; swapping moves V.
+    bool keepsPrefixOfV() const override { return M == 0; }
 };
 
 template <size_t N, size_t M>
@@ -82,6 +88,26 @@ bool Exchange<N, M>::adjacent(Route::Node *U, Route::Node *V) const
            && (U->idx() + N == V->idx() || V->idx() + M == U->idx());
 }
 
+template <size_t N, size_t M>
+bool Exchange<N, M>::createsIncompatibleArc(Route::Node *U,
+                                            Route::Node *V) const
+{
+    auto const compatible = [&](Route::Node const *from, Route::Node const *to)
+    { return data->isArcCompatible(from->client(), to->client()); };
+
+    auto *uLast = N == 1 ? U : (*U->route())[U->idx() + N - 1];
+
+    if constexpr (M == 0)
+        return !compatible(p(U), n(uLast)) || !compatible(V, U)
+               || !compatible(uLast, n(V));
+    else
+    {
+        auto *vLast = M == 1 ? V : (*V->route())[V->idx() + M - 1];
+        return !compatible(p(U), V) || !compatible(vLast, n(uLast))
+               || !compatible(p(V), U) || !compatible(uLast, n(vLast));
+    }
+}
+
 template <size_t N, size_t M>
 Cost Exchange<N, M>::evalRelocateMove(Route::Node *U,
                                       Route::Node *V,
@@ -212,6 +238,9 @@ Cost Exchange<N, M>::evaluate(Route::Node *U,
         if (U == n(V))
             return 0;
 
+        if (data->hardTimeWindows() && createsIncompatibleArc(U, V))
+            return 0;
+
         return evalRelocateMove(U, V, costEvaluator);
     }
     else
@@ -223,6 +252,9 @@ Cost Exchange<N, M>::evaluate(Route::Node *U,
         if (adjacent(U, V))
             return 0;
 
+        if (data->hardTimeWindows() && createsIncompatibleArc(U, V))
+            return 0;
+
         return evalSwapMove(U, V, costEvaluator);
     }
 }
@@ -12,8 +12,11 @@
 
 using pyvrp::Solution;
 using pyvrp::search::LocalSearch;
+using pyvrp::search::MissingClients;
 using pyvrp::search::NodeOperator;
 using pyvrp::search::RouteOperator;
+using pyvrp::search::ScopedTimer;
+using pyvrp::search::SearchProfile;
 using pyvrp::search::SearchSpace;
 
 pyvrp::Solution LocalSearch::operator()(pyvrp::Solution const &solution,
@@ -24,7 +27,11 @@ pyvrp::Solution LocalSearch::operator()(pyvrp::Solution const &solution,
     loadSolution(solution);
 
     if (!exhaustive)
-        perturbationManager_.perturb(solution_, searchSpace_, costEvaluator);
+    {
+        ScopedTimer timer(timing(SearchProfile::PERTURB));
+        perturbationManager_.perturb(
+            solution_, searchSpace_, costEvaluator, perturbed_);
+    }
 
     markMissingAsPromising();
 
@@ -39,49 +46,52 @@ pyvrp::Solution LocalSearch::operator()(pyvrp::Solution const &solution,
                         + std::chrono::milliseconds(
                             timeout_ms > 0 ? timeout_ms : SAFETY_TIMEOUT_MS);
 
-    static constexpr int MAX_OUTER_ITERS = 15;
-    for (int outerIter = 0; outerIter < MAX_OUTER_ITERS; ++outerIter)
-    {
-        search(costEvaluator);
-
-        // Check timeout after search
-        if (has_timeout_
-            && std::chrono::steady_clock::now() >= timeout_deadline_)
-            break;
+    optimise(costEvaluator);
 
-        auto const numUpdates = numUpdates_;
+    return unloadSolution();
+}
 
-        intensify(costEvaluator);
+pyvrp::Solution LocalSearch::insert(pyvrp::Solution const &solution,
+                                    std::vector<size_t> const &clients,
+                                    CostEvaluator const &costEvaluator,
+                                    int64_t timeout_ms)
+{
+    loadSolution(solution);
 
-        // Check timeout after intensify
-        if (has_timeout_
-            && std::chrono::steady_clock::now() >= timeout_deadline_)
-            break;
+    // Only the new clients and their neighbourhoods are worth searching: the
+    // rest of the plan was locally optimal before these clients arrived. Route
+    // pairs are only re-tested once one of their routes has been modified.
+    searchSpace_.unmarkAllPromising();
+    std::fill(lastTestedRoutes.begin(), lastTestedRoutes.end(), 0);
 
-        if (numUpdates_ == numUpdates)
-            // Then intensify (route search) did not do any additional
-            // updates, so the solution is locally optimal.
-            break;
-    }
+    static constexpr int64_t SAFETY_TIMEOUT_MS = 5000;
+    has_timeout_ = true;
+    timeout_deadline_ = std::chrono::steady_clock::now()
+                        + std::chrono::milliseconds(
+                            timeout_ms > 0 ? timeout_ms : SAFETY_TIMEOUT_MS);
 
-    // Re-insert unassigned prize clients as multi-trip after ILS
-    // perturbation may have dismantled multi-trip structures.
-    improveWithMultiTrip(costEvaluator);
+    for (auto const client : clients)
+    {
+        if (client < data->numDepots() || client >= data->numLocations())
+            throw std::out_of_range("Client index out of range.");
 
-    // Strip clients from trips where forbidden window delays push
-    // service past tw_late.
-    stripForbiddenWindowViolations();
+        auto *U = &solution_.nodes[client];
+        if (!U->route() && !searchSpace_.isLocked(client))
+        {
+            ProblemData::Client const &uData = data->location(client);
+            auto const required = uData.required;
+            if (solution_.insert(U, searchSpace_, costEvaluator, required))
+                update(U->route(), U->route());
+        }
 
-    // Re-insert stripped clients: stripFW may remove clients from bad
-    // trip orderings (e.g. C4 first), but improveWithMultiTrip can
-    // insert them at earlier trip boundaries in the correct time order.
-    improveWithMultiTrip(costEvaluator, true);  // skip feasibility
+        searchSpace_.markPromising(client);
+        for (auto const vClient : searchSpace_.neighboursOf(client))
+            searchSpace_.markPromising(vClient);
+    }
 
-    // Last resort: if any route with forbidden windows is still
-    // infeasible, strip non-required clients until feasible.
-    stripInfeasibleForbiddenWindowClients();
+    optimise(costEvaluator);
 
-    return solution_.unload();
+    return unloadSolution();
 }
 
 pyvrp::Solution LocalSearch::search(pyvrp::Solution const &solution,
@@ -126,7 +136,7 @@ pyvrp::Solution LocalSearch::search(pyvrp::Solution const &solution,
     // infeasible, strip non-required clients until feasible.
     stripInfeasibleForbiddenWindowClients();
 
-    return solution_.unload();
+    return unloadSolution();
 }
 
 pyvrp::Solution LocalSearch::intensify(pyvrp::Solution const &solution,
@@ -134,11 +144,58 @@ pyvrp::Solution LocalSearch::intensify(pyvrp::Solution const &solution,
 {
     loadSolution(solution);
     intensify(costEvaluator);
-    return solution_.unload();
+    return unloadSolution();
+}
+
+void LocalSearch::optimise(CostEvaluator const &costEvaluator)
+{
+    static constexpr int MAX_OUTER_ITERS = 15;
+    for (int outerIter = 0; outerIter < MAX_OUTER_ITERS; ++outerIter)
+    {
+        search(costEvaluator);
+
+        // Check timeout after search
+        if (has_timeout_
+            && std::chrono::steady_clock::now() >= timeout_deadline_)
+            break;
+
+        auto const numUpdates = numUpdates_;
+
+        intensify(costEvaluator);
+
+        // Check timeout after intensify
+        if (has_timeout_
+            && std::chrono::steady_clock::now() >= timeout_deadline_)
+            break;
+
+        if (numUpdates_ == numUpdates)
+            // Then intensify (route search) did not do any additional
+            // updates, so the solution is locally optimal.
+            break;
+    }
+
+    // Re-insert unassigned prize clients as multi-trip after ILS
+    // perturbation may have dismantled multi-trip structures.
+    improveWithMultiTrip(costEvaluator);
+
+    // Strip clients from trips where forbidden window delays push
+    // service past tw_late.
+    stripForbiddenWindowViolations();
+
+    // Re-insert stripped clients: stripFW may remove clients from bad
+    // trip orderings (e.g. C4 first), but improveWithMultiTrip can
+    // insert them at earlier trip boundaries in the correct time order.
+    improveWithMultiTrip(costEvaluator, true);  // skip feasibility
+
+    // Last resort: if any route with forbidden windows is still
+    // infeasible, strip non-required clients until feasible.
+    stripInfeasibleForbiddenWindowClients();
 }
 
 void LocalSearch::search(CostEvaluator const &costEvaluator)
 {
+    ScopedTimer timer(timing(SearchProfile::SEARCH));
+
     if (nodeOps.empty())
         return;
 
@@ -161,7 +218,10 @@ void LocalSearch::search(CostEvaluator const &costEvaluator)
         // Node operators are evaluated for neighbouring (U, V) pairs.
         for (auto const uClient : searchSpace_.clientOrder())
         {
-            if (!searchSpace_.isPromising(uClient))
+            // Locked clients are frozen in place, so there are no moves
+            // involving them that need to be evaluated.
+            if (!searchSpace_.isPromising(uClient)
+                || searchSpace_.isLocked(uClient))
                 continue;
 
             auto *U = &solution_.nodes[uClient];
@@ -201,7 +261,10 @@ void LocalSearch::search(CostEvaluator const &costEvaluator)
             {
                 auto *V = &solution_.nodes[vClient];
 
-                if (!V->route())
+                // Moves may not change the arcs of a locked prefix, so a
+                // locked V is only of use as the end of its prefix, after
+                // which U may be inserted. See applyNodeOps.
+                if (!V->route() || !searchSpace_.isInsertableAfter(V))
                     continue;
 
                 if (lastUpdated[U->route()->idx()] > lastTested
@@ -211,6 +274,7 @@ void LocalSearch::search(CostEvaluator const &costEvaluator)
                         continue;
 
                     if (p(V)->isStartDepot()
+                        && searchSpace_.isInsertableAfter(p(V))
                         && applyNodeOps(U, p(V), costEvaluator))
                         continue;
                 }
@@ -226,6 +290,8 @@ void LocalSearch::search(CostEvaluator const &costEvaluator)
 
 void LocalSearch::intensify(CostEvaluator const &costEvaluator)
 {
+    ScopedTimer timer(timing(SearchProfile::INTENSIFY));
+
     if (routeOps.empty())
         return;
 
@@ -278,6 +344,11 @@ void LocalSearch::shuffle(RandomNumberGenerator &rng)
     rng.shuffle(routeOps.begin(), routeOps.end());
 }
 
+bool LocalSearch::hasLockedPrefix(Route const *route) const
+{
+    return !route->empty() && searchSpace_.isLocked((*route)[1]->client());
+}
+
 bool LocalSearch::isHardToPlace(Route::Node const *U) const
 {
     if (!U->route() || U->isDepot())
@@ -286,16 +357,16 @@ bool LocalSearch::isHardToPlace(Route::Node const *U) const
     // Only meaningful when there are multiple profiles (zone restrictions).
     // With <= 2 profiles every client is equally restricted, so none are
     // "hard to place".
-    if (data.numProfiles() <= 2)
+    if (data->numProfiles() <= 2)
         return false;
 
     auto const client = U->client();
 
     // Count how many distinct profiles can reach this client
     size_t reachableProfiles = 0;
-    for (size_t p = 0; p < data.numProfiles(); ++p)
+    for (size_t p = 0; p < data->numProfiles(); ++p)
     {
-        auto const &distMatrix = data.distanceMatrix(p);
+        auto const &distMatrix = data->distanceMatrix(p);
         // Check from any depot (use first depot as proxy)
         if (distMatrix(0, client) < 1'000'000'000)
             reachableProfiles++;
@@ -312,10 +383,10 @@ bool LocalSearch::wouldViolateForbidden(Route::Node const *U,
     if (!targetRoute || U->isDepot())
         return false;
 
-    auto const profile = data.vehicleType(targetRoute->vehicleType()).profile;
-    auto const &distMatrix = data.distanceMatrix(profile);
+    auto const profile = data->vehicleType(targetRoute->vehicleType()).profile;
+    auto const &distMatrix = data->distanceMatrix(profile);
     auto const startDepot
-        = data.vehicleType(targetRoute->vehicleType()).startDepot;
+        = data->vehicleType(targetRoute->vehicleType()).startDepot;
     return distMatrix(startDepot, U->client()) >= 1'000'000'000;
 }
 
@@ -339,9 +410,9 @@ bool LocalSearch::wouldViolateSameVehicle(Route::Node const *U,
     if (targetRoute)
     {
         auto const *currentName
-            = data.vehicleType(currentRoute->vehicleType()).name;
+            = data->vehicleType(currentRoute->vehicleType()).name;
         auto const *targetName
-            = data.vehicleType(targetRoute->vehicleType()).name;
+            = data->vehicleType(targetRoute->vehicleType()).name;
 
         // If both have the same non-empty name, they represent the same
         // vehicle (possibly with different shifts), so moving is allowed.
@@ -353,7 +424,7 @@ bool LocalSearch::wouldViolateSameVehicle(Route::Node const *U,
     // Check each same-vehicle group U belongs to.
     for (auto const groupIdx : groups)
     {
-        auto const &group = data.sameVehicleGroup(groupIdx);
+        auto const &group = data->sameVehicleGroup(groupIdx);
 
         for (auto const otherClient : group)
         {
@@ -410,9 +481,20 @@ bool LocalSearch::applyNodeOps(Route::Node *U,
             return false;
     }
 
+    // V is locked only if it ends a locked prefix. Then only operators that
+    // keep V and the visits before it in place leave the prefix intact.
+    auto const vLocked = !V->isDepot() && searchSpace_.isLocked(V->client());
+
     for (auto *nodeOp : nodeOps)
     {
-        auto const deltaCost = nodeOp->evaluate(U, V, costEvaluator);
+        if (vLocked && !nodeOp->keepsPrefixOfV())
+            continue;
+
+        auto const deltaCost = [&]
+        {
+            ScopedTimer timer(timing(nodeOp));
+            return nodeOp->evaluate(U, V, costEvaluator);
+        }();
         if (deltaCost < 0)
         {
             // For operators that swap entire tails (SwapTails/2-OPT*),
@@ -457,9 +539,18 @@ bool LocalSearch::applyRouteOps(Route *U,
                                 Route *V,
                                 CostEvaluator const &costEvaluator)
 {
+    auto const locked = hasLockedPrefix(U) || hasLockedPrefix(V);
+
     for (auto *routeOp : routeOps)
     {
-        auto const deltaCost = routeOp->evaluate(U, V, costEvaluator);
+        if (locked && !routeOp->keepsLockedPrefixes())
+            continue;
+
+        auto const deltaCost = [&]
+        {
+            ScopedTimer timer(timing(routeOp));
+            return routeOp->evaluate(U, V, costEvaluator);
+        }();
         if (deltaCost < 0)
         {
             [[maybe_unused]] auto const costBefore
@@ -494,14 +585,14 @@ void LocalSearch::applyDepotRemovalMove(Route::Node *U,
     // DurationSegment-based cost evaluation can't account for the
     // forbidden delay that would be reintroduced, causing an
     // insert-remove oscillation that runs until timeout.
-    auto const &vehType = data.vehicleType(U->route()->vehicleType());
+    auto const &vehType = data->vehicleType(U->route()->vehicleType());
     if (!vehType.forbiddenWindows.empty())
         return;
 
     // We remove the depot when that's either better, or neutral. It can be
     // neutral if for example it's the same depot visited consecutively, but
     // that's then unnecessary.
-    if (removeCost(U, data, costEvaluator) <= 0)
+    if (removeCost(U, *data, costEvaluator) <= 0)
     {
         searchSpace_.markPromising(U);  // U's neighbours might not be depots
         auto *route = U->route();
@@ -519,7 +610,7 @@ void LocalSearch::applySameVehicleRepair(Route::Node *U,
 
     for (auto const groupIdx : groups)
     {
-        auto const &group = data.sameVehicleGroup(groupIdx);
+        auto const &group = data->sameVehicleGroup(groupIdx);
         for (auto const otherClient : group)
         {
             if (otherClient == U->client())
@@ -533,9 +624,9 @@ void LocalSearch::applySameVehicleRepair(Route::Node *U,
             // shifts), the SVG constraint is already satisfied.
             {
                 auto const *uName
-                    = data.vehicleType(U->route()->vehicleType()).name;
+                    = data->vehicleType(U->route()->vehicleType()).name;
                 auto const *vName
-                    = data.vehicleType(V->route()->vehicleType()).name;
+                    = data->vehicleType(V->route()->vehicleType()).name;
                 if (uName && vName && uName[0] != '\0'
                     && std::strcmp(uName, vName) == 0)
                     continue;
@@ -551,7 +642,7 @@ void LocalSearch::applySameVehicleRepair(Route::Node *U,
                 continue;
 
             // Cost of removing U from its current route
-            Cost remCost = removeCost(U, data, costEvaluator);
+            Cost remCost = removeCost(U, *data, costEvaluator);
 
             // Find best insertion position on V's route (exclude end depot)
             Cost bestIns = std::numeric_limits<Cost>::max();
@@ -559,7 +650,10 @@ void LocalSearch::applySameVehicleRepair(Route::Node *U,
             for (size_t idx = 0; idx + 1 < rV->size(); ++idx)
             {
                 auto *pos = rV->operator[](idx);
-                auto cost = insertCost(U, pos, data, costEvaluator);
+                if (!searchSpace_.isInsertableAfter(pos))
+                    continue;
+
+                auto cost = insertCost(U, pos, *data, costEvaluator);
                 if (cost < bestIns)
                 {
                     bestIns = cost;
@@ -602,7 +696,7 @@ bool LocalSearch::wouldTailSwapSplitSVG(Route::Node const *U,
 
         for (auto const groupIdx : clientToSameVehicleGroups_[node->client()])
         {
-            for (auto const partner : data.sameVehicleGroup(groupIdx))
+            for (auto const partner : data->sameVehicleGroup(groupIdx))
             {
                 if (partner == node->client())
                     continue;
@@ -622,7 +716,7 @@ bool LocalSearch::wouldTailSwapSplitSVG(Route::Node const *U,
 
         for (auto const groupIdx : clientToSameVehicleGroups_[node->client()])
         {
-            for (auto const partner : data.sameVehicleGroup(groupIdx))
+            for (auto const partner : data->sameVehicleGroup(groupIdx))
             {
                 if (partner == node->client())
                     continue;
@@ -647,8 +741,12 @@ void LocalSearch::applyEmptyRouteMoves(Route::Node *U,
     // costs but possibly high variable costs.
     for (auto const &[vehType, offset] : searchSpace_.vehTypeOrder())
     {
+        // An empty route of a dominating vehicle type is at least as good.
+        if (solution_.hasDominatingEmptyRoute(vehType))
+            continue;
+
         auto const begin = solution_.routes.begin() + offset;
-        auto const end = begin + data.vehicleType(vehType).numAvailable;
+        auto const end = begin + data->vehicleType(vehType).numAvailable;
         auto const pred = [](auto const &route) { return route.empty(); };
         auto empty = std::find_if(begin, end, pred);
 
@@ -660,7 +758,7 @@ void LocalSearch::applyEmptyRouteMoves(Route::Node *U,
 void LocalSearch::applyOptionalClientMoves(Route::Node *U,
                                            CostEvaluator const &costEvaluator)
 {
-    ProblemData::Client const &uData = data.location(U->client());
+    ProblemData::Client const &uData = data->location(U->client());
 
     if (uData.required && !U->route())  // then we must insert U
     {
@@ -681,11 +779,11 @@ void LocalSearch::applyOptionalClientMoves(Route::Node *U,
     // U is zone-restricted to very few vehicles (removing would likely leave
     // it unassigned since reinsertion options are severely limited).
     if (!wouldViolateSameVehicle(U, nullptr) && !isHardToPlace(U)
-        && removeCost(U, data, costEvaluator) < 0)  // remove if improving
+        && removeCost(U, *data, costEvaluator) < 0)  // remove if improving
     {
         searchSpace_.markPromising(U);
         auto *route = U->route();
-        auto const &vt = data.vehicleType(route->vehicleType());
+        auto const &vt = data->vehicleType(route->vehicleType());
 
         route->remove(U->idx());
         update(route, route);
@@ -719,14 +817,14 @@ void LocalSearch::applyOptionalClientMoves(Route::Node *U,
         auto *V = &solution_.nodes[vClient];
         auto *route = V->route();
 
-        if (!route)
+        if (!route || searchSpace_.isLocked(vClient))
             continue;
 
-        ProblemData::Client const &vData = data.location(V->client());
+        ProblemData::Client const &vData = data->location(V->client());
 
         // Check same-vehicle constraint for V before removing it.
         if (!vData.required && !wouldViolateSameVehicle(V, nullptr)
-            && inplaceCost(U, V, data, costEvaluator) < 0)
+            && inplaceCost(U, V, *data, costEvaluator) < 0)
         {
             searchSpace_.markPromising(V);
             auto const idx = V->idx();
@@ -742,19 +840,27 @@ void LocalSearch::applyOptionalClientMoves(Route::Node *U,
 void LocalSearch::applyGroupMoves(Route::Node *U,
                                   CostEvaluator const &costEvaluator)
 {
-    ProblemData::Client const &uData = data.location(U->client());
+    ProblemData::Client const &uData = data->location(U->client());
 
     if (!uData.group)
         return;
 
-    auto const &group = data.group(*uData.group);
+    auto const &group = data->group(*uData.group);
     assert(group.mutuallyExclusive);
 
-    std::vector<size_t> inSol;
+    auto &inSol = groupInSol_;
+    inSol.clear();
     auto const pred
         = [&](auto client) { return solution_.nodes[client].route(); };
     std::copy_if(group.begin(), group.end(), std::back_inserter(inSol), pred);
 
+    // Locked members can neither be removed nor swapped out, so there is
+    // nothing to evaluate for this group.
+    auto const isLocked
+        = [&](auto client) { return searchSpace_.isLocked(client); };
+    if (std::any_of(inSol.begin(), inSol.end(), isLocked))
+        return;
+
     if (inSol.empty())
     {
         auto const required = group.required;
@@ -769,15 +875,17 @@ void LocalSearch::applyGroupMoves(Route::Node *U,
 
     // We remove clients in order of increasing cost delta (biggest improvement
     // first), and evaluate swapping the last client with U.
-    std::vector<Cost> costs;
+    auto &costs = groupCosts_;
+    costs.clear();
     for (auto const client : inSol)
     {
-        auto cost = removeCost(&solution_.nodes[client], data, costEvaluator);
+        auto cost = removeCost(&solution_.nodes[client], *data, costEvaluator);
         costs.push_back(cost);
     }
 
     // Sort clients in order of increasing removal costs.
-    std::vector<size_t> range(inSol.size());
+    auto &range = groupOrder_;
+    range.resize(inSol.size());
     std::iota(range.begin(), range.end(), 0);
     std::sort(range.begin(),
               range.end(),
@@ -798,7 +906,7 @@ void LocalSearch::applyGroupMoves(Route::Node *U,
 
     // Test swapping U and V, and do so if U is better to have than V.
     auto *V = &solution_.nodes[inSol[range.back()]];
-    if (U != V && inplaceCost(U, V, data, costEvaluator) < 0)
+    if (U != V && inplaceCost(U, V, *data, costEvaluator) < 0)
     {
         auto *route = V->route();
         auto const idx = V->idx();
@@ -814,10 +922,10 @@ void LocalSearch::insertConstrainedFirst(CostEvaluator const &costEvaluator)
     // Phase 1: Insert same-vehicle group members together on a jointly
     // reachable route. This ensures SVG feasibility from the start —
     // the search's wouldViolateSameVehicle check will then maintain it.
-    for (size_t groupIdx = 0; groupIdx < data.numSameVehicleGroups();
+    for (size_t groupIdx = 0; groupIdx < data->numSameVehicleGroups();
          ++groupIdx)
     {
-        auto const &group = data.sameVehicleGroup(groupIdx);
+        auto const &group = data->sameVehicleGroup(groupIdx);
 
         // Skip if any member is already placed
         bool anyPlaced = false;
@@ -830,10 +938,10 @@ void LocalSearch::insertConstrainedFirst(CostEvaluator const &costEvaluator)
         // Find a route reachable by ALL group members
         for (auto &route : solution_.routes)
         {
-            auto const profile = data.vehicleType(route.vehicleType()).profile;
-            auto const &distMatrix = data.distanceMatrix(profile);
+            auto const profile = data->vehicleType(route.vehicleType()).profile;
+            auto const &distMatrix = data->distanceMatrix(profile);
             auto const startDepot
-                = data.vehicleType(route.vehicleType()).startDepot;
+                = data->vehicleType(route.vehicleType()).startDepot;
 
             bool allReachable = true;
             for (auto const client : group)
@@ -853,7 +961,7 @@ void LocalSearch::insertConstrainedFirst(CostEvaluator const &costEvaluator)
             // windows). If not, skip — inserting would create infeasible
             // time warp that the local search can't fix (since SVG
             // members can't be removed individually).
-            auto const &vehType = data.vehicleType(route.vehicleType());
+            auto const &vehType = data->vehicleType(route.vehicleType());
             Duration availableTime = vehType.twLate - vehType.twEarly;
             for (auto const &[fStart, fEnd] : vehType.forbiddenWindows)
                 availableTime -= (fEnd - fStart);
@@ -861,7 +969,7 @@ void LocalSearch::insertConstrainedFirst(CostEvaluator const &costEvaluator)
             Duration totalService = 0;
             for (auto const client : group)
             {
-                ProblemData::Client const &cl = data.location(client);
+                ProblemData::Client const &cl = data->location(client);
                 totalService += cl.serviceDuration;
             }
 
@@ -881,8 +989,9 @@ void LocalSearch::insertConstrainedFirst(CostEvaluator const &costEvaluator)
     }
 
     // Phase 2: Insert zone-restricted clients (few reachable routes).
-    std::vector<std::pair<size_t, size_t>> clientReach;
-    for (auto client = data.numDepots(); client != data.numLocations();
+    auto &clientReach = clientReach_;
+    clientReach.clear();
+    for (auto client = data->numDepots(); client != data->numLocations();
          ++client)
     {
         if (solution_.nodes[client].route())
@@ -891,10 +1000,10 @@ void LocalSearch::insertConstrainedFirst(CostEvaluator const &costEvaluator)
         size_t reachable = 0;
         for (auto const &route : solution_.routes)
         {
-            auto const profile = data.vehicleType(route.vehicleType()).profile;
-            auto const &distMatrix = data.distanceMatrix(profile);
+            auto const profile = data->vehicleType(route.vehicleType()).profile;
+            auto const &distMatrix = data->distanceMatrix(profile);
             auto const startDepot
-                = data.vehicleType(route.vehicleType()).startDepot;
+                = data->vehicleType(route.vehicleType()).startDepot;
             if (distMatrix(startDepot, client) < 1'000'000'000)
                 reachable++;
         }
@@ -921,42 +1030,34 @@ void LocalSearch::insertConstrainedFirst(CostEvaluator const &costEvaluator)
 
 void LocalSearch::markMissingAsPromising()
 {
-    for (auto client = data.numDepots(); client != data.numLocations();
-         ++client)
-    {
-        if (solution_.nodes[client].route())  // then it's not missing, so
-            continue;                         // nothing to do
-
-        ProblemData::Client const &clientData = data.location(client);
-        if (clientData.required)
-        {
-            searchSpace_.markPromising(client);
-            continue;
-        }
-
-        // Mark unassigned prize clients as promising so the search considers
-        // inserting them even when perturbation didn't reach them.
-        if (clientData.prize > 0)
-        {
-            searchSpace_.markPromising(client);
-            continue;
-        }
-
-        if (clientData.group)  // mark the group's first client as promising so
-        {                      // the group at least gets inserted if needed
-            auto const &group = data.group(clientData.group.value());
-            if (group.required && group.clients().front() == client)
-            {
-                searchSpace_.markPromising(client);
-                continue;
-            }
-        }
-    }
+    auto const &missing = solution_.missing;
+    auto const mark
+        = [&](size_t client) { searchSpace_.markPromising(client); };
+
+    // Required clients must be inserted. Unassigned prize clients are marked
+    // as well, so the search considers inserting them even when perturbation
+    // didn't reach them.
+    missing.forEach(MissingClients::REQUIRED, mark);
+    missing.forEach(MissingClients::PRIZE, mark);
+
+    // Mark the first client of each required group as promising, so the
+    // group at least gets inserted if needed.
+    missing.forEach(MissingClients::GROUP,
+                    [&](size_t client)
+                    {
+                        ProblemData::Client const &clientData
+                            = data->location(client);
+                        auto const &group = data->group(*clientData.group);
+                        if (group.required && group.clients().front() == client)
+                            mark(client);
+                    });
 }
 
 void LocalSearch::repairForbiddenWindowRoutes(
     [[maybe_unused]] CostEvaluator const &costEvaluator)
 {
+    ScopedTimer timer(timing(SearchProfile::REPAIR_FW));
+
     // For routes with forbidden window time warp, move clients whose service
     // overlaps the forbidden window to a new trip.  One-time, non-iterative.
     for (auto &route : solution_.routes)
@@ -964,7 +1065,7 @@ void LocalSearch::repairForbiddenWindowRoutes(
         if (route.empty() || route.timeWarp() == 0)
             continue;
 
-        auto const &vehType = data.vehicleType(route.vehicleType());
+        auto const &vehType = data->vehicleType(route.vehicleType());
         if (vehType.forbiddenWindows.empty() || vehType.reloadDepots.empty())
             continue;
         if (route.numTrips() >= route.maxTrips())
@@ -973,10 +1074,11 @@ void LocalSearch::repairForbiddenWindowRoutes(
         // Walk the route timeline to find clients whose service crosses
         // the first forbidden window.
         auto const fStart = vehType.forbiddenWindows[0].first;
-        auto const &durations = data.durationMatrix(vehType.profile);
+        auto const &durations = data->durationMatrix(vehType.profile);
 
         Duration now = vehType.twEarly;
-        std::vector<size_t> lateClients;
+        auto &lateClients = lateClients_;
+        lateClients.clear();
 
         for (size_t idx = 0; idx < route.size(); ++idx)
         {
@@ -990,11 +1092,11 @@ void LocalSearch::repairForbiddenWindowRoutes(
             if (node->isDepot() || node->isReloadDepot())
                 continue;
 
-            ProblemData::Client const &cl = data.location(node->client());
+            ProblemData::Client const &cl = data->location(node->client());
             auto const wait = cl.twEarly > now ? cl.twEarly - now : Duration(0);
             auto const serviceEnd = now + wait + cl.serviceDuration;
 
-            if (serviceEnd > fStart)
+            if (serviceEnd > fStart && !searchSpace_.isLocked(node->client()))
                 lateClients.push_back(node->client());
 
             now = serviceEnd;
@@ -1024,7 +1126,7 @@ void LocalSearch::repairForbiddenWindowRoutes(
         Duration lateService = 0;
         for (auto client : lateClients)
         {
-            ProblemData::Client const &cl = data.location(client);
+            ProblemData::Client const &cl = data->location(client);
             lateService += cl.serviceDuration;
         }
 
@@ -1065,6 +1167,8 @@ void LocalSearch::repairForbiddenWindowRoutes(
 void LocalSearch::improveWithMultiTrip(
     [[maybe_unused]] CostEvaluator const &costEvaluator, bool skipFeasibility)
 {
+    ScopedTimer timer(timing(SearchProfile::MULTI_TRIP));
+
     // This function tries to insert unassigned clients with prizes by creating
     // new trips. Unlike the main local search insert logic, this is a one-time
     // pass that won't cause infinite loops.
@@ -1075,29 +1179,14 @@ void LocalSearch::improveWithMultiTrip(
     // 3. Estimate if adding a new trip is beneficial (prize vs travel cost)
     // 4. If yes, insert the client as a new trip
     //
-    // Sort by tw_early so clients with earlier time windows are inserted
-    // first.  New trips are appended at the route end, so inserting in
-    // time order avoids "can't arrive in time" rejections.
-    std::vector<size_t> candidates;
-    for (auto client = data.numDepots(); client != data.numLocations();
-         ++client)
-    {
-        auto *U = &solution_.nodes[client];
-        if (U->route())
-            continue;
-        ProblemData::Client const &cd = data.location(client);
-        if (cd.prize > 0)
-            candidates.push_back(client);
-    }
-
-    std::sort(candidates.begin(),
-              candidates.end(),
-              [&](size_t a, size_t b) -> bool
-              {
-                  ProblemData::Client const &ca = data.location(a);
-                  ProblemData::Client const &cb = data.location(b);
-                  return ca.twEarly.get() < cb.twEarly.get();
-              });
+    // Take clients in order of tw_early, so clients with earlier time windows
+    // are inserted first.  New trips are appended at the route end, so
+    // inserting in time order avoids "can't arrive in time" rejections.
+    auto &candidates = candidates_;
+    candidates.clear();
+    solution_.missing.forEach(MissingClients::PRIZE,
+                              [&](size_t client)
+                              { candidates.push_back(client); });
 
     for (auto client : candidates)
     {
@@ -1105,12 +1194,12 @@ void LocalSearch::improveWithMultiTrip(
         if (U->route())  // already assigned (by earlier iteration)
             continue;
 
-        ProblemData::Client const &clientData = data.location(client);
+        ProblemData::Client const &clientData = data->location(client);
 
         // Skip if a mutually exclusive group member is already assigned.
         if (clientData.group)
         {
-            auto const &group = data.group(*clientData.group);
+            auto const &group = data->group(*clientData.group);
             if (group.mutuallyExclusive)
             {
                 bool skip = false;
@@ -1136,7 +1225,7 @@ void LocalSearch::improveWithMultiTrip(
             if (route.empty())
                 continue;
 
-            auto const &vehType = data.vehicleType(route.vehicleType());
+            auto const &vehType = data->vehicleType(route.vehicleType());
 
             // Check if multi-trip is available
             if (vehType.reloadDepots.empty())
@@ -1154,7 +1243,7 @@ void LocalSearch::improveWithMultiTrip(
             // Check if client fits alone in a trip
             bool clientFits = true;
             for (size_t d = 0;
-                 d < data.numLoadDimensions() && d < vehType.capacity.size();
+                 d < data->numLoadDimensions() && d < vehType.capacity.size();
                  ++d)
             {
                 Load clientDemand = 0;
@@ -1177,8 +1266,8 @@ void LocalSearch::improveWithMultiTrip(
             // Estimate the cost of adding a new trip
             auto const reloadDepot = vehType.reloadDepots[0];
             auto const profile = vehType.profile;
-            auto const &distMatrix = data.distanceMatrix(profile);
-            auto const &durMatrix = data.durationMatrix(profile);
+            auto const &distMatrix = data->distanceMatrix(profile);
+            auto const &durMatrix = data->durationMatrix(profile);
 
             auto const dist = distMatrix(reloadDepot, client)
                               + distMatrix(client, reloadDepot);
@@ -1192,10 +1281,10 @@ void LocalSearch::improveWithMultiTrip(
             if (shiftDuration < std::numeric_limits<Duration>::max())
             {
                 Duration reloadTime = 0;
-                if (reloadDepot < data.numDepots())
+                if (reloadDepot < data->numDepots())
                 {
                     ProblemData::Depot const &depot
-                        = data.location(reloadDepot);
+                        = data->location(reloadDepot);
                     reloadTime = depot.serviceDuration;
                 }
 
@@ -1220,10 +1309,10 @@ void LocalSearch::improveWithMultiTrip(
         // Fall back to the end if no earlier position works.
         if (bestRoute && bestCost < 0)
         {
-            auto const &vehType = data.vehicleType(bestRoute->vehicleType());
+            auto const &vehType = data->vehicleType(bestRoute->vehicleType());
             auto const reloadDepot = vehType.reloadDepots[0];
             auto const profile = vehType.profile;
-            auto const &durMatrix = data.durationMatrix(profile);
+            auto const &durMatrix = data->durationMatrix(profile);
 
             // Default: insert at end
             size_t insertIdx = bestRoute->size() - 1;
@@ -1237,7 +1326,8 @@ void LocalSearch::improveWithMultiTrip(
                 Duration arrive
                     = vehType.twEarly + durMatrix(vehType.startDepot, client);
                 arrive = advancePastForbidden(arrive, vehType.forbiddenWindows);
-                if (arrive <= clientData.twLate)
+                if (arrive <= clientData.twLate
+                    && searchSpace_.isInsertableAfter((*bestRoute)[0]))
                     canInsertAtBeginning = true;
             }
 
@@ -1261,7 +1351,7 @@ void LocalSearch::improveWithMultiTrip(
                     if (node->isReloadDepot())
                     {
                         ProblemData::Depot const &dp
-                            = data.location(node->client());
+                            = data->location(node->client());
                         depart += dp.serviceDuration;
                         depart = advancePastForbidden(depart,
                                                       vehType.forbiddenWindows);
@@ -1269,7 +1359,9 @@ void LocalSearch::improveWithMultiTrip(
                     Duration arrive
                         = depart + durMatrix(node->client(), client);
 
-                    if (arrive <= clientData.twLate)
+                    auto const *prev = (*bestRoute)[idx - 1];
+                    if (arrive <= clientData.twLate
+                        && searchSpace_.isInsertableAfter(prev))
                     {
                         insertIdx = idx;
                         foundBoundary = true;
@@ -1280,7 +1372,7 @@ void LocalSearch::improveWithMultiTrip(
                 if (!node->isDepot() && !node->isReloadDepot())
                 {
                     ProblemData::Client const &cl
-                        = data.location(node->client());
+                        = data->location(node->client());
                     auto const wait
                         = cl.twEarly > now ? cl.twEarly - now : Duration(0);
                     now += wait + cl.serviceDuration;
@@ -1288,7 +1380,7 @@ void LocalSearch::improveWithMultiTrip(
                 else if (node->isReloadDepot())
                 {
                     ProblemData::Depot const &dp
-                        = data.location(node->client());
+                        = data->location(node->client());
                     now += dp.serviceDuration;
                     now = advancePastForbidden(now, vehType.forbiddenWindows);
                 }
@@ -1343,12 +1435,14 @@ void LocalSearch::improveWithMultiTrip(
 
 void LocalSearch::stripForbiddenWindowViolations()
 {
+    ScopedTimer timer(timing(SearchProfile::STRIP_FW));
+
     for (auto &route : solution_.routes)
     {
         if (route.empty())
             continue;
 
-        auto const &vehType = data.vehicleType(route.vehicleType());
+        auto const &vehType = data->vehicleType(route.vehicleType());
         if (vehType.forbiddenWindows.empty())
             continue;
 
@@ -1356,10 +1450,11 @@ void LocalSearch::stripForbiddenWindowViolations()
         // exceeds tw_late after accounting for forbidden window delays.
         // We always check (not gated on timeWarp) because the DS-based
         // timeWarp doesn't account for FW delays pushing past tw_late.
-        auto const &durations = data.durationMatrix(vehType.profile);
+        auto const &durations = data->durationMatrix(vehType.profile);
         Duration now = vehType.twEarly;
 
-        std::vector<size_t> toRemove;
+        auto &toRemove = toRemove_;
+        toRemove.clear();
 
         for (size_t idx = 0; idx < route.size(); ++idx)
         {
@@ -1374,7 +1469,7 @@ void LocalSearch::stripForbiddenWindowViolations()
                 if (node->isReloadDepot())
                 {
                     ProblemData::Depot const &depot
-                        = data.location(node->client());
+                        = data->location(node->client());
                     now += depot.serviceDuration;
                     now = advancePastForbidden(now, vehType.forbiddenWindows);
 
@@ -1388,7 +1483,7 @@ void LocalSearch::stripForbiddenWindowViolations()
                                                       route[idx + 1]->client());
                         auto const arrive = now + travel;
                         ProblemData::Client const &next
-                            = data.location(route[idx + 1]->client());
+                            = data->location(route[idx + 1]->client());
                         auto const svcStart = std::max(arrive, next.twEarly);
                         auto const svcEnd = svcStart + next.serviceDuration;
 
@@ -1407,12 +1502,13 @@ void LocalSearch::stripForbiddenWindowViolations()
                 continue;
             }
 
-            ProblemData::Client const &cl = data.location(node->client());
+            ProblemData::Client const &cl = data->location(node->client());
             auto const wait = cl.twEarly > now ? cl.twEarly - now : Duration(0);
             now += wait;
 
             auto const serviceEnd = now + cl.serviceDuration;
-            if (serviceEnd > vehType.twLate && !cl.required)
+            if (serviceEnd > vehType.twLate && !cl.required
+                && !searchSpace_.isLocked(node->client()))
                 toRemove.push_back(node->client());
 
             now = serviceEnd;
@@ -1460,12 +1556,14 @@ void LocalSearch::stripForbiddenWindowViolations()
 
 void LocalSearch::stripInfeasibleForbiddenWindowClients()
 {
+    ScopedTimer timer(timing(SearchProfile::STRIP_INFEASIBLE_FW));
+
     for (auto &route : solution_.routes)
     {
         if (route.empty() || route.isFeasible())
             continue;
 
-        auto const &vehType = data.vehicleType(route.vehicleType());
+        auto const &vehType = data->vehicleType(route.vehicleType());
         if (vehType.forbiddenWindows.empty())
             continue;
 
@@ -1477,7 +1575,7 @@ void LocalSearch::stripInfeasibleForbiddenWindowClients()
         {
             changed = false;
 
-            auto const &durations = data.durationMatrix(vehType.profile);
+            auto const &durations = data->durationMatrix(vehType.profile);
             Duration now = vehType.twEarly;
             size_t worstClient = 0;
             Duration worstOverlap = 0;
@@ -1495,7 +1593,7 @@ void LocalSearch::stripInfeasibleForbiddenWindowClients()
                     if (node->isReloadDepot())
                     {
                         ProblemData::Depot const &dp
-                            = data.location(node->client());
+                            = data->location(node->client());
                         now += dp.serviceDuration;
                         now = advancePastForbidden(now,
                                                    vehType.forbiddenWindows);
@@ -1503,8 +1601,8 @@ void LocalSearch::stripInfeasibleForbiddenWindowClients()
                     continue;
                 }
 
-                ProblemData::Client const &cl = data.location(node->client());
-                if (cl.required)
+                ProblemData::Client const &cl = data->location(node->client());
+                if (cl.required || searchSpace_.isLocked(node->client()))
                 {
                     auto const wait
                         = cl.twEarly > now ? cl.twEarly - now : Duration(0);
@@ -1599,6 +1697,8 @@ void LocalSearch::update(Route *U, Route *V)
 
 void LocalSearch::loadSolution(pyvrp::Solution const &solution)
 {
+    ScopedTimer timer(timing(SearchProfile::LOAD));
+
     std::fill(lastTestedNodes.begin(), lastTestedNodes.end(), -1);
     std::fill(lastTestedRoutes.begin(), lastTestedRoutes.end(), -1);
     std::fill(lastUpdated.begin(), lastUpdated.end(), 0);
@@ -1614,14 +1714,48 @@ void LocalSearch::loadSolution(pyvrp::Solution const &solution)
         routeOp->init(solution);
 }
 
+pyvrp::Solution LocalSearch::unloadSolution()
+{
+    ScopedTimer timer(timing(SearchProfile::UNLOAD));
+    return solution_.unload();
+}
+
+SearchProfile::Timing *LocalSearch::timing(SearchProfile::Phase phase)
+{
+    return profiling_ ? &profile_.phases[phase] : nullptr;
+}
+
+SearchProfile::Timing *LocalSearch::timing(NodeOperator const *op)
+{
+    if (!profiling_)
+        return nullptr;
+
+    auto const it = std::find(addedNodeOps_.begin(), addedNodeOps_.end(), op);
+    return &profile_.nodeOperators[it - addedNodeOps_.begin()];
+}
+
+SearchProfile::Timing *LocalSearch::timing(RouteOperator const *op)
+{
+    if (!profiling_)
+        return nullptr;
+
+    auto const it = std::find(addedRouteOps_.begin(), addedRouteOps_.end(), op);
+    return &profile_.routeOperators[it - addedRouteOps_.begin()];
+}
+
 void LocalSearch::addNodeOperator(NodeOperator &op)
 {
     nodeOps.emplace_back(&op);
+    addedNodeOps_.emplace_back(&op);
+    profile_.nodeOperators.emplace_back();
 }
 
 void LocalSearch::addRouteOperator(RouteOperator &op)
 {
+    op.setSearchSpace(searchSpace_);
     routeOps.emplace_back(&op);
+    addedRouteOps_.emplace_back(&op);
+    profile_.routeOperators.emplace_back();
 }
 
 std::vector<NodeOperator *> const &LocalSearch::nodeOperators() const
@@ -1634,9 +1768,34 @@ std::vector<RouteOperator *> const &LocalSearch::routeOperators() const
     return routeOps;
 }
 
+void LocalSearch::setLocked(std::vector<size_t> const &clients)
+{
+    searchSpace_.setLocked(clients);
+}
+
 void LocalSearch::setNeighbours(SearchSpace::Neighbours neighbours)
 {
-    searchSpace_.setNeighbours(neighbours);
+    searchSpace_.setNeighbours(std::move(neighbours));
+}
+
+void LocalSearch::setData(ProblemData const &data,
+                          SearchSpace::Neighbours neighbours)
+{
+    if (data.numLocations() != this->data->numLocations()
+        || data.numVehicleTypes() != this->data->numVehicleTypes()
+        || data.numVehicles() != this->data->numVehicles())
+        throw std::invalid_argument("Data dimensions do not match.");
+
+    searchSpace_.setNeighbours(std::move(neighbours));
+
+    this->data = &data;
+    solution_.setData(data);
+
+    for (auto *op : nodeOps)
+        op->setData(data);
+
+    for (auto *op : routeOps)
+        op->setData(data);
 }
 
 SearchSpace::Neighbours const &LocalSearch::neighbours() const
@@ -1663,17 +1822,36 @@ LocalSearch::Statistics LocalSearch::statistics() const
     return {numMoves, numImproving, numUpdates_};
 }
 
+void LocalSearch::setProfiling(bool enabled) { profiling_ = enabled; }
+
+pyvrp::search::SearchProfile const &LocalSearch::profile() const
+{
+    return profile_;
+}
+
+void LocalSearch::resetProfile()
+{
+    profile_.phases = {};
+
+    for (auto &opTiming : profile_.nodeOperators)
+        opTiming = {};
+
+    for (auto &opTiming : profile_.routeOperators)
+        opTiming = {};
+}
+
 LocalSearch::LocalSearch(ProblemData const &data,
                          SearchSpace::Neighbours neighbours,
                          PerturbationManager &perturbationManager)
-    : data(data),
+    : data(&data),
       solution_(data),
       searchSpace_(data, neighbours),
       perturbationManager_(perturbationManager),
       lastTestedNodes(data.numLocations()),
       lastTestedRoutes(data.numVehicles()),
       lastUpdated(data.numVehicles()),
-      clientToSameVehicleGroups_(data.numLocations())
+      clientToSameVehicleGroups_(data.numLocations()),
+      perturbed_(data.numLocations())
 {
     // Build client-to-same-vehicle-groups lookup for efficient constraint
     // checking during local search.
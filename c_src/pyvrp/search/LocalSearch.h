@@ -2,11 +2,13 @@
 #define PYVRP_SEARCH_LOCALSEARCH_H
 
 #include "CostEvaluator.h"
+#include "DynamicBitset.h"
 #include "LocalSearchOperator.h"
 #include "PerturbationManager.h"
 #include "ProblemData.h"
 #include "RandomNumberGenerator.h"
 #include "Route.h"
+#include "SearchProfile.h"
 #include "SearchSpace.h"
 #include "Solution.h"  // pyvrp::search::Solution
 
@@ -19,7 +21,7 @@ namespace pyvrp::search
 {
 class LocalSearch
 {
-    ProblemData const &data;
+    ProblemData const *data;
 
     // Stores the node-based solution representation used during LS.
     Solution solution_;
@@ -42,6 +44,17 @@ class LocalSearch
     // Maps each client to the same-vehicle groups it belongs to.
     std::vector<std::vector<size_t>> clientToSameVehicleGroups_;
 
+    // Scratch buffers, reused across calls so that the search does not
+    // allocate once they have grown to their working size.
+    std::vector<size_t> groupInSol_;   // group members in the solution
+    std::vector<Cost> groupCosts_;     // removal cost of each such member
+    std::vector<size_t> groupOrder_;   // members by increasing removal cost
+    std::vector<size_t> candidates_;   // multi-trip insertion candidates
+    std::vector<size_t> lateClients_;  // clients late by forbidden windows
+    std::vector<size_t> toRemove_;     // clients to strip from a route
+    std::vector<std::pair<size_t, size_t>> clientReach_;
+    DynamicBitset perturbed_;  // clients touched by perturbation
+
     size_t numUpdates_ = 0;         // modification counter
     bool searchCompleted_ = false;  // No further improving move found?
 
@@ -49,9 +62,26 @@ class LocalSearch
     std::chrono::steady_clock::time_point timeout_deadline_;
     bool has_timeout_ = false;
 
+    // Profiling: time per phase and per operator, while enabled. The operator
+    // timings follow the order in which the operators were added, since the
+    // operator vectors above are shuffled.
+    SearchProfile profile_;
+    std::vector<NodeOperator const *> addedNodeOps_;
+    std::vector<RouteOperator const *> addedRouteOps_;
+    bool profiling_ = false;
+
+    // Returns the timing of the given phase or operator, or nullptr when not
+    // profiling.
+    SearchProfile::Timing *timing(SearchProfile::Phase phase);
+    SearchProfile::Timing *timing(NodeOperator const *op);
+    SearchProfile::Timing *timing(RouteOperator const *op);
+
     // Load an initial solution that we will attempt to improve.
     void loadSolution(pyvrp::Solution const &solution);
 
+    // Exports the currently loaded solution.
+    pyvrp::Solution unloadSolution();
+
     // Tests the node pair (U, V).
     bool applyNodeOps(Route::Node *U,
                       Route::Node *V,
@@ -86,6 +116,9 @@ class LocalSearch
     // Checks if U is hard to place (reachable from very few profiles).
     bool isHardToPlace(Route::Node const *U) const;
 
+    // Checks if the given route starts with a locked prefix.
+    bool hasLockedPrefix(Route const *route) const;
+
     // Tries to unite same-vehicle group members that are on different routes.
     void applySameVehicleRepair(Route::Node *U,
                                 CostEvaluator const &costEvaluator);
@@ -103,6 +136,11 @@ class LocalSearch
     // Performs intensify on the currently loaded solution.
     void intensify(CostEvaluator const &costEvaluator);
 
+    // Alternates search and intensify on the currently loaded solution until
+    // locally optimal or timed out, followed by the multi-trip and forbidden
+    // window post-processing passes.
+    void optimise(CostEvaluator const &costEvaluator);
+
     // Pre-pass for initial solution: inserts most-constrained clients first
     // (fewest reachable routes), ensuring zone-restricted clients get their
     // preferred vehicles before unrestricted clients fill them.
@@ -180,6 +218,17 @@ public:
      */
     std::vector<RouteOperator *> const &routeOperators() const;
 
+    /**
+     * Locks the given clients in place, replacing any existing locks. Locked
+     * clients are not moved or removed by the search, perturbation, or
+     * insertion, and moves that change the arcs between them are rejected.
+     * Clients may still be inserted after the last locked client of a route.
+     * The locked clients of each route must form a prefix of that route, e.g.
+     * the stops a driver has already served. Locks persist across calls; pass
+     * an empty vector to unlock all clients.
+     */
+    void setLocked(std::vector<size_t> const &clients);
+
     /**
      * Set neighbourhood structure to use by the local search. For each client,
      * the neighbourhood structure is a vector of nearby clients. Depots have
@@ -192,11 +241,39 @@ public:
      */
     SearchSpace::Neighbours const &neighbours() const;
 
+    /**
+     * Rebinds the search and its operators to the given data, with the given
+     * neighbourhood structure. The data must have the same locations, depots,
+     * vehicle types and groups as the current data, e.g. a version returned
+     * by ``ProblemData::update()``. This avoids rebuilding the search for a
+     * new version of the data. The data must outlive the search, or the next
+     * call to this function.
+     */
+    void setData(ProblemData const &data, SearchSpace::Neighbours neighbours);
+
     /**
      * Returns search statistics for the currently loaded solution.
      */
     Statistics statistics() const;
 
+    /**
+     * Enables or disables profiling. While enabled, the wall-clock time spent
+     * in each search phase and in each operator's ``evaluate()`` is added to
+     * the profile. Disabled by default; when disabled, the clock is not read.
+     */
+    void setProfiling(bool enabled);
+
+    /**
+     * Returns the profile accumulated since construction or the last call to
+     * ``resetProfile()``, across all calls to the search.
+     */
+    SearchProfile const &profile() const;
+
+    /**
+     * Resets all profile timings to zero.
+     */
+    void resetProfile();
+
     /**
      * Iteratively calls ``search()`` and ``intensify()`` until no further
      * improvements are made.
@@ -206,6 +283,23 @@ public:
                                bool exhaustive = false,
                                int64_t timeout_ms = 0);
 
+    /**
+     * Inserts the given clients into the solution, and then re-optimises only
+     * around them: the inserted clients and their neighbours are marked as
+     * promising, and route pairs are re-tested only once modified. No
+     * perturbation is applied. This is intended for incrementally adding new
+     * clients to an existing, locally optimal solution.
+     *
+     * Clients that are already in the solution are not moved, and locked
+     * clients are not inserted, but their neighbourhoods are searched as well.
+     * This makes it suitable for re-optimising after other changes to the
+     * data, too.
+     */
+    pyvrp::Solution insert(pyvrp::Solution const &solution,
+                           std::vector<size_t> const &clients,
+                           CostEvaluator const &costEvaluator,
+                           int64_t timeout_ms = 0);
+
     /**
      * Performs regular (node-based) local search around the given solution,
      * and returns a new, hopefully improved solution.
@@ -6,6 +6,7 @@
 #include "Measure.h"
 #include "ProblemData.h"
 #include "Route.h"
+#include "SearchSpace.h"
 
 namespace pyvrp::search
 {
@@ -34,7 +35,7 @@ template <typename Arg> class LocalSearchOperator
                   || std::is_same<Arg, Route>::value);
 
 protected:
-    ProblemData const &data;
+    ProblemData const *data;
     mutable OperatorStatistics stats_;
 
 public:
@@ -81,7 +82,22 @@ public:
      */
     virtual bool affectsEntireTail() const { return false; }
 
-    LocalSearchOperator(ProblemData const &data) : data(data) {};
+    /**
+     * Returns whether this operator leaves V and the visits before it in
+     * place, and only changes what follows V. LocalSearch also evaluates such
+     * operators when V is the last client of a locked prefix, since their
+     * moves keep the prefix intact.
+     */
+    virtual bool keepsPrefixOfV() const { return false; }
+
+    /**
+     * Rebinds this operator to the given data, which must have the same
+     * locations, depots and vehicle types as the current data, e.g. a version
+     * returned by ``ProblemData::update()``.
+     */
+    virtual void setData(ProblemData const &data) { this->data = &data; }
+
+    LocalSearchOperator(ProblemData const &data) : data(&data) {};
     virtual ~LocalSearchOperator() = default;
 };
 
@@ -97,7 +113,33 @@ class RouteOperator : public LocalSearchOperator<Route>
 {
     using LocalSearchOperator::LocalSearchOperator;
 
+protected:
+    SearchSpace const *searchSpace_ = nullptr;
+
+    // Returns the last node of the given route's locked prefix, or its start
+    // depot if the route has no locked prefix.
+    Route::Node *prefixEnd(Route *route) const
+    {
+        return searchSpace_ ? searchSpace_->prefixEnd(*route) : (*route)[0];
+    }
+
 public:
+    /**
+     * Sets the search space whose locked clients this operator respects.
+     * LocalSearch calls this when the operator is added.
+     */
+    void setSearchSpace(SearchSpace const &searchSpace)
+    {
+        searchSpace_ = &searchSpace;
+    }
+
+    /**
+     * Returns whether this operator only changes its routes after their
+     * locked prefixes. LocalSearch does not evaluate other operators on
+     * routes that have a locked prefix.
+     */
+    virtual bool keepsLockedPrefixes() const { return false; }
+
     /**
      * Called when a route has been changed. Can be used to update caches, but
      * the implementation should be fast: this is called every time something
@@ -0,0 +1,131 @@
+#ifndef PYVRP_SEARCH_MISSINGCLIENTS_H
+#define PYVRP_SEARCH_MISSINGCLIENTS_H
+
+#include "ProblemData.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace pyvrp::search
+{
+/**
+ * Index of the clients that are not in any route of a search solution. The
+ * solution's routes keep it in sync as clients are inserted and removed.
+ *
+ * Missing clients are tracked in order of increasing ``twEarly``, in separate
+ * sets for required clients, clients with a prize, and group members. A
+ * client can be in more than one of these sets, or in none. Iterating over a
+ * set takes time linear in the number of missing clients in it, plus one step
+ * per 64 clients of the instance.
+ */
+class MissingClients
+{
+public:
+    enum Kind : size_t
+    {
+        REQUIRED,  // required clients
+        PRIZE,     // clients with a positive prize
+        GROUP,     // members of a client group
+        NUM_KINDS
+    };
+
+private:
+    static constexpr size_t BLOCK_SIZE = 64;
+
+    std::vector<size_t> byRank_;  // clients in order of increasing twEarly
+    std::vector<size_t> rank_;    // index into byRank_, for each location
+    std::vector<uint8_t> kinds_;  // bit mask of kinds, for each location
+
+    // Missing clients of each kind, as bitsets over the ranks.
+    std::array<std::vector<uint64_t>, NUM_KINDS> sets_;
+
+public:
+    /**
+     * Marks the given client as missing.
+     */
+    inline void insert(size_t client);
+
+    /**
+     * Marks the given client as no longer missing.
+     */
+    inline void erase(size_t client);
+
+    /**
+     * Calls ``fn(client)`` for each missing client of the given kind, in order
+     * of increasing ``twEarly``. Ties are broken by client index.
+     */
+    template <typename Fn> void forEach(Kind kind, Fn &&fn) const;
+
+    /**
+     * Creates the index with all clients missing.
+     */
+    explicit MissingClients(ProblemData const &data);
+};
+
+void MissingClients::insert(size_t client)
+{
+    auto const rank = rank_[client];
+    for (size_t kind = 0; kind != NUM_KINDS; ++kind)
+        if (kinds_[client] & (1 << kind))
+            sets_[kind][rank / BLOCK_SIZE] |= uint64_t(1) << rank % BLOCK_SIZE;
+}
+
+void MissingClients::erase(size_t client)
+{
+    auto const rank = rank_[client];
+    for (size_t kind = 0; kind != NUM_KINDS; ++kind)
+        if (kinds_[client] & (1 << kind))
+            sets_[kind][rank / BLOCK_SIZE]
+                &= ~(uint64_t(1) << rank % BLOCK_SIZE);
+}
+
+template <typename Fn> void MissingClients::forEach(Kind kind, Fn &&fn) const
+{
+    auto const &set = sets_[kind];
+    for (size_t block = 0; block != set.size(); ++block)
+        for (auto bits = set[block]; bits; bits &= bits - 1)
+        {
+            auto const rank = block * BLOCK_SIZE + std::countr_zero(bits);
+            fn(byRank_[rank]);
+        }
+}
+
+inline MissingClients::MissingClients(ProblemData const &data)
+    : byRank_(data.numClients()),
+      rank_(data.numLocations()),
+      kinds_(data.numLocations())
+{
+    std::iota(byRank_.begin(), byRank_.end(), data.numDepots());
+    std::stable_sort(byRank_.begin(),
+                     byRank_.end(),
+                     [&](size_t client1, size_t client2)
+                     {
+                         ProblemData::Client const &c1 = data.location(client1);
+                         ProblemData::Client const &c2 = data.location(client2);
+                         return c1.twEarly < c2.twEarly;
+                     });
+
+    auto const numBlocks = (data.numClients() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    for (auto &set : sets_)
+        set.resize(numBlocks);
+
+    for (size_t rank = 0; rank != byRank_.size(); ++rank)
+    {
+        auto const client = byRank_[rank];
+        ProblemData::Client const &clientData = data.location(client);
+
+        rank_[client] = rank;
+        kinds_[client] = (clientData.required << REQUIRED)
+                         | ((clientData.prize > 0) << PRIZE)
+                         | (clientData.group.has_value() << GROUP);
+
+        insert(client);
+    }
+}
+}  // namespace pyvrp::search
+
+#endif  // PYVRP_SEARCH_MISSINGCLIENTS_H
@@ -0,0 +1,180 @@
+#ifndef PYVRP_SEARCH_OROPTREVERSE_H
+#define PYVRP_SEARCH_OROPTREVERSE_H
+
+#include "LocalSearchOperator.h"
+#include "Route.h"
+
+#include <cassert>
+
+namespace pyvrp::search
+{
+/**
+ * OrOptReverse(data: ProblemData)
+ *
+ * The reversing OR-OPT operators move :math:`N` consecutive clients starting
+ * at :math:`U` to directly after :math:`V`, in reverse order. :math:`V` may be
+ * in the same route as :math:`U`, including :math:`V = p(U)`, which reverses
+ * the clients in place. Together with the :math:`(N, 0)`-exchange operators,
+ * which keep the clients in order, these cover both orientations of each
+ * relocated segment.
+ *
+ * The distance of the reversed clients takes constant time in their own
+ * route's profile, also for asymmetric matrices.
+ */
+template <size_t N> class OrOptReverse : public NodeOperator
+{
+    using NodeOperator::NodeOperator;
+
+    static_assert(N > 1, "reversing a single client does not make sense");
+
+    // Tests if the segment starting at U contains a depot.
+    bool containsDepot(Route::Node *U) const;
+
+    // Tests if V is in the segment starting at U.
+    bool overlap(Route::Node *U, Route::Node *V) const;
+
+    // Tests if the move creates an arc that is not time window compatible.
+    bool createsIncompatibleArc(Route::Node *U, Route::Node *V) const;
+
+public:
+    Cost evaluate(Route::Node *U,
+                  Route::Node *V,
+                  CostEvaluator const &costEvaluator) override;
+
+    void apply(Route::Node *U, Route::Node *V) const override;
+
+    bool keepsPrefixOfV() const override { return true; }
+};
+
+template <size_t N>
+bool OrOptReverse<N>::containsDepot(Route::Node *U) const
+{
+    auto const first = U->idx();
+    auto const last = first + N - 1;
+    auto const &route = *U->route();
+
+    return first == 0                            // contains start depot
+           || last >= route.size() - 1           // contains end depot
+           || U->trip() != route[last]->trip();  // contains reload depot
+}
+
+template <size_t N>
+bool OrOptReverse<N>::overlap(Route::Node *U, Route::Node *V) const
+{
+    return U->route() == V->route() && U->idx() <= V->idx()
+           && V->idx() <= U->idx() + N - 1;
+}
+
+template <size_t N>
+bool OrOptReverse<N>::createsIncompatibleArc(Route::Node *U,
+                                             Route::Node *V) const
+{
+    auto const compatible = [&](Route::Node const *from, Route::Node const *to)
+    { return data->isArcCompatible(from->client(), to->client()); };
+
+    auto const &uRoute = *U->route();
+    auto *uLast = uRoute[U->idx() + N - 1];
+
+    if (V == p(U))
+    {
+        if (!compatible(V, uLast) || !compatible(U, n(uLast)))
+            return true;
+    }
+    else if (!compatible(p(U), n(uLast)) || !compatible(V, uLast)
+             || !compatible(U, n(V)))
+        return true;
+
+    // The arcs within the segment are travelled the other way now.
+    for (auto idx = U->idx(); idx != uLast->idx(); ++idx)
+        if (!compatible(uRoute[idx + 1], uRoute[idx]))
+            return true;
+
+    return false;
+}
+
+template <size_t N>
+Cost OrOptReverse<N>::evaluate(Route::Node *U,
+                               Route::Node *V,
+                               CostEvaluator const &costEvaluator)
+{
+    stats_.numEvaluations++;
+
+    if (containsDepot(U) || overlap(U, V))
+        return 0;
+
+    // We cannot easily evaluate across trips, so we cannot determine this move.
+    if (U->route() == V->route() && U->trip() != V->trip())
+        return 0;
+
+    if (data->hardTimeWindows() && createsIncompatibleArc(U, V))
+        return 0;
+
+    Cost deltaCost = 0;
+    auto const *uRoute = U->route();
+    auto const *vRoute = V->route();
+    auto const uLast = U->idx() + N - 1;
+
+    if (uRoute != vRoute)
+    {
+        // We're going to incur V's fixed cost if V is currently empty.
+        if (V->isStartDepot() && vRoute->empty())
+            deltaCost += vRoute->fixedVehicleCost();
+
+        // We lose U's fixed cost if we're moving all U's clients.
+        if (uRoute->numClients() == N)
+            deltaCost -= uRoute->fixedVehicleCost();
+
+        auto const uProposal = Route::Proposal(uRoute->before(U->idx() - 1),
+                                               uRoute->after(uLast + 1));
+
+        auto const vProposal
+            = Route::Proposal(vRoute->before(V->idx()),
+                              uRoute->reversed(U->idx(), uLast),
+                              vRoute->after(V->idx() + 1));
+
+        costEvaluator.deltaCost(deltaCost, uProposal, vProposal);
+    }
+    else if (V == p(U))  // reverse in place
+        costEvaluator.deltaCost(
+            deltaCost,
+            Route::Proposal(uRoute->before(V->idx()),
+                            uRoute->reversed(U->idx(), uLast),
+                            uRoute->after(uLast + 1)));
+    else if (U->idx() < V->idx())
+        costEvaluator.deltaCost(
+            deltaCost,
+            Route::Proposal(uRoute->before(U->idx() - 1),
+                            uRoute->between(uLast + 1, V->idx()),
+                            uRoute->reversed(U->idx(), uLast),
+                            uRoute->after(V->idx() + 1)));
+    else
+        costEvaluator.deltaCost(
+            deltaCost,
+            Route::Proposal(uRoute->before(V->idx()),
+                            uRoute->reversed(U->idx(), uLast),
+                            uRoute->between(V->idx() + 1, U->idx() - 1),
+                            uRoute->after(uLast + 1)));
+
+    return deltaCost;
+}
+
+template <size_t N>
+void OrOptReverse<N>::apply(Route::Node *U, Route::Node *V) const
+{
+    stats_.numApplications++;
+
+    auto &uRoute = *U->route();
+    auto &vRoute = *V->route();
+
+    // Inserting each client directly after V reverses their order.
+    for (size_t count = 0; count != N; ++count)
+    {
+        auto *next = count + 1 == N ? nullptr : n(U);
+        uRoute.remove(U->idx());
+        vRoute.insert(V->idx() + 1, U);
+        U = next;
+    }
+}
+}  // namespace pyvrp::search
+
+#endif  // PYVRP_SEARCH_OROPTREVERSE_H
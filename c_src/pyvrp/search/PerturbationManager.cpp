@@ -4,6 +4,7 @@
 #include <cassert>
 #include <stdexcept>
 
+using pyvrp::DynamicBitset;
 using pyvrp::search::PerturbationManager;
 using pyvrp::search::PerturbationParams;
 using pyvrp::search::Route;
@@ -45,6 +46,15 @@ void PerturbationManager::shuffle(RandomNumberGenerator &rng)
 void PerturbationManager::perturb(Solution &solution,
                                   SearchSpace &searchSpace,
                                   CostEvaluator const &costEvaluator) const
+{
+    DynamicBitset perturbed = {solution.nodes.size()};
+    perturb(solution, searchSpace, costEvaluator, perturbed);
+}
+
+void PerturbationManager::perturb(Solution &solution,
+                                  SearchSpace &searchSpace,
+                                  CostEvaluator const &costEvaluator,
+                                  DynamicBitset &perturbed) const
 {
     size_t movesLeft = numPerturbations_;
 
@@ -55,12 +65,16 @@ void PerturbationManager::perturb(Solution &solution,
     // set of promising nodes for further (local search) improvement.
     searchSpace.unmarkAllPromising();
 
-    DynamicBitset perturbed = {solution.nodes.size()};
+    if (perturbed.size() < solution.nodes.size())
+        perturbed = {solution.nodes.size()};
+    else
+        perturbed.reset();
+
     auto const perturb = [&](auto *node, PerturbType action)
     {
-        // This node has already been touched by a previous perturbation, so
-        // we skip it here.
-        if (perturbed[node->client()])
+        // This node has already been touched by a previous perturbation, or
+        // is locked in place, so we skip it here.
+        if (perturbed[node->client()] || searchSpace.isLocked(node->client()))
             return;
 
         // Remove if node is in a route and we are currently removing.
@@ -2,6 +2,7 @@
 #define PYVRP_SEARCH_PERTURBATIONMANAGER_H
 
 #include "CostEvaluator.h"
+#include "DynamicBitset.h"
 #include "RandomNumberGenerator.h"
 #include "SearchSpace.h"
 #include "Solution.h"
@@ -80,6 +81,16 @@ public:
     void perturb(Solution &solution,
                  SearchSpace &searchSpace,
                  CostEvaluator const &costEvaluator) const;
+
+    /**
+     * Same as above, but tracks the perturbed clients in the given bitset
+     * rather than allocating a new one. The bitset is reset first, and is
+     * resized only when it is too small for the solution.
+     */
+    void perturb(Solution &solution,
+                 SearchSpace &searchSpace,
+                 CostEvaluator const &costEvaluator,
+                 DynamicBitset &perturbed) const;
 };
 }  // namespace pyvrp::search
 
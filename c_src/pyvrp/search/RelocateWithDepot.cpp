@@ -2,7 +2,9 @@
 
 #include "Route.h"
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
 using pyvrp::search::RelocateWithDepot;
 
@@ -53,6 +55,76 @@ public:
 };
 }  // namespace
 
+RelocateWithDepot::RelocateWithDepot(ProblemData const &data)
+    : NodeOperator(data)
+{
+    reloadDepots_.reserve(data.numVehicleTypes());
+    for (auto const &vehType : data.vehicleTypes())
+    {
+        auto &depots = reloadDepots_.emplace_back();
+        for (auto const depot : vehType.reloadDepots)
+        {
+            ProblemData::Depot const &depotData = data.location(depot);
+            depots.push_back({0, depotData.reloadCost, depot});
+        }
+    }
+}
+
+std::vector<RelocateWithDepot::Candidate> const &
+RelocateWithDepot::rankDepots(Route const *route, size_t from, size_t to)
+{
+    auto const &vehType = data->vehicleType(route->vehicleType());
+    auto const &distMat = data->distanceMatrix(vehType.profile);
+
+    // The excess distance penalty is not part of the detour cost.
+    bounded_ = route->maxDistance() == std::numeric_limits<Distance>::max();
+
+    candidates_ = reloadDepots_[route->vehicleType()];
+    if (candidates_.size() <= 1)
+        return candidates_;
+
+    for (auto &[detour, reloadCost, depot] : candidates_)
+    {
+        auto const dist = distMat(from, depot) + distMat(depot, to);
+        auto const distCost
+            = vehType.unitDistanceCost * static_cast<Cost>(dist);
+        detour = reloadCost + distCost;
+    }
+
+    std::sort(candidates_.begin(),
+              candidates_.end(),
+              [](auto const &lhs, auto const &rhs)
+              {
+                  if (lhs.detour != rhs.detour)
+                      return lhs.detour < rhs.detour;
+
+                  return lhs.depot < rhs.depot;
+              });
+
+    return candidates_;
+}
+
+template <typename... Proposals>
+bool RelocateWithDepot::evalDepot(Cost deltaCost,
+                                  MoveType type,
+                                  size_t depot,
+                                  CostEvaluator const &costEvaluator,
+                                  Proposals const &...proposals)
+{
+    // The evaluation stops as soon as the delta cost cannot become negative.
+    // Shifting by the best delta cost so far makes it stop as soon as the
+    // move cannot improve on that instead.
+    auto const threshold = std::min<Cost>(move_.cost, 0);
+    deltaCost -= threshold;
+    auto const exact = costEvaluator.deltaCost(deltaCost, proposals...);
+    deltaCost += threshold;
+
+    if (deltaCost < move_.cost)
+        move_ = {deltaCost, type, depot};
+
+    return exact || !bounded_;
+}
+
 void RelocateWithDepot::evalDepotBefore(Cost fixedCost,
                                         Route::Node *U,
                                         Route::Node *V,
@@ -60,55 +132,59 @@ void RelocateWithDepot::evalDepotBefore(Cost fixedCost,
 {
     auto const *uRoute = U->route();
     auto const *vRoute = V->route();
-    auto const &vehType = data.vehicleType(vRoute->vehicleType());
+    auto const &depots = rankDepots(vRoute, V->client(), U->client());
 
     if (uRoute != vRoute)
     {
         auto const uProposal = Route::Proposal(uRoute->before(U->idx() - 1),
                                                uRoute->after(U->idx() + 1));
 
-        for (auto const depot : vehType.reloadDepots)
-        {
-            ProblemData::Depot const &depotData = data.location(depot);
-            auto deltaCost = fixedCost + depotData.reloadCost;
-            costEvaluator.deltaCost(
-                deltaCost,
-                uProposal,
-                Route::Proposal(vRoute->before(V->idx()),
-                                ReloadDepotSegment(data, depot),
-                                uRoute->at(U->idx()),
-                                vRoute->after(V->idx() + 1)));
-
-            if (deltaCost < move_.cost)
-                move_ = {deltaCost, MoveType::DEPOT_U, depot};
-        }
+        for (auto const &[detour, reloadCost, depot] : depots)
+            if (!evalDepot(
+                    fixedCost + reloadCost,
+                    MoveType::DEPOT_U,
+                    depot,
+                    costEvaluator,
+                    uProposal,
+                    Route::Proposal(vRoute->before(V->idx()),
+                                    ReloadDepotSegment(*data, depot),
+                                    uRoute->at(U->idx()),
+                                    vRoute->after(V->idx() + 1))))
+                break;
     }
     else  // within same route
     {
         auto const *route = vRoute;
-        for (auto const depot : vehType.reloadDepots)
+        for (auto const &[detour, reloadCost, depot] : depots)
         {
-            ProblemData::Depot const &depotData = data.location(depot);
-            auto deltaCost = fixedCost + depotData.reloadCost;
-            if (U->idx() < V->idx())
-                costEvaluator.deltaCost(
-                    deltaCost,
-                    Route::Proposal(route->before(U->idx() - 1),
-                                    route->between(U->idx() + 1, V->idx()),
-                                    ReloadDepotSegment(data, depot),
-                                    route->at(U->idx()),
-                                    route->after(V->idx() + 1)));
-            else
-                costEvaluator.deltaCost(
-                    deltaCost,
-                    Route::Proposal(route->before(V->idx()),
-                                    ReloadDepotSegment(data, depot),
-                                    route->at(U->idx()),
-                                    route->between(V->idx() + 1, U->idx() - 1),
-                                    route->after(U->idx() + 1)));
-
-            if (deltaCost < move_.cost)
-                move_ = {deltaCost, MoveType::DEPOT_U, depot};
+            auto const deltaCost = fixedCost + reloadCost;
+            auto const exact
+                = U->idx() < V->idx()
+                      ? evalDepot(
+                            deltaCost,
+                            MoveType::DEPOT_U,
+                            depot,
+                            costEvaluator,
+                            Route::Proposal(
+                                route->before(U->idx() - 1),
+                                route->between(U->idx() + 1, V->idx()),
+                                ReloadDepotSegment(*data, depot),
+                                route->at(U->idx()),
+                                route->after(V->idx() + 1)))
+                      : evalDepot(
+                            deltaCost,
+                            MoveType::DEPOT_U,
+                            depot,
+                            costEvaluator,
+                            Route::Proposal(
+                                route->before(V->idx()),
+                                ReloadDepotSegment(*data, depot),
+                                route->at(U->idx()),
+                                route->between(V->idx() + 1, U->idx() - 1),
+                                route->after(U->idx() + 1)));
+
+            if (!exact)
+                break;
         }
     }
 }
@@ -120,55 +196,59 @@ void RelocateWithDepot::evalDepotAfter(Cost fixedCost,
 {
     auto const *uRoute = U->route();
     auto const *vRoute = V->route();
-    auto const &vehType = data.vehicleType(vRoute->vehicleType());
+    auto const &depots = rankDepots(vRoute, U->client(), n(V)->client());
 
     if (uRoute != vRoute)
     {
         auto const uProposal = Route::Proposal(uRoute->before(U->idx() - 1),
                                                uRoute->after(U->idx() + 1));
 
-        for (auto const depot : vehType.reloadDepots)
-        {
-            ProblemData::Depot const &depotData = data.location(depot);
-            Cost deltaCost = fixedCost + depotData.reloadCost;
-            costEvaluator.deltaCost(
-                deltaCost,
-                uProposal,
-                Route::Proposal(vRoute->before(V->idx()),
-                                uRoute->at(U->idx()),
-                                ReloadDepotSegment(data, depot),
-                                vRoute->after(V->idx() + 1)));
-
-            if (deltaCost < move_.cost)
-                move_ = {deltaCost, MoveType::U_DEPOT, depot};
-        }
+        for (auto const &[detour, reloadCost, depot] : depots)
+            if (!evalDepot(
+                    fixedCost + reloadCost,
+                    MoveType::U_DEPOT,
+                    depot,
+                    costEvaluator,
+                    uProposal,
+                    Route::Proposal(vRoute->before(V->idx()),
+                                    uRoute->at(U->idx()),
+                                    ReloadDepotSegment(*data, depot),
+                                    vRoute->after(V->idx() + 1))))
+                break;
     }
     else  // within same route
     {
         auto const *route = vRoute;
-        for (auto const depot : vehType.reloadDepots)
+        for (auto const &[detour, reloadCost, depot] : depots)
         {
-            ProblemData::Depot const &depotData = data.location(depot);
-            Cost deltaCost = fixedCost + depotData.reloadCost;
-            if (U->idx() < V->idx())
-                costEvaluator.deltaCost(
-                    deltaCost,
-                    Route::Proposal(route->before(U->idx() - 1),
-                                    route->between(U->idx() + 1, V->idx()),
-                                    route->at(U->idx()),
-                                    ReloadDepotSegment(data, depot),
-                                    route->after(V->idx() + 1)));
-            else
-                costEvaluator.deltaCost(
-                    deltaCost,
-                    Route::Proposal(route->before(V->idx()),
-                                    route->at(U->idx()),
-                                    ReloadDepotSegment(data, depot),
-                                    route->between(V->idx() + 1, U->idx() - 1),
-                                    route->after(U->idx() + 1)));
-
-            if (deltaCost < move_.cost)
-                move_ = {deltaCost, MoveType::U_DEPOT, depot};
+            auto const deltaCost = fixedCost + reloadCost;
+            auto const exact
+                = U->idx() < V->idx()
+                      ? evalDepot(
+                            deltaCost,
+                            MoveType::U_DEPOT,
+                            depot,
+                            costEvaluator,
+                            Route::Proposal(
+                                route->before(U->idx() - 1),
+                                route->between(U->idx() + 1, V->idx()),
+                                route->at(U->idx()),
+                                ReloadDepotSegment(*data, depot),
+                                route->after(V->idx() + 1)))
+                      : evalDepot(
+                            deltaCost,
+                            MoveType::U_DEPOT,
+                            depot,
+                            costEvaluator,
+                            Route::Proposal(
+                                route->before(V->idx()),
+                                route->at(U->idx()),
+                                ReloadDepotSegment(*data, depot),
+                                route->between(V->idx() + 1, U->idx() - 1),
+                                route->after(U->idx() + 1)));
+
+            if (!exact)
+                break;
         }
     }
 }
@@ -180,20 +260,17 @@ void RelocateWithDepot::evalInPlaceDepot(Route::Node *V,
     // Before: ... V -> U ... where U = n(V)
     // After:  ... V -> depot -> U ...
     auto const *route = V->route();
-    auto const &vehType = data.vehicleType(route->vehicleType());
-
-    for (auto const depot : vehType.reloadDepots)
-    {
-        ProblemData::Depot const &depotData = data.location(depot);
-        Cost deltaCost = depotData.reloadCost;
-        costEvaluator.deltaCost(deltaCost,
-                                Route::Proposal(route->before(V->idx()),
-                                                ReloadDepotSegment(data, depot),
-                                                route->after(V->idx() + 1)));
-
-        if (deltaCost < move_.cost)
-            move_ = {deltaCost, MoveType::IN_PLACE, depot};
-    }
+    auto const &depots = rankDepots(route, V->client(), n(V)->client());
+
+    for (auto const &[detour, reloadCost, depot] : depots)
+        if (!evalDepot(reloadCost,
+                       MoveType::IN_PLACE,
+                       depot,
+                       costEvaluator,
+                       Route::Proposal(route->before(V->idx()),
+                                       ReloadDepotSegment(*data, depot),
+                                       route->after(V->idx() + 1))))
+            break;
 }
 
 pyvrp::Cost RelocateWithDepot::evaluate(Route::Node *U,
@@ -3,6 +3,8 @@
 
 #include "LocalSearchOperator.h"
 
+#include <vector>
+
 namespace pyvrp::search
 {
 /**
@@ -12,6 +14,14 @@ namespace pyvrp::search
  * results in an improving move. Concretely, this operator implements the second
  * and third insertion scheme of Francois et al. [1]_.
  *
+ * Reload depots are tried in order of their detour cost between the two
+ * clients they are inserted between. Without a maximum distance, the part of
+ * the delta cost that depends on the depot is exactly this detour cost, so
+ * once a depot cannot improve on the best move found so far, the remaining,
+ * worse-ranked depots are skipped. With a maximum distance, the excess
+ * distance penalty depends on the rest of the route as well, so then all
+ * depots are evaluated.
+ *
  * References
  * ----------
  * .. [1] Francois, V., Y. Arda, and Y. Crama (2019). Adaptive Large
@@ -21,8 +31,6 @@ namespace pyvrp::search
  */
 class RelocateWithDepot : public NodeOperator
 {
-    using NodeOperator::NodeOperator;
-
     enum class MoveType
     {
         DEPOT_U,   // V -> depot -> U (relocate U after V, depot before U)
@@ -37,8 +45,42 @@ class RelocateWithDepot : public NodeOperator
         size_t depot = 0;
     };
 
+    struct Candidate
+    {
+        Cost detour;  // reload cost plus the distance cost of the detour
+        Cost reloadCost;
+        size_t depot;
+    };
+
+    // Per vehicle type, the reload depots and their reload costs.
+    std::vector<std::vector<Candidate>> reloadDepots_;
+
+    // Reload depots ranked by detour cost, reused between evaluations.
+    std::vector<Candidate> candidates_;
+
+    // Whether the ranking bounds the delta costs of worse-ranked depots, so
+    // that those can be skipped.
+    bool bounded_ = true;
+
     Move move_;
 
+    // Ranks the reload depots of the given route's vehicle type by the cost
+    // of the detour from -> depot -> to, cheapest first.
+    std::vector<Candidate> const &
+    rankDepots(Route const *route, size_t from, size_t to);
+
+    // Records the move if it improves on the best move so far. The delta cost
+    // is evaluated relative to that best move, so that depots that cannot
+    // improve on it are cut short. Returns whether worse-ranked depots still
+    // need to be evaluated: false if this evaluation was cut short and the
+    // ranking bounds their delta costs.
+    template <typename... Proposals>
+    bool evalDepot(Cost deltaCost,
+                   MoveType type,
+                   size_t depot,
+                   CostEvaluator const &costEvaluator,
+                   Proposals const &...proposals);
+
     // Evaluates moves where a reload depot is inserted before U, as
     // V -> depot -> U.
     void evalDepotBefore(Cost fixedCost,
@@ -58,11 +100,15 @@ class RelocateWithDepot : public NodeOperator
     void evalInPlaceDepot(Route::Node *V, CostEvaluator const &costEvaluator);
 
 public:
+    RelocateWithDepot(ProblemData const &data);
+
     Cost evaluate(Route::Node *U,
                   Route::Node *V,
                   CostEvaluator const &costEvaluator) override;
 
     void apply(Route::Node *U, Route::Node *V) const override;
+
+    bool keepsPrefixOfV() const override { return true; }
 };
 
 template <> bool supports<RelocateWithDepot>(ProblemData const &data);
@@ -1,4 +1,5 @@
 #include "Route.h"
+#include "../Solution.h"  // pyvrp::Solution::arcKey
 
 #include <cmath>
 #include <numbers>
@@ -23,7 +24,7 @@ void Route::Node::unassign()
     route_ = nullptr;
 }
 
-Route::Iterator::Iterator(std::vector<Node *> const &nodes, size_t idx)
+Route::Iterator::Iterator(std::pmr::vector<Node *> const &nodes, size_t idx)
     : nodes_(&nodes), idx_(idx)
 {
     ensureValidIndex();
@@ -60,16 +61,30 @@ Route::Iterator &Route::Iterator::operator++()
     return *this;
 }
 
-Route::Route(ProblemData const &data, size_t idx, size_t vehicleType)
-    : data(data),
-      vehicleType_(data.vehicleType(vehicleType)),
+Route::Route(ProblemData const &data,
+             size_t idx,
+             size_t vehicleType,
+             std::pmr::memory_resource *resource,
+             MissingClients *missing)
+    : data(&data),
+      vehicleType_(&data.vehicleType(vehicleType)),
       idx_(idx),
+      missing_(missing),
       reloadCost_(0),
-      loadAt(data.numLoadDimensions()),
-      loadAfter(data.numLoadDimensions()),
-      loadBefore(data.numLoadDimensions()),
+      depots_(resource),
+      nodes(resource),
+      visits(resource),
+      cumDist(resource),
+      profileCumDist(data.numProfiles(), resource),
+      reverseCumDist(resource),
+      loadAt(data.numLoadDimensions(), resource),
+      loadAfter(data.numLoadDimensions(), resource),
+      loadBefore(data.numLoadDimensions(), resource),
       load_(data.numLoadDimensions()),
-      excessLoad_(data.numLoadDimensions())
+      excessLoad_(data.numLoadDimensions()),
+      durAt(resource),
+      durAfter(resource),
+      durBefore(resource)
 {
     clear();
 }
@@ -86,17 +101,23 @@ std::pair<pyvrp::Coordinate, pyvrp::Coordinate> const &Route::centroid() const
     return centroid_;
 }
 
+size_t Route::hash() const
+{
+    assert(!dirty);
+    return hash_;
+}
+
 size_t Route::vehicleType() const
 {
-    auto const &vehicleTypes = data.vehicleTypes();
-    return std::distance(&vehicleTypes[0], &vehicleType_);
+    auto const &vehicleTypes = data->vehicleTypes();
+    return std::distance(&vehicleTypes[0], vehicleType_);
 }
 
 bool Route::overlapsWith(Route const &other, double tolerance) const
 {
     assert(!dirty && !other.dirty);
 
-    auto const [dX, dY] = data.centroid();
+    auto const [dX, dY] = data->centroid();
     auto const [tX, tY] = this->centroid_;
     auto const [oX, oY] = other.centroid_;
 
@@ -116,15 +137,23 @@ void Route::clear()
     if (nodes.size() == 2)  // then the route is already empty and we have
         return;             // nothing to do.
 
-    for (auto *node : nodes)        // only unassign if in route; node may not
-        if (node->route() == this)  // be if it's been assigned to another route
-            node->unassign();       // while loading a new solution into the LS
+    // Only unassign nodes that are in this route. A node may not be if it has
+    // been assigned to another route while loading a new solution into the LS.
+    for (auto *node : nodes)
+    {
+        if (node->route() != this)
+            continue;
+
+        node->unassign();
+        if (missing_ && node->client() >= data->numDepots())
+            missing_->insert(node->client());
+    }
 
     nodes.clear();
     depots_.clear();
 
-    depots_.emplace_back(vehicleType_.startDepot);
-    depots_.emplace_back(vehicleType_.endDepot);
+    depots_.emplace_back(vehicleType_->startDepot);
+    depots_.emplace_back(vehicleType_->endDepot);
 
     for (size_t idx : {0, 1})
     {
@@ -136,12 +165,28 @@ void Route::clear()
     assert(empty());
 }
 
-void Route::reserve(size_t size) { nodes.reserve(size); }
+void Route::reserve(size_t size)
+{
+    nodes.reserve(size);
+    visits.reserve(size);
+    cumDist.reserve(size);
+
+    durAt.reserve(size);
+    durAfter.reserve(size);
+    durBefore.reserve(size);
+
+    for (size_t dim = 0; dim != data->numLoadDimensions(); ++dim)
+    {
+        loadAt[dim].reserve(size);
+        loadAfter[dim].reserve(size);
+        loadBefore[dim].reserve(size);
+    }
+}
 
 void Route::insert(size_t idx, Node *node)
 {
     assert(0 < idx && idx < nodes.size());
-    auto const isDepot = node->client() < data.numDepots();
+    auto const isDepot = node->client() < data->numDepots();
 
     if (isDepot)  // is depot, so we need to insert a copy into our own memory
     {
@@ -161,6 +206,9 @@ void Route::insert(size_t idx, Node *node)
     nodes.insert(nodes.begin() + idx, node);
     node->assign(this, idx, nodes[idx - 1]->trip());
 
+    if (missing_ && !isDepot)
+        missing_->erase(node->client());
+
     for (size_t after = idx; after != nodes.size(); ++after)
     {
         nodes[after]->idx_ = after;
@@ -187,8 +235,12 @@ void Route::remove(size_t idx)
             nodes[it->idx()] = &*it;
     }
     else
+    {
         // We do not own this node, so we only unassign it.
         nodes[idx]->unassign();
+        if (missing_)
+            missing_->insert(nodes[idx]->client());
+    }
 
     nodes.erase(nodes.begin() + idx);  // remove dangling pointer
     for (auto after = idx; after != nodes.size(); ++after)
@@ -214,6 +266,18 @@ void Route::swap(Node *first, Node *second)
     if (second->route_)
         second->route_->nodes[second->idx_] = first;
 
+    if (first->route_ && !second->route_ && first->route_->missing_)
+    {
+        first->route_->missing_->insert(first->client());
+        first->route_->missing_->erase(second->client());
+    }
+
+    if (second->route_ && !first->route_ && second->route_->missing_)
+    {
+        second->route_->missing_->insert(second->client());
+        second->route_->missing_->erase(first->client());
+    }
+
     std::swap(first->route_, second->route_);
     std::swap(first->idx_, second->idx_);
     std::swap(first->trip_, second->trip_);
@@ -227,6 +291,18 @@ void Route::swap(Node *first, Node *second)
 #endif
 }
 
+void Route::computeCumDistance(size_t profile) const
+{
+    assert(!dirty);
+    auto const &distMat = data->distanceMatrix(profile);
+
+    auto &dists = profileCumDist[profile];
+    dists.resize(visits.size());
+    dists[0] = 0;
+    for (size_t idx = 1; idx != visits.size(); ++idx)
+        dists[idx] = dists[idx - 1] + distMat(visits[idx - 1], visits[idx]);
+}
+
 void Route::update()
 {
     visits.clear();
@@ -239,30 +315,42 @@ void Route::update()
         if (node->isDepot())
             continue;
 
-        ProblemData::Client const &clientData = data.location(node->client());
+        ProblemData::Client const &clientData = data->location(node->client());
         centroid_.first += static_cast<double>(clientData.x) / numClients();
         centroid_.second += static_cast<double>(clientData.y) / numClients();
     }
 
+    // Hash. Arcs between two depots are left out, like pyvrp::Solution does
+    // for empty trips, so that an empty route hashes to zero.
+    hash_ = 0;
+    for (size_t idx = 1; idx != nodes.size(); ++idx)
+        if (!nodes[idx - 1]->isDepot() || !nodes[idx]->isDepot())
+            hash_ ^= pyvrp::Solution::arcKey(visits[idx - 1], visits[idx]);
+
     // Distance.
-    auto const &distMat = data.distanceMatrix(profile());
+    auto const &distMat = data->distanceMatrix(profile());
 
     cumDist.resize(nodes.size());
     cumDist[0] = 0;
     for (size_t idx = 1; idx != nodes.size(); ++idx)
         cumDist[idx] = cumDist[idx - 1] + distMat(visits[idx - 1], visits[idx]);
 
+    for (auto &dists : profileCumDist)  // keeps the memory for reuse
+        dists.clear();
+
+    reverseCumDist.clear();
+
     // Duration.
     durAt.resize(nodes.size());
 
-    ProblemData::Depot const &start = data.location(startDepot());
-    DurationSegment const vehStart(vehicleType_, vehicleType_.startLate);
+    ProblemData::Depot const &start = data->location(startDepot());
+    DurationSegment const vehStart(*vehicleType_, vehicleType_->startLate);
     DurationSegment const depotStart(start);
     durAt[0] = DurationSegment::merge(0, vehStart, depotStart);
 
-    ProblemData::Depot const &end = data.location(endDepot());
+    ProblemData::Depot const &end = data->location(endDepot());
     DurationSegment const depotEnd(end);
-    DurationSegment const vehEnd(vehicleType_, vehicleType_.twLate);
+    DurationSegment const vehEnd(*vehicleType_, vehicleType_->twLate);
     durAt[nodes.size() - 1] = DurationSegment::merge(0, depotEnd, vehEnd);
 
     for (size_t idx = 1; idx != nodes.size() - 1; ++idx)
@@ -271,13 +359,13 @@ void Route::update()
 
         if (!node->isReloadDepot())
         {
-            ProblemData::Client const &client = data.location(node->client());
+            ProblemData::Client const &client = data->location(node->client());
             durAt[idx] = {client};
         }
         else
         {
             // Reload depot - apply service time
-            ProblemData::Depot const &depot = data.location(node->client());
+            ProblemData::Depot const &depot = data->location(node->client());
             durAt[idx] = DurationSegment(depot.serviceDuration,
                                          0,
                                          0,
@@ -286,7 +374,7 @@ void Route::update()
         }
     }
 
-    auto const &durations = data.durationMatrix(profile());
+    auto const &durations = data->durationMatrix(profile());
 
     durBefore.resize(nodes.size());
     durBefore[0] = durAt[0];
@@ -315,19 +403,19 @@ void Route::update()
     }
 
     // Load.
-    for (size_t dim = 0; dim != data.numLoadDimensions(); ++dim)
+    for (size_t dim = 0; dim != data->numLoadDimensions(); ++dim)
     {
-        auto const capacity = vehicleType_.capacity[dim];
+        auto const capacity = vehicleType_->capacity[dim];
 
         loadAt[dim].resize(nodes.size());
-        loadAt[dim][0] = {vehicleType_, dim};  // initial load
+        loadAt[dim][0] = {*vehicleType_, dim};  // initial load
         loadAt[dim][nodes.size() - 1] = {};
 
         for (size_t idx = 1; idx != nodes.size() - 1; ++idx)
             loadAt[dim][idx]
                 = nodes[idx]->isReloadDepot()
                       ? LoadSegment{}
-                      : LoadSegment{data.location(visits[idx]), dim};
+                      : LoadSegment{data->location(visits[idx]), dim};
 
         loadBefore[dim].resize(nodes.size());
         loadBefore[dim][0] = loadAt[dim][0];
@@ -385,9 +473,9 @@ void Route::update()
     // Violations at non-depot locations (vehicle idle or serving at a client
     // during a forbidden window) are added to timeWarp_ so the solver treats
     // them as hard constraint violations, forcing a depot return.
-    if (!vehicleType_.forbiddenWindows.empty())
+    if (!vehicleType_->forbiddenWindows.empty())
     {
-        auto const &durations = data.durationMatrix(profile());
+        auto const &durations = data->durationMatrix(profile());
         auto now = durAfter[0].startEarly();
         Duration totalForbiddenDelay = 0;
         Duration forbiddenTimeWarp = 0;
@@ -400,7 +488,7 @@ void Route::update()
             // Check forbidden window at every node (client, reload depot,
             // end depot) — not just clients.
             auto const advanced
-                = advancePastForbidden(now, vehicleType_.forbiddenWindows);
+                = advancePastForbidden(now, vehicleType_->forbiddenWindows);
             if (advanced != now)
             {
                 auto const delay = advanced - now;
@@ -412,7 +500,7 @@ void Route::update()
                         // It wasn't at the depot from fStart to now —
                         // violation.
                         for (auto const &[fStart, fEnd] :
-                             vehicleType_.forbiddenWindows)
+                             vehicleType_->forbiddenWindows)
                         {
                             if (now >= fStart && now < fEnd)
                             {
@@ -432,7 +520,7 @@ void Route::update()
             if (!nodes[idx]->isDepot() && !nodes[idx]->isReloadDepot())
             {
                 ProblemData::Client const &client
-                    = data.location(nodes[idx]->client());
+                    = data->location(nodes[idx]->client());
                 auto const arrivalTime = now;
                 auto const wait
                     = client.twEarly > now ? client.twEarly - now : Duration(0);
@@ -442,7 +530,8 @@ void Route::update()
                 // arrivalTime until now (after service).  Any overlap
                 // with a forbidden window is a constraint violation —
                 // the vehicle should be at the depot instead.
-                for (auto const &[fStart, fEnd] : vehicleType_.forbiddenWindows)
+                auto const &forbidden = vehicleType_->forbiddenWindows;
+                for (auto const &[fStart, fEnd] : forbidden)
                 {
                     auto const oStart = std::max(arrivalTime, fStart);
                     auto const oEnd = std::min(now, fEnd);
@@ -453,13 +542,13 @@ void Route::update()
             else if (nodes[idx]->isReloadDepot())
             {
                 ProblemData::Depot const &depot
-                    = data.location(nodes[idx]->client());
+                    = data->location(nodes[idx]->client());
                 now += depot.serviceDuration;
 
                 // After reload service, the vehicle may now be in a
                 // forbidden window.  Wait at the depot until it ends.
                 auto const afterReload
-                    = advancePastForbidden(now, vehicleType_.forbiddenWindows);
+                    = advancePastForbidden(now, vehicleType_->forbiddenWindows);
                 if (afterReload != now)
                 {
                     totalForbiddenDelay += afterReload - now;
@@ -476,12 +565,12 @@ void Route::update()
                     auto const travel = durations(visits[idx], visits[idx + 1]);
                     auto const arrive = now + travel;
                     ProblemData::Client const &next
-                        = data.location(nodes[idx + 1]->client());
+                        = data->location(nodes[idx + 1]->client());
                     auto const svcStart = std::max(arrive, next.twEarly);
                     auto const svcEnd = svcStart + next.serviceDuration;
 
                     for (auto const &[fStart, fEnd] :
-                         vehicleType_.forbiddenWindows)
+                         vehicleType_->forbiddenWindows)
                     {
                         // Vehicle would be at the client during
                         // [fStart, fEnd): arriving/serving overlaps the
@@ -507,11 +596,11 @@ void Route::update()
         // If the delays push the vehicle's end time past twLate, the
         // additional excess must be added to timeWarp_.
         auto const dsEndTime = durAfter[0].startEarly() + durationDS;
-        auto const dsEndExcess = dsEndTime > vehicleType_.twLate
-                                     ? dsEndTime - vehicleType_.twLate
+        auto const dsEndExcess = dsEndTime > vehicleType_->twLate
+                                     ? dsEndTime - vehicleType_->twLate
                                      : Duration(0);
-        auto const actualEndExcess = now > vehicleType_.twLate
-                                         ? now - vehicleType_.twLate
+        auto const actualEndExcess = now > vehicleType_->twLate
+                                         ? now - vehicleType_->twLate
                                          : Duration(0);
         if (actualEndExcess > dsEndExcess)
             timeWarp_ += actualEndExcess - dsEndExcess;
@@ -536,7 +625,7 @@ void Route::update()
         if (nodes[idx]->isReloadDepot())
         {
             ProblemData::Depot const &depot
-                = data.location(nodes[idx]->client());
+                = data->location(nodes[idx]->client());
             reloadCost_ += depot.reloadCost;
         }
     }
@@ -546,6 +635,17 @@ void Route::update()
 #endif
 }
 
+void Route::setData(ProblemData const &data)
+{
+    auto const type = vehicleType();
+    this->data = &data;
+    vehicleType_ = &data.vehicleType(type);
+
+#ifndef NDEBUG
+    dirty = true;
+#endif
+}
+
 bool Route::operator==(Route const &other) const
 {
     assert(!dirty && !other.dirty);
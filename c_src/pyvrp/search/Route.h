@@ -4,12 +4,14 @@
 #include "../Route.h"  // pyvrp::Route
 #include "DurationSegment.h"
 #include "LoadSegment.h"
+#include "MissingClients.h"
 #include "ProblemData.h"
 
 #include <algorithm>
 #include <cassert>
 #include <concepts>
 #include <iosfwd>
+#include <memory_resource>
 #include <utility>
 
 namespace pyvrp::search
@@ -191,7 +193,7 @@ public:
      */
     class Iterator
     {
-        std::vector<Node *> const *nodes_ = nullptr;
+        std::pmr::vector<Node *> const *nodes_ = nullptr;
         size_t idx_ = 0;
 
         // Ensures we skip reload depots.
@@ -202,7 +204,7 @@ public:
         using difference_type = std::ptrdiff_t;
         using value_type = Node *;
 
-        Iterator(std::vector<Node *> const &nodes, size_t idx);
+        Iterator(std::pmr::vector<Node *> const &nodes, size_t idx);
 
         Iterator() = default;
         Iterator(Iterator const &other) = default;
@@ -220,7 +222,7 @@ public:
     };
 
 private:
-    using LoadSegments = std::vector<LoadSegment>;
+    using LoadSegments = std::pmr::vector<LoadSegment>;
 
     /**
      * Class storing data related to the route segment starting at ``start``,
@@ -299,11 +301,44 @@ private:
         inline LoadSegment load(size_t dimension) const;
     };
 
-    ProblemData const &data;
+    /**
+     * Class storing data related to the route segment between ``start`` and
+     * ``end`` (inclusive), visited in reverse: from ``end`` back to
+     * ``start``. The segment must consist of clients of a single trip. Its
+     * distance takes constant time in the route's own profile; its duration
+     * and load are merged visit by visit.
+     */
+    class SegmentReversed
+    {
+        Route const &route_;
+        size_t const start;
+        size_t const end;
 
-    ProblemData::VehicleType const &vehicleType_;
+    public:
+        inline Route const *route() const;
+
+        inline size_t first() const;  // client at end
+        inline size_t last() const;   // client at start
+        inline size_t size() const;
+
+        inline bool startsAtReloadDepot() const;
+        inline bool endsAtReloadDepot() const;
+
+        inline SegmentReversed(Route const &route, size_t start, size_t end);
+        inline Distance distance(size_t profile) const;
+        inline DurationSegment duration(size_t profile) const;
+        inline LoadSegment load(size_t dimension) const;
+    };
+
+    ProblemData const *data;
+
+    ProblemData::VehicleType const *vehicleType_;
     size_t const idx_;
 
+    // Clients that are not in any route, updated as clients enter and leave
+    // this route. May be null.
+    MissingClients *const missing_;
+
     Distance distance_;  // Separately cached cost components
     Cost distanceCost_;
     Distance excessDistance_;
@@ -318,26 +353,51 @@ private:
     Cost durationCostDS_;
     Duration timeWarpDS_;
 
-    std::vector<Node> depots_;  // start, end, and reload depots (in that order)
+    // The vectors below are allocated from the memory resource passed to the
+    // constructor, e.g. the arena of the search solution owning this route.
+    std::pmr::vector<Node> depots_;  // start, end, and reload depots (in order)
 
-    std::vector<Node *> nodes;   // Nodes in this route, including depots
-    std::vector<size_t> visits;  // Locations in this route, incl. depots
+    std::pmr::vector<Node *> nodes;   // Nodes in this route, including depots
+    std::pmr::vector<size_t> visits;  // Locations in this route, incl. depots
     std::pair<Coordinate, Coordinate> centroid_;  // Client center point
+    size_t hash_;  // XOR of the arc keys of this route, see hash()
+
+    std::pmr::vector<Distance> cumDist;  // Dist of start -> node (incl.)
+
+    // Dist of start -> node (incl.) in each of the other profiles, for when
+    // segments of this route are evaluated in another route's profile. These
+    // are computed lazily: update() clears them, and an empty vector has not
+    // been computed since.
+    mutable std::pmr::vector<std::pmr::vector<Distance>> profileCumDist;
 
-    std::vector<Distance> cumDist;  // Dist of start -> node (incl.)
+    // Dist of start -> node (incl.), with each arc travelled in reverse, for
+    // reversed segments. Computed lazily like profileCumDist, so that routes
+    // never searched with a reversing operator do not pay for it.
+    mutable std::pmr::vector<Distance> reverseCumDist;
 
     // Load data, for each load dimension. These vectors form matrices, where
     // the rows index the load dimension, and the columns the nodes.
-    std::vector<LoadSegments> loadAt;      // Load data at each node
-    std::vector<LoadSegments> loadAfter;   // Load of node -> end (incl)
-    std::vector<LoadSegments> loadBefore;  // Load of start -> node (incl)
+    std::pmr::vector<LoadSegments> loadAt;      // Load data at each node
+    std::pmr::vector<LoadSegments> loadAfter;   // Load of node -> end (incl)
+    std::pmr::vector<LoadSegments> loadBefore;  // Load of start -> node (incl)
 
     std::vector<Load> load_;        // Route loads (for each dimension)
     std::vector<Load> excessLoad_;  // Route excess load (for each dimension)
 
-    std::vector<DurationSegment> durAt;      // Duration data at each node
-    std::vector<DurationSegment> durAfter;   // Dur of node -> end (incl.)
-    std::vector<DurationSegment> durBefore;  // Dur of start -> node (incl.)
+    std::pmr::vector<DurationSegment> durAt;      // Duration at each node
+    std::pmr::vector<DurationSegment> durAfter;   // Dur of node -> end (incl)
+    std::pmr::vector<DurationSegment> durBefore;  // Dur of start -> node (incl)
+
+    // Returns the cumulative distances along this route in the given profile.
+    inline std::pmr::vector<Distance> const &cumDistance(size_t profile) const;
+
+    // Computes the cumulative distances along this route in the given
+    // profile, for cumDistance().
+    void computeCumDistance(size_t profile) const;
+
+    // Returns the cumulative reverse distances along this route in its own
+    // profile.
+    inline std::pmr::vector<Distance> const &reverseCumDistance() const;
 
 #ifndef NDEBUG
     // When debug assertions are enabled, we use this flag to check whether
@@ -592,11 +652,25 @@ public:
      */
     [[nodiscard]] inline SegmentBetween between(size_t start, size_t end) const;
 
+    /**
+     * Returns an object that can be queried for data associated with the
+     * segment between [start, end], visited from end to start.
+     */
+    [[nodiscard]] inline SegmentReversed reversed(size_t start,
+                                                  size_t end) const;
+
     /**
      * Center point of the client locations on this route.
      */
     [[nodiscard]] std::pair<Coordinate, Coordinate> const &centroid() const;
 
+    /**
+     * XOR of the keys of the arcs on this route, as in
+     * ``pyvrp::Solution::hash()``, and zero if the route is empty. Updated
+     * with the route's other statistics.
+     */
+    [[nodiscard]] size_t hash() const;
+
     /**
      * @return This route's vehicle type.
      */
@@ -616,7 +690,7 @@ public:
 
     /**
      * Reserves capacity for at least given ``size`` number of nodes (depots
-     * and clients).
+     * and clients), and for the statistics kept for each node.
      */
     void reserve(size_t size);
 
@@ -650,10 +724,22 @@ public:
      */
     void update();
 
+    /**
+     * Rebinds this route to the given data, which must have the same vehicle
+     * types as the current data. The route must be updated before its
+     * statistics are used again.
+     */
+    void setData(ProblemData const &data);
+
     bool operator==(Route const &other) const;
     bool operator==(pyvrp::Route const &other) const;
 
-    Route(ProblemData const &data, size_t idx, size_t vehicleType);
+    Route(ProblemData const &data,
+          size_t idx,
+          size_t vehicleType,
+          std::pmr::memory_resource *resource
+          = std::pmr::get_default_resource(),
+          MissingClients *missing = nullptr);
     ~Route();
 };
 
@@ -714,7 +800,7 @@ bool Route::Node::isReloadDepot() const
 {
     // clang-format off
     return route_
-        && loc_ < route_->data.numDepots()
+        && loc_ < route_->data->numDepots()
         && !isStartDepot()
         && !isEndDepot();
     // clang-format on
@@ -822,23 +908,12 @@ bool Route::SegmentBetween::endsAtReloadDepot() const
 
 Distance Route::SegmentBetween::distance(size_t profile) const
 {
-    if (profile != route_.profile())  // then we have to compute the distance
-    {                                 // segment from scratch.
-        auto const &mat = route_.data.distanceMatrix(profile);
-        Distance distance = 0;
-
-        for (size_t step = start; step != end; ++step)
-        {
-            auto const from = route_.visits[step];
-            auto const to = route_.visits[step + 1];
-            distance += mat(from, to);
-        }
-
-        return distance;
-    }
+    if (start == end)
+        return 0;
 
-    auto const startDist = route_.cumDist[start];
-    auto const endDist = route_.cumDist[end];
+    auto const &cumDist = route_.cumDistance(profile);
+    auto const startDist = cumDist[start];
+    auto const endDist = cumDist[end];
 
     assert(startDist <= endDist);
     return endDist - startDist;
@@ -847,7 +922,7 @@ Distance Route::SegmentBetween::distance(size_t profile) const
 DurationSegment
 Route::SegmentBetween::duration([[maybe_unused]] size_t profile) const
 {
-    auto const &mat = route_.data.durationMatrix(profile);
+    auto const &mat = route_.data->durationMatrix(profile);
     auto durSegment = route_.durAt[start];
 
     for (size_t step = start; step != end; ++step)
@@ -872,6 +947,69 @@ LoadSegment Route::SegmentBetween::load(size_t dimension) const
     return loadSegment;
 }
 
+Route::SegmentReversed::SegmentReversed(Route const &route,
+                                        size_t start,
+                                        size_t end)
+    : route_(route), start(start), end(end)
+{
+    assert(start <= end && end < route.size());
+    assert(!route[start]->isDepot() && !route[end]->isDepot());
+    assert(route[start]->trip() == route[end]->trip());
+}
+
+Route const *Route::SegmentReversed::route() const { return &route_; }
+
+size_t Route::SegmentReversed::first() const { return route_.visits[end]; }
+size_t Route::SegmentReversed::last() const { return route_.visits[start]; }
+size_t Route::SegmentReversed::size() const { return end - start + 1; }
+
+bool Route::SegmentReversed::startsAtReloadDepot() const { return false; }
+bool Route::SegmentReversed::endsAtReloadDepot() const { return false; }
+
+Distance Route::SegmentReversed::distance(size_t profile) const
+{
+    if (profile == route_.profile())
+    {
+        auto const &cumDist = route_.reverseCumDistance();
+        return cumDist[end] - cumDist[start];
+    }
+
+    auto const &mat = route_.data->distanceMatrix(profile);
+
+    Distance distance = 0;
+    for (size_t step = end; step != start; --step)
+        distance += mat(route_.visits[step], route_.visits[step - 1]);
+
+    return distance;
+}
+
+DurationSegment Route::SegmentReversed::duration(size_t profile) const
+{
+    auto const &mat = route_.data->durationMatrix(profile);
+    auto durSegment = route_.durAt[end];
+
+    for (size_t step = end; step != start; --step)
+    {
+        auto const from = route_.visits[step];
+        auto const to = route_.visits[step - 1];
+        auto const &durAt = route_.durAt[step - 1];
+        durSegment = DurationSegment::merge(mat(from, to), durSegment, durAt);
+    }
+
+    return durSegment;
+}
+
+LoadSegment Route::SegmentReversed::load(size_t dimension) const
+{
+    auto const &loads = route_.loadAt[dimension];
+
+    auto loadSegment = loads[end];
+    for (size_t step = end; step != start; --step)
+        loadSegment = LoadSegment::merge(loadSegment, loads[step - 1]);
+
+    return loadSegment;
+}
+
 bool Route::isFeasible() const
 {
     assert(!dirty);
@@ -932,14 +1070,14 @@ Distance Route::excessDistance() const
 
 std::vector<Load> const &Route::capacity() const
 {
-    return vehicleType_.capacity;
+    return vehicleType_->capacity;
 }
 
-size_t Route::startDepot() const { return vehicleType_.startDepot; }
+size_t Route::startDepot() const { return vehicleType_->startDepot; }
 
-size_t Route::endDepot() const { return vehicleType_.endDepot; }
+size_t Route::endDepot() const { return vehicleType_->endDepot; }
 
-Cost Route::fixedVehicleCost() const { return vehicleType_.fixedCost; }
+Cost Route::fixedVehicleCost() const { return vehicleType_->fixedCost; }
 
 Distance Route::distance() const
 {
@@ -953,7 +1091,7 @@ Cost Route::distanceCost() const
     return distanceCost_;
 }
 
-Cost Route::unitDistanceCost() const { return vehicleType_.unitDistanceCost; }
+Cost Route::unitDistanceCost() const { return vehicleType_->unitDistanceCost; }
 
 bool Route::hasDistanceCost() const
 {
@@ -985,27 +1123,27 @@ Cost Route::reloadCost() const
     return reloadCost_;
 }
 
-Cost Route::unitDurationCost() const { return vehicleType_.unitDurationCost; }
+Cost Route::unitDurationCost() const { return vehicleType_->unitDurationCost; }
 
-Cost Route::unitOvertimeCost() const { return vehicleType_.unitOvertimeCost; }
+Cost Route::unitOvertimeCost() const { return vehicleType_->unitOvertimeCost; }
 
 bool Route::hasDurationCost() const
 {
     // clang-format off
-    return data.hasTimeWindows()
+    return data->hasTimeWindows()
         || unitDurationCost() != 0
         || (unitOvertimeCost() != 0 && maxOvertime() != 0)
         || maxDuration() != std::numeric_limits<Duration>::max();
     // clang-format on
 }
 
-Duration Route::shiftDuration() const { return vehicleType_.shiftDuration; }
+Duration Route::shiftDuration() const { return vehicleType_->shiftDuration; }
 
-Duration Route::maxDuration() const { return vehicleType_.maxDuration; }
+Duration Route::maxDuration() const { return vehicleType_->maxDuration; }
 
-Duration Route::maxOvertime() const { return vehicleType_.maxOvertime; }
+Duration Route::maxOvertime() const { return vehicleType_->maxOvertime; }
 
-Distance Route::maxDistance() const { return vehicleType_.maxDistance; }
+Distance Route::maxDistance() const { return vehicleType_->maxDistance; }
 
 Duration Route::timeWarp() const
 {
@@ -1025,11 +1163,40 @@ Duration Route::timeWarpDS() const
     return timeWarpDS_;
 }
 
-size_t Route::profile() const { return vehicleType_.profile; }
+size_t Route::profile() const { return vehicleType_->profile; }
+
+std::pmr::vector<Distance> const &Route::cumDistance(size_t profile) const
+{
+    if (profile == vehicleType_->profile)
+        return cumDist;
+
+    assert(profile < profileCumDist.size());
+    if (profileCumDist[profile].empty())
+        computeCumDistance(profile);
+
+    return profileCumDist[profile];
+}
+
+std::pmr::vector<Distance> const &Route::reverseCumDistance() const
+{
+    assert(!dirty);
+    if (reverseCumDist.empty())
+    {
+        auto const &distMat = data->distanceMatrix(profile());
+
+        reverseCumDist.resize(visits.size());
+        reverseCumDist[0] = 0;
+        for (size_t idx = 1; idx != visits.size(); ++idx)
+            reverseCumDist[idx] = reverseCumDist[idx - 1]
+                                  + distMat(visits[idx], visits[idx - 1]);
+    }
+
+    return reverseCumDist;
+}
 
 bool Route::hasForbiddenWindows() const
 {
-    return !vehicleType_.forbiddenWindows.empty();
+    return !vehicleType_->forbiddenWindows.empty();
 }
 
 bool Route::empty() const { return numClients() == 0; }
@@ -1042,7 +1209,7 @@ size_t Route::numDepots() const { return depots_.size(); }
 
 size_t Route::numTrips() const { return depots_.size() - 1; }
 
-size_t Route::maxTrips() const { return vehicleType_.maxTrips(); }
+size_t Route::maxTrips() const { return vehicleType_->maxTrips(); }
 
 Route::SegmentBetween Route::at(size_t idx) const
 {
@@ -1068,6 +1235,12 @@ Route::SegmentBetween Route::between(size_t start, size_t end) const
     return {*this, start, end};
 }
 
+Route::SegmentReversed Route::reversed(size_t start, size_t end) const
+{
+    assert(!dirty);
+    return {*this, start, end};
+}
+
 template <Segment... Segments>
 Route::Proposal<Segments...>::Proposal(Segments &&...segments)
     : segments_(std::forward<Segments>(segments)...)
@@ -1106,7 +1279,7 @@ std::pair<Cost, Distance> Route::Proposal<Segments...>::distance() const
     if (empty())
         return std::make_pair(0, 0);
 
-    auto const &data = route()->data;
+    auto const &data = *route()->data;
     auto const unitDistanceCost = route()->unitDistanceCost();
     auto const maxDistance = route()->maxDistance();
     auto const profile = route()->profile();
@@ -1142,7 +1315,7 @@ std::pair<Cost, Duration> Route::Proposal<Segments...>::duration() const
     if (empty())
         return std::make_pair(0, 0);
 
-    auto const &data = route()->data;
+    auto const &data = *route()->data;
     auto const unitDurationCost = route()->unitDurationCost();
     auto const unitOvertimeCost = route()->unitOvertimeCost();
     auto const shiftDuration = route()->shiftDuration();
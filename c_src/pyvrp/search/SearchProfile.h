@@ -0,0 +1,105 @@
+#ifndef PYVRP_SEARCH_SEARCHPROFILE_H
+#define PYVRP_SEARCH_SEARCHPROFILE_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pyvrp::search
+{
+/**
+ * Time spent by the local search per phase and per operator, accumulated
+ * while profiling is enabled.
+ *
+ * Phases nest: operator evaluations are part of the search and intensify
+ * phases, and those are part of neither the load nor the unload phase.
+ */
+struct SearchProfile
+{
+    /**
+     * Number of timed calls, and their total wall-clock time.
+     */
+    struct Timing
+    {
+        size_t count = 0;
+        uint64_t nanoseconds = 0;
+    };
+
+    enum Phase : size_t
+    {
+        LOAD,                 // loadSolution()
+        PERTURB,              // perturbation before the search
+        SEARCH,               // node-based search
+        INTENSIFY,            // route-based search
+        MULTI_TRIP,           // improveWithMultiTrip()
+        REPAIR_FW,            // repairForbiddenWindowRoutes()
+        STRIP_FW,             // stripForbiddenWindowViolations()
+        STRIP_INFEASIBLE_FW,  // stripInfeasibleForbiddenWindowClients()
+        UNLOAD,               // exporting the improved solution
+        NUM_PHASES
+    };
+
+    std::array<Timing, NUM_PHASES> phases = {};
+    std::vector<Timing> nodeOperators;   // evaluate(), in order of addition
+    std::vector<Timing> routeOperators;  // evaluate(), in order of addition
+
+    /**
+     * Returns a lower-case name for the given phase.
+     */
+    static char const *phaseName(Phase phase);
+};
+
+/**
+ * Adds the wall-clock time spent in its scope to the given timing. Does
+ * nothing, and in particular does not read the clock, for a null timing.
+ */
+class ScopedTimer
+{
+    using Clock = std::chrono::steady_clock;
+
+    SearchProfile::Timing *timing_;
+    Clock::time_point start_;
+
+public:
+    explicit ScopedTimer(SearchProfile::Timing *timing) : timing_(timing)
+    {
+        if (timing_)
+            start_ = Clock::now();
+    }
+
+    ~ScopedTimer()
+    {
+        if (!timing_)
+            return;
+
+        auto const elapsed = Clock::now() - start_;
+        timing_->count++;
+        timing_->nanoseconds
+            += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                   .count();
+    }
+
+    ScopedTimer(ScopedTimer const &) = delete;
+    ScopedTimer &operator=(ScopedTimer const &) = delete;
+};
+
+inline char const *SearchProfile::phaseName(Phase phase)
+{
+    static constexpr char const *names[NUM_PHASES]
+        = {"load",
+           "perturb",
+           "search",
+           "intensify",
+           "multi_trip",
+           "repair_forbidden_windows",
+           "strip_forbidden_windows",
+           "strip_infeasible_forbidden_windows",
+           "unload"};
+
+    return phase < NUM_PHASES ? names[phase] : "unknown";
+}
+}  // namespace pyvrp::search
+
+#endif  // PYVRP_SEARCH_SEARCHPROFILE_H
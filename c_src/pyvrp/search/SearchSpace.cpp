@@ -10,6 +10,7 @@ using pyvrp::search::SearchSpace;
 SearchSpace::SearchSpace(ProblemData const &data, Neighbours neighbours)
     : neighbours_(data.numLocations()),
       promising_(data.numLocations()),
+      locked_(data.numLocations()),
       clientOrder_(data.numClients()),
       routeOrder_(data.numVehicles())
 {
@@ -48,7 +49,7 @@ void SearchSpace::setNeighbours(Neighbours neighbours)
         }
     }
 
-    neighbours_ = neighbours;
+    neighbours_ = std::move(neighbours);
 }
 
 SearchSpace::Neighbours const &SearchSpace::neighbours() const
@@ -91,6 +92,45 @@ void SearchSpace::markAllPromising() { promising_.set(); }
 
 void SearchSpace::unmarkAllPromising() { promising_.reset(); }
 
+void SearchSpace::setLocked(std::vector<size_t> const &clients)
+{
+    size_t numDepots = neighbours_.size() - clientOrder_.size();
+    for (auto const client : clients)
+        if (client < numDepots || client >= neighbours_.size())
+            throw std::out_of_range("Client index out of range.");
+
+    locked_.reset();
+    for (auto const client : clients)
+        locked_[client] = true;
+}
+
+bool SearchSpace::isLocked(size_t client) const
+{
+    assert(client < neighbours_.size());
+    return locked_[client];
+}
+
+bool SearchSpace::isInsertableAfter(Route::Node const *node) const
+{
+    assert(node->route() && !node->isEndDepot());
+
+    // Reload depots between locked clients are part of the locked prefix.
+    auto const *next = n(node);
+    while (next->isReloadDepot())
+        next = n(next);
+
+    return !isLocked(next->client());
+}
+
+Route::Node *SearchSpace::prefixEnd(Route &route) const
+{
+    auto *node = route[0];
+    while (!isInsertableAfter(node))
+        node = n(node);
+
+    return node;
+}
+
 std::vector<size_t> const &SearchSpace::clientOrder() const
 {
     return clientOrder_;
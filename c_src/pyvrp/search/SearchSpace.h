@@ -32,6 +32,10 @@ private:
     // Tracks clients that can likely be improved by local search operators.
     DynamicBitset promising_;
 
+    // Tracks clients that are locked in place, e.g. because they have already
+    // been visited. Locked clients form a prefix of their route.
+    DynamicBitset locked_;
+
     // Client order used for node-based search.
     std::vector<size_t> clientOrder_;
 
@@ -90,6 +94,34 @@ public:
      */
     void unmarkAllPromising();
 
+    /**
+     * Locks the given clients in place, replacing any existing locks. Locked
+     * clients are not moved or removed, and no client may be inserted before
+     * or between them. The locked clients of each route must form a prefix of
+     * that route, e.g. the stops a driver has already committed to.
+     */
+    void setLocked(std::vector<size_t> const &clients);
+
+    /**
+     * Returns whether the given client is locked in place.
+     */
+    bool isLocked(size_t client) const;
+
+    /**
+     * Returns whether a client may be inserted directly after the given node,
+     * that is, whether the node is not part of a locked prefix other than its
+     * last client. The node must currently be in a route, and must not be the
+     * end depot.
+     */
+    bool isInsertableAfter(Route::Node const *node) const;
+
+    /**
+     * Returns the last node of the given route's locked prefix, that is, the
+     * first node after which a client may be inserted. This is the route's
+     * start depot if the route has no locked prefix.
+     */
+    Route::Node *prefixEnd(Route &route) const;
+
     /**
      * Returns a randomised order in which the client search space may be
      * traversed. This order remains unchanged until :meth:`~shuffle` is called.
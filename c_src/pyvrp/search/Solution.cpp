@@ -8,33 +8,90 @@
 #include <iterator>
 #include <limits>
 
+using pyvrp::search::Route;
 using pyvrp::search::Solution;
 
-Solution::Solution(ProblemData const &data) : data_(data)
+namespace
+{
+// Number of nodes each route reserves up front: the start and end depots,
+// and an equal share of the clients.
+size_t plannedRouteSize(pyvrp::ProblemData const &data)
+{
+    auto const numVehicles = std::max<size_t>(data.numVehicles(), 1);
+    return 2 + (data.numClients() + numVehicles - 1) / numVehicles;
+}
+
+// Size of the arena backing the routes of a solution: the nodes reserved by
+// each route and their statistics (see Route::reserve()), plus the depots
+// and per-dimension and per-profile vectors that each route always has.
+size_t plannedArenaSize(pyvrp::ProblemData const &data)
+{
+    auto const numDims = data.numLoadDimensions();
+    auto const nodeBytes = sizeof(Route::Node *) + sizeof(size_t)
+                           + sizeof(pyvrp::Distance)
+                           + 3 * sizeof(pyvrp::DurationSegment)
+                           + 3 * numDims * sizeof(pyvrp::LoadSegment);
+
+    auto const numVectors = 3 * numDims + data.numProfiles();
+    auto const routeBytes = 2 * sizeof(Route::Node)
+                            + numVectors * sizeof(std::pmr::vector<char>)
+                            + plannedRouteSize(data) * nodeBytes;
+
+    return std::max<size_t>(data.numVehicles() * routeBytes, 1);
+}
+}  // namespace
+
+Solution::Solution(ProblemData const &data)
+    : data_(&data),
+      typeOffset_(data.numVehicleTypes()),
+      vehicleOffset_(data.numVehicleTypes()),
+      arena_(plannedArenaSize(data)),
+      missing(data)
 {
     nodes.reserve(data.numLocations());
     for (size_t loc = 0; loc != data.numLocations(); ++loc)
         nodes.emplace_back(loc);
 
+    auto const routeSize = plannedRouteSize(data);
     routes.reserve(data.numVehicles());
     size_t rIdx = 0;
     for (size_t vehType = 0; vehType != data.numVehicleTypes(); ++vehType)
     {
+        typeOffset_[vehType] = rIdx;
+
         auto const numAvailable = data.vehicleType(vehType).numAvailable;
         for (size_t vehicle = 0; vehicle != numAvailable; ++vehicle)
-            routes.emplace_back(data, rIdx++, vehType);
+        {
+            auto &route = routes.emplace_back(
+                data, rIdx++, vehType, &arena_, &missing);
+            route.reserve(routeSize);
+        }
     }
 }
 
-void Solution::load(pyvrp::Solution const &solution)
+void Solution::setData(ProblemData const &data)
 {
-    // Determine offsets for vehicle types.
-    std::vector<size_t> vehicleOffset(data_.numVehicleTypes(), 0);
-    for (size_t vehType = 1; vehType < data_.numVehicleTypes(); vehType++)
+    data_ = &data;
+
+    // The clients' windows, prizes and requirements may have changed, so the
+    // index of missing clients is rebuilt around the clients in the routes.
+    missing = MissingClients(data);
+    for (auto &route : routes)
     {
-        auto const prevAvail = data_.vehicleType(vehType - 1).numAvailable;
-        vehicleOffset[vehType] = vehicleOffset[vehType - 1] + prevAvail;
+        route.setData(data);
+        route.update();
+
+        for (auto const *node : route)
+            if (node->client() >= data.numDepots())
+                missing.erase(node->client());
     }
+}
+
+void Solution::load(pyvrp::Solution const &solution)
+{
+    // Start at the first route of each vehicle type.
+    auto &vehicleOffset = vehicleOffset_;
+    vehicleOffset = typeOffset_;
 
     for (auto const &solRoute : solution.routes())
     {
@@ -76,9 +133,9 @@ void Solution::load(pyvrp::Solution const &solution)
     // Finally, we clear any routes that we have not re-used or inserted from
     // the solution.
     size_t firstOfType = 0;
-    for (size_t vehType = 0; vehType != data_.numVehicleTypes(); ++vehType)
+    for (size_t vehType = 0; vehType != data_->numVehicleTypes(); ++vehType)
     {
-        auto const numAvailable = data_.vehicleType(vehType).numAvailable;
+        auto const numAvailable = data_->vehicleType(vehType).numAvailable;
         auto const firstOfNextType = firstOfType + numAvailable;
         for (size_t idx = vehicleOffset[vehType]; idx != firstOfNextType; ++idx)
             routes[idx].clear();
@@ -87,12 +144,35 @@ void Solution::load(pyvrp::Solution const &solution)
     }
 }
 
-pyvrp::Solution Solution::unload() const
+size_t Solution::hash() const
+{
+    size_t hash = 0;
+    for (auto const &route : routes)
+        hash ^= route.hash();
+
+    return hash;
+}
+
+bool Solution::hasDominatingEmptyRoute(size_t vehType) const
+{
+    for (auto const other : data_->vehicleTypeDominators(vehType))
+    {
+        auto const begin = routes.begin() + typeOffset_[other];
+        auto const end = begin + data_->vehicleType(other).numAvailable;
+        auto const pred = [](auto const &route) { return route.empty(); };
+        if (std::any_of(begin, end, pred))
+            return true;
+    }
+
+    return false;
+}
+
+pyvrp::Solution Solution::unload()
 {
     std::vector<pyvrp::Route> solRoutes;
-    solRoutes.reserve(data_.numVehicles());
+    solRoutes.reserve(data_->numVehicles());
 
-    std::vector<size_t> visits;
+    auto &visits = visits_;
 
     for (auto const &route : routes)
     {
@@ -116,7 +196,7 @@ pyvrp::Solution Solution::unload() const
                 continue;
             }
 
-            trips.emplace_back(data_,
+            trips.emplace_back(*data_,
                                visits,
                                route.vehicleType(),
                                prevDepot->client(),
@@ -127,10 +207,10 @@ pyvrp::Solution Solution::unload() const
         }
 
         assert(trips.size() == route.numTrips());
-        solRoutes.emplace_back(data_, std::move(trips), route.vehicleType());
+        solRoutes.emplace_back(*data_, std::move(trips), route.vehicleType());
     }
 
-    return {data_, std::move(solRoutes)};
+    return {*data_, std::move(solRoutes)};
 }
 
 bool Solution::insert(Route::Node *U,
@@ -143,10 +223,10 @@ bool Solution::insert(Route::Node *U,
     Route *requiredRoute = nullptr;
     char const *requiredVehicleName = nullptr;
 
-    for (size_t groupIdx = 0; groupIdx != data_.numSameVehicleGroups();
+    for (size_t groupIdx = 0; groupIdx != data_->numSameVehicleGroups();
          ++groupIdx)
     {
-        auto const &group = data_.sameVehicleGroup(groupIdx);
+        auto const &group = data_->sameVehicleGroup(groupIdx);
 
         bool uInGroup = false;
         for (auto const client : group)
@@ -171,7 +251,7 @@ bool Solution::insert(Route::Node *U,
             {
                 requiredRoute = otherNode->route();
                 requiredVehicleName
-                    = data_.vehicleType(requiredRoute->vehicleType()).name;
+                    = data_->vehicleType(requiredRoute->vehicleType()).name;
                 break;
             }
         }
@@ -191,7 +271,7 @@ bool Solution::insert(Route::Node *U,
         if (requiredVehicleName && requiredVehicleName[0] != '\0')
         {
             auto const *routeName
-                = data_.vehicleType(route->vehicleType()).name;
+                = data_->vehicleType(route->vehicleType()).name;
             if (routeName && routeName[0] != '\0'
                 && std::strcmp(requiredVehicleName, routeName) == 0)
                 return true;
@@ -206,15 +286,20 @@ bool Solution::insert(Route::Node *U,
     auto const clientLoc = U->client();
     auto isReachable = [&](Route const *route) -> bool
     {
-        if (data_.numProfiles() <= 1)
+        if (data_->numProfiles() <= 1)
             return true;
-        auto const profile = data_.vehicleType(route->vehicleType()).profile;
-        auto const &distMatrix = data_.distanceMatrix(profile);
+        auto const profile = data_->vehicleType(route->vehicleType()).profile;
+        auto const &distMatrix = data_->distanceMatrix(profile);
         auto const startDepot
-            = data_.vehicleType(route->vehicleType()).startDepot;
+            = data_->vehicleType(route->vehicleType()).startDepot;
         return distMatrix(startDepot, clientLoc) < 1'000'000'000;
     };
 
+    // Locked clients form a prefix of their route, so the first position at
+    // which U may be inserted into a route is after its last locked client.
+    auto routeStart
+        = [&](Route &route) { return searchSpace.prefixEnd(route); };
+
     Route::Node *UAfter = nullptr;
     auto bestCost = std::numeric_limits<Cost>::max();
 
@@ -222,8 +307,8 @@ bool Solution::insert(Route::Node *U,
     {
         if (isCompatibleRoute(&route) && isReachable(&route))
         {
-            UAfter = route[0];
-            bestCost = insertCost(U, UAfter, data_, costEvaluator);
+            UAfter = routeStart(route);
+            bestCost = insertCost(U, UAfter, *data_, costEvaluator);
             break;
         }
     }
@@ -235,11 +320,15 @@ bool Solution::insert(Route::Node *U,
     {
         auto *V = &nodes[vClient];
 
-        if (!V->route() || !isCompatibleRoute(V->route())
-            || !isReachable(V->route()))
+        if (!V->route() || !searchSpace.isInsertableAfter(V)
+            || !isCompatibleRoute(V->route()) || !isReachable(V->route()))
+            continue;
+
+        if (!data_->isArcCompatible(vClient, U->client())
+            || !data_->isArcCompatible(U->client(), n(V)->client()))
             continue;
 
-        auto const cost = insertCost(U, V, data_, costEvaluator);
+        auto const cost = insertCost(U, V, *data_, costEvaluator);
         if (cost < bestCost)
         {
             bestCost = cost;
@@ -250,21 +339,33 @@ bool Solution::insert(Route::Node *U,
     for (auto const &[vehType, offset] : searchSpace.vehTypeOrder())
     {
         auto const begin = routes.begin() + offset;
-        auto const end = begin + data_.vehicleType(vehType).numAvailable;
+        auto const end = begin + data_->vehicleType(vehType).numAvailable;
+
+        // All empty routes of a vehicle type give the same insertion cost, so
+        // we try at most one. We skip them altogether if an empty route of a
+        // dominating type is available, since that is at least as good. That
+        // need not hold with a required route, which is matched by name.
+        bool skipEmpty = !requiredRoute && hasDominatingEmptyRoute(vehType);
 
         for (auto it = begin; it != end; ++it)
         {
+            if (it->empty() && skipEmpty)
+                continue;
+
             if (!isCompatibleRoute(&*it) || !isReachable(&*it))
                 continue;
 
             if (!it->empty() && UAfter->route() == &*it)
                 continue;
 
-            auto const cost = insertCost(U, (*it)[0], data_, costEvaluator);
+            skipEmpty |= it->empty();
+
+            auto *start = routeStart(*it);
+            auto const cost = insertCost(U, start, *data_, costEvaluator);
             if (cost < bestCost)
             {
                 bestCost = cost;
-                UAfter = (*it)[0];
+                UAfter = start;
 
                 if (it->empty())
                     break;
@@ -282,19 +383,19 @@ bool Solution::insert(Route::Node *U,
     if (UAfter && UAfter->route())
     {
         auto *route = UAfter->route();
-        auto const &vehType = data_.vehicleType(route->vehicleType());
+        auto const &vehType = data_->vehicleType(route->vehicleType());
         canUseMultiTrip = !vehType.reloadDepots.empty()
                           && route->numTrips() < route->maxTrips();
 
         auto const clientLoc = U->client();
-        if (clientLoc >= data_.numDepots())
+        if (clientLoc >= data_->numDepots())
         {
-            ProblemData::Client const &client = data_.location(clientLoc);
+            ProblemData::Client const &client = data_->location(clientLoc);
             hasPrize = client.prize > 0;
 
             // Check if client fits alone in a trip
             for (size_t d = 0;
-                 d < data_.numLoadDimensions() && d < vehType.capacity.size();
+                 d < data_->numLoadDimensions() && d < vehType.capacity.size();
                  ++d)
             {
                 Load clientDemand = 0;
@@ -311,14 +412,14 @@ bool Solution::insert(Route::Node *U,
             }
         }
 
-        if (data_.numLoadDimensions() > 0 && !vehType.capacity.empty()
+        if (data_->numLoadDimensions() > 0 && !vehType.capacity.empty()
             && canUseMultiTrip)
         {
-            if (clientLoc >= data_.numDepots())
+            if (clientLoc >= data_->numDepots())
             {
                 ProblemData::Client const &clientData
-                    = data_.location(clientLoc);
-                for (size_t d = 0; d < data_.numLoadDimensions()
+                    = data_->location(clientLoc);
+                for (size_t d = 0; d < data_->numLoadDimensions()
                                    && d < vehType.capacity.size();
                      ++d)
                 {
@@ -342,10 +443,10 @@ bool Solution::insert(Route::Node *U,
                     for (size_t i = tripStartIdx; i <= maxIdx; ++i)
                     {
                         auto *node = route->operator[](i);
-                        if (node->client() >= data_.numDepots())
+                        if (node->client() >= data_->numDepots())
                         {
                             ProblemData::Client const &loc
-                                = data_.location(node->client());
+                                = data_->location(node->client());
                             if (d < loc.delivery.size())
                                 tripDelivery = tripDelivery + loc.delivery[d];
                             if (d < loc.pickup.size())
@@ -389,13 +490,13 @@ bool Solution::insert(Route::Node *U,
     // If so, inflate bestCost so multi-trip gets a fair comparison.
     if (UAfter && UAfter->route())
     {
-        auto const &vt = data_.vehicleType(UAfter->route()->vehicleType());
+        auto const &vt = data_->vehicleType(UAfter->route()->vehicleType());
         if (!vt.forbiddenWindows.empty())
         {
             // Estimate route end time: twEarly + duration (before time warp)
             auto const routeEnd = vt.twEarly + UAfter->route()->duration()
                                   - UAfter->route()->timeWarp();
-            ProblemData::Client const &cl = data_.location(U->client());
+            ProblemData::Client const &cl = data_->location(U->client());
 
             for (auto const &[fStart, fEnd] : vt.forbiddenWindows)
             {
@@ -416,14 +517,14 @@ bool Solution::insert(Route::Node *U,
         // or we inflated it because of forbidden window time warp.
         // Try inserting as a new trip on a route that supports multi-trip.
         auto const clientLoc = U->client();
-        ProblemData::Client const &client = data_.location(clientLoc);
+        ProblemData::Client const &client = data_->location(clientLoc);
 
         for (auto &route : routes)
         {
             if (route.empty())
                 continue;
 
-            auto const &vehType = data_.vehicleType(route.vehicleType());
+            auto const &vehType = data_->vehicleType(route.vehicleType());
             if (vehType.reloadDepots.empty())
                 continue;
             if (route.numTrips() >= route.maxTrips())
@@ -436,8 +537,8 @@ bool Solution::insert(Route::Node *U,
 
             auto const reloadDepot = vehType.reloadDepots[0];
             auto const profile = vehType.profile;
-            auto const &distMatrix = data_.distanceMatrix(profile);
-            auto const &durMatrix = data_.durationMatrix(profile);
+            auto const &distMatrix = data_->distanceMatrix(profile);
+            auto const &durMatrix = data_->durationMatrix(profile);
 
             // Calculate distance cost of the new trip
             auto const tripDist = distMatrix(reloadDepot, clientLoc)
@@ -450,9 +551,9 @@ bool Solution::insert(Route::Node *U,
 
             // Add reload depot service time and get reload cost
             Cost reloadCost = 0;
-            if (reloadDepot < data_.numDepots())
+            if (reloadDepot < data_->numDepots())
             {
-                ProblemData::Depot const &depot = data_.location(reloadDepot);
+                ProblemData::Depot const &depot = data_->location(reloadDepot);
                 tripDur = tripDur + depot.serviceDuration;
                 reloadCost = depot.reloadCost;
             }
@@ -511,7 +612,7 @@ bool Solution::insert(Route::Node *U,
         {
             // Insert as a new trip at the end of the route
             auto const &vehType
-                = data_.vehicleType(newTripRoute->vehicleType());
+                = data_->vehicleType(newTripRoute->vehicleType());
             auto const insertIdx
                 = newTripRoute->size() - 1;  // Before end depot
             Route::Node depot = {vehType.reloadDepots[0]};
@@ -521,7 +622,7 @@ bool Solution::insert(Route::Node *U,
         }
 
         auto *route = UAfter->route();
-        auto const &vehType = data_.vehicleType(route->vehicleType());
+        auto const &vehType = data_->vehicleType(route->vehicleType());
 
         if (wouldExceedCapacity && canUseMultiTrip)
         {
@@ -3,10 +3,12 @@
 
 #include "../Solution.h"  // pyvrp::Solution
 #include "CostEvaluator.h"
+#include "MissingClients.h"
 #include "ProblemData.h"
 #include "Route.h"  // pyvrp::search::Route
 #include "SearchSpace.h"
 
+#include <memory_resource>
 #include <vector>
 
 namespace pyvrp::search
@@ -23,25 +25,58 @@ namespace pyvrp::search
  * search operators involves copying pointers, not whole nodes. That is very
  * efficient in practice.
  *
+ * The routes allocate their internal data from an arena owned by the
+ * solution. The arena is sized up front from the number of locations and
+ * vehicles, so that route data is contiguous in memory, and is released at
+ * once when the solution is destroyed.
+ *
  * The solution does not protect its internal state---it is just a simple
  * wrapper around nodes and routes. Ensuring the solution remains valid is
  * up to the interacting code.
  */
 class Solution
 {
-    ProblemData const &data_;
+    ProblemData const *data_;
+
+    std::vector<size_t> typeOffset_;  // index of first route of each type
+
+    // Scratch space for load() and unload(), reused between calls.
+    std::vector<size_t> vehicleOffset_;  // size numVehicleTypes()
+    std::vector<size_t> visits_;
+
+    // Backs all route data, and must outlive the routes. Memory that routes
+    // free is not reused, but route vectors never shrink, so the arena stays
+    // within a small factor of the routes' peak size.
+    std::pmr::monotonic_buffer_resource arena_;
 
 public:
     std::vector<Route::Node> nodes;  // size numLocations()
+    MissingClients missing;          // clients that are not in any route
     std::vector<Route> routes;       // size numVehicles(), ordered by type
 
     Solution(ProblemData const &data);
 
+    // Rebinds this solution and its routes to the given data, which must have
+    // the same locations and vehicle types as the current data. The routes
+    // keep their visits, and are updated for the new data.
+    void setData(ProblemData const &data);
+
     // Converts the given solution into our node-based representation.
     void load(pyvrp::Solution const &solution);
 
-    // Converts from our representation to a proper solution.
-    pyvrp::Solution unload() const;
+    // Converts from our representation to a proper solution. Not const, since
+    // it reuses the scratch space, so concurrent calls are not safe.
+    pyvrp::Solution unload();
+
+    // Returns the hash of the current routes, which equals the hash() of the
+    // solution unload() returns. Each route keeps its part of the hash up to
+    // date when it is updated, so this only combines the routes' hashes.
+    size_t hash() const;
+
+    // Returns whether there is an empty route of a vehicle type dominating the
+    // given vehicle type. Empty routes of the given type then need not be
+    // considered, since they cannot be better.
+    bool hasDominatingEmptyRoute(size_t vehType) const;
 
     // Inserts the given node into the solution - either in its neighbourhood,
     // or in an empty route, if improving or required. Returns true if the node
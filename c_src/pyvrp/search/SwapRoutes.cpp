@@ -12,14 +12,21 @@ Cost SwapRoutes::evaluate(Route *U,
     if (U == V || U->vehicleType() == V->vehicleType())
         return 0;
 
-    // Evaluate swapping the routes after the two depots.
-    return op.evaluate((*U)[0], (*V)[0], costEvaluator);
+    // Evaluate swapping the routes after the two depots, or after their
+    // locked prefixes.
+    return op.evaluate(prefixEnd(U), prefixEnd(V), costEvaluator);
 }
 
 void SwapRoutes::apply(Route *U, Route *V) const
 {
     stats_.numApplications++;
-    op.apply((*U)[0], (*V)[0]);
+    op.apply(prefixEnd(U), prefixEnd(V));
+}
+
+void SwapRoutes::setData(ProblemData const &data)
+{
+    RouteOperator::setData(data);
+    op.setData(data);
 }
 
 SwapRoutes::SwapRoutes(ProblemData const &data) : RouteOperator(data), op(data)
@@ -10,7 +10,8 @@ namespace pyvrp::search
  * SwapRoutes(data: ProblemData)
  *
  * This operator evaluates exchanging the visits of two routes :math:`U` and
- * :math:`V`.
+ * :math:`V`. Visits in a locked prefix stay in their route; only the visits
+ * after it are exchanged.
  */
 class SwapRoutes : public RouteOperator
 {
@@ -22,6 +23,10 @@ public:
 
     void apply(Route *U, Route *V) const override;
 
+    bool keepsLockedPrefixes() const override { return true; }
+
+    void setData(ProblemData const &data) override;
+
     explicit SwapRoutes(ProblemData const &data);
 };
 
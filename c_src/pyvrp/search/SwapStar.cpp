@@ -22,7 +22,7 @@ void SwapStar::updateRemovalCosts(Route *R, CostEvaluator const &costEvaluator)
     }
 
     isCached(R->idx(), 0) = true;  // removal costs are now updated
-    for (size_t idx = data.numDepots(); idx != data.numLocations(); ++idx)
+    for (size_t idx = data->numDepots(); idx != data->numLocations(); ++idx)
         isCached(R->idx(), idx) = false;  // but insert costs not yet
 }
 
@@ -67,8 +67,8 @@ Cost SwapStar::deltaLoadCost(Route::Node *U,
     auto const *uRoute = U->route();
     auto const *vRoute = V->route();
 
-    ProblemData::Client const &uClient = data.location(U->client());
-    ProblemData::Client const &vClient = data.location(V->client());
+    ProblemData::Client const &uClient = data->location(U->client());
+    ProblemData::Client const &vClient = data->location(V->client());
 
     auto const &uLoad = uRoute->load();
     auto const &uCap = uRoute->capacity();
@@ -82,7 +82,7 @@ Cost SwapStar::deltaLoadCost(Route::Node *U,
     // which is inexact when there are both pickups and deliveries in the data.
     // So it's pretty rough but fast and seems to mostly work well enough.
     Cost cost = 0;
-    for (size_t dim = 0; dim != data.numLoadDimensions(); ++dim)
+    for (size_t dim = 0; dim != data->numLoadDimensions(); ++dim)
     {
         auto const delta
             = std::max(uClient.delivery[dim], uClient.pickup[dim])
@@ -37,6 +37,10 @@ pyvrp::Cost SwapTails::evaluate(Route::Node *U,
         // not include a reload depot.
         return 0;
 
+    if (!data->isArcCompatible(U->client(), n(V)->client())
+        || !data->isArcCompatible(V->client(), n(U)->client()))
+        return 0;  // would connect clients that cannot follow each other
+
     Cost deltaCost = 0;
 
     // We're going to incur fixed cost if a route is currently empty but
@@ -0,0 +1,76 @@
+#include "TwoOpt.h"
+
+#include "Route.h"
+
+#include <cassert>
+
+using pyvrp::search::TwoOpt;
+
+bool TwoOpt::createsIncompatibleArc(Route::Node *first,
+                                    Route::Node *last) const
+{
+    auto const compatible = [&](Route::Node const *from, Route::Node const *to)
+    { return data->isArcCompatible(from->client(), to->client()); };
+
+    if (!compatible(first, last) || !compatible(n(first), n(last)))
+        return true;
+
+    // The arcs within the reversed visits are travelled the other way now.
+    auto const &route = *first->route();
+    for (auto idx = first->idx() + 1; idx != last->idx(); ++idx)
+        if (!compatible(route[idx + 1], route[idx]))
+            return true;
+
+    return false;
+}
+
+pyvrp::Cost TwoOpt::evaluate(Route::Node *U,
+                             Route::Node *V,
+                             CostEvaluator const &costEvaluator)
+{
+    stats_.numEvaluations++;
+    assert(!U->isEndDepot() && !V->isEndDepot());
+
+    if (U->route() != V->route())
+        return 0;
+
+    auto *first = U->idx() < V->idx() ? U : V;
+    auto *last = U->idx() < V->idx() ? V : U;
+
+    if (last->idx() <= first->idx() + 1)  // nothing to reverse
+        return 0;
+
+    // We cannot reverse across trips, since that would move a reload depot.
+    auto *nFirst = n(first);
+    if (nFirst->isDepot() || nFirst->trip() != last->trip())
+        return 0;
+
+    if (data->hardTimeWindows() && createsIncompatibleArc(first, last))
+        return 0;
+
+    auto const *route = U->route();
+
+    Cost deltaCost = 0;
+    costEvaluator.deltaCost(deltaCost,
+                            Route::Proposal(route->before(first->idx()),
+                                            route->reversed(nFirst->idx(),
+                                                            last->idx()),
+                                            route->after(last->idx() + 1)));
+
+    return deltaCost;
+}
+
+void TwoOpt::apply(Route::Node *U, Route::Node *V) const
+{
+    stats_.numApplications++;
+
+    auto *first = U->idx() < V->idx() ? U : V;
+    auto *last = U->idx() < V->idx() ? V : U;
+
+    auto &route = *U->route();
+    auto left = first->idx() + 1;
+    auto right = last->idx();
+
+    while (left < right)
+        Route::swap(route[left++], route[right--]);
+}
@@ -0,0 +1,48 @@
+#ifndef PYVRP_SEARCH_TWOOPT_H
+#define PYVRP_SEARCH_TWOOPT_H
+
+#include "LocalSearchOperator.h"
+
+namespace pyvrp::search
+{
+/**
+ * TwoOpt(data: ProblemData)
+ *
+ * Given two nodes :math:`U` and :math:`V` in the same trip of a route, with
+ * :math:`U` before :math:`V`, tests whether replacing the arcs of :math:`U`
+ * to :math:`n(U)` and :math:`V` to :math:`n(V)` by :math:`U \rightarrow V`
+ * and :math:`n(U) \rightarrow n(V)` is an improving move. This reverses the
+ * visits from :math:`n(U)` to :math:`V`. If :math:`V` comes before
+ * :math:`U`, the roles of the two nodes are swapped.
+ *
+ * The distance of the reversed visits takes constant time, also for
+ * asymmetric matrices. Their duration and load are only evaluated for moves
+ * that do not already increase the distance cost.
+ *
+ * .. note::
+ *
+ *    This is the intra-route 2-OPT operator. See :class:`~SwapTails` for its
+ *    inter-route counterpart, 2-OPT*.
+ */
+class TwoOpt : public NodeOperator
+{
+    using NodeOperator::NodeOperator;
+
+    // Tests if reversing the visits after first up to last creates an arc
+    // that is not time window compatible.
+    bool createsIncompatibleArc(Route::Node *first, Route::Node *last) const;
+
+public:
+    Cost evaluate(Route::Node *U,
+                  Route::Node *V,
+                  CostEvaluator const &costEvaluator) override;
+
+    void apply(Route::Node *U, Route::Node *V) const override;
+
+    // Reverses the visits after the earlier of U and V, which is V when V is
+    // locked and U is not.
+    bool keepsPrefixOfV() const override { return true; }
+};
+}  // namespace pyvrp::search
+
+#endif  // PYVRP_SEARCH_TWOOPT_H
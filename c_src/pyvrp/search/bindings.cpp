@@ -327,7 +327,10 @@ PYBIND11_MODULE(_search, m)
              py::arg("rng"),
              DOC(pyvrp, search, PerturbationManager, shuffle))
         .def("perturb",
-             &PerturbationManager::perturb,
+             py::overload_cast<Solution &,
+                               SearchSpace &,
+                               pyvrp::CostEvaluator const &>(
+                 &PerturbationManager::perturb, py::const_),
              py::arg("solution"),
              py::arg("search_space"),
              py::arg("cost_evaluator"),
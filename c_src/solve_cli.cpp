@@ -0,0 +1,263 @@
+/**
+ * Standalone native solver, for profiling the search without the BEAM. Runs
+ * the same iterated local search (or, with ``--algorithm hgs``, hybrid genetic
+ * search) as ``ExVrp.Solver.solve/2`` with a single start, and prints the
+ * result together with a timing breakdown.
+ *
+ * The instance is either a VRPLIB file (see ``exvrp::readVrplib()`` for the
+ * supported subset), or a binary dump of the problem data written from
+ * Elixir:
+ *
+ *     {:ok, data} = ExVrp.Model.to_problem_data(model)
+ *     File.write!("instance.dump", ExVrp.Native.problem_data_dump(data))
+ *
+ * A dump captures the data exactly as the NIF sees it, so any model can be
+ * reproduced this way.
+ *
+ * Build: make solver-cli
+ * Run:   ./exvrp_solve <instance> [--round none|round|trunc|dimacs|exact]
+ *                      [--algorithm ils|hgs] [--seed <n>]
+ *                      [--max-iterations <n>] [--max-runtime-ms <ms>]
+ *                      [--max-no-improvement <n>] [--elite-size <n>]
+ *                      [--decompose-interval <n>] [--cluster-size <n>]
+ *                      [--profile] [--routes]
+ */
+#include "exvrp/IteratedLocalSearch.h"
+#include "exvrp/ProblemDataIO.h"
+#include "pyvrp/ProblemData.h"
+#include "pyvrp/Solution.h"
+#include "pyvrp/search/SearchProfile.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace pyvrp;
+
+namespace
+{
+struct Options
+{
+    std::string path;
+    exvrp::RoundFunc round = exvrp::RoundFunc::NONE;
+    exvrp::SolveParams params = {};
+    bool routes = false;
+};
+
+[[noreturn]] void usage(char const *program)
+{
+    fprintf(stderr,
+            "Usage: %s <instance> [--round none|round|trunc|dimacs|exact] "
+            "[--algorithm ils|hgs] [--seed <n>] [--max-iterations <n>] "
+            "[--max-runtime-ms <ms>] [--max-no-improvement <n>] "
+            "[--elite-size <n>] [--decompose-interval <n>] "
+            "[--cluster-size <n>] [--profile] [--routes]\n",
+            program);
+    std::exit(1);
+}
+
+exvrp::RoundFunc parseRound(std::string const &arg, char const *program)
+{
+    if (arg == "none")
+        return exvrp::RoundFunc::NONE;
+    if (arg == "round")
+        return exvrp::RoundFunc::ROUND;
+    if (arg == "trunc")
+        return exvrp::RoundFunc::TRUNC;
+    if (arg == "dimacs")
+        return exvrp::RoundFunc::DIMACS;
+    if (arg == "exact")
+        return exvrp::RoundFunc::EXACT;
+
+    usage(program);
+}
+
+exvrp::Algorithm parseAlgorithm(std::string const &arg, char const *program)
+{
+    if (arg == "ils")
+        return exvrp::Algorithm::ILS;
+    if (arg == "hgs")
+        return exvrp::Algorithm::HGS;
+
+    usage(program);
+}
+
+Options parseOptions(int argc, char **argv)
+{
+    Options options;
+    for (int idx = 1; idx < argc; ++idx)
+    {
+        std::string const arg = argv[idx];
+        bool const hasValue = idx + 1 < argc;
+
+        if (arg == "--round" && hasValue)
+            options.round = parseRound(argv[++idx], argv[0]);
+        else if (arg == "--algorithm" && hasValue)
+            options.params.algorithm = parseAlgorithm(argv[++idx], argv[0]);
+        else if (arg == "--seed" && hasValue)
+            options.params.seed = std::strtoul(argv[++idx], nullptr, 10);
+        else if (arg == "--max-iterations" && hasValue)
+            options.params.maxIterations
+                = std::strtoull(argv[++idx], nullptr, 10);
+        else if (arg == "--max-runtime-ms" && hasValue)
+            options.params.maxRuntimeMs
+                = std::strtoll(argv[++idx], nullptr, 10);
+        else if (arg == "--max-no-improvement" && hasValue)
+            options.params.ils.maxNoImprovement
+                = std::strtoull(argv[++idx], nullptr, 10);
+        else if (arg == "--elite-size" && hasValue)
+            options.params.ils.eliteSize
+                = std::strtoull(argv[++idx], nullptr, 10);
+        else if (arg == "--decompose-interval" && hasValue)
+            options.params.decomposition.interval
+                = std::strtoull(argv[++idx], nullptr, 10);
+        else if (arg == "--cluster-size" && hasValue)
+            options.params.decomposition.clusterSize
+                = std::strtoull(argv[++idx], nullptr, 10);
+        else if (arg == "--profile")
+            options.params.profile = true;
+        else if (arg == "--routes")
+            options.routes = true;
+        else if (options.path.empty() && !arg.starts_with("--"))
+            options.path = arg;
+        else
+            usage(argv[0]);
+    }
+
+    if (options.path.empty())
+        usage(argv[0]);
+
+    return options;
+}
+
+ProblemData readInstance(Options const &options)
+{
+    std::ifstream file(options.path, std::ios::binary);
+    if (!file)
+        throw std::invalid_argument("Cannot open " + options.path + ".");
+
+    std::string const bytes(std::istreambuf_iterator<char>(file), {});
+    if (exvrp::isDump(bytes))
+        return exvrp::deserialise(bytes);
+
+    std::istringstream stream(bytes);
+    return exvrp::readVrplib(stream, options.round);
+}
+
+void printTiming(char const *name, search::SearchProfile::Timing timing)
+{
+    auto const ms = static_cast<double>(timing.nanoseconds) / 1e6;
+    auto const nsPerCall
+        = timing.count > 0 ? timing.nanoseconds / timing.count : 0;
+
+    printf("  %-34s %10zu calls %12.3f ms %10llu ns/call\n",
+           name,
+           timing.count,
+           ms,
+           static_cast<unsigned long long>(nsPerCall));
+}
+
+void printProfile(exvrp::SolveResult const &result)
+{
+    using Profile = search::SearchProfile;
+    auto const &profile = result.profile;
+
+    printf("\nLocal search phases (ILS loop)\n");
+    for (size_t phase = 0; phase != Profile::NUM_PHASES; ++phase)
+        if (profile.phases[phase].count > 0)
+            printTiming(Profile::phaseName(static_cast<Profile::Phase>(phase)),
+                        profile.phases[phase]);
+
+    printf("\nOperator evaluations\n");
+    for (size_t idx = 0; idx != profile.nodeOperators.size(); ++idx)
+        printTiming(result.nodeOperatorNames[idx].c_str(),
+                    profile.nodeOperators[idx]);
+
+    for (size_t idx = 0; idx != profile.routeOperators.size(); ++idx)
+        printTiming(result.routeOperatorNames[idx].c_str(),
+                    profile.routeOperators[idx]);
+}
+
+void printRoutes(Solution const &solution)
+{
+    printf("\nRoutes\n");
+    auto const &routes = solution.routes();
+    for (size_t idx = 0; idx != routes.size(); ++idx)
+    {
+        printf("  #%zu:", idx + 1);
+        for (auto const client : routes[idx].visits())
+            printf(" %zu", client);
+        printf("\n");
+    }
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    auto const options = parseOptions(argc, argv);
+
+    try
+    {
+        auto const start = std::chrono::steady_clock::now();
+        auto const data = readInstance(options);
+        std::chrono::duration<double, std::milli> const readMs
+            = std::chrono::steady_clock::now() - start;
+
+        printf("Instance: %s\n", options.path.c_str());
+        printf("  %zu clients, %zu depots, %zu vehicle types, %zu profiles\n",
+               data.numClients(),
+               data.numDepots(),
+               data.numVehicleTypes(),
+               data.numProfiles());
+
+        auto const result = exvrp::solve(data, options.params);
+        auto const &best = *result.best;
+        auto const &timings = result.timings;
+
+        printf("\nResult\n");
+        printf("  cost:         %lld\n",
+               static_cast<long long>(result.finalCost));
+        printf("  feasible:     %s\n", best.isFeasible() ? "yes" : "no");
+        printf("  routes:       %zu\n", best.numRoutes());
+        printf("  distance:     %lld\n",
+               static_cast<long long>(best.distance()));
+        printf("  duration:     %lld\n",
+               static_cast<long long>(best.duration()));
+        printf("  iterations:   %zu\n", result.numIterations);
+        printf("  improvements: %zu\n", result.improvements);
+        printf("  restarts:     %zu\n", result.restarts);
+        if (options.params.decomposition.interval > 0)
+            printf("  decompositions: %zu (%zu improved)\n",
+                   result.decompositions,
+                   result.decompositionImprovements);
+
+        printf("\nTimings (ms)\n");
+        printf("  read instance:    %10.3f\n", readMs.count());
+        printf("  penalty init:     %10.3f\n", timings.penaltyInitMs);
+        printf("  neighbours:       %10.3f\n", timings.neighboursMs);
+        printf("  local search:     %10.3f\n", timings.localSearchMs);
+        printf("  initial solution: %10.3f\n", timings.initialSolutionMs);
+        printf("  ILS loop:         %10.3f\n", timings.ilsMs);
+        printf("  solve total:      %10.3f\n",
+               static_cast<double>(result.runtimeMs));
+
+        if (options.params.profile)
+            printProfile(result);
+
+        if (options.routes)
+            printRoutes(best);
+    }
+    catch (std::exception const &error)
+    {
+        fprintf(stderr, "%s: %s\n", argv[0], error.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -7,23 +7,177 @@
  * Build: make test-solver
  * Run:   valgrind --error-exitcode=1 ./solver_test
  */
+#include "exvrp/Crossover.h"
+#include "exvrp/Decomposition.h"
+#include "exvrp/EliteArchive.h"
+#include "exvrp/IteratedLocalSearch.h"
+#include "exvrp/Neighbourhood.h"
+#include "exvrp/Population.h"
+#include "exvrp/ProblemDataIO.h"
+#include "exvrp/Reclaimer.h"
 #include "pyvrp/ProblemData.h"
 #include "pyvrp/RandomNumberGenerator.h"
 #include "pyvrp/Solution.h"
 #include "pyvrp/search/Exchange.h"
 #include "pyvrp/search/LocalSearch.h"
+#include "pyvrp/search/OrOptReverse.h"
 #include "pyvrp/search/PerturbationManager.h"
 #include "pyvrp/search/RelocateWithDepot.h"
+#include "pyvrp/search/Solution.h"
 #include "pyvrp/search/SwapRoutes.h"
 #include "pyvrp/search/SwapTails.h"
+#include "pyvrp/search/TwoOpt.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 using namespace pyvrp;
 
+// ---------------------------------------------------------------------------
+// Allocation counting
+// ---------------------------------------------------------------------------
+
+// Replaces the global allocation functions to count heap allocations while
+// countAllocations is set. All forms (array, aligned, nothrow) are replaced
+// consistently, and are backed by malloc/free, so valgrind still checks every
+// allocation.
+bool countAllocations = false;
+size_t numAllocations = 0;
+
+namespace
+{
+void *countedAlloc(size_t size, size_t align = 0) noexcept
+{
+    if (countAllocations)
+        numAllocations++;
+
+    size = std::max<size_t>(size, 1);
+    if (align <= alignof(std::max_align_t))
+        return std::malloc(size);
+
+    // aligned_alloc requires the size to be a multiple of the alignment.
+    return std::aligned_alloc(align, (size + align - 1) / align * align);
+}
+
+// Not inlined, so that the compiler does not pair free() with the operator
+// new at the call sites and warn about mismatched allocation functions.
+[[gnu::noinline]] void countedFree(void *ptr) noexcept { std::free(ptr); }
+
+void *countedAllocOrThrow(size_t size, size_t align = 0)
+{
+    if (auto *ptr = countedAlloc(size, align))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+}  // namespace
+
+void *operator new(size_t size) { return countedAllocOrThrow(size); }
+
+void *operator new[](size_t size) { return countedAllocOrThrow(size); }
+
+void *operator new(size_t size, std::align_val_t align)
+{
+    return countedAllocOrThrow(size, static_cast<size_t>(align));
+}
+
+void *operator new[](size_t size, std::align_val_t align)
+{
+    return countedAllocOrThrow(size, static_cast<size_t>(align));
+}
+
+void *operator new(size_t size, std::nothrow_t const &) noexcept
+{
+    return countedAlloc(size);
+}
+
+void *operator new[](size_t size, std::nothrow_t const &) noexcept
+{
+    return countedAlloc(size);
+}
+
+void *operator new(size_t size,
+                   std::align_val_t align,
+                   std::nothrow_t const &) noexcept
+{
+    return countedAlloc(size, static_cast<size_t>(align));
+}
+
+void *operator new[](size_t size,
+                     std::align_val_t align,
+                     std::nothrow_t const &) noexcept
+{
+    return countedAlloc(size, static_cast<size_t>(align));
+}
+
+void operator delete(void *ptr) noexcept { countedFree(ptr); }
+
+void operator delete[](void *ptr) noexcept { countedFree(ptr); }
+
+void operator delete(void *ptr, size_t) noexcept { countedFree(ptr); }
+
+void operator delete[](void *ptr, size_t) noexcept { countedFree(ptr); }
+
+void operator delete(void *ptr, std::align_val_t) noexcept { countedFree(ptr); }
+
+void operator delete[](void *ptr, std::align_val_t) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete(void *ptr, std::nothrow_t const &) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete[](void *ptr, std::nothrow_t const &) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete(void *ptr,
+                     std::align_val_t,
+                     std::nothrow_t const &) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete[](void *ptr,
+                       std::align_val_t,
+                       std::nothrow_t const &) noexcept
+{
+    countedFree(ptr);
+}
+
+// Returns the number of heap allocations made by calling fn.
+template <typename Fn> size_t allocationsOf(Fn &&fn)
+{
+    numAllocations = 0;
+    countAllocations = true;
+    fn();
+    countAllocations = false;
+    return numAllocations;
+}
+
 // ---------------------------------------------------------------------------
 // Helpers
 // ---------------------------------------------------------------------------
@@ -1011,6 +1165,2025 @@ void test_backhaul_like()
     PASS();
 }
 
+void test_incremental_insert()
+{
+    TEST("incremental insert (20 clients, 3 arrive late)");
+
+    size_t n = 21;  // 1 depot + 20 clients
+    std::vector<std::pair<int64_t, int64_t>> coords;
+    coords.push_back({0, 0});
+    for (size_t i = 1; i < n; ++i)
+        coords.push_back({static_cast<int64_t>((i * 11) % 100),
+                          static_cast<int64_t>((i * 17) % 100)});
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t i = 1; i < n; ++i)
+        clients.emplace_back(coords[i].first,
+                             coords[i].second,
+                             std::vector<Load>{1},
+                             std::vector<Load>{},
+                             Duration(0),
+                             Duration(0),
+                             Duration(100000),
+                             Duration(0),
+                             Cost(0),
+                             true,
+                             std::nullopt,
+                             "");
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(
+        0, 0, Duration(0), Duration(100000), Duration(0), Cost(0), "");
+
+    std::vector<ProblemData::VehicleType> vts;
+    vts.emplace_back(3,
+                     std::vector<Load>{10},
+                     0,
+                     0,
+                     Cost(0),
+                     Duration(0),
+                     Duration(100000),
+                     Duration(100000),
+                     Distance(std::numeric_limits<int64_t>::max()),
+                     Cost(1),
+                     Cost(0),
+                     0,
+                     std::nullopt,
+                     std::vector<Load>{},
+                     std::vector<size_t>{},
+                     0,
+                     Duration(0),
+                     Cost(0),
+                     "");
+
+    std::vector<Matrix<Distance>> distMats;
+    distMats.push_back(makeDistMatrix(n, coords));
+    std::vector<Matrix<Duration>> durMats;
+    durMats.push_back(makeDurMatrix(n, coords));
+
+    ProblemData pd(std::move(clients),
+                   std::move(depots),
+                   std::move(vts),
+                   std::move(distMats),
+                   std::move(durMats),
+                   {},
+                   {});
+
+    // Plan without the last three clients, as if they arrived later.
+    std::vector<std::vector<size_t>> plan = {{1, 2, 3, 4, 5, 6},
+                                             {7, 8, 9, 10, 11, 12},
+                                             {13, 14, 15, 16, 17}};
+    Solution partial(pd, plan);
+    assert(partial.numClients() == 17);
+
+    auto neighbours = buildNeighbours(pd);
+    TestLocalSearch tls(pd, neighbours);
+
+    CostEvaluator costEval(
+        std::vector<double>(pd.numLoadDimensions(), 100000.0),
+        100000.0,
+        100000.0);
+
+    auto result = tls.ls->insert(partial, {18, 19, 20}, costEval, 100);
+    assert(result.numClients() == 20);
+    assert(result.isFeasible());
+    PASS();
+}
+
+void test_locked_prefixes()
+{
+    TEST("locked route prefixes (20 clients, perturbation + insert)");
+
+    size_t n = 21;  // 1 depot + 20 clients
+    std::vector<std::pair<int64_t, int64_t>> coords;
+    coords.push_back({0, 0});
+    for (size_t i = 1; i < n; ++i)
+        coords.push_back({static_cast<int64_t>((i * 11) % 100),
+                          static_cast<int64_t>((i * 17) % 100)});
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t i = 1; i < n; ++i)
+        clients.emplace_back(coords[i].first,
+                             coords[i].second,
+                             std::vector<Load>{1},
+                             std::vector<Load>{},
+                             Duration(0),
+                             Duration(0),
+                             Duration(100000),
+                             Duration(0),
+                             Cost(0),
+                             true,
+                             std::nullopt,
+                             "");
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(
+        0, 0, Duration(0), Duration(100000), Duration(0), Cost(0), "");
+
+    std::vector<ProblemData::VehicleType> vts;
+    vts.emplace_back(3,
+                     std::vector<Load>{10},
+                     0,
+                     0,
+                     Cost(0),
+                     Duration(0),
+                     Duration(100000),
+                     Duration(100000),
+                     Distance(std::numeric_limits<int64_t>::max()),
+                     Cost(1),
+                     Cost(0),
+                     0,
+                     std::nullopt,
+                     std::vector<Load>{},
+                     std::vector<size_t>{},
+                     0,
+                     Duration(0),
+                     Cost(0),
+                     "");
+
+    std::vector<Matrix<Distance>> distMats;
+    distMats.push_back(makeDistMatrix(n, coords));
+    std::vector<Matrix<Duration>> durMats;
+    durMats.push_back(makeDurMatrix(n, coords));
+
+    ProblemData pd(std::move(clients),
+                   std::move(depots),
+                   std::move(vts),
+                   std::move(distMats),
+                   std::move(durMats),
+                   {},
+                   {});
+
+    // Deliberately poor plan: the locked prefixes (the first two stops of each
+    // route) are far apart, so the search would like to move them.
+    std::vector<std::vector<size_t>> plan = {{9, 1, 2, 3, 4, 5, 6},
+                                             {18, 7, 8, 10, 11, 12},
+                                             {13, 14, 15, 16, 17}};
+    Solution planned(pd, plan);
+
+    std::vector<std::vector<size_t>> prefixes = {{9, 1}, {18, 7}, {13, 14}};
+    std::vector<size_t> locked;
+    for (auto const &prefix : prefixes)
+        locked.insert(locked.end(), prefix.begin(), prefix.end());
+
+    auto neighbours = buildNeighbours(pd);
+    TestLocalSearch tls(pd, neighbours);
+    tls.ls->setLocked(locked);
+
+    CostEvaluator costEval(
+        std::vector<double>(pd.numLoadDimensions(), 100000.0),
+        100000.0,
+        100000.0);
+
+    auto const hasPrefix = [&](Solution const &sol)
+    {
+        for (auto const &prefix : prefixes)
+        {
+            bool found = false;
+            for (auto const &route : sol.routes())
+            {
+                auto const visits = route.visits();
+                if (visits.size() >= prefix.size()
+                    && std::equal(prefix.begin(), prefix.end(), visits.begin()))
+                    found = true;
+            }
+
+            if (!found)
+                return false;
+        }
+
+        return true;
+    };
+
+    RandomNumberGenerator rng(42);
+    auto sol = std::make_unique<Solution>(planned);
+    for (int i = 0; i < 10; ++i)
+    {
+        tls.ls->shuffle(rng);
+        sol = std::make_unique<Solution>((*tls.ls)(*sol, costEval));
+        assert(hasPrefix(*sol));
+    }
+
+    auto result = tls.ls->insert(*sol, {19, 20}, costEval, 100);
+    assert(hasPrefix(result));
+    assert(result.numClients() == 20);
+
+    // Clients may be moved directly after the last locked client: here, 3 is
+    // best served right after the locked prefix 1 -> 2 of the first route.
+    std::vector<std::pair<int64_t, int64_t>> line
+        = {{0, 0}, {10, 0}, {20, 0}, {21, 0}};
+
+    std::vector<ProblemData::Client> lineClients;
+    for (size_t i = 1; i != line.size(); ++i)
+        lineClients.emplace_back(line[i].first,
+                                 line[i].second,
+                                 std::vector<Load>{1},
+                                 std::vector<Load>{},
+                                 Duration(0),
+                                 Duration(0),
+                                 Duration(100000),
+                                 Duration(0),
+                                 Cost(0),
+                                 true,
+                                 std::nullopt,
+                                 "");
+
+    ProblemData linePd(std::move(lineClients),
+                       pd.depots(),
+                       pd.vehicleTypes(),
+                       {makeDistMatrix(line.size(), line)},
+                       {makeDurMatrix(line.size(), line)},
+                       {},
+                       {});
+
+    auto lineNeighbours = buildNeighbours(linePd);
+    TestLocalSearch lineLs(linePd, lineNeighbours);
+    lineLs.ls->setLocked({1, 2});
+
+    Solution linePlan(linePd, {{1, 2}, {3}});
+    auto const improved = lineLs.ls->search(linePlan, costEval);
+    assert(improved.numRoutes() == 1);
+    assert((improved.routes()[0].visits() == std::vector<size_t>{1, 2, 3}));
+    PASS();
+}
+
+void test_problem_data_update()
+{
+    TEST("problem data update (shares unchanged matrices)");
+
+    size_t n = 11;  // 1 depot + 10 clients
+    std::vector<std::pair<int64_t, int64_t>> coords;
+    coords.push_back({0, 0});
+    for (size_t i = 1; i < n; ++i)
+        coords.push_back({static_cast<int64_t>((i * 13) % 50),
+                          static_cast<int64_t>((i * 7) % 50)});
+
+    auto makeClient = [&](size_t idx, Duration twEarly, Duration twLate)
+    {
+        return ProblemData::Client(coords[idx].first,
+                                   coords[idx].second,
+                                   std::vector<Load>{1},
+                                   std::vector<Load>{},
+                                   Duration(0),
+                                   twEarly,
+                                   twLate,
+                                   Duration(0),
+                                   Cost(0),
+                                   true,
+                                   std::nullopt,
+                                   "");
+    };
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t i = 1; i < n; ++i)
+        clients.push_back(makeClient(i, Duration(0), Duration(100000)));
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(
+        0, 0, Duration(0), Duration(100000), Duration(0), Cost(0), "");
+
+    std::vector<ProblemData::VehicleType> vts;
+    vts.emplace_back(2,
+                     std::vector<Load>{10},
+                     0,
+                     0,
+                     Cost(0),
+                     Duration(0),
+                     Duration(100000),
+                     Duration(100000),
+                     Distance(std::numeric_limits<int64_t>::max()),
+                     Cost(1),
+                     Cost(0),
+                     0,
+                     std::nullopt,
+                     std::vector<Load>{},
+                     std::vector<size_t>{},
+                     0,
+                     Duration(0),
+                     Cost(0),
+                     "");
+
+    std::vector<Matrix<Distance>> distMats;
+    distMats.push_back(makeDistMatrix(n, coords));
+    std::vector<Matrix<Duration>> durMats;
+    durMats.push_back(makeDurMatrix(n, coords));
+
+    ProblemData pd(std::move(clients),
+                   std::move(depots),
+                   std::move(vts),
+                   std::move(distMats),
+                   std::move(durMats),
+                   {},
+                   {});
+
+    // A new time window for client 4 leaves both matrices and the other
+    // clients untouched.
+    auto updated = pd.update(
+        {{4, makeClient(4, Duration(500), Duration(1000))}}, {}, {});
+    assert(updated.distanceMatrix(0) == pd.distanceMatrix(0));
+    assert(&updated.distanceMatrix(0).base() == &pd.distanceMatrix(0).base());
+    assert(&updated.durationMatrix(0).base() == &pd.durationMatrix(0).base());
+    assert(updated.location(4).client->twEarly == Duration(500));
+    assert(&updated.clients()[3] != &pd.clients()[3]);
+    assert(&updated.clients()[2] == &pd.clients()[2]);
+    assert(pd.originalClients()[3].twEarly == Duration(0));
+
+    // Updating a distance row shares the rest of the distance matrix, and all
+    // of the duration matrix.
+    std::vector<Distance> row;
+    for (size_t loc = 0; loc != n; ++loc)
+        row.push_back(pd.distanceMatrix(0)(0, loc));
+
+    row[4] = Distance(1);
+    auto rerouted = updated.update({}, {{0, 0, true, row}}, {});
+    assert(&rerouted.distanceMatrix(0).base() == &pd.distanceMatrix(0).base());
+    assert(&rerouted.durationMatrix(0).base() == &pd.durationMatrix(0).base());
+    assert(rerouted.distanceMatrix(0).numPatches() == 1);
+    assert(rerouted.distanceMatrix(0)(0, 4) == Distance(1));
+    assert(rerouted.distanceMatrix(0)(1, 4) == pd.distanceMatrix(0)(1, 4));
+    assert(updated.distanceMatrix(0)(0, 4) != Distance(1));
+    assert(rerouted.location(4).client->twEarly == Duration(500));
+
+    // A later column update takes precedence where it crosses the row. This
+    // is the second update of an 11 x 11 matrix, which is enough to fold both
+    // into new dense storage.
+    std::vector<Distance> col(n, Distance(7));
+    col[4] = Distance(0);
+    auto const recol = rerouted.update({}, {{0, 4, false, col}}, {});
+    auto const &dists = recol.distanceMatrix(0);
+    assert(dists.numPatches() == 0);
+    assert(&dists.base() != &pd.distanceMatrix(0).base());
+    assert(dists(0, 4) == Distance(7) && dists(0, 5) == row[5]);
+    assert(dists(3, 4) == Distance(7));
+    assert(dists(3, 5) == pd.distanceMatrix(0)(3, 5));
+
+    // Solving the updated data must respect the new time window.
+    auto sol = solveEmpty(updated);
+    assert(sol.isFeasible());
+
+    // A search rebound to a new version finds the same solution as a search
+    // built around it, also after it searched the previous version.
+    CostEvaluator costEval({100}, 100.0, 100.0);
+    TestLocalSearch rebound(pd, buildNeighbours(pd));
+    auto const previous = rebound.ls->search(solveEmpty(pd), costEval);
+
+    std::vector<std::vector<size_t>> plan;
+    for (auto const &route : previous.routes())
+        plan.push_back(route.visits());
+
+    Solution const start(recol, plan);
+    rebound.ls->setData(recol, buildNeighbours(recol));
+    TestLocalSearch fresh(recol, buildNeighbours(recol));
+    assert(rebound.ls->search(start, costEval)
+           == fresh.ls->search(start, costEval));
+    PASS();
+}
+
+void test_native_ils()
+{
+    TEST("native ILS (30 clients, 200 iterations, deterministic)");
+
+    size_t n = 31;  // 1 depot + 30 clients
+    std::vector<std::pair<int64_t, int64_t>> coords;
+    coords.push_back({50, 50});
+    for (size_t i = 1; i < n; ++i)
+        coords.push_back({static_cast<int64_t>((i * 37) % 100),
+                          static_cast<int64_t>((i * 53) % 100)});
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t i = 1; i < n; ++i)
+        clients.emplace_back(coords[i].first,
+                             coords[i].second,
+                             std::vector<Load>{1},
+                             std::vector<Load>{},
+                             Duration(0),
+                             Duration(0),
+                             Duration(100000),
+                             Duration(0),
+                             Cost(0),
+                             true,
+                             std::nullopt,
+                             "");
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(
+        50, 50, Duration(0), Duration(100000), Duration(0), Cost(0), "");
+
+    std::vector<ProblemData::VehicleType> vts;
+    vts.emplace_back(4,
+                     std::vector<Load>{10},
+                     0,
+                     0,
+                     Cost(0),
+                     Duration(0),
+                     Duration(100000),
+                     Duration(100000),
+                     Distance(std::numeric_limits<int64_t>::max()),
+                     Cost(1),
+                     Cost(0),
+                     0,
+                     std::nullopt,
+                     std::vector<Load>{},
+                     std::vector<size_t>{},
+                     0,
+                     Duration(0),
+                     Cost(0),
+                     "");
+
+    std::vector<Matrix<Distance>> distMats;
+    distMats.push_back(makeDistMatrix(n, coords));
+    std::vector<Matrix<Duration>> durMats;
+    durMats.push_back(makeDurMatrix(n, coords));
+
+    ProblemData pd(std::move(clients),
+                   std::move(depots),
+                   std::move(vts),
+                   std::move(distMats),
+                   std::move(durMats),
+                   {},
+                   {});
+
+    exvrp::SolveParams params;
+    params.seed = 7;
+    params.maxIterations = 200;
+    params.ils.maxNoImprovement = 50;  // also exercise restarts
+
+    auto const result = exvrp::solve(pd, params);
+    assert(result.numIterations == 200);
+    assert(result.restarts > 0);
+    assert(result.best->isFeasible());
+    assert(result.best->numClients() == 30);
+    assert(result.finalCost <= result.initialCost);
+
+    auto const again = exvrp::solve(pd, params);
+    assert(again.finalCost == result.finalCost);
+    assert(again.improvements == result.improvements);
+    PASS();
+}
+
+void test_problem_data_dump()
+{
+    TEST("problem data dump round trip and VRPLIB reading");
+
+    size_t n = 9;  // 1 depot + 8 clients
+    std::vector<std::pair<int64_t, int64_t>> coords;
+    coords.push_back({0, 0});
+    for (size_t i = 1; i < n; ++i)
+        coords.push_back({static_cast<int64_t>((i * 11) % 40),
+                          static_cast<int64_t>((i * 17) % 40)});
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t i = 1; i < n; ++i)
+        clients.emplace_back(coords[i].first,
+                             coords[i].second,
+                             std::vector<Load>{1, 2},
+                             std::vector<Load>{0, 1},
+                             Duration(5),
+                             Duration(10 * i),
+                             Duration(5000),
+                             Duration(0),
+                             Cost(i % 2 ? 0 : 40),
+                             i % 2 == 1,
+                             std::nullopt,
+                             "client " + std::to_string(i));
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(
+        0, 0, Duration(0), Duration(10000), Duration(3), Cost(0), "hub");
+
+    std::vector<ProblemData::VehicleType> vts;
+    vts.emplace_back(3,
+                     std::vector<Load>{6, 9},
+                     0,
+                     0,
+                     Cost(10),
+                     Duration(0),
+                     Duration(10000),
+                     Duration(8000),
+                     Distance(std::numeric_limits<int64_t>::max()),
+                     Cost(1),
+                     Cost(2),
+                     0,
+                     std::nullopt,
+                     std::vector<Load>{},
+                     std::vector<size_t>{},
+                     0,
+                     Duration(0),
+                     Cost(0),
+                     "van");
+
+    std::vector<Matrix<Distance>> distMats;
+    distMats.push_back(makeDistMatrix(n, coords));
+    std::vector<Matrix<Duration>> durMats;
+    durMats.push_back(makeDurMatrix(n, coords));
+
+    ProblemData pd(std::move(clients),
+                   std::move(depots),
+                   std::move(vts),
+                   std::move(distMats),
+                   std::move(durMats),
+                   {},
+                   {});
+
+    auto const dump = exvrp::serialise(pd);
+    assert(exvrp::isDump(dump));
+    assert(exvrp::deserialise(dump) == pd);
+
+    // A truncated dump must be rejected, not read past its end.
+    bool threw = false;
+    try
+    {
+        exvrp::deserialise(std::string_view(dump).substr(0, dump.size() / 2));
+    }
+    catch (std::invalid_argument const &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    std::istringstream vrplib("NAME : tiny\n"
+                              "TYPE : CVRP\n"
+                              "DIMENSION : 4\n"
+                              "EDGE_WEIGHT_TYPE : EUC_2D\n"
+                              "CAPACITY : 10\n"
+                              "NODE_COORD_SECTION\n"
+                              "1 0 0\n2 3 4\n3 6 8\n4 0 5\n"
+                              "DEMAND_SECTION\n"
+                              "1 0\n2 4\n3 4\n4 4\n"
+                              "DEPOT_SECTION\n1\n-1\n"
+                              "EOF\n");
+
+    auto const tiny = exvrp::readVrplib(vrplib, exvrp::RoundFunc::ROUND);
+    assert(tiny.numDepots() == 1);
+    assert(tiny.numClients() == 3);
+    assert(tiny.distanceMatrix(0)(0, 2) == Distance(10));
+    assert(!exvrp::isDump("NAME : tiny"));
+    PASS();
+}
+
+void test_allocation_free_search()
+{
+    TEST("local search does not allocate beyond its result");
+
+    // Prize-collecting instance with a reload depot and a mutually exclusive
+    // group, so that perturbation, group moves and the multi-trip pass all
+    // run in each call.
+    size_t n = 41;
+    std::vector<std::pair<int64_t, int64_t>> coords;
+    coords.push_back({50, 50});
+    coords.push_back({20, 80});  // reload depot
+    for (size_t i = 2; i < n; ++i)
+        coords.push_back({static_cast<int64_t>((i * 37) % 100),
+                          static_cast<int64_t>((i * 53) % 100)});
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t i = 2; i < n; ++i)
+    {
+        std::optional<size_t> group;
+        if (i >= 36)
+            group = 0;
+
+        bool required = i < 30;
+        Cost prize = required ? Cost(0) : Cost(40);
+        clients.emplace_back(coords[i].first,
+                             coords[i].second,
+                             std::vector<Load>{2},
+                             std::vector<Load>{},
+                             Duration(5),
+                             Duration(0),
+                             Duration(100000),
+                             Duration(0),
+                             prize,
+                             required && !group,
+                             group,
+                             "");
+    }
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(
+        50, 50, Duration(0), Duration(100000), Duration(0), Cost(0), "");
+    depots.emplace_back(
+        20, 80, Duration(0), Duration(100000), Duration(0), Cost(0), "");
+
+    std::vector<ProblemData::VehicleType> vts;
+    vts.emplace_back(3,
+                     std::vector<Load>{12},
+                     0,
+                     0,
+                     Cost(0),
+                     Duration(0),
+                     Duration(100000),
+                     Duration(100000),
+                     Distance(std::numeric_limits<int64_t>::max()),
+                     Cost(1),
+                     Cost(0),
+                     0,
+                     std::nullopt,
+                     std::vector<Load>{},
+                     std::vector<size_t>{1},
+                     2,
+                     Duration(0),
+                     Cost(0),
+                     "");
+
+    std::vector<Matrix<Distance>> distMats;
+    distMats.push_back(makeDistMatrix(n, coords));
+    std::vector<Matrix<Duration>> durMats;
+    durMats.push_back(makeDurMatrix(n, coords));
+
+    std::vector<ProblemData::ClientGroup> groups;
+    groups.emplace_back(std::vector<size_t>{36, 37, 38, 39, 40}, false);
+
+    ProblemData pd(std::move(clients),
+                   std::move(depots),
+                   std::move(vts),
+                   std::move(distMats),
+                   std::move(durMats),
+                   std::move(groups),
+                   {});
+
+    auto neighbours = buildNeighbours(pd);
+    TestLocalSearch tls(pd, neighbours);
+    CostEvaluator costEval(std::vector<double>(1, 20.0), 6.0, 6.0);
+
+    std::vector<std::vector<size_t>> emptyRoutes;
+    Solution emptySol(pd, emptyRoutes);
+    auto sol
+        = std::make_unique<Solution>(tls.ls->search(emptySol, costEval, 0));
+
+    // Each call must allocate its result, which we measure by converting the
+    // result once more with a separate search solution. Everything else the
+    // search needs should come from buffers that have grown to size during
+    // the warm-up calls. Routes may still grow on occasion, but not anywhere
+    // near once per call.
+    RandomNumberGenerator rng(42);
+    search::Solution output(pd);
+    size_t const numWarmUp = 10;
+    size_t const numCalls = 20;
+    size_t numExtra = 0;
+
+    for (size_t call = 0; call != numWarmUp + numCalls; ++call)
+    {
+        tls.ls->shuffle(rng);
+
+        std::unique_ptr<Solution> next;
+        auto const searchAllocs = allocationsOf(
+            [&]
+            { next = std::make_unique<Solution>((*tls.ls)(*sol, costEval)); });
+
+        output.load(*next);
+        auto const outputAllocs = allocationsOf(
+            [&] { std::make_unique<Solution>(output.unload()); });
+
+        if (call >= numWarmUp && searchAllocs > outputAllocs)
+            numExtra += searchAllocs - outputAllocs;
+
+        sol = std::move(next);
+    }
+
+    assert(numExtra < numCalls);
+    PASS();
+}
+
+void test_missing_clients_index()
+{
+    TEST("missing clients index follows route changes");
+
+    // Clients 1-4 are required, 5-8 have a prize, and 9-12 form a group.
+    // Time windows open in reverse order of the client index, with ties.
+    size_t n = 13;
+    std::vector<std::pair<int64_t, int64_t>> coords;
+    coords.push_back({0, 0});
+    for (size_t i = 1; i < n; ++i)
+        coords.push_back({static_cast<int64_t>((i * 13) % 50),
+                          static_cast<int64_t>((i * 29) % 50)});
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t i = 1; i < n; ++i)
+    {
+        std::optional<size_t> group;
+        if (i >= 9)
+            group = 0;
+
+        clients.emplace_back(coords[i].first,
+                             coords[i].second,
+                             std::vector<Load>{1},
+                             std::vector<Load>{},
+                             Duration(0),
+                             Duration(100 * ((n - i) / 2)),
+                             Duration(100000),
+                             Duration(0),
+                             Cost(i >= 5 && i <= 8 ? 10 : 0),
+                             i <= 4,
+                             group,
+                             "");
+    }
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(
+        0, 0, Duration(0), Duration(100000), Duration(0), Cost(0), "");
+
+    std::vector<ProblemData::VehicleType> vts;
+    vts.emplace_back(2,
+                     std::vector<Load>{20},
+                     0,
+                     0,
+                     Cost(0),
+                     Duration(0),
+                     Duration(100000),
+                     Duration(100000),
+                     Distance(std::numeric_limits<int64_t>::max()),
+                     Cost(1),
+                     Cost(0),
+                     0,
+                     std::nullopt,
+                     std::vector<Load>{},
+                     std::vector<size_t>{},
+                     0,
+                     Duration(0),
+                     Cost(0),
+                     "");
+
+    std::vector<Matrix<Distance>> distMats;
+    distMats.push_back(makeDistMatrix(n, coords));
+    std::vector<Matrix<Duration>> durMats;
+    durMats.push_back(makeDurMatrix(n, coords));
+
+    std::vector<ProblemData::ClientGroup> groups;
+    groups.emplace_back(std::vector<size_t>{9, 10, 11, 12}, true);
+
+    ProblemData pd(std::move(clients),
+                   std::move(depots),
+                   std::move(vts),
+                   std::move(distMats),
+                   std::move(durMats),
+                   std::move(groups),
+                   {});
+
+    search::Solution sol(pd);
+
+    // Compares each set of the index against a scan over all clients.
+    auto const check = [&]()
+    {
+        using Kind = search::MissingClients::Kind;
+        for (auto kind : {Kind::REQUIRED, Kind::PRIZE, Kind::GROUP})
+        {
+            std::vector<size_t> expected;
+            for (size_t client = 1; client != n; ++client)
+            {
+                ProblemData::Client const &data = pd.location(client);
+                bool const isKind = kind == Kind::REQUIRED ? data.required
+                                    : kind == Kind::PRIZE  ? data.prize > 0
+                                                           : bool(data.group);
+                if (isKind && !sol.nodes[client].route())
+                    expected.push_back(client);
+            }
+
+            std::stable_sort(expected.begin(),
+                             expected.end(),
+                             [&](size_t client1, size_t client2)
+                             {
+                                 ProblemData::Client const &c1
+                                     = pd.location(client1);
+                                 ProblemData::Client const &c2
+                                     = pd.location(client2);
+                                 return c1.twEarly < c2.twEarly;
+                             });
+
+            std::vector<size_t> actual;
+            sol.missing.forEach(kind,
+                                [&](size_t client)
+                                { actual.push_back(client); });
+            assert(actual == expected);
+        }
+    };
+
+    check();  // all clients are missing
+
+    std::vector<std::vector<size_t>> plan = {{1, 2, 5, 9}, {3, 6, 7}};
+    sol.load(Solution(pd, plan));
+    check();
+
+    auto &route0 = sol.routes[0];
+    auto &route1 = sol.routes[1];
+    route0.remove(sol.nodes[5].idx());  // prize client leaves
+    route1.insert(1, &sol.nodes[4]);    // required client enters
+    route0.update();
+    route1.update();
+    check();
+
+    search::Route::swap(&sol.nodes[9], &sol.nodes[10]);  // 10 replaces 9
+    route0.update();
+    check();
+
+    plan = {{8, 12}};
+    sol.load(Solution(pd, plan));
+    check();
+
+    route0.clear();
+    check();
+    PASS();
+}
+
+void test_vehicle_type_dominance()
+{
+    TEST("dominated vehicle types skip empty routes");
+
+    size_t n = 22;
+    std::vector<std::pair<int64_t, int64_t>> coords;
+    coords.push_back({50, 50});
+    coords.push_back({10, 10});  // second depot
+    for (size_t i = 2; i < n; ++i)
+        coords.push_back({static_cast<int64_t>((i * 37) % 100),
+                          static_cast<int64_t>((i * 53) % 100)});
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t i = 2; i < n; ++i)
+        clients.emplace_back(coords[i].first,
+                             coords[i].second,
+                             std::vector<Load>{3});
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(50, 50);
+    depots.emplace_back(10, 10);
+
+    // Type 0 is smaller and more expensive than types 1 and 2, which are
+    // identical. Type 3 starts at the other depot, and type 4 is smaller
+    // but has no distance cost. Neither compares to the others.
+    auto const vehicleType = [](size_t numAvailable,
+                                Load capacity,
+                                size_t depot,
+                                Cost fixedCost,
+                                Cost unitDistanceCost)
+    {
+        return ProblemData::VehicleType(numAvailable,
+                                        {capacity},
+                                        depot,
+                                        depot,
+                                        fixedCost,
+                                        0,
+                                        std::numeric_limits<Duration>::max(),
+                                        std::numeric_limits<Duration>::max(),
+                                        std::numeric_limits<Distance>::max(),
+                                        unitDistanceCost);
+    };
+
+    std::vector<ProblemData::VehicleType> vts;
+    vts.push_back(vehicleType(3, 10, 0, 5, 1));
+    vts.push_back(vehicleType(2, 20, 0, 0, 1));
+    vts.push_back(vehicleType(2, 20, 0, 0, 1));
+    vts.push_back(vehicleType(2, 30, 1, 0, 1));
+    vts.push_back(vehicleType(2, 5, 0, 0, 0));
+
+    std::vector<Matrix<Distance>> distMats;
+    distMats.push_back(makeDistMatrix(n, coords));
+    std::vector<Matrix<Duration>> durMats;
+    durMats.push_back(makeDurMatrix(n, coords));
+
+    ProblemData pd(std::move(clients),
+                   std::move(depots),
+                   std::move(vts),
+                   std::move(distMats),
+                   std::move(durMats),
+                   {},
+                   {});
+
+    using Types = std::vector<size_t>;
+    assert(pd.vehicleTypeDominators(0) == (Types{1, 2}));
+    assert(pd.vehicleTypeDominators(1) == Types{});
+    assert(pd.vehicleTypeDominators(2) == Types{1});
+    assert(pd.vehicleTypeDominators(3) == Types{});
+    assert(pd.vehicleTypeDominators(4) == Types{});
+
+    // Only types with an empty dominating route are skipped. The type 1
+    // routes are at indices 3 and 4.
+    search::Solution searchSol(pd);
+    assert(searchSol.hasDominatingEmptyRoute(0));
+    assert(!searchSol.hasDominatingEmptyRoute(1));
+    assert(searchSol.hasDominatingEmptyRoute(2));
+
+    Route route1(pd, std::vector<size_t>{2, 3}, 1);
+    Route route2(pd, std::vector<size_t>{4}, 1);
+
+    searchSol.load(Solution(pd, std::vector<Route>{route1}));
+    assert(searchSol.hasDominatingEmptyRoute(2));
+
+    searchSol.load(Solution(pd, std::vector<Route>{route1, route2}));
+    assert(searchSol.hasDominatingEmptyRoute(0));  // type 2 is still empty
+    assert(!searchSol.hasDominatingEmptyRoute(2));
+
+    // Skipping dominated empty routes must not keep the search from serving
+    // all clients within capacity.
+    auto neighbours = buildNeighbours(pd);
+    TestLocalSearch tls(pd, neighbours);
+    CostEvaluator costEval(std::vector<double>(1, 1000.0), 6.0, 6.0);
+
+    std::vector<std::vector<size_t>> emptyRoutes;
+    auto sol = std::make_unique<Solution>(pd, emptyRoutes);
+    for (size_t iter = 0; iter != 5; ++iter)
+        sol = std::make_unique<Solution>((*tls.ls)(*sol, costEval));
+
+    assert(sol->isFeasible());
+    assert(sol->numClients() == pd.numClients());
+    PASS();
+}
+
+void test_reachable_neighbours()
+{
+    TEST("neighbours share a reachable vehicle type (2 profiles)");
+
+    // Profile 0 cannot reach clients 31-40, and profile 1 cannot reach
+    // clients 1-10. Clients 11-30 are reachable by both.
+    size_t n = 41;
+    std::vector<std::pair<int64_t, int64_t>> coords;
+    coords.push_back({0, 0});
+    for (size_t i = 1; i < n; ++i)
+        coords.push_back({static_cast<int64_t>((i * 7) % 100),
+                          static_cast<int64_t>((i * 13) % 100)});
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t i = 1; i < n; ++i)
+        clients.emplace_back(
+            coords[i].first, coords[i].second, std::vector<Load>{1});
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(0, 0);
+
+    std::vector<ProblemData::VehicleType> vts;
+    for (size_t profile = 0; profile != 2; ++profile)
+        vts.emplace_back(2,
+                         std::vector<Load>{20},
+                         0,
+                         0,
+                         Cost(0),
+                         Duration(0),
+                         std::numeric_limits<Duration>::max(),
+                         std::numeric_limits<Duration>::max(),
+                         std::numeric_limits<Distance>::max(),
+                         Cost(1),
+                         Cost(0),
+                         profile);
+
+    auto const forbid = [&](size_t first, size_t last)
+    {
+        auto const dist = makeDistMatrix(n, coords);
+        std::vector<Distance> flat;
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                if (j >= first && j <= last && i != j)
+                    flat.push_back(Distance(1000000000));
+                else
+                    flat.push_back(dist(i, j));
+        return Matrix<Distance>(std::move(flat), n, n);
+    };
+
+    std::vector<Matrix<Distance>> distMats;
+    distMats.push_back(forbid(31, 40));
+    distMats.push_back(forbid(1, 10));
+    std::vector<Matrix<Duration>> durMats;
+    durMats.push_back(makeDurMatrix(n, coords));
+    durMats.push_back(makeDurMatrix(n, coords));
+
+    ProblemData pd(std::move(clients),
+                   std::move(depots),
+                   std::move(vts),
+                   std::move(distMats),
+                   std::move(durMats),
+                   {},
+                   {});
+
+    exvrp::Reachability const reachability(pd);
+    assert(reachability.restricted());
+    assert(reachability.canShareRoute(1, 20));
+    assert(reachability.canShareRoute(20, 40));
+    assert(!reachability.canShareRoute(1, 40));
+
+    // Clients 1-10 and 31-40 never neighbour each other. The lists are still
+    // filled up with clients that can share a route.
+    auto const neighbours = exvrp::computeNeighbours(pd, 35);
+    for (size_t client = 1; client != n; ++client)
+    {
+        auto const &list = neighbours[client];
+        auto const expected = client <= 10 || client > 30 ? 29 : 35;
+        assert(list.size() == size_t(expected));
+
+        for (auto const other : list)
+            assert(reachability.canShareRoute(client, other));
+    }
+
+    PASS();
+}
+
+void test_hard_time_windows()
+{
+    TEST("hard time windows remove incompatible arcs");
+
+    // Client 2 opens after client 1 has closed. Client 3 has a wide window,
+    // but its vehicle must be back at the depot at 10000. Clients 2 and 5
+    // are too far apart to be visited in either order.
+    std::vector<std::pair<int64_t, int64_t>> coords
+        = {{0, 0}, {10, 0}, {20, 0}, {40, 0}, {10, 0}, {1500, 0}};
+    size_t n = coords.size();
+
+    auto const client = [&](size_t idx, Duration early, Duration late)
+    {
+        Duration const service = idx == 1 ? 10 : idx == 5 ? 100 : 0;
+        return ProblemData::Client(coords[idx].first,
+                                   coords[idx].second,
+                                   std::vector<Load>{1},
+                                   std::vector<Load>{},
+                                   service,
+                                   early,
+                                   late);
+    };
+
+    std::vector<ProblemData::Client> clients = {client(1, 0, 100),
+                                                client(2, 5000, 6000),
+                                                client(3, 0, 50000),
+                                                client(4, 9950, 50000),
+                                                client(5, 5000, 5005)};
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(0, 0, Duration(0), Duration(10000));
+
+    std::vector<ProblemData::VehicleType> vts;
+    vts.emplace_back(2, std::vector<Load>{10}, 0, 0, Cost(0), 0, 10000);
+
+    ProblemData soft(clients,
+                     depots,
+                     vts,
+                     {makeDistMatrix(n, coords)},
+                     {makeDurMatrix(n, coords)});
+
+    // Only tightened windows account for the return to the depot.
+    ProblemData tightened(clients,
+                          depots,
+                          vts,
+                          {makeDistMatrix(n, coords)},
+                          {makeDurMatrix(n, coords)},
+                          {},
+                          {},
+                          true,
+                          true);
+    assert(!tightened.isArcCompatible(4, 3));
+
+    ProblemData pd(std::move(clients),
+                   std::move(depots),
+                   std::move(vts),
+                   {makeDistMatrix(n, coords)},
+                   {makeDurMatrix(n, coords)},
+                   {},
+                   {},
+                   true);
+
+    assert(!soft.hardTimeWindows() && pd.hardTimeWindows());
+    assert(soft.isArcCompatible(2, 1));
+
+    assert(pd.isArcCompatible(1, 2));
+    assert(!pd.isArcCompatible(2, 1));  // client windows
+    assert(pd.isArcCompatible(3, 4));
+    assert(pd.isArcCompatible(4, 3));
+    assert(!pd.isArcCompatible(2, 5) && !pd.isArcCompatible(5, 2));
+    assert(pd.isArcCompatible(0, 2) && pd.isArcCompatible(2, 0));
+
+    auto const dump = exvrp::serialise(pd);
+    assert(exvrp::deserialise(dump) == pd);
+    assert(!(pd == soft));
+
+    // Updates only recompute the arcs of changed clients, which gives the
+    // same arcs as computing them all again. Client 1 now opens after client
+    // 2, and client 5 moves next to client 2.
+    std::vector<Duration> nearby(n, Duration(1490));
+    nearby[2] = 5;
+    nearby[5] = 0;
+    auto const updated
+        = pd.update({{1, client(1, 7000, 8000)}},
+                    {},
+                    {{0, 5, true, nearby}, {0, 5, false, nearby}});
+    assert(!updated.isArcCompatible(1, 2) && updated.isArcCompatible(2, 1));
+    assert(updated.isArcCompatible(2, 5) && updated.isArcCompatible(5, 2));
+
+    auto const recomputed = exvrp::deserialise(exvrp::serialise(updated));
+    for (size_t from = 0; from != n; ++from)
+        for (size_t to = 0; to != n; ++to)
+            assert(updated.isArcCompatible(from, to)
+                   == recomputed.isArcCompatible(from, to));
+
+    // Clients 2 and 5 can share a route, but not neighbour each other.
+    auto const neighbours = exvrp::computeNeighbours(pd);
+    auto const &of2 = neighbours[2];
+    assert(of2.size() == 3);
+    assert(std::find(of2.begin(), of2.end(), 5) == of2.end());
+
+    // Exchange never proposes a move that creates an incompatible arc. With
+    // client 2 first and client 1 in another route, relocating client 1 after
+    // client 2 would create arc 2 -> 1.
+    std::vector<Route> routes = {Route(pd, std::vector<size_t>{2}, 0),
+                                 Route(pd, std::vector<size_t>{1}, 0)};
+    search::Solution sol(pd);
+    sol.load(Solution(pd, routes));
+
+    search::Exchange<1, 0> relocate(pd);
+    CostEvaluator costEval({20}, 6.0, 6.0);
+    assert(relocate.evaluate(&sol.nodes[1], &sol.nodes[2], costEval) == 0);
+    assert(relocate.evaluate(&sol.nodes[2], sol.routes[1][0], costEval) == 0);
+    assert(relocate.evaluate(&sol.nodes[2], &sol.nodes[1], costEval) < 0);
+    PASS();
+}
+
+void test_time_window_tightening()
+{
+    TEST("client time windows are tightened from the vehicle shifts");
+
+    // The vehicle leaves the depot at 100 and must be back at 900. Client 2
+    // is far from the depot. Client 3's window is already tight, and client 4
+    // cannot be reached in time.
+    std::vector<std::pair<int64_t, int64_t>> coords
+        = {{0, 0}, {10, 0}, {20, 0}, {30, 0}, {40, 0}};
+    size_t n = coords.size();
+
+    auto const durations = [&](Duration depotToClient1)
+    {
+        std::vector<Duration> flat(n * n, Duration(50));
+        for (size_t loc = 0; loc != n; ++loc)
+            flat[loc * n + loc] = 0;
+
+        flat[0 * n + 1] = depotToClient1;
+        flat[1 * n + 0] = 40;
+        flat[0 * n + 2] = 300;
+        flat[1 * n + 2] = 20;
+        flat[2 * n + 0] = 40;
+        return Matrix<Duration>(std::move(flat), n, n);
+    };
+
+    auto const client = [&](size_t idx, Duration early, Duration late)
+    {
+        Duration const service = idx == 1 ? 10 : 0;
+        return ProblemData::Client(coords[idx].first,
+                                   coords[idx].second,
+                                   std::vector<Load>{1},
+                                   std::vector<Load>{},
+                                   service,
+                                   early,
+                                   late);
+    };
+
+    std::vector<ProblemData::Client> clients = {client(1, 0, 2000),
+                                                client(2, 0, 2000),
+                                                client(3, 500, 600),
+                                                client(4, 0, 50)};
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(0, 0, Duration(0), Duration(1000));
+
+    std::vector<ProblemData::VehicleType> vts;
+    vts.emplace_back(1, std::vector<Load>{10}, 0, 0, Cost(0), 100, 900);
+
+    // Windows are only tightened when asked, also with hard time windows.
+    ProblemData const soft(clients,
+                           depots,
+                           vts,
+                           {makeDistMatrix(n, coords)},
+                           {durations(50)});
+    assert(std::ranges::equal(soft.clients(), soft.originalClients()));
+
+    ProblemData const hard(clients,
+                           depots,
+                           vts,
+                           {makeDistMatrix(n, coords)},
+                           {durations(50)},
+                           {},
+                           {},
+                           true);
+    assert(std::ranges::equal(hard.clients(), hard.originalClients()));
+    assert(hard.hardTimeWindows() && !hard.tightenTimeWindows());
+
+    ProblemData pd(std::move(clients),
+                   std::move(depots),
+                   std::move(vts),
+                   {makeDistMatrix(n, coords)},
+                   {durations(50)},
+                   {},
+                   {},
+                   false,
+                   true);
+    assert(!pd.hardTimeWindows() && pd.tightenTimeWindows());
+
+    auto const window = [](ProblemData const &data, size_t client)
+    {
+        ProblemData::Client const &clientData = data.location(client);
+        return std::make_pair(clientData.twEarly.get(),
+                              clientData.twLate.get());
+    };
+
+    using Window = std::pair<int64_t, int64_t>;
+    assert(window(pd, 1) == Window(150, 850));
+    assert(window(pd, 2) == Window(400, 860));
+    assert(window(pd, 3) == Window(500, 600));
+    assert(window(pd, 4) == Window(0, 50));  // kept, cannot be met anyway
+
+    // The original windows are kept, and are what a dump stores.
+    assert(pd.originalClients()[0].twEarly == 0);
+    assert(pd.originalClients()[0].twLate == 2000);
+    auto const restored = exvrp::deserialise(exvrp::serialise(pd));
+    assert(restored == pd);
+    assert(window(restored, 2) == Window(400, 860));
+
+    // Updates tighten again from the original windows.
+    auto const longer = durations(200);
+    std::vector<Duration> depotRow(longer.data(), longer.data() + n);
+    auto const updated = pd.update({}, {}, {{0, 0, true, depotRow}});
+    assert(window(updated, 1) == Window(300, 850));
+    assert(window(updated, 2) == Window(400, 860));
+
+    // Without travel changes, unchanged clients keep their windows, and
+    // replaced ones are tightened again.
+    auto const replaced = pd.update({{3, client(3, 0, 2000)}}, {}, {});
+    assert(replaced.clients()[0] == pd.clients()[0]);
+    assert(window(replaced, 3) == Window(150, 850));
+
+    std::optional<std::vector<ProblemData::Client>> keepClients;
+    std::optional<std::vector<ProblemData::Depot>> keepDepots;
+    std::optional<std::vector<ProblemData::VehicleType>> keepVehicleTypes;
+    std::optional<std::vector<Matrix<Distance>>> keepDists;
+    std::optional<std::vector<Matrix<Duration>>> keepDurs;
+    std::optional<std::vector<ProblemData::ClientGroup>> keepGroups;
+    std::optional<std::vector<ProblemData::SameVehicleGroup>> keepSameVehicle;
+    auto const same = pd.replace(keepClients,
+                                 keepDepots,
+                                 keepVehicleTypes,
+                                 keepDists,
+                                 keepDurs,
+                                 keepGroups,
+                                 keepSameVehicle);
+    assert(std::ranges::equal(same.clients(), pd.clients()));
+
+    // Visiting clients 1 and 2 fits within the tightened windows.
+    Route route(pd, std::vector<size_t>{1, 2}, 0);
+    assert(route.isFeasible());
+    assert(route.timeWarp() == 0);
+    PASS();
+}
+
+void test_reversing_operators()
+{
+    TEST("segment-reversing operators evaluate moves exactly");
+
+    // An asymmetric instance: travelling towards higher indices is more
+    // expensive than travelling back. The routes cross themselves, so there
+    // are improving reversals.
+    std::vector<std::pair<int64_t, int64_t>> coords
+        = {{0, 0}, {10, 0}, {20, 5}, {30, 0}, {30, 20}, {20, 25},
+           {10, 20}, {0, 30}, {40, 30}, {50, 10}};
+    size_t n = coords.size();
+
+    std::vector<Distance> distances;
+    std::vector<Duration> durations;
+    auto const euclidean = makeDistMatrix(n, coords);
+    for (size_t i = 0; i != n; ++i)
+        for (size_t j = 0; j != n; ++j)
+        {
+            auto const value = euclidean(i, j).get() + (i < j ? 3 * j : 0);
+            distances.emplace_back(value);
+            durations.emplace_back(value);
+        }
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t idx = 1; idx != n; ++idx)
+        clients.emplace_back(coords[idx].first,
+                             coords[idx].second,
+                             std::vector<Load>{2},
+                             std::vector<Load>{},
+                             Duration(5),
+                             Duration(idx % 3 == 0 ? 60 : 0),
+                             Duration(idx % 3 == 0 ? 120 : 400));
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(0, 0);
+
+    std::vector<ProblemData::VehicleType> vts;
+    vts.emplace_back(3, std::vector<Load>{10}, 0, 0, Cost(25));
+
+    ProblemData pd(std::move(clients),
+                   std::move(depots),
+                   std::move(vts),
+                   {Matrix<Distance>(std::move(distances), n, n)},
+                   {Matrix<Duration>(std::move(durations), n, n)});
+
+    std::vector<Route> routes
+        = {Route(pd, std::vector<size_t>{1, 4, 3, 2, 5, 6}, 0),
+           Route(pd, std::vector<size_t>{9, 7, 8}, 0)};
+
+    // The reversed distance uses prefix sums, which must match the arcs.
+    search::Solution sol(pd);
+    sol.load(Solution(pd, routes));
+    auto const &route = sol.routes[0];
+    auto const &distMat = pd.distanceMatrix(0);
+    for (size_t start = 1; start != route.size() - 1; ++start)
+        for (size_t end = start; end != route.size() - 1; ++end)
+        {
+            Distance expected = 0;
+            for (auto idx = end; idx != start; --idx)
+                expected += distMat(route[idx]->client(),
+                                    route[idx - 1]->client());
+
+            assert(route.reversed(start, end).distance(0) == expected);
+        }
+
+    search::TwoOpt twoOpt(pd);
+    search::OrOptReverse<2> orOpt2(pd);
+    search::OrOptReverse<3> orOpt3(pd);
+    std::vector<search::NodeOperator *> ops = {&twoOpt, &orOpt2, &orOpt3};
+
+    // Every improving move must change the cost by exactly its delta.
+    CostEvaluator costEval({20}, 6.0, 6.0);
+    for (auto *op : ops)
+    {
+        size_t numImproving = 0;
+        for (size_t u = pd.numDepots(); u != pd.numLocations(); ++u)
+            for (size_t v = 0; v != pd.numLocations(); ++v)
+            {
+                sol.load(Solution(pd, routes));
+
+                auto *U = &sol.nodes[u];
+                auto *V = v < pd.numDepots() ? sol.routes[u % 3][0]
+                                             : &sol.nodes[v];
+                if (U == V)
+                    continue;
+
+                auto const delta = op->evaluate(U, V, costEval);
+                if (delta >= 0)
+                    continue;
+
+                numImproving++;
+                auto const before = costEval.penalisedCost(sol.unload());
+                auto *uRoute = U->route();
+                auto *vRoute = V->route();
+                op->apply(U, V);
+                uRoute->update();
+                vRoute->update();
+
+                auto const after = costEval.penalisedCost(sol.unload());
+                assert(after - before == delta);
+            }
+
+        assert(numImproving > 0);
+    }
+    PASS();
+}
+
+void test_hybrid_genetic_search()
+{
+    TEST("native HGS (distance, crossover, 30 clients)");
+
+    size_t n = 31;  // 1 depot + 30 clients
+    std::vector<std::pair<int64_t, int64_t>> coords;
+    coords.push_back({50, 50});
+    for (size_t i = 1; i < n; ++i)
+        coords.push_back({static_cast<int64_t>((i * 37) % 100),
+                          static_cast<int64_t>((i * 53) % 100)});
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t i = 1; i < n; ++i)
+        clients.emplace_back(coords[i].first,
+                             coords[i].second,
+                             std::vector<Load>{1},
+                             std::vector<Load>{});
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(50, 50);
+
+    auto const makeData = [&](size_t numAvailable, Load capacity)
+    {
+        std::vector<ProblemData::VehicleType> vts;
+        vts.emplace_back(numAvailable, std::vector<Load>{capacity});
+
+        return ProblemData(clients,
+                           depots,
+                           std::move(vts),
+                           {makeDistMatrix(n, coords)},
+                           {makeDurMatrix(n, coords)});
+    };
+
+    auto const pd = makeData(4, 10);
+
+    RandomNumberGenerator rng(3);
+    Solution const first(pd, rng);
+    Solution const second(pd, rng);
+
+    // Broken pairs distance is zero for identical solutions, and symmetric.
+    auto const dist = exvrp::brokenPairsDistance(first, second);
+    assert(exvrp::brokenPairsDistance(first, first) == 0);
+    assert(dist == exvrp::brokenPairsDistance(second, first));
+    assert(dist > 0 && dist <= 1);
+
+    // Offspring never visit a client twice.
+    CostEvaluator costEval({20}, 6.0, 6.0);
+    for (size_t iter = 0; iter != 20; ++iter)
+    {
+        auto const offspring = exvrp::selectiveRouteExchange(
+            {&first, &second}, pd, costEval, rng);
+
+        std::vector<size_t> seen(pd.numLocations(), 0);
+        for (auto const &route : offspring.routes())
+            for (auto const client : route)
+                seen[client]++;
+
+        assert(std::all_of(
+            seen.begin(), seen.end(), [](size_t num) { return num <= 1; }));
+    }
+
+    exvrp::SolveParams params;
+    params.seed = 7;
+    params.maxIterations = 100;
+    params.algorithm = exvrp::Algorithm::HGS;
+    params.hgs.population.minPopSize = 5;
+    params.hgs.population.generationSize = 10;
+    params.hgs.numItersNoImprovement = 40;  // also exercise restarts
+
+    auto const result = exvrp::solve(pd, params);
+    assert(result.numIterations == 100);
+    assert(result.best->isFeasible());
+    assert(result.best->numClients() == 30);
+    assert(result.finalCost <= result.initialCost);
+
+    auto const again = exvrp::solve(pd, params);
+    assert(again.finalCost == result.finalCost);
+
+    // With a single vehicle, offspring come from ordered crossover instead.
+    auto const tsp = makeData(1, 30);
+    auto const tspResult = exvrp::solve(tsp, params);
+    assert(tspResult.best->isFeasible());
+    assert(tspResult.best->numClients() == 30);
+    PASS();
+}
+
+void test_solution_hashing()
+{
+    TEST("solution hashes and broken pairs distances");
+
+    size_t n = 16;  // 2 depots + 14 clients
+    std::vector<std::pair<int64_t, int64_t>> coords;
+    coords.push_back({50, 50});
+    coords.push_back({20, 80});  // reload depot
+    for (size_t i = 2; i < n; ++i)
+        coords.push_back({static_cast<int64_t>((i * 37) % 100),
+                          static_cast<int64_t>((i * 53) % 100)});
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t i = 2; i < n; ++i)
+        clients.emplace_back(coords[i].first,
+                             coords[i].second,
+                             std::vector<Load>{2},
+                             std::vector<Load>{});
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(50, 50);
+    depots.emplace_back(20, 80);
+
+    // Two vehicles that can reload at the second depot, so that routes can
+    // have several trips.
+    std::vector<ProblemData::VehicleType> vts;
+    vts.emplace_back(2,
+                     std::vector<Load>{8},
+                     0,
+                     0,
+                     Cost(0),
+                     Duration(0),
+                     Duration(100000),
+                     Duration(100000),
+                     Distance(std::numeric_limits<int64_t>::max()),
+                     Cost(1),
+                     Cost(0),
+                     0,
+                     std::nullopt,
+                     std::vector<Load>{},
+                     std::vector<size_t>{1},
+                     3,
+                     Duration(0),
+                     Cost(0),
+                     "");
+
+    ProblemData pd(clients,
+                   depots,
+                   std::move(vts),
+                   {makeDistMatrix(n, coords)},
+                   {makeDurMatrix(n, coords)});
+
+    // The hash depends on the arcs only, not on the order of the routes.
+    Solution const first(pd, {{2, 3, 4}, {5, 6}});
+    Solution const swapped(pd, {{5, 6}, {2, 3, 4}});
+    Solution const reversed(pd, {{4, 3, 2}, {5, 6}});
+    assert(first.hash() == swapped.hash());
+    assert(first.hash() != reversed.hash());
+    assert(Solution(pd, std::vector<std::vector<size_t>>{}).hash() == 0);
+
+    // Arcs from and to the reload depot count as well.
+    std::vector<Trip> trips = {Trip(pd, {2, 3, 4}, 0, 0, 1),
+                               Trip(pd, {5, 6}, 0, 1, 0)};
+    Solution const multiTrip(pd, {Route(pd, trips, 0)});
+    assert(multiTrip.hash() != first.hash());
+
+    // Broken pairs distances do not depend on the order or direction of the
+    // routes.
+    assert(exvrp::brokenPairsDistance(first, swapped) == 0);
+    assert(exvrp::brokenPairsDistance(first, reversed) == 0);
+    assert(exvrp::brokenPairsDistance(reversed, first) == 0);
+    assert(exvrp::brokenPairsDistance(first, multiTrip) > 0);
+    assert(exvrp::brokenPairsDistance(first, multiTrip)
+           == exvrp::brokenPairsDistance(multiTrip, first));
+
+    search::Solution sol(pd);
+    sol.load(multiTrip);
+    assert(sol.hash() == multiTrip.hash());
+
+    // The search solution keeps the same hash while operators modify it.
+    RandomNumberGenerator rng(5);
+    CostEvaluator costEval({20}, 6.0, 6.0);
+    Solution const initial(pd, rng);
+
+    search::Exchange<1, 0> relocate(pd);
+    size_t numApplied = 0;
+    for (size_t u = pd.numDepots(); u != pd.numLocations(); ++u)
+        for (size_t v = pd.numDepots(); v != pd.numLocations(); ++v)
+        {
+            sol.load(initial);
+            assert(sol.hash() == initial.hash());
+
+            auto *U = &sol.nodes[u];
+            auto *V = &sol.nodes[v];
+            if (U == V || !U->route() || !V->route())
+                continue;
+
+            if (relocate.evaluate(U, V, costEval) >= 0)
+                continue;
+
+            auto *uRoute = U->route();
+            auto *vRoute = V->route();
+            relocate.apply(U, V);
+            uRoute->update();
+            vRoute->update();
+            numApplied++;
+
+            auto const unloaded = sol.unload();
+            assert(sol.hash() == unloaded.hash());
+            assert(unloaded.hash() != initial.hash());
+            assert(exvrp::brokenPairsDistance(initial, unloaded) > 0);
+        }
+
+    assert(numApplied > 0);
+
+    // The batched distances match the pairwise ones.
+    std::vector<Solution> pool;
+    for (size_t idx = 0; idx != 5; ++idx)
+        pool.emplace_back(pd, rng);
+
+    std::vector<Solution const *> poolPtrs;
+    for (auto const &other : pool)
+        poolPtrs.push_back(&other);
+
+    auto const distances = exvrp::brokenPairsDistances(initial, poolPtrs);
+    assert(distances.size() == pool.size());
+    for (size_t idx = 0; idx != pool.size(); ++idx)
+        assert(distances[idx]
+               == exvrp::brokenPairsDistance(initial, pool[idx]));
+
+    // Crossover offspring keep the trips of their parents' routes.
+    auto const twoTrips = [&](std::vector<size_t> const &trip1,
+                              std::vector<size_t> const &trip2)
+    {
+        std::vector<Trip> trips = {Trip(pd, trip1, 0, 0, 1),
+                                   Trip(pd, trip2, 0, 1, 0)};
+        return Route(pd, trips, 0);
+    };
+
+    Solution const parentA(pd,
+                           {twoTrips({2, 3, 4}, {5, 6, 7}),
+                            twoTrips({8, 9, 10, 11}, {12, 13, 14, 15})});
+    Solution const parentB(pd,
+                           {twoTrips({15, 14, 13, 12}, {11, 10, 9, 8}),
+                            twoTrips({7, 6}, {5, 4, 3, 2})});
+
+    for (size_t iter = 0; iter != 20; ++iter)
+    {
+        auto const offspring = exvrp::selectiveRouteExchange(
+            {&parentA, &parentB}, pd, costEval, rng);
+
+        auto const &routes = offspring.routes();
+        assert(std::any_of(routes.begin(),
+                           routes.end(),
+                           [](auto const &route)
+                           { return route.numTrips() > 1; }));
+    }
+
+    Solution const tourA(pd, {twoTrips({2, 3, 4}, {5, 6})});
+    Solution const tourB(pd, {{6, 5, 4, 3, 2}});
+    for (size_t iter = 0; iter != 20; ++iter)
+    {
+        auto const offspring
+            = exvrp::orderedCrossover({&tourA, &tourB}, pd, rng);
+        assert(offspring.numClients() == 5);
+        assert(offspring.routes()[0].numTrips() == 2);
+    }
+
+    // Late acceptance that skips seen solutions is still deterministic, and
+    // still improves on the initial solution.
+    std::vector<ProblemData::VehicleType> single;
+    single.emplace_back(2, std::vector<Load>{16});
+    ProblemData const vrp(clients,
+                          depots,
+                          std::move(single),
+                          {makeDistMatrix(n, coords)},
+                          {makeDurMatrix(n, coords)});
+
+    exvrp::SolveParams params;
+    params.seed = 3;
+    params.maxIterations = 100;
+    params.ils.skipSeen = true;
+
+    auto const result = exvrp::solve(vrp, params);
+    assert(result.best->isFeasible());
+    assert(result.finalCost <= result.initialCost);
+    assert(exvrp::solve(vrp, params).finalCost == result.finalCost);
+    PASS();
+}
+
+void test_elite_archive()
+{
+    TEST("elite archive and path relinking");
+
+    size_t n = 21;  // 1 depot + 20 clients
+    std::vector<std::pair<int64_t, int64_t>> coords;
+    coords.push_back({50, 50});
+    for (size_t i = 1; i < n; ++i)
+        coords.push_back({static_cast<int64_t>((i * 37) % 100),
+                          static_cast<int64_t>((i * 53) % 100)});
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t i = 1; i < n; ++i)
+        clients.emplace_back(coords[i].first,
+                             coords[i].second,
+                             std::vector<Load>{3},
+                             std::vector<Load>{});
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(50, 50);
+
+    std::vector<ProblemData::VehicleType> vts;
+    vts.emplace_back(4, std::vector<Load>{20});
+
+    ProblemData pd(clients,
+                   depots,
+                   std::move(vts),
+                   {makeDistMatrix(n, coords)},
+                   {makeDurMatrix(n, coords)});
+
+    CostEvaluator costEval({20}, 6.0, 6.0);
+    RandomNumberGenerator rng(11);
+
+    // Feasible random solutions, cheapest first after sorting.
+    std::vector<std::shared_ptr<Solution const>> pool;
+    while (pool.size() != 8)
+    {
+        auto sol = std::make_shared<Solution const>(pd, rng);
+        if (sol->isFeasible())
+            pool.push_back(sol);
+    }
+
+    // A disabled archive never stores anything.
+    exvrp::EliteArchive disabled(0, 0.0);
+    assert(!disabled.add(pool[0], costEval.cost(*pool[0])));
+    assert(disabled.size() == 0);
+
+    // The archive is bounded, ordered by cost, and rejects duplicates.
+    exvrp::EliteArchive elite(4, 0.0);
+    for (auto const &sol : pool)
+        elite.add(sol, costEval.cost(*sol));
+
+    assert(elite.size() == 4);
+    assert(!elite.add(elite[0], costEval.cost(*elite[0])));
+    for (size_t idx = 1; idx != elite.size(); ++idx)
+        assert(costEval.cost(*elite[idx - 1]) <= costEval.cost(*elite[idx]));
+
+    auto cheapest = pool[0];
+    for (auto const &sol : pool)
+        if (costEval.cost(*sol) < costEval.cost(*cheapest))
+            cheapest = sol;
+    assert(costEval.cost(*elite[0]) == costEval.cost(*cheapest));
+
+    // With the maximum distance, all solutions are too similar, so only the
+    // cheapest survives.
+    exvrp::EliteArchive similar(4, 1.1);
+    for (auto const &sol : pool)
+        similar.add(sol, costEval.cost(*sol));
+    assert(similar.size() == 1);
+    assert(costEval.cost(*similar[0]) == costEval.cost(*cheapest));
+
+    elite.clear();
+    assert(elite.size() == 0);
+
+    // Path relinking keeps every client, and polishes its result.
+    auto const neighbours = exvrp::computeNeighbours(pd);
+    exvrp::DefaultLocalSearch ls(pd, neighbours, 7);
+    auto const relinked
+        = exvrp::pathRelink(*pool[1], *pool[0], pd, ls, costEval, rng, 3);
+    assert(relinked.numClients() == pd.numClients());
+
+    // Relinking a solution towards itself just polishes it.
+    auto const self
+        = exvrp::pathRelink(*pool[0], *pool[0], pd, ls, costEval, rng, 3);
+    assert(costEval.penalisedCost(self) <= costEval.penalisedCost(*pool[0]));
+
+    // The ILS with an elite archive restarts by relinking, and is still
+    // deterministic.
+    exvrp::SolveParams params;
+    params.seed = 5;
+    params.maxIterations = 200;
+    params.ils.maxNoImprovement = 20;
+    params.ils.eliteSize = 4;
+
+    auto const result = exvrp::solve(pd, params);
+    assert(result.best->isFeasible());
+    assert(result.restarts > 0);
+    assert(result.relinks > 0);
+    assert(result.finalCost <= result.initialCost);
+    assert(exvrp::solve(pd, params).finalCost == result.finalCost);
+
+    // On an instance with a reload depot, relinking keeps the trips of the
+    // single vehicle, rather than flattening them into one overloaded trip.
+    size_t m = 14;  // 2 depots + 12 clients
+    std::vector<std::pair<int64_t, int64_t>> reloadCoords;
+    reloadCoords.push_back({50, 50});
+    reloadCoords.push_back({20, 80});  // reload depot
+    for (size_t i = 2; i < m; ++i)
+        reloadCoords.push_back({static_cast<int64_t>((i * 37) % 100),
+                                static_cast<int64_t>((i * 53) % 100)});
+
+    std::vector<ProblemData::Client> reloadClients;
+    for (size_t i = 2; i < m; ++i)
+        reloadClients.emplace_back(reloadCoords[i].first,
+                                   reloadCoords[i].second,
+                                   std::vector<Load>{2},
+                                   std::vector<Load>{});
+
+    std::vector<ProblemData::Depot> reloadDepots;
+    reloadDepots.emplace_back(50, 50);
+    reloadDepots.emplace_back(20, 80);
+
+    std::vector<ProblemData::VehicleType> reloadVts;
+    reloadVts.emplace_back(1,
+                           std::vector<Load>{8},
+                           0,
+                           0,
+                           Cost(0),
+                           Duration(0),
+                           Duration(100000),
+                           Duration(100000),
+                           Distance(std::numeric_limits<int64_t>::max()),
+                           Cost(1),
+                           Cost(0),
+                           0,
+                           std::nullopt,
+                           std::vector<Load>{},
+                           std::vector<size_t>{1},
+                           2,
+                           Duration(0),
+                           Cost(0),
+                           "");
+
+    ProblemData reloadPd(reloadClients,
+                         reloadDepots,
+                         std::move(reloadVts),
+                         {makeDistMatrix(m, reloadCoords)},
+                         {makeDurMatrix(m, reloadCoords)});
+
+    auto const threeTrips = [&](std::vector<std::vector<size_t>> visits)
+    {
+        std::vector<Trip> trips = {Trip(reloadPd, visits[0], 0, 0, 1),
+                                   Trip(reloadPd, visits[1], 0, 1, 1),
+                                   Trip(reloadPd, visits[2], 0, 1, 0)};
+        return Solution(reloadPd, {Route(reloadPd, trips, 0)});
+    };
+
+    auto const reloadInitial
+        = threeTrips({{2, 3, 4, 5}, {6, 7, 8, 9}, {10, 11, 12, 13}});
+    auto const reloadGuide
+        = threeTrips({{13, 2, 9, 6}, {3, 12, 7, 4}, {5, 8, 11, 10}});
+    assert(reloadInitial.isFeasible() && reloadGuide.isFeasible());
+
+    // Without neighbours, the local search barely changes the relinked
+    // solutions, so their trips are the ones that relinking built.
+    CostEvaluator reloadCostEval({1000}, 6.0, 6.0);
+    std::vector<std::vector<size_t>> const reloadNeighbours(m);
+    exvrp::DefaultLocalSearch reloadLs(reloadPd, reloadNeighbours, 7);
+    for (size_t numSteps = 1; numSteps != 4; ++numSteps)
+    {
+        auto const relinkedTrips = exvrp::pathRelink(reloadInitial,
+                                                     reloadGuide,
+                                                     reloadPd,
+                                                     reloadLs,
+                                                     reloadCostEval,
+                                                     rng,
+                                                     numSteps);
+        assert(relinkedTrips.numClients() == reloadPd.numClients());
+        assert(relinkedTrips.routes()[0].numTrips() > 1);
+    }
+
+    PASS();
+}
+
+void test_decomposition()
+{
+    TEST("route-based decomposition (120 clients)");
+
+    size_t n = 121;  // 1 depot + 120 clients
+    std::vector<std::pair<int64_t, int64_t>> coords;
+    coords.push_back({500, 500});
+    for (size_t i = 1; i < n; ++i)
+        coords.push_back({static_cast<int64_t>((i * 379) % 1000),
+                          static_cast<int64_t>((i * 613) % 1000)});
+
+    std::vector<ProblemData::Client> clients;
+    for (size_t i = 1; i < n; ++i)
+        clients.emplace_back(coords[i].first,
+                             coords[i].second,
+                             std::vector<Load>{1},
+                             std::vector<Load>{});
+
+    std::vector<ProblemData::Depot> depots;
+    depots.emplace_back(500, 500);
+
+    std::vector<ProblemData::VehicleType> vts;
+    vts.emplace_back(10, std::vector<Load>{10});
+    vts.emplace_back(6, std::vector<Load>{15});
+
+    ProblemData pd(clients,
+                   depots,
+                   std::move(vts),
+                   {makeDistMatrix(n, coords)},
+                   {makeDurMatrix(n, coords)});
+
+    // A feasible, but poor, starting solution of twelve routes with ten
+    // consecutive clients each, using both vehicle types.
+    std::vector<Route> routes;
+    for (size_t start = 1; start < n; start += 10)
+    {
+        std::vector<size_t> visits;
+        for (size_t client = start; client != start + 10; ++client)
+            visits.push_back(client);
+        routes.emplace_back(pd, visits, routes.size() < 8 ? 0 : 1);
+    }
+
+    Solution const initial(pd, routes);
+    assert(initial.isFeasible());
+
+    // Clusters cover every route exactly once, and depend on the offset.
+    auto const clusters = exvrp::clusterRoutes(initial, pd, 30, 0);
+    assert(clusters.size() == 4);
+    std::vector<size_t> seen;
+    for (auto const &cluster : clusters)
+        seen.insert(seen.end(), cluster.begin(), cluster.end());
+    std::sort(seen.begin(), seen.end());
+    for (size_t idx = 0; idx != seen.size(); ++idx)
+        assert(seen[idx] == idx);
+    assert(exvrp::clusterRoutes(initial, pd, 30, 1) != clusters);
+    assert(exvrp::clusterRoutes(initial, pd, 200, 0).size() == 1);
+
+    // Decomposition keeps all clients and feasibility, and improves the cost.
+    CostEvaluator costEval({20}, 6.0, 6.0);
+    exvrp::SolveParams params;
+    params.decomposition.clusterSize = 30;
+    params.decomposition.maxIterations = 50;
+    params.decomposition.maxRuntimeMs = 0;
+    params.decomposition.numThreads = 2;
+
+    auto const improved = exvrp::decompose(initial, pd, costEval, params, 1);
+    assert(improved.numClients() == pd.numClients());
+    assert(improved.isFeasible());
+    assert(costEval.cost(improved) < costEval.cost(initial));
+
+    // Subproblem solves are seeded per cluster, so the result does not
+    // depend on the number of threads.
+    params.decomposition.numThreads = 1;
+    auto const single = exvrp::decompose(initial, pd, costEval, params, 1);
+    assert(single.hash() == improved.hash());
+
+    // Too few routes for two clusters: the solution is returned unchanged.
+    params.decomposition.clusterSize = 500;
+    auto const same = exvrp::decompose(initial, pd, costEval, params, 1);
+    assert(same.hash() == initial.hash());
+
+    // The ILS decomposes its best solution periodically.
+    params.decomposition.clusterSize = 30;
+    params.decomposition.interval = 20;
+    params.decomposition.numThreads = 0;
+    params.maxIterations = 60;
+
+    auto const result = exvrp::solve(pd, params, &initial);
+    assert(result.best->isFeasible());
+    assert(result.best->numClients() == pd.numClients());
+    assert(result.finalCost < costEval.cost(initial));
+    PASS();
+}
+
+// Records the thread that destroys it.
+struct DestructionProbe
+{
+    std::shared_ptr<std::thread::id> destroyedOn;
+
+    DestructionProbe(DestructionProbe &&) = default;
+    explicit DestructionProbe(std::shared_ptr<std::thread::id> id)
+        : destroyedOn(std::move(id))
+    {
+    }
+
+    ~DestructionProbe()
+    {
+        if (destroyedOn)
+            *destroyedOn = std::this_thread::get_id();
+    }
+};
+
+void test_reclaimer()
+{
+    TEST("reclaimer (deferred destruction)");
+
+    exvrp::Reclaimer reclaimer(1000);
+    auto const self = std::this_thread::get_id();
+
+    // Small objects are destroyed right away, on the calling thread.
+    auto small = std::make_shared<std::thread::id>();
+    reclaimer.reclaim(DestructionProbe(small), 999);
+    assert(*small == self);
+    assert(reclaimer.stats().numDeferred == 0);
+
+    // Large objects are destroyed on the background thread.
+    std::vector<std::shared_ptr<std::thread::id>> large;
+    for (size_t idx = 0; idx != 10; ++idx)
+    {
+        large.push_back(std::make_shared<std::thread::id>());
+        reclaimer.reclaim(DestructionProbe(large.back()), 1000 + idx);
+    }
+
+    reclaimer.drain();
+    for (auto const &id : large)
+        assert(*id != self && *id != std::thread::id());
+
+    auto const stats = reclaimer.stats();
+    assert(stats.numDeferred == 10);
+    assert(stats.deferredBytes == 10 * 1000 + 45);
+    assert(stats.numPending == 0 && stats.pendingBytes == 0);
+
+    // A lower threshold defers smaller objects, too, such as the last
+    // reference to some problem data.
+    reclaimer.setThreshold(0);
+    auto data = std::make_shared<ProblemData>(
+        std::vector<ProblemData::Client>{ProblemData::Client(1, 1)},
+        std::vector<ProblemData::Depot>{ProblemData::Depot(0, 0)},
+        std::vector<ProblemData::VehicleType>{ProblemData::VehicleType()},
+        std::vector<Matrix<Distance>>{Matrix<Distance>(2, 2)},
+        std::vector<Matrix<Duration>>{Matrix<Duration>(2, 2)});
+    std::weak_ptr<ProblemData> const weak = data;
+    reclaimer.reclaim(std::move(data), 1);
+    reclaimer.drain();
+    assert(weak.expired());
+    assert(reclaimer.stats().numDeferred == 11);
+
+    // Embedders can start and join the thread themselves. Stopping joins the
+    // thread, after which objects are destroyed right away.
+    static size_t numStarted = 0;
+    static size_t numJoined = 0;
+
+    exvrp::Reclaimer::ThreadFunctions const threads{
+        [](void *(*func)(void *), void *arg) -> void *
+        {
+            numStarted++;
+            return new std::thread(func, arg);
+        },
+        [](void *handle)
+        {
+            numJoined++;
+            auto *thread = static_cast<std::thread *>(handle);
+            thread->join();
+            delete thread;
+        }};
+
+    exvrp::Reclaimer embedded(0);
+    embedded.setThreadFunctions(threads);
+
+    auto deferred = std::make_shared<std::thread::id>();
+    embedded.reclaim(DestructionProbe(deferred), 1);
+    embedded.stop();
+    assert(numStarted == 1 && numJoined == 1);
+    assert(*deferred != self && *deferred != std::thread::id());
+
+    auto stopped = std::make_shared<std::thread::id>();
+    embedded.reclaim(DestructionProbe(stopped), 1);
+    assert(*stopped == self);
+    assert(embedded.stats().numDeferred == 1);
+    PASS();
+}
+
 // ---------------------------------------------------------------------------
 // Main
 // ---------------------------------------------------------------------------
@@ -1030,6 +3203,23 @@ int main()
     test_tight_time_windows();
     test_perturbation_prize_collecting();
     test_backhaul_like();
+    test_incremental_insert();
+    test_locked_prefixes();
+    test_problem_data_update();
+    test_native_ils();
+    test_problem_data_dump();
+    test_allocation_free_search();
+    test_missing_clients_index();
+    test_vehicle_type_dominance();
+    test_reachable_neighbours();
+    test_hard_time_windows();
+    test_time_window_tightening();
+    test_reversing_operators();
+    test_hybrid_genetic_search();
+    test_solution_hashing();
+    test_elite_archive();
+    test_decomposition();
+    test_reclaimer();
 
     printf("\n%d passed, %d failed\n", passed, failed);
     return failed > 0 ? 1 : 0;
@@ -4,6 +4,21 @@ defmodule ExVrp.Benchmark do
 
   Runs benchmarks on VRPLIB instances with multiple seeds and reports
   solution quality regressions against known expected distances (seed=42).
+
+  Each run also records how fast the solver gets there:
+
+  - iterations per second of the search
+  - time to reach within 1% and 0.5% of the expected distance, from the
+    start of the solve (`nil` if not reached)
+  - time spent in NIFs (setup phases and local search) versus the rest of
+    the solve, which is mostly Elixir
+  - peak RSS of the VM during the run, and an estimate of the native memory
+    (peak RSS minus the memory allocated by the BEAM), on Linux only
+
+  Runs are bounded by a fixed number of iterations, or by a wall-clock
+  budget. Results can be saved as JSON and compared against such a saved
+  baseline, flagging throughput and time-to-target regressions beyond a
+  tolerance.
   """
 
   alias ExVrp.Read
@@ -14,6 +29,14 @@ defmodule ExVrp.Benchmark do
 
   @data_dir Path.join(:code.priv_dir(:ex_vrp), "benchmark_data")
   @seeds [42, 1, 1337]
+  @target_gaps [{:time_to_1pct_ms, 0.01}, {:time_to_05pct_ms, 0.005}]
+
+  @events [
+    [:ex_vrp, :setup, :problem_data, :stop],
+    [:ex_vrp, :setup, :local_search, :stop],
+    [:ex_vrp, :setup, :initial_solution, :stop],
+    [:ex_vrp, :ils, :new_best]
+  ]
 
   @instances %{
     small_vrpspd: {"SmallVRPSPD.vrp", :round},
@@ -54,35 +77,57 @@ defmodule ExVrp.Benchmark do
   ## Options
 
   - `:iterations` - Number of solver iterations per run (default: 1000)
+  - `:max_runtime` - Wall-clock budget per run in seconds. Replaces the
+    iteration limit; since such runs are not deterministic, the seed=42
+    distance then only has to be within 1% of the expected distance.
   - `:save` - Path to save JSON results
+  - `:baseline` - Path of saved JSON results to compare performance against
+  - `:tolerance` - Relative slowdown allowed against the baseline
+    (default: 0.1)
 
   ## Examples
 
       ExVrp.Benchmark.run(:all)
       ExVrp.Benchmark.run([:ok_small, :rc208], iterations: 500)
+      ExVrp.Benchmark.run(:all, max_runtime: 5, baseline: "baseline.json")
 
   """
   def run(instances, opts \\ []) do
-    iterations = Keyword.get(opts, :iterations, 1000)
     save_path = Keyword.get(opts, :save)
 
     instance_list =
       if instances == :all, do: @instances |> Map.keys() |> Enum.sort(), else: instances
 
-    IO.puts("\nRunning benchmarks (seeds=#{inspect(@seeds)}, iterations=#{iterations})...\n")
+    IO.puts("\nRunning benchmarks (seeds=#{inspect(@seeds)}, #{budget(opts)})...\n")
 
     prev_level = Logger.level()
     Logger.configure(level: :warning)
-    results = collect_results(instance_list, iterations)
+    results = collect_results(instance_list, opts)
     Logger.configure(level: prev_level)
 
-    print_report(results, iterations)
+    print_report(results, opts)
+    print_performance(results)
 
+    if opts[:baseline], do: compare_baseline(results, opts[:baseline], Keyword.get(opts, :tolerance, 0.1))
     if save_path, do: save_json(results, save_path)
     results
   end
 
-  defp collect_results(instances, iterations) do
+  defp budget(opts) do
+    case opts[:max_runtime] do
+      nil -> "iterations=#{Keyword.get(opts, :iterations, 1000)}"
+      seconds -> "max_runtime=#{seconds}s"
+    end
+  end
+
+  defp stop(opts) do
+    case opts[:max_runtime] do
+      nil -> StoppingCriteria.max_iterations(Keyword.get(opts, :iterations, 1000))
+      seconds -> StoppingCriteria.max_runtime(seconds)
+    end
+  end
+
+  defp collect_results(instances, opts) do
     for name <- instances, Map.has_key?(@instances, name) do
       {file, round_func} = @instances[name]
       path = Path.join(@data_dir, file)
@@ -90,27 +135,146 @@ defmodule ExVrp.Benchmark do
 
       IO.write("  #{name}...")
 
-      seed_results =
-        for seed <- @seeds do
-          stop = StoppingCriteria.max_iterations(iterations)
-          {:ok, result} = Solver.solve(model, stop: stop, seed: seed, num_starts: 1)
-          {seed, result.best.distance, result.best.is_feasible}
-        end
+      seed_results = for seed <- @seeds, do: run_seed(model, seed, @expected_distances[name], opts)
+
+      best = seed_results |> Enum.map(& &1.distance) |> Enum.min()
+      all_feasible = Enum.all?(seed_results, & &1.feasible)
+      metrics = aggregate(seed_results)
+
+      IO.puts(" best=#{best} (all_feasible=#{all_feasible}, #{round(metrics.iterations_per_second)} it/s)")
+
+      {name, %{seed_results: seed_results, best: best, all_feasible: all_feasible, metrics: metrics}}
+    end
+  end
+
+  defp run_seed(model, seed, expected, opts) do
+    ref = make_ref()
+    pid = self()
+    handler_id = {__MODULE__, ref}
+    :telemetry.attach_many(handler_id, @events, &__MODULE__.handle_event/4, {pid, ref})
+    reset_peak_rss()
+
+    # The initial solution is reported through the progress callback.
+    on_progress = fn
+      %{stage: :initial_solution} = info -> send(pid, {ref, :initial_solution, info, System.monotonic_time()})
+      _info -> :ok
+    end
+
+    started = System.monotonic_time()
+
+    {:ok, result} =
+      try do
+        Solver.solve(model,
+          stop: stop(opts),
+          seed: seed,
+          num_starts: 1,
+          on_progress: on_progress,
+          telemetry_metadata: %{benchmark_ref: ref}
+        )
+      after
+        :telemetry.detach(handler_id)
+      end
+
+    wall_ms = ms_since(started, System.monotonic_time())
+    events = collect_events(ref, [])
+    peak_rss_mb = peak_rss_mb()
+
+    setup_ms =
+      events
+      |> Enum.filter(&match?({[:ex_vrp, :setup, _phase, :stop], _measurements, _time}, &1))
+      |> Enum.map(fn {_event, %{duration: duration}, _time} -> to_ms(duration) end)
+      |> Enum.sum()
+
+    nif_ms = setup_ms + result.stats.local_search_ms
+
+    times_to_target =
+      for {key, gap} <- @target_gaps, into: %{} do
+        {key, time_to_target(events, expected * (1 + gap), started)}
+      end
+
+    Map.merge(times_to_target, %{
+      seed: seed,
+      distance: result.best.distance,
+      feasible: result.best.is_feasible,
+      iterations: result.num_iterations,
+      iterations_per_second: result.num_iterations / max(result.runtime / 1000, 0.001),
+      wall_ms: wall_ms,
+      nif_ms: nif_ms,
+      elixir_ms: max(wall_ms - nif_ms, 0.0),
+      peak_rss_mb: peak_rss_mb,
+      native_mb: peak_rss_mb && max(peak_rss_mb - :erlang.memory(:total) / 1_048_576, 0.0)
+    })
+  end
+
+  @doc false
+  def handle_event(event, measurements, %{benchmark_ref: ref}, {pid, ref}) do
+    send(pid, {ref, event, measurements, System.monotonic_time()})
+  end
+
+  def handle_event(_event, _measurements, _metadata, _config), do: :ok
+
+  defp collect_events(ref, acc) do
+    receive do
+      {^ref, event, measurements, time} -> collect_events(ref, [{event, measurements, time} | acc])
+    after
+      0 -> Enum.reverse(acc)
+    end
+  end
+
+  # Time from the start of the solve until the first feasible solution whose
+  # distance is at most the target: the initial solution, or a new best.
+  defp time_to_target(events, target, started) do
+    Enum.find_value(events, fn
+      {:initial_solution, %{is_feasible: true, best_distance: distance}, time} when distance <= target ->
+        ms_since(started, time)
+
+      {[:ex_vrp, :ils, :new_best], %{distance: distance}, time} when distance <= target ->
+        ms_since(started, time)
+
+      _event ->
+        nil
+    end)
+  end
+
+  # Means over the seeds; times to target only over the seeds reaching it.
+  defp aggregate(seed_results) do
+    keys = [:iterations_per_second, :wall_ms, :nif_ms, :elixir_ms, :peak_rss_mb, :native_mb]
+    keys = keys ++ Enum.map(@target_gaps, &elem(&1, 0))
+
+    for key <- keys, into: %{} do
+      {key, seed_results |> Enum.map(&Map.fetch!(&1, key)) |> mean()}
+    end
+  end
+
+  defp mean(values) do
+    case Enum.reject(values, &is_nil/1) do
+      [] -> nil
+      present -> Enum.sum(present) / length(present)
+    end
+  end
 
-      best = seed_results |> Enum.min_by(&elem(&1, 1)) |> elem(1)
-      all_feasible = Enum.all?(seed_results, &elem(&1, 2))
+  defp ms_since(started, time), do: to_ms(time - started)
+  defp to_ms(native), do: System.convert_time_unit(native, :native, :microsecond) / 1000
 
-      IO.puts(" best=#{best} (all_feasible=#{all_feasible})")
+  @doc false
+  # Resets the VmHWM peak of /proc/self/status, so that it covers one run.
+  def reset_peak_rss, do: File.write("/proc/self/clear_refs", "5")
 
-      {name, %{seed_results: seed_results, best: best, all_feasible: all_feasible}}
+  @doc false
+  def peak_rss_mb do
+    with {:ok, status} <- File.read("/proc/self/status"),
+         [_match, kb] <- Regex.run(~r/VmHWM:\s+(\d+) kB/, status) do
+      String.to_integer(kb) / 1024
+    else
+      _other -> nil
     end
   end
 
-  defp print_report(results, iterations) do
+  defp print_report(results, opts) do
     separator = String.duplicate("-", 72)
 
     IO.puts("")
-    IO.puts("Regression Report (seeds=#{inspect(@seeds)}, iterations=#{iterations})")
+    IO.puts("Regression Report (seeds=#{inspect(@seeds)}, #{budget(opts)})")
     IO.puts(separator)
 
     IO.puts(
@@ -122,21 +286,16 @@ defmodule ExVrp.Benchmark do
     {pass, fail} =
       Enum.reduce(results, {0, 0}, fn {name, m}, {p, f} ->
         expected = @expected_distances[name]
-
-        seed_42_dist =
-          Enum.find_value(m.seed_results, fn
-            {42, dist, _} -> dist
-            _ -> nil
-          end)
+        seed_42_dist = Enum.find_value(m.seed_results, &(&1.seed == 42 and &1.distance))
 
         quality =
           cond do
-            seed_42_dist == expected and m.all_feasible -> "ok"
-            seed_42_dist != expected -> "REGRESSED"
+            not quality_ok?(seed_42_dist, expected, opts) -> "REGRESSED"
             not m.all_feasible -> "INFEASIBLE"
+            true -> "ok"
           end
 
-        feasible_count = Enum.count(m.seed_results, &elem(&1, 2))
+        feasible_count = Enum.count(m.seed_results, & &1.feasible)
         feasible_str = "#{feasible_count}/#{length(@seeds)}"
 
         IO.puts(
@@ -160,6 +319,79 @@ defmodule ExVrp.Benchmark do
     IO.puts("")
   end
 
+  defp quality_ok?(distance, expected, opts) do
+    if opts[:max_runtime], do: distance <= expected * 1.01, else: distance == expected
+  end
+
+  defp print_performance(results) do
+    separator = String.duplicate("-", 92)
+
+    IO.puts("Performance (means over seeds)")
+    IO.puts(separator)
+
+    IO.puts(
+      "#{rpad("Instance", 14)} #{lpad("It/s", 9)} #{lpad("TTT 1%", 9)} #{lpad("TTT 0.5%", 9)} #{lpad("NIF ms", 10)} #{lpad("Elixir ms", 10)} #{lpad("Peak MB", 9)} #{lpad("Native MB", 10)}"
+    )
+
+    IO.puts(separator)
+
+    for {name, %{metrics: m}} <- results do
+      IO.puts(
+        "#{rpad(to_string(name), 14)} #{lpad(format(m.iterations_per_second, 0), 9)} #{lpad(format(m.time_to_1pct_ms, 1), 9)} #{lpad(format(m.time_to_05pct_ms, 1), 9)} #{lpad(format(m.nif_ms, 1), 10)} #{lpad(format(m.elixir_ms, 1), 10)} #{lpad(format(m.peak_rss_mb, 1), 9)} #{lpad(format(m.native_mb, 1), 10)}"
+      )
+    end
+
+    IO.puts(separator)
+    IO.puts("")
+  end
+
+  # Flags lower throughput, or a later (or missed) target, than the baseline
+  # beyond the tolerance. Instances missing from the baseline are skipped.
+  defp compare_baseline(results, path, tolerance) do
+    baseline = path |> File.read!() |> Jason.decode!()
+    separator = String.duplicate("-", 72)
+
+    IO.puts("Baseline Comparison (#{path}, tolerance=#{tolerance * 100}%)")
+    IO.puts(separator)
+    IO.puts("#{rpad("Instance", 14)} #{lpad("It/s", 22)} #{lpad("TTT 1% (ms)", 22)} #{rpad("Status", 11)}")
+    IO.puts(separator)
+
+    regressions =
+      for {name, %{metrics: m}} <- results,
+          %{"metrics" => base} <- [baseline[to_string(name)]] do
+        base_ips = base["iterations_per_second"]
+        base_ttt = base["time_to_1pct_ms"]
+
+        slower? = is_number(base_ips) and m.iterations_per_second < base_ips * (1 - tolerance)
+
+        later? =
+          is_number(base_ttt) and
+            (is_nil(m.time_to_1pct_ms) or m.time_to_1pct_ms > base_ttt * (1 + tolerance))
+
+        status = if slower? or later?, do: "REGRESSED", else: "ok"
+
+        IO.puts(
+          "#{rpad(to_string(name), 14)} #{lpad("#{format(base_ips, 0)} -> #{format(m.iterations_per_second, 0)}", 22)} #{lpad("#{format(base_ttt, 1)} -> #{format(m.time_to_1pct_ms, 1)}", 22)} #{rpad(status, 11)}"
+        )
+
+        status == "REGRESSED"
+      end
+
+    IO.puts(separator)
+
+    if Enum.any?(regressions) do
+      IO.puts("PERFORMANCE REGRESSION DETECTED")
+    else
+      IO.puts("No performance regressions.")
+    end
+
+    IO.puts("")
+  end
+
+  defp format(nil, _decimals), do: "-"
+  defp format(value, 0), do: value |> round() |> to_string()
+  defp format(value, decimals), do: :erlang.float_to_binary(value / 1, decimals: decimals)
+
   defp rpad(str, width), do: String.pad_trailing(str, width)
   defp lpad(str, width), do: String.pad_leading(str, width)
 
@@ -167,11 +399,11 @@ defmodule ExVrp.Benchmark do
     data =
       for {name, m} <- results, into: %{} do
         seeds =
-          for {seed, dist, feasible} <- m.seed_results, into: %{} do
-            {to_string(seed), %{distance: dist, feasible: feasible}}
+          for seed_result <- m.seed_results, into: %{} do
+            {to_string(seed_result.seed), Map.delete(seed_result, :seed)}
           end
 
-        {to_string(name), %{best: m.best, all_feasible: m.all_feasible, seeds: seeds}}
+        {to_string(name), %{best: m.best, all_feasible: m.all_feasible, metrics: m.metrics, seeds: seeds}}
       end
 
     File.write!(path, Jason.encode!(data, pretty: true))
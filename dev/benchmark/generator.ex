@@ -0,0 +1,238 @@
+defmodule ExVrp.Benchmark.Generator do
+  @moduledoc """
+  Deterministic generator of synthetic instances for scaling benchmarks.
+
+  The same options and seed always give the same model, so that runs at
+  different commits solve identical instances. Instances are built directly
+  as `ExVrp.Model` structs, which keeps generating 20k clients fast.
+
+  Coordinates lie in a 10_000 x 10_000 square around a central depot, and
+  the default Euclidean distances double as travel times over an 8 hour
+  (28_800) horizon. The fleet is sized from the total demand, with enough
+  slack that the instances are not dominated by fleet size.
+
+  ## Options
+
+  - `:seed` - Random seed (default: `1`)
+  - `:coordinates` - `:random` (uniform) or `:clustered` (Gaussian clusters
+    around a few centres, plus some uniform background clients)
+    (default: `:random`)
+  - `:time_windows` - Give clients time windows of 1 to 3 hours
+    (default: `false`)
+  - `:multi_trip` - Smaller vehicles that reload at the depot, up to three
+    times per route (default: `false`)
+  - `:forbidden_windows` - A 30 minute break in the middle of every shift
+    (default: `false`)
+  - `:same_vehicle_groups` - Fraction of clients in same-vehicle pairs
+    (default: `0.0`)
+  - `:vehicle_types` - Number of vehicle types, with different capacities
+    and costs (default: `1`)
+
+  ## Example
+
+      opts = ExVrp.Benchmark.Generator.profile(:mixed)
+      model = ExVrp.Benchmark.Generator.generate(2_000, opts)
+  """
+
+  alias ExVrp.Client
+  alias ExVrp.Depot
+  alias ExVrp.Model
+  alias ExVrp.SameVehicleGroup
+  alias ExVrp.VehicleType
+
+  @size 10_000
+  @horizon 28_800
+  @break {14_400, 16_200}
+  @base_capacity 100
+
+  @profiles %{
+    random: [],
+    clustered: [coordinates: :clustered],
+    time_windows: [time_windows: true],
+    multi_trip: [multi_trip: true],
+    forbidden_windows: [forbidden_windows: true],
+    same_vehicle: [same_vehicle_groups: 0.1],
+    heterogeneous: [vehicle_types: 3],
+    mixed: [
+      coordinates: :clustered,
+      time_windows: true,
+      multi_trip: true,
+      forbidden_windows: true,
+      same_vehicle_groups: 0.05,
+      vehicle_types: 3
+    ]
+  }
+
+  @doc """
+  Returns the names of the predefined instance profiles.
+  """
+  @spec profiles() :: [atom()]
+  def profiles, do: @profiles |> Map.keys() |> Enum.sort()
+
+  @doc """
+  Returns the generator options of a predefined instance profile.
+  """
+  @spec profile(atom()) :: keyword()
+  def profile(name), do: Map.fetch!(@profiles, name)
+
+  @doc """
+  Generates a model with the given number of clients.
+  """
+  @spec generate(pos_integer(), keyword()) :: Model.t()
+  def generate(num_clients, opts \\ []) when is_integer(num_clients) and num_clients > 0 do
+    seed = Keyword.get(opts, :seed, 1)
+    rng = :rand.seed_s(:exsss, {seed, num_clients, 0})
+
+    {coords, rng} = coordinates(num_clients, Keyword.get(opts, :coordinates, :random), rng)
+    {clients, rng} = clients(coords, opts, rng)
+    {groups, _rng} = same_vehicle_groups(num_clients, Keyword.get(opts, :same_vehicle_groups, 0.0), rng)
+
+    total_demand = Enum.reduce(clients, 0, fn %Client{delivery: [demand]}, acc -> acc + demand end)
+
+    %Model{
+      depots: [Depot.new(x: div(@size, 2), y: div(@size, 2), tw_early: 0, tw_late: @horizon)],
+      clients: clients,
+      vehicle_types: vehicle_types(total_demand, opts),
+      same_vehicle_groups: groups
+    }
+  end
+
+  defp coordinates(num_clients, :random, rng) do
+    map_reduce_times(num_clients, rng, fn rng ->
+      {x, rng} = uniform(@size, rng)
+      {y, rng} = uniform(@size, rng)
+      {{x, y}, rng}
+    end)
+  end
+
+  defp coordinates(num_clients, :clustered, rng) do
+    num_centres = max(3, div(num_clients, 250))
+
+    {centres, rng} =
+      map_reduce_times(num_centres, rng, fn rng ->
+        {x, rng} = uniform(@size, rng)
+        {y, rng} = uniform(@size, rng)
+        {{x, y}, rng}
+      end)
+
+    centres = List.to_tuple(centres)
+
+    # 80% of the clients lie around a centre; the rest are uniform.
+    map_reduce_times(num_clients, rng, fn rng ->
+      {u, rng} = :rand.uniform_s(rng)
+
+      if u < 0.8 do
+        {idx, rng} = :rand.uniform_s(num_centres, rng)
+        {cx, cy} = elem(centres, idx - 1)
+        {dx, rng} = :rand.normal_s(rng)
+        {dy, rng} = :rand.normal_s(rng)
+        {{clamp(round(cx + dx * 400)), clamp(round(cy + dy * 400))}, rng}
+      else
+        {x, rng} = uniform(@size, rng)
+        {y, rng} = uniform(@size, rng)
+        {{x, y}, rng}
+      end
+    end)
+  end
+
+  defp clients(coords, opts, rng) do
+    time_windows? = Keyword.get(opts, :time_windows, false)
+
+    coords
+    |> Enum.with_index(1)
+    |> Enum.map_reduce(rng, fn {{x, y}, idx}, rng ->
+      {demand, rng} = :rand.uniform_s(10, rng)
+      {service, rng} = :rand.uniform_s(240, rng)
+      service = 60 + service
+
+      {tw, rng} =
+        if time_windows?,
+          do: time_window({x, y}, service, rng),
+          else: {[], rng}
+
+      client =
+        Client.new(
+          [x: x, y: y, delivery: [demand], service_duration: service, name: "c#{idx}"] ++ tw
+        )
+
+      {client, rng}
+    end)
+  end
+
+  # A window of 1 to 3 hours that can be reached from, and left for, the
+  # depot within the horizon.
+  defp time_window({x, y}, service, rng) do
+    travel = round(:math.sqrt((x - div(@size, 2)) ** 2 + (y - div(@size, 2)) ** 2))
+    latest_start = max(travel, @horizon - travel - service)
+
+    {width, rng} = :rand.uniform_s(7_200, rng)
+    width = 3_600 + width
+    {start, rng} = :rand.uniform_s(max(latest_start - travel, 1), rng)
+    early = travel + start - 1
+
+    {[tw_early: early, tw_late: min(early + width, latest_start)], rng}
+  end
+
+  # Pairs of consecutive clients (location 0 is the depot).
+  defp same_vehicle_groups(_num_clients, fraction, rng) when fraction <= 0, do: {[], rng}
+
+  defp same_vehicle_groups(num_clients, fraction, rng) do
+    num_groups = min(round(num_clients * fraction / 2), div(num_clients, 2))
+
+    {starts, rng} =
+      map_reduce_times(num_groups, rng, fn rng -> :rand.uniform_s(div(num_clients, 2), rng) end)
+
+    groups =
+      starts
+      |> Enum.uniq()
+      |> Enum.sort()
+      |> Enum.map(fn pair ->
+        %SameVehicleGroup{clients: [2 * pair - 1, 2 * pair], name: "pair#{pair}"}
+      end)
+
+    {groups, rng}
+  end
+
+  defp vehicle_types(total_demand, opts) do
+    num_types = Keyword.get(opts, :vehicle_types, 1)
+    multi_trip? = Keyword.get(opts, :multi_trip, false)
+
+    time_windows =
+      if Keyword.get(opts, :forbidden_windows, false) do
+        {break_start, break_end} = @break
+        [{0, break_start}, {break_end, @horizon}]
+      else
+        [{0, @horizon}]
+      end
+
+    for idx <- 1..num_types do
+      # Larger types carry more, but cost more to use and to drive.
+      capacity = div(@base_capacity * (idx + 1), 2)
+      capacity = if multi_trip?, do: div(capacity, 2), else: capacity
+      trips = if multi_trip?, do: 4, else: 1
+      num_available = ceil(total_demand * 2 / (capacity * trips * num_types)) + 1
+
+      VehicleType.new(
+        [
+          num_available: num_available,
+          capacity: [capacity],
+          time_windows: time_windows,
+          fixed_cost: 1_000 * idx,
+          unit_distance_cost: idx,
+          name: "type#{idx}"
+        ] ++ if(multi_trip?, do: [reload_depots: [0], max_reloads: trips - 1], else: [])
+      )
+    end
+  end
+
+  defp map_reduce_times(count, rng, fun) do
+    Enum.map_reduce(List.duplicate(nil, count), rng, fn nil, rng -> fun.(rng) end)
+  end
+
+  defp uniform(max, rng) do
+    {value, rng} = :rand.uniform_s(max + 1, rng)
+    {value - 1, rng}
+  end
+
+  defp clamp(value), do: value |> max(0) |> min(@size)
+end
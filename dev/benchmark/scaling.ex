@@ -0,0 +1,238 @@
+defmodule ExVrp.Benchmark.Scaling do
+  @moduledoc """
+  Scaling benchmark on synthetic instances.
+
+  Solves instances from `ExVrp.Benchmark.Generator` for each combination of
+  profile and size, with a single start, and reports how the solver scales:
+
+  - setup time per phase (problem data, local search, initial solution), from
+    the `[:ex_vrp, :setup, ...]` spans of `ExVrp.Telemetry`
+  - peak resident set size of the VM during the solve (Linux only)
+  - iterations and evaluated moves per second of the search
+  - time to target: the search time until the best solution is within
+    `:target_gap` of the run's final cost
+
+  Results can be saved as JSON, tagged with the current commit, to track
+  them over time.
+  """
+
+  alias ExVrp.Benchmark
+  alias ExVrp.Benchmark.Generator
+  alias ExVrp.Solver
+  alias ExVrp.StoppingCriteria
+
+  require Logger
+
+  @default_sizes [500, 1_000, 2_000]
+  @default_profiles [:random, :mixed]
+
+  @events [
+    [:ex_vrp, :setup, :problem_data, :stop],
+    [:ex_vrp, :setup, :local_search, :stop],
+    [:ex_vrp, :setup, :initial_solution, :stop],
+    [:ex_vrp, :ils, :new_best],
+    [:ex_vrp, :ils, :throughput]
+  ]
+
+  @doc """
+  Runs the scaling benchmark and returns one result map per run.
+
+  ## Options
+
+  - `:sizes` - Numbers of clients (default: `#{inspect(@default_sizes)}`)
+  - `:profiles` - Generator profiles, see `ExVrp.Benchmark.Generator.profiles/0`
+    (default: `#{inspect(@default_profiles)}`)
+  - `:iterations` - Iterations per run (default: `1000`)
+  - `:max_runtime` - Maximum runtime per run in seconds (default: unlimited)
+  - `:seed` - Seed for both the generator and the solver (default: `1`)
+  - `:target_gap` - Relative gap for the time to target (default: `0.01`)
+  - `:save` - Path to save JSON results
+  """
+  def run(opts \\ []) do
+    sizes = opts |> Keyword.get(:sizes, @default_sizes) |> Enum.sort()
+    profiles = Keyword.get(opts, :profiles, @default_profiles)
+
+    IO.puts("\nRunning scaling benchmark (sizes=#{inspect(sizes)}, profiles=#{inspect(profiles)})...\n")
+
+    prev_level = Logger.level()
+    Logger.configure(level: :warning)
+
+    results =
+      for profile <- profiles, size <- sizes do
+        IO.write("  #{profile}/#{size}...")
+        result = measure(profile, size, opts)
+        IO.puts(" #{format_ms(result.total_setup_ms)} setup, #{round(result.iterations_per_second)} it/s")
+        result
+      end
+
+    Logger.configure(level: prev_level)
+
+    print_report(results)
+
+    if opts[:save], do: save_json(results, opts, opts[:save])
+    results
+  end
+
+  defp measure(profile, size, opts) do
+    seed = Keyword.get(opts, :seed, 1)
+
+    {generate_us, model} =
+      :timer.tc(fn -> Generator.generate(size, Keyword.put(Generator.profile(profile), :seed, seed)) end)
+
+    ref = make_ref()
+    handler_id = {__MODULE__, ref}
+    :telemetry.attach_many(handler_id, @events, &__MODULE__.handle_event/4, {self(), ref})
+    Benchmark.reset_peak_rss()
+
+    {:ok, result} =
+      try do
+        Solver.solve(model,
+          stop: stop(opts),
+          seed: seed,
+          num_starts: 1,
+          telemetry_metadata: %{benchmark_ref: ref}
+        )
+      after
+        :telemetry.detach(handler_id)
+      end
+
+    peak_rss_mb = Benchmark.peak_rss_mb()
+    events = collect_events(ref, [])
+
+    setup_ms =
+      for phase <- [:problem_data, :local_search, :initial_solution], into: %{} do
+        {phase, events |> Enum.find_value(&setup_duration(&1, phase)) |> to_ms()}
+      end
+
+    throughput = for {[:ex_vrp, :ils, :throughput], measurements} <- events, do: measurements
+    moves = throughput |> Enum.map(& &1.moves) |> Enum.sum()
+    interval_ms = throughput |> Enum.map(& &1.interval_ms) |> Enum.sum()
+    final_cost = result.stats.final_cost
+
+    %{
+      profile: profile,
+      size: size,
+      seed: seed,
+      generate_ms: generate_us / 1000,
+      setup_ms: setup_ms,
+      total_setup_ms: setup_ms |> Map.values() |> Enum.sum(),
+      peak_rss_mb: peak_rss_mb,
+      iterations: result.num_iterations,
+      search_ms: result.runtime,
+      iterations_per_second: result.num_iterations / max(result.runtime / 1000, 0.001),
+      moves_per_second: moves / max(interval_ms / 1000, 0.001),
+      final_cost: final_cost,
+      feasible: result.best.is_feasible,
+      time_to_target_ms: time_to_target(events, final_cost, Keyword.get(opts, :target_gap, 0.01))
+    }
+  end
+
+  @doc false
+  def handle_event(event, measurements, %{benchmark_ref: ref}, {pid, ref}) do
+    send(pid, {ref, event, measurements})
+  end
+
+  def handle_event(_event, _measurements, _metadata, _config), do: :ok
+
+  defp collect_events(ref, acc) do
+    receive do
+      {^ref, event, measurements} -> collect_events(ref, [{event, measurements} | acc])
+    after
+      0 -> Enum.reverse(acc)
+    end
+  end
+
+  defp setup_duration({[:ex_vrp, :setup, phase, :stop], %{duration: duration}}, phase), do: duration
+  defp setup_duration(_event, _phase), do: nil
+
+  defp to_ms(nil), do: 0.0
+  defp to_ms(native), do: System.convert_time_unit(native, :native, :microsecond) / 1000
+
+  defp stop(opts) do
+    iterations = StoppingCriteria.max_iterations(Keyword.get(opts, :iterations, 1000))
+
+    case opts[:max_runtime] do
+      nil -> iterations
+      seconds -> StoppingCriteria.any([iterations, StoppingCriteria.max_runtime(seconds)])
+    end
+  end
+
+  # The search time of the first new best solution within the target gap.
+  # Without any new best solution, the initial solution was already the
+  # final one, and the target was met at the start of the search.
+  defp time_to_target(_events, :infinity, _gap), do: nil
+
+  defp time_to_target(events, final_cost, gap) do
+    target = final_cost * (1 + gap)
+
+    Enum.find_value(events, 0, fn
+      {[:ex_vrp, :ils, :new_best], %{cost: cost, elapsed_ms: elapsed_ms}} when cost <= target -> elapsed_ms
+      _event -> nil
+    end)
+  end
+
+  defp print_report(results) do
+    separator = String.duplicate("-", 100)
+
+    IO.puts("")
+    IO.puts("Scaling Report")
+    IO.puts(separator)
+
+    IO.puts(
+      "#{rpad("Profile", 18)} #{lpad("Size", 7)} #{lpad("Setup ms", 10)} #{lpad("Peak MB", 9)} #{lpad("It/s", 9)} #{lpad("Moves/s", 12)} #{lpad("TTT ms", 9)} #{lpad("Cost", 12)} #{rpad("Feasible", 8)}"
+    )
+
+    IO.puts(separator)
+
+    for r <- results do
+      IO.puts(
+        "#{rpad(to_string(r.profile), 18)} #{lpad(to_string(r.size), 7)} #{lpad(format_ms(r.total_setup_ms), 10)} #{lpad(format_mb(r.peak_rss_mb), 9)} #{lpad(to_string(round(r.iterations_per_second)), 9)} #{lpad(to_string(round(r.moves_per_second)), 12)} #{lpad(to_string(r.time_to_target_ms), 9)} #{lpad(to_string(r.final_cost), 12)} #{rpad(to_string(r.feasible), 8)}"
+      )
+    end
+
+    IO.puts(separator)
+    IO.puts("")
+  end
+
+  defp format_ms(ms), do: :erlang.float_to_binary(ms / 1, decimals: 1)
+  defp format_mb(nil), do: "-"
+  defp format_mb(mb), do: :erlang.float_to_binary(mb, decimals: 1)
+
+  defp rpad(str, width), do: String.pad_trailing(str, width)
+  defp lpad(str, width), do: String.pad_leading(str, width)
+
+  defp save_json(results, opts, path) do
+    data = %{
+      commit: commit(),
+      otp_release: to_string(:erlang.system_info(:otp_release)),
+      schedulers: System.schedulers_online(),
+      timestamp: DateTime.to_iso8601(DateTime.utc_now()),
+      options: %{
+        iterations: Keyword.get(opts, :iterations, 1000),
+        max_runtime: opts[:max_runtime],
+        seed: Keyword.get(opts, :seed, 1),
+        target_gap: Keyword.get(opts, :target_gap, 0.01)
+      },
+      results: Enum.map(results, &json_result/1)
+    }
+
+    File.write!(path, Jason.encode!(data, pretty: true))
+    IO.puts("Results saved to #{path}")
+  end
+
+  defp json_result(result) do
+    %{result | profile: to_string(result.profile), final_cost: json_cost(result.final_cost)}
+  end
+
+  defp json_cost(:infinity), do: nil
+  defp json_cost(cost), do: cost
+
+  defp commit do
+    case System.cmd("git", ["rev-parse", "--short", "HEAD"], stderr_to_stdout: true) do
+      {sha, 0} -> String.trim(sha)
+      _error -> nil
+    end
+  rescue
+    ErlangError -> nil
+  end
+end
@@ -0,0 +1,67 @@
+defmodule Mix.Tasks.Benchmark.Scaling do
+  @shortdoc "Run the scaling benchmark on synthetic instances"
+
+  @moduledoc """
+  Run the scaling benchmark on generated instances of increasing size.
+
+  Reports setup-phase times, peak RSS, iterations and moves per second, and
+  time to target for each profile and size. See `ExVrp.Benchmark.Scaling`
+  and `ExVrp.Benchmark.Generator`.
+
+  ## Usage
+
+      mix benchmark.scaling                              # Default sizes and profiles
+      mix benchmark.scaling --sizes 2000,5000,20000      # Custom sizes
+      mix benchmark.scaling --profiles mixed,time_windows
+      mix benchmark.scaling --iterations 500 --max-runtime 60
+      mix benchmark.scaling --target-gap 0.02            # Time to within 2%
+      mix benchmark.scaling --save scaling.json          # Save results to file
+
+  ## Available profiles
+
+  - random, clustered, time_windows, multi_trip, forbidden_windows,
+    same_vehicle, heterogeneous, mixed
+  """
+  use Mix.Task
+
+  alias ExVrp.Benchmark.Generator
+
+  @requirements ["app.config"]
+
+  @impl Mix.Task
+  def run(args) do
+    {opts, _, _} =
+      OptionParser.parse(args,
+        switches: [
+          sizes: :string,
+          profiles: :string,
+          iterations: :integer,
+          max_runtime: :float,
+          seed: :integer,
+          target_gap: :float,
+          save: :string
+        ]
+      )
+
+    Application.ensure_all_started(:ex_vrp)
+
+    opts =
+      opts
+      |> parse_list(:sizes, &String.to_integer/1)
+      |> parse_list(:profiles, &parse_profile/1)
+
+    ExVrp.Benchmark.Scaling.run(opts)
+  end
+
+  defp parse_list(opts, key, parse) do
+    case opts[key] do
+      nil -> opts
+      value -> Keyword.put(opts, key, value |> String.split(",", trim: true) |> Enum.map(parse))
+    end
+  end
+
+  defp parse_profile(name) do
+    Enum.find(Generator.profiles(), &(Atom.to_string(&1) == name)) ||
+      Mix.raise("Unknown profile #{name}, expected one of #{Enum.join(Generator.profiles(), ", ")}")
+  end
+end
@@ -0,0 +1,53 @@
+defmodule ExVrp.Decomposition do
+  @moduledoc """
+  Route-based decomposition, for very large instances (thousands of clients)
+  where a full local search pass is slow and most improving moves are local.
+
+  Enabled with `ExVrp.Solver.solve(model, decomposition_params: %Params{interval: 100})`,
+  which then runs the ILS in native code. Every `:interval` iterations, the
+  ILS partitions the routes of its best solution into clusters of about
+  `:cluster_size` clients, by the polar angle of their centroids, with cluster
+  boundaries that change from round to round. Each cluster becomes a
+  subproblem with its clients, all depots, and as many vehicles of each type
+  as its routes use. The subproblems are solved in parallel by short ILS runs
+  that start from the cluster's routes, and each cluster that improves gets
+  its new routes back in the global solution.
+
+  Decomposition is off by default. It does not pay off on instances of a few
+  hundred clients, so enable it only for large instances where it is shown to
+  help; the `:decompositions` and `:decomposition_improvements` counts of a
+  native solve tell how often it ran and improved the best solution.
+
+  Decomposition is skipped for data with client groups or same-vehicle
+  groups, which can span several clusters.
+  """
+
+  defmodule Params do
+    @moduledoc """
+    Parameters for route-based decomposition.
+
+    - `:interval` - ILS iterations between decomposition rounds (`0`, the
+      default, disables decomposition)
+    - `:cluster_size` - Target number of clients per subproblem
+    - `:max_iterations` - Maximum ILS iterations per subproblem
+    - `:max_runtime_ms` - Maximum runtime per subproblem in milliseconds,
+      capped by the remaining runtime of the solve (`0` for no limit of its
+      own)
+    - `:num_threads` - Threads that solve the subproblems (`0` for all
+      hardware threads)
+    """
+    defstruct interval: 0,
+              cluster_size: 300,
+              max_iterations: 500,
+              max_runtime_ms: 1_000,
+              num_threads: 0
+
+    @type t :: %__MODULE__{
+            interval: non_neg_integer(),
+            cluster_size: pos_integer(),
+            max_iterations: pos_integer(),
+            max_runtime_ms: non_neg_integer(),
+            num_threads: non_neg_integer()
+          }
+  end
+end
@@ -0,0 +1,51 @@
+defmodule ExVrp.GeneticAlgorithm do
+  @moduledoc """
+  Hybrid genetic search, as in PyVRP's `GeneticAlgorithm`.
+
+  Selected with `ExVrp.Solver.solve(model, algorithm: :hgs)`. The algorithm
+  runs entirely in native code: it keeps a population of feasible and
+  infeasible solutions, selects parents by binary tournament on their biased
+  fitness (a mix of cost rank and broken-pairs diversity), recombines them with
+  selective route exchange (or ordered crossover when there is a single
+  vehicle), and educates each offspring with the same local search as the ILS.
+  Infeasible offspring are repaired with a probability, and the population
+  restarts after a number of iterations without improvement.
+  """
+
+  defmodule Params do
+    @moduledoc """
+    Parameters for the hybrid genetic search.
+
+    - `:min_pop_size` - Minimum size of each subpopulation
+    - `:generation_size` - Number of solutions added before a subpopulation
+      is purged back to `:min_pop_size`
+    - `:num_elite` - Number of elite solutions whose fitness weighs diversity
+      less
+    - `:num_close` - Number of closest solutions in the diversity measure
+    - `:lb_diversity` / `:ub_diversity` - Preferred range of the broken-pairs
+      distance between selected parents
+    - `:repair_probability` - Probability of repairing an infeasible offspring
+    - `:num_iters_no_improvement` - Iterations without improvement before the
+      population restarts
+    """
+    defstruct min_pop_size: 25,
+              generation_size: 40,
+              num_elite: 4,
+              num_close: 5,
+              lb_diversity: 0.1,
+              ub_diversity: 0.5,
+              repair_probability: 0.8,
+              num_iters_no_improvement: 20_000
+
+    @type t :: %__MODULE__{
+            min_pop_size: pos_integer(),
+            generation_size: non_neg_integer(),
+            num_elite: non_neg_integer(),
+            num_close: pos_integer(),
+            lb_diversity: float(),
+            ub_diversity: float(),
+            repair_probability: float(),
+            num_iters_no_improvement: pos_integer()
+          }
+  end
+end
@@ -17,21 +17,48 @@ defmodule ExVrp.IteratedLocalSearch do
   alias ExVrp.Native
   alias ExVrp.PenaltyManager
   alias ExVrp.Solution
+  alias ExVrp.Telemetry
 
   require Logger
 
   defmodule Params do
     @moduledoc """
     Parameters for Iterated Local Search.
+
+    With `skip_seen: true`, late acceptance does not accept a candidate that
+    is the current solution or already in the history buffer (compared by
+    `ExVrp.Solution.hash/1`), unless it improves on the current solution.
+    This keeps the search from cycling back to solutions it has already
+    visited. Off by default, matching PyVRP.
+
+    With a positive `elite_size`, the native ILS (`ExVrp.Solver.solve_batch/2`,
+    `ExVrp.Native.solve_native/2`, and `exvrp_solve`) keeps an archive of
+    diverse feasible solutions, at least `min_elite_distance` apart in broken
+    pairs distance. A restart then relinks a random archived solution towards
+    the cheapest one, polishing `relink_steps` intermediate solutions, instead
+    of restarting from the best solution. The Elixir ILS ignores these fields.
+    Off by default.
     """
     defstruct max_no_improvement: 5_000,
               # Number of iterations without improvement before restart
               # Size of the late acceptance history buffer
-              history_size: 500
+              history_size: 500,
+              # Skip candidates already seen during late acceptance
+              skip_seen: false,
+              # Native ILS only: size of the elite archive (0 disables it)
+              elite_size: 0,
+              # Native ILS only: minimum distance between elite solutions
+              min_elite_distance: 0.05,
+              # Native ILS only: intermediate solutions per path relinking
+              relink_steps: 4
 
     @type t :: %__MODULE__{
             max_no_improvement: pos_integer(),
-            history_size: pos_integer()
+            history_size: pos_integer(),
+            skip_seen: boolean(),
+            elite_size: non_neg_integer(),
+            min_elite_distance: float(),
+            relink_steps: pos_integer()
           }
   end
 
@@ -75,7 +102,8 @@ defmodule ExVrp.IteratedLocalSearch do
     - `cost/1` - Returns the cost of the best solution (infinity if infeasible)
     - `feasible?/1` - Returns whether the best solution is feasible
     - `best` - The best Solution found
-    - `stats` - Statistics from the search
+    - `stats` - Statistics from the search, including `:local_search_ms`,
+      the time spent in the local search NIF
     - `num_iterations` - Total iterations performed
     - `runtime` - Runtime in milliseconds
     """
@@ -143,6 +171,8 @@ defmodule ExVrp.IteratedLocalSearch do
   - `initial_solution` - Starting solution reference
   - `stop_fn` - Function that takes best_cost and returns true to stop
   - `params` - ILS parameters (optional)
+  - `opts` - `:seed`, `:on_progress`, `:max_runtime_ms`, and the
+    `:telemetry_metadata` and `:telemetry_interval_ms` of `ExVrp.Telemetry`
 
   ## Returns
 
@@ -157,6 +187,8 @@ defmodule ExVrp.IteratedLocalSearch do
     on_progress = Keyword.get(opts, :on_progress)
 
     max_runtime_ms = Keyword.get(opts, :max_runtime_ms)
+    telemetry_metadata = Keyword.get(opts, :telemetry_metadata, %{})
+    sampler = Telemetry.new_sampler(local_search, 0, Keyword.get(opts, :telemetry_interval_ms))
 
     {:ok, cost_eval} = PenaltyManager.cost_evaluator(penalty_manager)
 
@@ -179,6 +211,8 @@ defmodule ExVrp.IteratedLocalSearch do
       current_cost: initial_penalised_cost,
       # Ring buffer matching PyVRP's implementation exactly
       history: RingBuffer.new(params.history_size),
+      # Solution hash => number of occurrences in the history, if skip_seen
+      seen: %{},
       iteration: 0,
       iters_no_improvement: 0,
       initial_cost: initial_penalised_cost,
@@ -190,12 +224,20 @@ defmodule ExVrp.IteratedLocalSearch do
         improvements: 0,
         restarts: 0
       },
+      # Time spent in the local search NIF, in native time units
+      local_search_time: 0,
       on_progress: on_progress,
-      last_progress_time: start_time
+      last_progress_time: start_time,
+      telemetry_metadata: telemetry_metadata,
+      sampler: sampler
     }
 
     final_state = iterate(state, stop_fn)
 
+    if final_state.iteration > final_state.sampler.iteration do
+      Telemetry.sample(final_state.sampler, local_search, final_state.iteration, telemetry_metadata)
+    end
+
     runtime = System.monotonic_time(:millisecond) - start_time
 
     %Result{
@@ -203,7 +245,8 @@ defmodule ExVrp.IteratedLocalSearch do
       stats:
         Map.merge(final_state.stats, %{
           initial_cost: final_state.initial_cost,
-          final_cost: final_state.best_cost
+          final_cost: final_state.best_cost,
+          local_search_ms: System.convert_time_unit(final_state.local_search_time, :native, :microsecond) / 1000
         }),
       num_iterations: final_state.iteration,
       runtime: runtime
@@ -231,6 +274,7 @@ defmodule ExVrp.IteratedLocalSearch do
       |> update_penalty_manager()
       |> Map.update!(:iteration, &(&1 + 1))
       |> maybe_report_progress()
+      |> maybe_sample_throughput()
       |> iterate(stop_fn)
     end
   end
@@ -254,11 +298,18 @@ defmodule ExVrp.IteratedLocalSearch do
           {state.best, Native.solution_penalised_cost(state.best, state.cost_eval)}
         end
 
+      Telemetry.execute(
+        [:ils, :restart],
+        %{iteration: state.iteration, restarts: state.stats.restarts + 1},
+        Map.put(state.telemetry_metadata, :fresh_start, state.best_cost == :infinity)
+      )
+
       %{
         state
         | current: restart_sol,
           current_cost: restart_cost,
           history: RingBuffer.clear(state.history),
+          seen: %{},
           iters_no_improvement: 0,
           stats: Map.update!(state.stats, :restarts, &(&1 + 1))
       }
@@ -274,6 +325,8 @@ defmodule ExVrp.IteratedLocalSearch do
     # Use persistent LocalSearch for performance
     # RNG is stored in the LocalSearch resource and advances across calls,
     # matching PyVRP's behavior
+    started = System.monotonic_time()
+
     {:ok, candidate} =
       Native.local_search_run(
         state.local_search,
@@ -282,11 +335,13 @@ defmodule ExVrp.IteratedLocalSearch do
         timeout_ms
       )
 
+    local_search_time = state.local_search_time + System.monotonic_time() - started
     candidate_cost = Native.solution_penalised_cost(candidate, state.cost_eval)
 
     Map.merge(state, %{
       candidate: candidate,
-      candidate_cost: candidate_cost
+      candidate_cost: candidate_cost,
+      local_search_time: local_search_time
     })
   end
 
@@ -312,9 +367,14 @@ defmodule ExVrp.IteratedLocalSearch do
     late_cost = compute_late_cost(late, new_best, state.cost_eval)
 
     {new_current, new_curr_cost} =
-      accept_candidate(candidate, cand_cost, current, curr_cost, state.best_cost, candidate_obj_cost, late_cost)
+      if seen?(state) and cand_cost >= curr_cost and not first_feasible?(state.best_cost, candidate_obj_cost) do
+        {current, curr_cost}
+      else
+        accept_candidate(candidate, cand_cost, current, curr_cost, state.best_cost, candidate_obj_cost, late_cost)
+      end
 
     new_history = update_history(history, new_current, new_curr_cost, late, late_cost)
+    new_seen = update_seen(state, new_current, late, late == nil or new_curr_cost < late_cost)
 
     %{
       state
@@ -324,11 +384,40 @@ defmodule ExVrp.IteratedLocalSearch do
         best_cost: new_best_cost,
         best_penalised_cost: new_best_penalised,
         history: new_history,
+        seen: new_seen,
         iters_no_improvement: new_iters_no_improvement,
         stats: new_stats
     }
   end
 
+  # With skip_seen, whether the candidate is the current solution or in the
+  # history. Such candidates are only accepted if they improve on the current.
+  defp seen?(%{params: %{skip_seen: true}} = state) do
+    hash = Native.solution_hash(state.candidate)
+    hash == Native.solution_hash(state.current) or Map.has_key?(state.seen, hash)
+  end
+
+  defp seen?(_state), do: false
+
+  # Counts the hashes of the history's solutions: an append stores current in
+  # place of late.
+  defp update_seen(%{params: %{skip_seen: true}, seen: seen}, current, late, true = _appended?) do
+    seen = Map.update(seen, Native.solution_hash(current), 1, &(&1 + 1))
+
+    if late == nil do
+      seen
+    else
+      late_hash = Native.solution_hash(late)
+
+      case Map.fetch!(seen, late_hash) do
+        1 -> Map.delete(seen, late_hash)
+        count -> Map.put(seen, late_hash, count - 1)
+      end
+    end
+  end
+
+  defp update_seen(state, _current, _late, _appended?), do: state.seen
+
   # Update best if candidate improves. Use cost() (infinity for infeasible)
   # so feasible always beats infeasible. When both are infeasible, fall back
   # to penalisedCost so the solver tracks progress toward feasibility.
@@ -338,6 +427,7 @@ defmodule ExVrp.IteratedLocalSearch do
 
     cond do
       candidate_obj_cost < best_cost ->
+        report_new_best(state, candidate_obj_cost)
         stats = Map.update!(state.stats, :improvements, &(&1 + 1))
         {candidate, candidate_obj_cost, cand_cost, 0, stats}
 
@@ -354,6 +444,19 @@ defmodule ExVrp.IteratedLocalSearch do
     end
   end
 
+  defp report_new_best(state, cost) do
+    Telemetry.execute(
+      [:ils, :new_best],
+      %{
+        iteration: state.iteration,
+        cost: cost,
+        distance: Native.solution_distance(state.candidate),
+        elapsed_ms: System.monotonic_time(:millisecond) - state.start_time
+      },
+      state.telemetry_metadata
+    )
+  end
+
   # PyVRP lines 157-159: late_cost from history.peek() or best
   defp compute_late_cost(nil, best, cost_eval), do: Native.solution_penalised_cost(best, cost_eval)
 
@@ -364,15 +467,15 @@ defmodule ExVrp.IteratedLocalSearch do
   # from infeasible to feasible is always an improvement even if penalised
   # cost is higher (uncollected prizes inflate cost of feasible solutions).
   defp accept_candidate(candidate, cand_cost, current, curr_cost, best_cost, candidate_obj_cost, late_cost) do
-    first_feasible? = best_cost == :infinity and candidate_obj_cost != :infinity
-
-    if first_feasible? or cand_cost < late_cost or cand_cost < curr_cost do
+    if first_feasible?(best_cost, candidate_obj_cost) or cand_cost < late_cost or cand_cost < curr_cost do
       {candidate, cand_cost}
     else
       {current, curr_cost}
     end
   end
 
+  defp first_feasible?(best_cost, candidate_obj_cost), do: best_cost == :infinity and candidate_obj_cost != :infinity
+
   # PyVRP lines 171-174: Update history
   # - append(current) if curr_cost < late_cost OR late is nil
   # - skip() otherwise
@@ -391,11 +494,30 @@ defmodule ExVrp.IteratedLocalSearch do
     if new_pm == state.penalty_manager do
       state
     else
+      maybe_report_penalty_update(state.penalty_manager, new_pm, state)
       {:ok, new_cost_eval} = PenaltyManager.cost_evaluator(new_pm)
       %{state | penalty_manager: new_pm, cost_eval: new_cost_eval}
     end
   end
 
+  # Registration also changes the feasibility history, so compare only the
+  # penalty weights themselves.
+  defp maybe_report_penalty_update(old_pm, new_pm, state) do
+    if {old_pm.load_penalties, old_pm.tw_penalty, old_pm.dist_penalty} !=
+         {new_pm.load_penalties, new_pm.tw_penalty, new_pm.dist_penalty} do
+      Telemetry.execute(
+        [:ils, :penalty_update],
+        %{
+          iteration: state.iteration,
+          tw_penalty: new_pm.tw_penalty,
+          dist_penalty: new_pm.dist_penalty,
+          max_load_penalty: Enum.max(new_pm.load_penalties, fn -> 0.0 end)
+        },
+        Map.put(state.telemetry_metadata, :load_penalties, new_pm.load_penalties)
+      )
+    end
+  end
+
   defp maybe_report_progress(%{on_progress: nil} = state), do: state
   defp maybe_report_progress(%{on_progress: f} = state) when not is_function(f, 1), do: state
 
@@ -428,6 +550,11 @@ defmodule ExVrp.IteratedLocalSearch do
     end
   end
 
+  defp maybe_sample_throughput(state) do
+    sampler = Telemetry.maybe_sample(state.sampler, state.local_search, state.iteration, state.telemetry_metadata)
+    %{state | sampler: sampler}
+  end
+
   # Remaining time budget in milliseconds (0 means no timeout).
   # round/1 ensures integer for NIF when max_runtime_ms is a float.
   defp remaining_timeout_ms(%{max_runtime_ms: nil}), do: 0
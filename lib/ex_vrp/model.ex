@@ -65,6 +65,28 @@ defmodule ExVrp.Model do
       [c1, c2] = model.clients
       model = ExVrp.Model.add_same_vehicle_group(model, [c1, c2])
 
+  ## Hard Time Windows
+
+  By default, time window violations are allowed during the search at a
+  penalty, and only solutions without them are feasible. When client time
+  windows are contractual, mark them as hard:
+
+      model = ExVrp.Model.set_hard_time_windows(model, true)
+
+  The search then never connects two clients directly when the second
+  cannot be reached in time after serving the first, given the depot and
+  shift windows of the vehicles that can serve them. On tightly windowed
+  instances this rules out most client pairs, and the search skips them.
+
+  Client time windows can also be narrowed internally to the service starts
+  that those depot and shift windows allow, which prunes more moves:
+
+      model = ExVrp.Model.set_tighten_time_windows(model, true)
+
+  This is independent of hard time windows. It is only sound when costs and
+  penalties do not depend on the original window bounds, since time warp is
+  then counted against the narrowed windows.
+
   ## Validation
 
   Models are validated automatically before solving. You can also validate
@@ -90,7 +112,9 @@ defmodule ExVrp.Model do
           client_groups: [ClientGroup.t()],
           same_vehicle_groups: [SameVehicleGroup.t()],
           distance_matrices: [[[non_neg_integer()]]],
-          duration_matrices: [[[non_neg_integer()]]]
+          duration_matrices: [[[non_neg_integer()]]],
+          hard_time_windows: boolean(),
+          tighten_time_windows: boolean()
         }
 
   defstruct clients: [],
@@ -99,7 +123,9 @@ defmodule ExVrp.Model do
             client_groups: [],
             same_vehicle_groups: [],
             distance_matrices: [],
-            duration_matrices: []
+            duration_matrices: [],
+            hard_time_windows: false,
+            tighten_time_windows: false
 
   @doc """
   Creates a new empty model.
@@ -392,6 +418,42 @@ defmodule ExVrp.Model do
     %{model | duration_matrices: matrices}
   end
 
+  @doc """
+  Sets whether client time windows are hard constraints.
+
+  With hard time windows, the search never creates an arc between two
+  clients that no solution without time warp can contain, and neighbourhoods
+  leave out such pairs. See "Hard Time Windows" above. Default `false`.
+
+  ## Example
+
+      model
+      |> ExVrp.Model.set_hard_time_windows(true)
+
+  """
+  @spec set_hard_time_windows(t(), boolean()) :: t()
+  def set_hard_time_windows(%__MODULE__{} = model, hard?) when is_boolean(hard?) do
+    %{model | hard_time_windows: hard?}
+  end
+
+  @doc """
+  Sets whether client time windows are tightened to the service starts that
+  the vehicles' depot and shift windows allow.
+
+  Only sound when costs and penalties do not depend on the original window
+  bounds. See "Hard Time Windows" above. Default `false`.
+
+  ## Example
+
+      model
+      |> ExVrp.Model.set_tighten_time_windows(true)
+
+  """
+  @spec set_tighten_time_windows(t(), boolean()) :: t()
+  def set_tighten_time_windows(%__MODULE__{} = model, tighten?) when is_boolean(tighten?) do
+    %{model | tighten_time_windows: tighten?}
+  end
+
   @doc """
   Validates the model and returns any errors.
 
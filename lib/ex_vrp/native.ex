@@ -31,6 +31,8 @@ defmodule ExVrp.Native do
     solution_num_routes: 1,
     solution_num_clients: 1,
     solution_unassigned: 1,
+    solution_hash: 1,
+    solution_broken_pairs_distances: 2,
     # CostEvaluator
     create_cost_evaluator_nif: 1,
     solution_penalised_cost: 2,
@@ -49,6 +51,7 @@ defmodule ExVrp.Native do
     problem_data_has_time_windows_nif: 1,
     problem_data_centroid_nif: 1,
     problem_data_num_profiles_nif: 1,
+    problem_data_dump_nif: 1,
     # ProblemData extraction
     problem_data_clients_nif: 1,
     problem_data_distance_matrix_nif: 2,
@@ -61,9 +64,25 @@ defmodule ExVrp.Native do
     local_search_with_operators_nif: 4,
     local_search_stats_nif: 4,
     # LocalSearch (persistent resource)
-    create_local_search_nif: 2,
+    create_local_search_nif: 3,
     local_search_run_nif: 4,
     local_search_search_run_nif: 4,
+    local_search_lock_prefixes_nif: 3,
+    local_search_set_profiling_nif: 2,
+    local_search_profile_nif: 1,
+    local_search_reset_profile_nif: 1,
+    local_search_counters_nif: 1,
+    # Session (incremental re-optimisation)
+    create_session_nif: 2,
+    session_insert_nif: 4,
+    session_lock_prefixes_nif: 2,
+    session_update_nif: 4,
+    # Batch solve
+    solve_batch_nif: 2,
+    solve_native_nif: 2,
+    # Resource reclamation
+    reclaim_stats_nif: 0,
+    set_reclaim_threshold_nif: 1,
     # Route stats via Solution
     solution_route_distance: 2,
     solution_route_duration: 2,
@@ -310,6 +329,20 @@ defmodule ExVrp.Native do
   @spec solution_unassigned(reference()) :: [non_neg_integer()]
   def solution_unassigned(_solution), do: :erlang.nif_error(:nif_not_loaded)
 
+  @doc """
+  Gets the Zobrist hash of a solution's arcs. Solutions with the same
+  predecessor and successor for each client have the same hash.
+  """
+  @spec solution_hash(reference()) :: non_neg_integer()
+  def solution_hash(_solution), do: :erlang.nif_error(:nif_not_loaded)
+
+  @doc """
+  Gets the broken pairs distance, in [0, 1], between a solution and each
+  solution of a pool, in order. Runs on a dirty scheduler.
+  """
+  @spec solution_broken_pairs_distances(reference(), [reference()]) :: [float()]
+  def solution_broken_pairs_distances(_solution, _pool), do: :erlang.nif_error(:nif_not_loaded)
+
   # ---------------------------------------------------------------------------
   # CostEvaluator
   # ---------------------------------------------------------------------------
@@ -463,6 +496,21 @@ defmodule ExVrp.Native do
   @spec problem_data_num_profiles_nif(reference()) :: non_neg_integer()
   def problem_data_num_profiles_nif(_problem_data), do: :erlang.nif_error(:nif_not_loaded)
 
+  @doc """
+  Serialises ProblemData to a self-contained binary dump.
+
+  The dump can be solved outside the BEAM with the `exvrp_solve` CLI
+  (`make solver-cli`), which runs the same native search as
+  `ExVrp.Solver.solve/2` and prints a timing breakdown:
+
+      {:ok, data} = ExVrp.Model.to_problem_data(model)
+      File.write!("instance.dump", ExVrp.Native.problem_data_dump(data))
+  """
+  @spec problem_data_dump(reference()) :: binary()
+  def problem_data_dump(problem_data), do: problem_data_dump_nif(problem_data)
+
+  defp problem_data_dump_nif(_problem_data), do: :erlang.nif_error(:nif_not_loaded)
+
   # ---------------------------------------------------------------------------
   # ProblemData - Data Extraction for Neighbourhood Computation
   # ---------------------------------------------------------------------------
@@ -579,6 +627,9 @@ defmodule ExVrp.Native do
     - `:exchange33` / `:swap33` - Exchange 3 nodes for 3
     - `:swap_tails` - Swap route tails
     - `:relocate_with_depot` - Relocate with depot reload (multi-trip)
+    - `:two_opt` - Reverse the visits between two nodes of the same route
+    - `:or_opt_reverse2` - Relocate two consecutive nodes, reversed
+    - `:or_opt_reverse3` - Relocate three consecutive nodes, reversed
 
   - `:route_operators` - List of route operator names:
     - `:swap_star` - SWAP* operator (Vidal et al.)
@@ -640,17 +691,21 @@ defmodule ExVrp.Native do
 
   - `problem_data` - Reference to the problem data
   - `seed` - Random seed for the RNG
+  - `opts` - Keyword list of options:
+    - `:node_operators` - Segment-reversing operators to add to the default
+      operators: `:two_opt`, `:or_opt_reverse2` and `:or_opt_reverse3` (see
+      `local_search_with_operators/4`). Default: `[]`.
 
   ## Returns
 
   Reference to the LocalSearch resource.
   """
-  @spec create_local_search(reference(), integer()) :: reference()
-  def create_local_search(problem_data, seed) do
-    create_local_search_nif(problem_data, seed)
+  @spec create_local_search(reference(), integer(), keyword()) :: reference()
+  def create_local_search(problem_data, seed, opts \\ []) do
+    create_local_search_nif(problem_data, seed, Map.new(opts))
   end
 
-  defp create_local_search_nif(_problem_data, _seed), do: :erlang.nif_error(:nif_not_loaded)
+  defp create_local_search_nif(_problem_data, _seed, _opts), do: :erlang.nif_error(:nif_not_loaded)
 
   @doc """
   Runs local search using a persistent LocalSearch resource.
@@ -706,6 +761,308 @@ defmodule ExVrp.Native do
   defp local_search_search_run_nif(_local_search, _solution, _cost_evaluator, _timeout_ms),
     do: :erlang.nif_error(:nif_not_loaded)
 
+  @doc """
+  Locks a prefix of each route of a solution in a persistent LocalSearch resource.
+
+  Locked clients are frozen in place: subsequent runs do not move or remove
+  them, nor insert other clients before or between them. Moves that change an
+  arc between locked clients are rejected; clients may still be moved directly
+  after the last locked client. Replaces any existing locks.
+
+  ## Parameters
+
+  - `local_search` - Reference to LocalSearch resource from `create_local_search/2`
+  - `solution` - Reference to the solution whose routes are locked
+  - `prefix_lengths` - Number of leading visits to lock, per route in the
+    order of `solution_routes/1`. Routes without an entry are not locked, so
+    `[]` unlocks all clients.
+  """
+  @spec local_search_lock_prefixes(reference(), reference(), [non_neg_integer()]) :: :ok
+  def local_search_lock_prefixes(local_search, solution, prefix_lengths) do
+    local_search_lock_prefixes_nif(local_search, solution, prefix_lengths)
+  end
+
+  defp local_search_lock_prefixes_nif(_local_search, _solution, _prefix_lengths),
+    do: :erlang.nif_error(:nif_not_loaded)
+
+  @doc """
+  Enables or disables profiling on a persistent LocalSearch resource.
+
+  While enabled, every run records the number of calls and the wall-clock
+  time spent per search phase and per operator evaluation. Timings accumulate
+  across runs until `local_search_reset_profile/1` is called. Disabled by
+  default; when disabled, the clock is never read.
+  """
+  @spec local_search_set_profiling(reference(), boolean()) :: :ok
+  def local_search_set_profiling(local_search, enabled) do
+    local_search_set_profiling_nif(local_search, enabled)
+  end
+
+  defp local_search_set_profiling_nif(_local_search, _enabled), do: :erlang.nif_error(:nif_not_loaded)
+
+  @doc """
+  Returns the accumulated profile of a persistent LocalSearch resource.
+
+  ## Returns
+
+  A map with `:phases` and `:operators`, each mapping a name to
+  `%{count: non_neg_integer(), time_ns: non_neg_integer()}`. Phases are
+  `:load`, `:perturb`, `:search`, `:intensify`, `:multi_trip`,
+  `:repair_forbidden_windows`, `:strip_forbidden_windows`,
+  `:strip_infeasible_forbidden_windows` and `:unload`. Operators are the
+  resource's operators, e.g. `:exchange10` or `:swap_routes`.
+
+  Operator evaluations are part of the `:search` and `:intensify` phases.
+  """
+  @spec local_search_profile(reference()) :: %{
+          phases: %{atom() => %{count: non_neg_integer(), time_ns: non_neg_integer()}},
+          operators: %{atom() => %{count: non_neg_integer(), time_ns: non_neg_integer()}}
+        }
+  def local_search_profile(local_search) do
+    local_search_profile_nif(local_search)
+  end
+
+  defp local_search_profile_nif(_local_search), do: :erlang.nif_error(:nif_not_loaded)
+
+  @doc """
+  Resets the accumulated profile of a persistent LocalSearch resource to zero.
+  """
+  @spec local_search_reset_profile(reference()) :: :ok
+  def local_search_reset_profile(local_search) do
+    local_search_reset_profile_nif(local_search)
+  end
+
+  defp local_search_reset_profile_nif(_local_search), do: :erlang.nif_error(:nif_not_loaded)
+
+  @doc """
+  Returns the search statistics of a persistent LocalSearch resource, summed
+  over all runs since the resource was created.
+
+  ## Returns
+
+  A map with `:runs` (number of `local_search_run/4` and
+  `local_search_search_run/4` calls), `:moves` (evaluated operator moves),
+  `:improving` (applied improving moves) and `:updates` (all changes to the
+  solution, including e.g. insertion of missing clients).
+  """
+  @spec local_search_counters(reference()) :: %{
+          runs: non_neg_integer(),
+          moves: non_neg_integer(),
+          improving: non_neg_integer(),
+          updates: non_neg_integer()
+        }
+  def local_search_counters(local_search) do
+    local_search_counters_nif(local_search)
+  end
+
+  defp local_search_counters_nif(_local_search), do: :erlang.nif_error(:nif_not_loaded)
+
+  # ---------------------------------------------------------------------------
+  # Session (incremental re-optimisation)
+  # ---------------------------------------------------------------------------
+
+  @doc """
+  Creates a re-optimisation session around a solution.
+
+  The session keeps the solution resident together with a LocalSearch built
+  for the solution's problem data, so that new clients can be inserted
+  without rebuilding everything. See `ExVrp.Session` for the high-level API.
+
+  ## Parameters
+
+  - `solution` - Reference to the plan to start from
+  - `seed` - Random seed for the session's RNG
+
+  ## Returns
+
+  Reference to the session resource.
+  """
+  @spec create_session(reference(), integer()) :: reference()
+  def create_session(solution, seed) do
+    create_session_nif(solution, seed)
+  end
+
+  defp create_session_nif(_solution, _seed), do: :erlang.nif_error(:nif_not_loaded)
+
+  @doc """
+  Inserts new clients into the session's plan and re-optimises around them.
+
+  The clients are appended after the existing locations, in the given order.
+  Only the new clients and their neighbours are searched; the rest of the plan
+  is left alone unless a move involving the new clients touches it.
+
+  ## Options
+
+  - `:timeout_ms` - Budget for the whole call, in milliseconds (default: `0`,
+    which applies the LocalSearch safety deadline only)
+  - `:distance_rows` / `:duration_rows` - Per profile, one row per new client
+    with the travel from that client to every location (including the new
+    ones). Defaults to Euclidean distances from the coordinates.
+  - `:distance_cols` / `:duration_cols` - Per profile, one list per new client
+    with the travel from every location to that client. Defaults to the rows.
+
+  ## Returns
+
+  `{:ok, {problem_data, solution}}` with the extended problem data and the
+  updated plan, which also becomes the session's current plan.
+  """
+  @spec session_insert(reference(), [struct()], reference(), keyword()) ::
+          {:ok, {reference(), reference()}} | {:error, term()}
+  def session_insert(session, clients, cost_evaluator, opts \\ []) do
+    {timeout_ms, opts} = Keyword.pop(opts, :timeout_ms, 0)
+    update = opts |> Map.new() |> Map.put(:clients, clients)
+    session_insert_nif(session, update, cost_evaluator, timeout_ms)
+  end
+
+  defp session_insert_nif(_session, _update, _cost_evaluator, _timeout_ms),
+    do: :erlang.nif_error(:nif_not_loaded)
+
+  @doc """
+  Locks a prefix of each route of the session's current plan.
+
+  See `local_search_lock_prefixes/3`. The locks are kept by the session and
+  respected by all subsequent inserts.
+  """
+  @spec session_lock_prefixes(reference(), [non_neg_integer()]) :: :ok
+  def session_lock_prefixes(session, prefix_lengths) do
+    session_lock_prefixes_nif(session, prefix_lengths)
+  end
+
+  defp session_lock_prefixes_nif(_session, _prefix_lengths), do: :erlang.nif_error(:nif_not_loaded)
+
+  @doc """
+  Applies changes to existing clients and travel times to the session's plan.
+
+  The new problem data shares all matrices of profiles without travel updates
+  with the current data, and only the neighbour lists of affected clients are
+  recomputed. Location indices never change.
+
+  ## Changes
+
+  - `:clients` - `{idx, client}` tuples replacing the client at location index
+    `idx` (e.g. with a new time window). The client group must not change.
+  - `:remove` - Indices of cancelled clients. They are dropped from the plan
+    and kept out of it; in the data they become optional without a prize.
+  - `:distance_rows` / `:duration_rows` - `{profile, idx, values}` tuples with
+    the travel from location `idx` to every location.
+  - `:distance_cols` / `:duration_cols` - `{profile, idx, values}` tuples with
+    the travel from every location to location `idx`.
+
+  ## Options
+
+  - `:timeout_ms` - Budget for the whole call, in milliseconds (default: `0`,
+    which applies the LocalSearch safety deadline only)
+
+  ## Returns
+
+  `{:ok, {problem_data, solution}}` with the updated problem data and plan,
+  which also becomes the session's current plan.
+  """
+  @spec session_update(reference(), keyword(), reference(), keyword()) ::
+          {:ok, {reference(), reference()}} | {:error, term()}
+  def session_update(session, changes, cost_evaluator, opts \\ []) do
+    timeout_ms = Keyword.get(opts, :timeout_ms, 0)
+    session_update_nif(session, Map.new(changes), cost_evaluator, timeout_ms)
+  end
+
+  defp session_update_nif(_session, _update, _cost_evaluator, _timeout_ms),
+    do: :erlang.nif_error(:nif_not_loaded)
+
+  # ---------------------------------------------------------------------------
+  # Batch solve
+  # ---------------------------------------------------------------------------
+
+  @doc """
+  Solves many independent instances natively, on a pool of worker threads.
+
+  Each instance is a `{packed_model, params}` tuple. `packed_model` is an
+  `%ExVrp.Model{}` encoded with `:erlang.term_to_binary/1`, which the workers
+  decode in parallel. `params` is a map with the keys `:seed`,
+  `:max_iterations`, `:max_runtime_ms` (`0` for no limit), `:algorithm`
+  (`:ils` or `:hgs`), `:ils_params`, `:hgs_params`, `:decomposition_params`
+  and `:penalty_params`, all optional.
+
+  Each instance runs the same algorithm as `ExVrp.Solver.solve/2` with a
+  single start, but entirely in native code.
+
+  ## Returns
+
+  `{:ok, outcomes}` with, per instance and in order, `{:ok, result}` or
+  `{:error, message}`. A result is a map with the keys `:solution`,
+  `:problem_data`, `:routes`, `:distance`, `:duration`, `:num_clients`,
+  `:is_feasible`, `:is_complete`, `:num_iterations`, `:runtime`,
+  `:improvements`, `:restarts`, `:decompositions`,
+  `:decomposition_improvements`, `:initial_cost` and `:final_cost`.
+  """
+  @spec solve_batch([{binary(), map()}], pos_integer()) ::
+          {:ok, [{:ok, map()} | {:error, String.t()}]}
+  def solve_batch(instances, num_workers) when is_list(instances) and is_integer(num_workers) do
+    solve_batch_nif(instances, num_workers)
+  end
+
+  defp solve_batch_nif(_instances, _num_workers), do: :erlang.nif_error(:nif_not_loaded)
+
+  @doc """
+  Solves a single instance natively, on a dirty scheduler.
+
+  `params` is a map with the same keys as an instance of `solve_batch/2`.
+  This is how `ExVrp.Solver.solve/2` runs the hybrid genetic search, whose
+  population and crossover live in native code, and the route-based
+  decomposition of `ExVrp.Decomposition`.
+
+  ## Returns
+
+  `{:ok, result}`, with the same result map as `solve_batch/2`.
+  """
+  @spec solve_native(reference(), map()) :: {:ok, map()}
+  def solve_native(problem_data, params) when is_map(params) do
+    solve_native_nif(problem_data, params)
+  end
+
+  defp solve_native_nif(_problem_data, _params), do: :erlang.nif_error(:nif_not_loaded)
+
+  # ---------------------------------------------------------------------------
+  # Resource reclamation
+  # ---------------------------------------------------------------------------
+
+  @doc """
+  Returns the counters of the background reclaimer.
+
+  Resource destructors run on whichever scheduler garbage collects the owning
+  process. Problem data, solutions, local searches and sessions whose
+  estimated size is at least the threshold hand their contents to a background
+  thread instead, so that tearing down e.g. a multi-GB problem data does not
+  block a scheduler.
+
+  ## Returns
+
+  A map with `:deferred` and `:deferred_bytes` (objects handed to the
+  background thread since the NIF was loaded, and their estimated size),
+  `:pending` and `:pending_bytes` (those not yet destroyed), and `:threshold`
+  (the current threshold in bytes).
+  """
+  @spec reclaim_stats() :: %{
+          deferred: non_neg_integer(),
+          deferred_bytes: non_neg_integer(),
+          pending: non_neg_integer(),
+          pending_bytes: non_neg_integer(),
+          threshold: non_neg_integer()
+        }
+  def reclaim_stats, do: reclaim_stats_nif()
+
+  defp reclaim_stats_nif, do: :erlang.nif_error(:nif_not_loaded)
+
+  @doc """
+  Sets the estimated size in bytes from which resources are destroyed on the
+  background reclaimer thread (default: 1 MiB). `0` defers all of them.
+  """
+  @spec set_reclaim_threshold(non_neg_integer()) :: :ok
+  def set_reclaim_threshold(bytes) when is_integer(bytes) and bytes >= 0 do
+    set_reclaim_threshold_nif(bytes)
+  end
+
+  defp set_reclaim_threshold_nif(_bytes), do: :erlang.nif_error(:nif_not_loaded)
+
   # ---------------------------------------------------------------------------
   # Route - via Solution reference + route index
   # ---------------------------------------------------------------------------
@@ -0,0 +1,168 @@
+defmodule ExVrp.Session do
+  @moduledoc """
+  Incremental re-optimisation of a live plan.
+
+  A session keeps a plan resident in native memory, together with the local
+  search built around it. New clients (e.g. orders that arrive during the day)
+  can then be inserted into the plan within a small time budget, instead of
+  rebuilding the model and solving it again from scratch.
+
+  Each insert appends the new clients to the session's problem data, inserts
+  them into the plan, and runs the local search with only the new clients and
+  their neighbours marked as promising. The rest of the plan is only changed
+  when a move involving the new clients improves it.
+
+  ## Example
+
+      {:ok, result} = ExVrp.Solver.solve(model, max_runtime: 5_000)
+      session = ExVrp.Session.new(result.best, seed: 42)
+
+      new_orders = [ExVrp.Client.new(x: 10, y: 5, delivery: [3])]
+      {:ok, session, solution} = ExVrp.Session.insert(session, new_orders, timeout_ms: 100)
+
+  New clients get the location indices that follow the existing locations, in
+  the order in which they are given.
+
+  As the day progresses, the stops that drivers have already served (and
+  usually the next one) can be locked with `lock_prefixes/2`. Locked stops are
+  never moved, and no new client is inserted before them.
+
+  Changes to existing clients (e.g. a new time window or a cancellation) and
+  to travel times (e.g. after a traffic update) are applied with `update/3`.
+  """
+
+  alias ExVrp.Native
+  alias ExVrp.PenaltyManager
+  alias ExVrp.Solution
+
+  @type t :: %__MODULE__{
+          ref: reference(),
+          problem_data: reference(),
+          cost_evaluator: reference(),
+          solution: Solution.t()
+        }
+
+  @enforce_keys [:ref, :problem_data, :cost_evaluator, :solution]
+  defstruct [:ref, :problem_data, :cost_evaluator, :solution]
+
+  @doc """
+  Creates a session around the given solution.
+
+  ## Options
+
+  - `:seed` - Random seed for the session's local search (default: random)
+  - `:penalty_params` - `PenaltyManager.Params` used to derive the cost
+    evaluator for re-optimisation (default: `%PenaltyManager.Params{}`)
+  - `:cost_evaluator` - Explicit cost evaluator reference, overriding
+    `:penalty_params`
+  """
+  @spec new(Solution.t(), keyword()) :: t()
+  def new(%Solution{solution_ref: solution_ref, problem_data: problem_data} = solution, opts \\ []) do
+    seed = opts[:seed] || :rand.uniform(1_000_000)
+
+    cost_evaluator =
+      case opts[:cost_evaluator] do
+        nil -> default_cost_evaluator(problem_data, opts[:penalty_params])
+        cost_evaluator -> cost_evaluator
+      end
+
+    %__MODULE__{
+      ref: Native.create_session(solution_ref, seed),
+      problem_data: problem_data,
+      cost_evaluator: cost_evaluator,
+      solution: solution
+    }
+  end
+
+  @doc """
+  Inserts new clients into the session's plan.
+
+  Returns the updated session and the updated plan, which is also available
+  as `session.solution`.
+
+  ## Options
+
+  - `:timeout_ms` - Time budget for the whole insert, in milliseconds
+  - `:distance_rows`, `:distance_cols`, `:duration_rows`, `:duration_cols` -
+    Travel data for the new clients; see `ExVrp.Native.session_insert/4`.
+    Defaults to Euclidean distances from the client coordinates.
+  """
+  @spec insert(t(), [ExVrp.Client.t()], keyword()) :: {:ok, t(), Solution.t()}
+  def insert(%__MODULE__{} = session, clients, opts \\ []) when is_list(clients) do
+    {:ok, {problem_data, solution_ref}} =
+      Native.session_insert(session.ref, clients, session.cost_evaluator, opts)
+
+    solution = build_solution(solution_ref, problem_data)
+    {:ok, %{session | problem_data: problem_data, solution: solution}, solution}
+  end
+
+  @doc """
+  Applies changes to existing clients and travel times to the session's plan.
+
+  The plan is re-optimised around the affected clients. Returns the updated
+  session and plan, like `insert/3`.
+
+  ## Changes
+
+  - `:clients` - `{idx, %ExVrp.Client{}}` tuples replacing existing clients
+  - `:remove` - Indices of cancelled clients, which are dropped from the plan
+  - `:distance_rows`, `:distance_cols`, `:duration_rows`, `:duration_cols` -
+    `{profile, idx, values}` travel updates; see `ExVrp.Native.session_update/4`
+
+  ## Options
+
+  - `:timeout_ms` - Time budget for the whole update, in milliseconds
+
+  ## Example
+
+      # Client 3 can now only be served in the afternoon, and client 5 cancelled.
+      {:ok, session, solution} =
+        ExVrp.Session.update(session, clients: [{3, afternoon_client}], remove: [5])
+  """
+  @spec update(t(), keyword(), keyword()) :: {:ok, t(), Solution.t()}
+  def update(%__MODULE__{} = session, changes, opts \\ []) when is_list(changes) do
+    {:ok, {problem_data, solution_ref}} =
+      Native.session_update(session.ref, changes, session.cost_evaluator, opts)
+
+    solution = build_solution(solution_ref, problem_data)
+    {:ok, %{session | problem_data: problem_data, solution: solution}, solution}
+  end
+
+  @doc """
+  Locks a prefix of each route of the session's plan.
+
+  `prefix_lengths` gives, per route in the order of `session.solution.routes`,
+  the number of leading stops that are committed. Those stops stay where they
+  are in all subsequent inserts. Replaces any existing locks; routes without
+  an entry are not locked.
+
+  ## Example
+
+      # Driver 0 has served two stops, driver 1 is on the way to its first.
+      session = ExVrp.Session.lock_prefixes(session, [2, 1])
+  """
+  @spec lock_prefixes(t(), [non_neg_integer()]) :: t()
+  def lock_prefixes(%__MODULE__{} = session, prefix_lengths) when is_list(prefix_lengths) do
+    :ok = Native.session_lock_prefixes(session.ref, prefix_lengths)
+    session
+  end
+
+  defp default_cost_evaluator(problem_data, penalty_params) do
+    penalty_manager = PenaltyManager.init_from(problem_data, penalty_params || %PenaltyManager.Params{})
+    {:ok, cost_evaluator} = PenaltyManager.cost_evaluator(penalty_manager)
+    cost_evaluator
+  end
+
+  defp build_solution(solution_ref, problem_data) do
+    %Solution{
+      routes: Native.solution_routes(solution_ref),
+      solution_ref: solution_ref,
+      problem_data: problem_data,
+      distance: Native.solution_distance(solution_ref),
+      duration: Native.solution_duration(solution_ref),
+      num_clients: Native.solution_num_clients(solution_ref),
+      is_feasible: Native.solution_is_feasible(solution_ref),
+      is_complete: Native.solution_is_complete(solution_ref)
+    }
+  end
+end
@@ -220,6 +220,40 @@ defmodule ExVrp.Solution do
     Native.solution_unassigned(solution_ref)
   end
 
+  @doc """
+  Returns a hash of the solution's arcs.
+
+  Solutions that visit every client with the same predecessor and successor
+  have the same hash, regardless of route order. Use it for cheap duplicate
+  detection, e.g. in an elite pool.
+  """
+  @spec hash(t()) :: non_neg_integer()
+  def hash(%__MODULE__{solution_ref: solution_ref}) do
+    Native.solution_hash(solution_ref)
+  end
+
+  @doc """
+  Returns the broken pairs distance between two solutions of the same problem.
+
+  This is the fraction of client neighbour pairs (predecessor and successor)
+  of the one solution that differ in the other, from `0.0` for solutions
+  with the same routes to `1.0`.
+  """
+  @spec broken_pairs_distance(t(), t()) :: float()
+  def broken_pairs_distance(%__MODULE__{} = first, %__MODULE__{} = second) do
+    [distance] = broken_pairs_distances(first, [second])
+    distance
+  end
+
+  @doc """
+  Returns the broken pairs distance between a solution and each solution of
+  a pool, in order, in one native call.
+  """
+  @spec broken_pairs_distances(t(), [t()]) :: [float()]
+  def broken_pairs_distances(%__MODULE__{solution_ref: solution_ref}, pool) when is_list(pool) do
+    Native.solution_broken_pairs_distances(solution_ref, Enum.map(pool, & &1.solution_ref))
+  end
+
   # ==========================================
   # Solution-Level Aggregate Functions (PyVRP parity)
   # ==========================================
@@ -4,14 +4,19 @@ defmodule ExVrp.Solver do
 
   This module provides the `solve/2` function which is a direct port of PyVRP's
   `solve()` function. It sets up the solver components and runs Iterated Local
-  Search with Late Acceptance Hill-Climbing.
+  Search with Late Acceptance Hill-Climbing, or optionally a native hybrid
+  genetic search (see `ExVrp.GeneticAlgorithm`).
   """
 
+  alias ExVrp.Decomposition
+  alias ExVrp.GeneticAlgorithm
   alias ExVrp.IteratedLocalSearch
   alias ExVrp.Model
   alias ExVrp.Native
   alias ExVrp.PenaltyManager
+  alias ExVrp.Solution
   alias ExVrp.StoppingCriteria
+  alias ExVrp.Telemetry
 
   require Logger
 
@@ -23,8 +28,13 @@ defmodule ExVrp.Solver do
           num_starts: pos_integer() | :auto,
           penalty_params: PenaltyManager.Params.t(),
           ils_params: IteratedLocalSearch.Params.t(),
+          algorithm: :ils | :hgs,
+          hgs_params: GeneticAlgorithm.Params.t(),
+          decomposition_params: Decomposition.Params.t() | nil,
           on_progress: (map() -> any()) | nil,
-          initial_routes: [[non_neg_integer()]] | nil
+          initial_routes: [[non_neg_integer()]] | nil,
+          telemetry_metadata: map() | nil,
+          telemetry_interval_ms: pos_integer() | nil
         ]
 
   @default_opts [
@@ -35,8 +45,13 @@ defmodule ExVrp.Solver do
     num_starts: :auto,
     penalty_params: nil,
     ils_params: nil,
+    algorithm: :ils,
+    hgs_params: nil,
+    decomposition_params: nil,
     on_progress: nil,
-    initial_routes: nil
+    initial_routes: nil,
+    telemetry_metadata: nil,
+    telemetry_interval_ms: nil
   ]
 
   @doc """
@@ -60,6 +75,14 @@ defmodule ExVrp.Solver do
     Use `:auto` to pick based on available cores (`div(schedulers_online, 2)`).
   - `:penalty_params` - PenaltyManager.Params for penalty adjustment
   - `:ils_params` - IteratedLocalSearch.Params for ILS behavior
+  - `:algorithm` - `:ils` (default) or `:hgs`. `:hgs` runs the hybrid genetic
+    search of `ExVrp.GeneticAlgorithm` entirely in native code, with the same
+    local search, penalties and budgets. Of `:stop`, only a runtime limit
+    applies; `:on_progress` and `:initial_routes` are ignored.
+  - `:hgs_params` - GeneticAlgorithm.Params for HGS behavior
+  - `:decomposition_params` - Decomposition.Params for route-based
+    decomposition of very large instances (see `ExVrp.Decomposition`). When
+    given, the ILS runs in native code, with the same restrictions as `:hgs`.
   - `:on_progress` - Optional callback function receiving progress maps during ILS iterations (time-gated at ~1s intervals). When `num_starts > 1`, progress maps include `:seed_idx` and `:seed` fields.
   - `:initial_routes` - Optional warm-start. A list of routes where the position
     in the outer list maps to the vehicle type index. Each inner list is a
@@ -75,6 +98,9 @@ defmodule ExVrp.Solver do
     out-of-range vehicle types or client IDs, too many routes for
     `num_available`) are logged as warnings and the solver falls back to a
     cold (empty) start rather than crashing.
+  - `:telemetry_metadata` - Map merged into the metadata of all `:telemetry`
+    events of this solve, e.g. to label the instance class. See `ExVrp.Telemetry`.
+  - `:telemetry_interval_ms` - Interval between throughput samples (default: 1000).
 
   ## Returns
 
@@ -104,16 +130,27 @@ defmodule ExVrp.Solver do
   @dialyzer {:nowarn_function, solve: 2}
   @spec solve(Model.t(), solve_opts()) :: {:ok, IteratedLocalSearch.Result.t()} | {:error, term()}
   def solve(%Model{} = model, opts \\ []) do
-    solve_start = System.monotonic_time(:millisecond)
     opts = Keyword.merge(@default_opts, opts)
+    Telemetry.span([:solve], opts[:telemetry_metadata] || %{}, fn -> do_solve(model, opts) end)
+  end
 
+  defp do_solve(model, opts) do
+    solve_start = System.monotonic_time(:millisecond)
     base_seed = opts[:seed] || :rand.uniform(1_000_000)
     num_starts = resolve_num_starts(opts[:num_starts])
 
-    with {:ok, problem_data} <- Model.to_problem_data(model) do
+    problem_data_result =
+      Telemetry.span([:setup, :problem_data], opts[:telemetry_metadata] || %{}, fn ->
+        Model.to_problem_data(model)
+      end)
+
+    with {:ok, problem_data} <- problem_data_result do
       problem_data_time = System.monotonic_time(:millisecond) - solve_start
       Logger.info("Problem data created in #{problem_data_time}ms")
 
+      metadata = Telemetry.problem_metadata(problem_data, opts[:telemetry_metadata])
+      opts = Keyword.put(opts, :telemetry_metadata, metadata)
+
       if num_starts == 1 do
         solve_single(problem_data, base_seed, opts, solve_start)
       else
@@ -123,7 +160,145 @@ defmodule ExVrp.Solver do
     end
   end
 
+  @doc """
+  Solves many small, independent models in one native call.
+
+  Meant for high-throughput workloads of tiny instances (e.g. per-driver TSPs
+  or per-zone VRPs), where the per-solve overhead of `solve/2` dominates the
+  actual search. The models are solved on a native worker pool, each with the
+  same algorithm as `solve/2` with a single start, and all results are
+  returned at once.
+
+  Each instance is a `%Model{}`, a model packed with `pack_model/1`, or a
+  `{model, instance_opts}` tuple overriding `:seed`, `:max_iterations` and
+  `:max_runtime` for that instance. Models are not validated with
+  `Model.validate/1`; invalid data is still rejected natively, for that
+  instance only.
+
+  ## Options
+
+  - `:max_iterations` - Maximum number of iterations per instance (default: 10_000)
+  - `:max_runtime` - Maximum runtime per instance in milliseconds (default: unlimited)
+  - `:seed` - Base random seed; instance `i` uses `seed + i` (default: random)
+  - `:num_workers` - Number of worker threads (default: `System.schedulers_online()`)
+  - `:penalty_params` - PenaltyManager.Params for penalty adjustment
+  - `:ils_params` - IteratedLocalSearch.Params for ILS behavior
+  - `:algorithm` - `:ils` (default) or `:hgs`, as for `solve/2`
+  - `:hgs_params` - GeneticAlgorithm.Params for HGS behavior
+  - `:decomposition_params` - Decomposition.Params, as for `solve/2`
+
+  ## Returns
+
+  A list with, per instance and in order, `{:ok, result}` with an
+  `IteratedLocalSearch.Result`, or `{:error, message}`.
+
+  ## Example
+
+      packed = Enum.map(driver_models, &Solver.pack_model/1)
+      results = Solver.solve_batch(packed, max_runtime: 20, num_workers: 8)
+  """
+  @spec solve_batch([Model.t() | binary() | {Model.t() | binary(), keyword()}], keyword()) ::
+          [{:ok, IteratedLocalSearch.Result.t()} | {:error, String.t()}]
+  def solve_batch(instances, opts \\ []) when is_list(instances) do
+    opts = Keyword.merge(@default_opts, opts)
+    base_seed = opts[:seed] || :rand.uniform(1_000_000)
+    num_workers = opts[:num_workers] || System.schedulers_online()
+
+    jobs =
+      instances
+      |> Enum.with_index()
+      |> Enum.map(fn {instance, idx} -> batch_job(instance, base_seed + idx, opts) end)
+
+    {:ok, outcomes} = Native.solve_batch(jobs, num_workers)
+    Enum.map(outcomes, &batch_result/1)
+  end
+
+  @doc """
+  Packs a model for `solve_batch/2`.
+
+  Packing can happen ahead of time (e.g. in the processes that build the
+  models), so that `solve_batch/2` only has to hand the binaries to the
+  native workers.
+  """
+  @spec pack_model(Model.t()) :: binary()
+  def pack_model(%Model{} = model), do: :erlang.term_to_binary(model)
+
+  defp batch_job({instance, instance_opts}, seed, opts) do
+    batch_job(instance, instance_opts[:seed] || seed, Keyword.merge(opts, instance_opts))
+  end
+
+  defp batch_job(%Model{} = model, seed, opts), do: batch_job(pack_model(model), seed, opts)
+
+  defp batch_job(packed, seed, opts) when is_binary(packed), do: {packed, native_params(seed, opts)}
+
+  defp native_params(seed, opts) do
+    %{
+      seed: seed,
+      max_iterations: opts[:max_iterations],
+      max_runtime_ms: round(opts[:max_runtime] || 0),
+      algorithm: opts[:algorithm],
+      ils_params: opts[:ils_params],
+      hgs_params: opts[:hgs_params],
+      decomposition_params: opts[:decomposition_params],
+      penalty_params: opts[:penalty_params]
+    }
+  end
+
+  defp batch_result({:error, _message} = error), do: error
+
+  defp batch_result({:ok, result}) do
+    stats = %{
+      iterations: result.num_iterations,
+      initial_cost: result.initial_cost,
+      final_cost: result.final_cost,
+      improvements: result.improvements,
+      restarts: result.restarts,
+      decompositions: result.decompositions,
+      decomposition_improvements: result.decomposition_improvements
+    }
+
+    best = %Solution{
+      routes: result.routes,
+      solution_ref: result.solution,
+      problem_data: result.problem_data,
+      distance: result.distance,
+      duration: result.duration,
+      num_clients: result.num_clients,
+      is_feasible: result.is_feasible,
+      is_complete: result.is_complete,
+      stats: stats
+    }
+
+    {:ok,
+     %IteratedLocalSearch.Result{
+       best: best,
+       stats: Map.drop(stats, [:iterations]),
+       num_iterations: result.num_iterations,
+       runtime: result.runtime
+     }}
+  end
+
   defp solve_single(problem_data, seed, opts, solve_start) do
+    if opts[:algorithm] == :hgs or opts[:decomposition_params] do
+      solve_native(problem_data, seed, opts)
+    else
+      solve_ils(problem_data, seed, opts, solve_start)
+    end
+  end
+
+  # The hybrid genetic search and decomposition run natively end to end, so
+  # there are no per-iteration callbacks; the result converts like a batch
+  # result.
+  defp solve_native(problem_data, seed, opts) do
+    opts = Keyword.put(opts, :max_runtime, resolve_max_runtime_ms(opts))
+    {:ok, result} = Native.solve_native(problem_data, native_params(seed, opts))
+    algorithm = if opts[:algorithm] == :hgs, do: "HGS", else: "Native ILS"
+    Logger.info("#{algorithm} completed in #{result.runtime}ms (#{result.num_iterations} iterations)")
+    batch_result({:ok, result})
+  end
+
+  defp solve_ils(problem_data, seed, opts, solve_start) do
+    opts = Keyword.update!(opts, :telemetry_metadata, &Map.put(&1, :seed, seed))
     stop_fn = build_stop_fn(opts)
 
     {local_search, penalty_manager, initial_solution} =
@@ -242,12 +417,19 @@ defmodule ExVrp.Solver do
     penalty_manager = PenaltyManager.init_from(problem_data, penalty_params)
 
     local_search_start = System.monotonic_time(:millisecond)
-    local_search = Native.create_local_search(problem_data, seed)
+
+    local_search =
+      Telemetry.span([:setup, :local_search], opts[:telemetry_metadata], fn ->
+        Native.create_local_search(problem_data, seed)
+      end)
+
     local_search_time = System.monotonic_time(:millisecond) - local_search_start
     Logger.info("LocalSearch created (neighbours computed) in #{local_search_time}ms")
 
     initial_solution =
-      build_initial_solution(problem_data, local_search, penalty_manager, opts, solve_start)
+      Telemetry.span([:setup, :initial_solution], opts[:telemetry_metadata], fn ->
+        build_initial_solution(problem_data, local_search, penalty_manager, opts, solve_start)
+      end)
 
     {local_search, penalty_manager, initial_solution}
   end
@@ -330,7 +512,12 @@ defmodule ExVrp.Solver do
 
     Logger.info("Starting ILS iterations")
 
-    ils_opts = [seed: seed, on_progress: opts[:on_progress]]
+    ils_opts = [
+      seed: seed,
+      on_progress: opts[:on_progress],
+      telemetry_metadata: opts[:telemetry_metadata],
+      telemetry_interval_ms: opts[:telemetry_interval_ms]
+    ]
 
     max_runtime_ms = resolve_max_runtime_ms(opts)
 
@@ -0,0 +1,154 @@
+defmodule ExVrp.Telemetry do
+  @moduledoc """
+  `:telemetry` events emitted by the solver.
+
+  All events share the metadata of the solve they belong to: `:num_clients`,
+  `:num_locations` and `:num_vehicle_types` of the problem, merged with the
+  `:telemetry_metadata` map passed to `ExVrp.Solver.solve/2` (e.g. an
+  instance class to group metrics by). Events from the search itself also
+  carry the `:seed` of the start that emitted them.
+
+  ## Spans
+
+  Each span emits `:start`, `:stop` and `:exception` events, as described in
+  `:telemetry.span/3`.
+
+  - `[:ex_vrp, :solve]` - A complete `ExVrp.Solver.solve/2` call.
+  - `[:ex_vrp, :setup, :problem_data]` - Converting the model to problem data.
+    Only the user-supplied metadata is available at this point.
+  - `[:ex_vrp, :setup, :local_search]` - Creating the LocalSearch resource,
+    which is dominated by computing the granular neighbourhood.
+  - `[:ex_vrp, :setup, :initial_solution]` - Building the initial solution.
+
+  ## Events
+
+  - `[:ex_vrp, :ils, :restart]` - The search restarted after too many
+    iterations without improvement.
+    - Measurements: `:iteration`, `:restarts`
+    - Metadata: `:fresh_start` (whether the best solution was infeasible, so
+      that a new initial solution was built rather than restarting from the
+      best solution)
+
+  - `[:ex_vrp, :ils, :new_best]` - The search found a new best feasible
+    solution.
+    - Measurements: `:iteration`, `:cost`, `:distance`, `:elapsed_ms` (since
+      the start of the search, excluding setup)
+
+  - `[:ex_vrp, :ils, :penalty_update]` - The penalty manager changed one or
+    more penalty weights.
+    - Measurements: `:iteration`, `:tw_penalty`, `:dist_penalty`,
+      `:max_load_penalty`
+    - Metadata: `:load_penalties` (per load dimension)
+
+  - `[:ex_vrp, :ils, :throughput]` - Search throughput since the previous
+    sample, emitted every `:telemetry_interval_ms` (default 1000) and once
+    more when the search stops. Move counts come from the native local
+    search.
+    - Measurements: `:iterations_per_second`, `:moves_per_second`,
+      `:improving_per_second`, `:iterations`, `:moves`, `:improving`,
+      `:interval_ms`
+
+  ## Example
+
+      :telemetry.attach(
+        "vrp-throughput",
+        [:ex_vrp, :ils, :throughput],
+        fn _event, measurements, metadata, _config ->
+          MyApp.Metrics.observe(metadata.instance_class, measurements.moves_per_second)
+        end,
+        nil
+      )
+
+      ExVrp.solve(model, telemetry_metadata: %{instance_class: :urban})
+  """
+
+  alias ExVrp.Native
+
+  @default_interval_ms 1_000
+
+  @type sampler :: %{
+          interval_ms: pos_integer(),
+          time_ms: integer(),
+          iteration: non_neg_integer(),
+          moves: non_neg_integer(),
+          improving: non_neg_integer()
+        }
+
+  @doc false
+  @spec span([atom()], map(), (-> result)) :: result when result: var
+  def span(name, metadata, fun) do
+    :telemetry.span([:ex_vrp | name], metadata, fn -> {fun.(), metadata} end)
+  end
+
+  @doc false
+  @spec execute([atom()], map(), map()) :: :ok
+  def execute(name, measurements, metadata) do
+    :telemetry.execute([:ex_vrp | name], measurements, metadata)
+  end
+
+  @doc false
+  @spec problem_metadata(reference(), map() | nil) :: map()
+  def problem_metadata(problem_data, user_metadata) do
+    Map.merge(
+      %{
+        num_clients: Native.problem_data_num_clients(problem_data),
+        num_locations: Native.problem_data_num_locations(problem_data),
+        num_vehicle_types: Native.problem_data_num_vehicle_types(problem_data)
+      },
+      user_metadata || %{}
+    )
+  end
+
+  @doc false
+  @spec new_sampler(reference(), non_neg_integer(), pos_integer() | nil) :: sampler()
+  def new_sampler(local_search, iteration, interval_ms) do
+    counters = Native.local_search_counters(local_search)
+
+    %{
+      interval_ms: interval_ms || @default_interval_ms,
+      time_ms: System.monotonic_time(:millisecond),
+      iteration: iteration,
+      moves: counters.moves,
+      improving: counters.improving
+    }
+  end
+
+  @doc false
+  @spec maybe_sample(sampler(), reference(), non_neg_integer(), map()) :: sampler()
+  def maybe_sample(sampler, local_search, iteration, metadata) do
+    if System.monotonic_time(:millisecond) - sampler.time_ms >= sampler.interval_ms do
+      sample(sampler, local_search, iteration, metadata)
+    else
+      sampler
+    end
+  end
+
+  @doc false
+  @spec sample(sampler(), reference(), non_neg_integer(), map()) :: sampler()
+  def sample(sampler, local_search, iteration, metadata) do
+    now = System.monotonic_time(:millisecond)
+    counters = Native.local_search_counters(local_search)
+
+    interval_ms = now - sampler.time_ms
+    iterations = iteration - sampler.iteration
+    moves = counters.moves - sampler.moves
+    improving = counters.improving - sampler.improving
+    seconds = max(interval_ms, 1) / 1000
+
+    execute(
+      [:ils, :throughput],
+      %{
+        iterations_per_second: iterations / seconds,
+        moves_per_second: moves / seconds,
+        improving_per_second: improving / seconds,
+        iterations: iterations,
+        moves: moves,
+        improving: improving,
+        interval_ms: interval_ms
+      },
+      metadata
+    )
+
+    %{sampler | time_ms: now, iteration: iteration, moves: counters.moves, improving: counters.improving}
+  end
+end
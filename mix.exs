@@ -98,6 +98,7 @@ defmodule ExVrp.MixProject do
       {:cc_precompiler, "~> 0.1", runtime: false},
       {:fine, "~> 0.1.4"},
       {:nx, "~> 0.10"},
+      {:telemetry, "~> 1.0"},
 
       # Testing
       {:stream_data, "~> 1.0", only: [:test, :dev]},
@@ -155,7 +156,8 @@ defmodule ExVrp.MixProject do
           ExVrp.PenaltyManager,
           ExVrp.PenaltyManager.Params,
           ExVrp.IteratedLocalSearch,
-          ExVrp.IteratedLocalSearch.Params
+          ExVrp.IteratedLocalSearch.Params,
+          ExVrp.Telemetry
         ],
         Results: [
           ExVrp.Solution,
@@ -0,0 +1,40 @@
+defmodule ExVrp.GeneticAlgorithmTest do
+  use ExUnit.Case, async: true
+
+  alias ExVrp.GeneticAlgorithm
+  alias ExVrp.IteratedLocalSearch
+  alias ExVrp.Model
+  alias ExVrp.Solver
+
+  defp vrp_model(num_vehicles) do
+    Enum.reduce(1..30, Model.add_depot(Model.new(), x: 50, y: 50), fn i, acc ->
+      Model.add_client(acc, x: rem(i * 37, 100), y: rem(i * 53, 100), delivery: [1])
+    end)
+    |> Model.add_vehicle_type(num_available: num_vehicles, capacity: [div(40, num_vehicles)])
+  end
+
+  test "solves with the hybrid genetic search" do
+    params = %GeneticAlgorithm.Params{min_pop_size: 5, generation_size: 10}
+
+    for num_vehicles <- [1, 4] do
+      model = vrp_model(num_vehicles)
+
+      {:ok, result} =
+        Solver.solve(model, algorithm: :hgs, hgs_params: params, max_iterations: 50, seed: 1, num_starts: 1)
+
+      assert %IteratedLocalSearch.Result{} = result
+      assert result.num_iterations == 50
+      assert result.best.is_feasible
+      assert result.best.num_clients == Model.num_clients(model)
+    end
+  end
+
+  test "is deterministic for the same seed" do
+    opts = [algorithm: :hgs, max_iterations: 30, seed: 7, num_starts: 1]
+
+    {:ok, first} = Solver.solve(vrp_model(4), opts)
+    {:ok, second} = Solver.solve(vrp_model(4), opts)
+
+    assert first.best.routes == second.best.routes
+  end
+end
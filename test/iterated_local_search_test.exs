@@ -103,6 +103,7 @@ defmodule ExVrp.IteratedLocalSearchTest do
       # PyVRP defaults from IteratedLocalSearchParams
       assert params.max_no_improvement == 5_000
       assert params.history_size == 500
+      refute params.skip_seen
     end
   end
 
@@ -183,6 +184,17 @@ defmodule ExVrp.IteratedLocalSearchTest do
       assert result_many.best.distance <= result_few.best.distance
     end
 
+    test "skips seen solutions when enabled, natively and in Elixir" do
+      model = build_cvrp_model(10)
+      params = %IteratedLocalSearch.Params{skip_seen: true, history_size: 20}
+
+      {:ok, result} = Solver.solve(model, max_iterations: 100, seed: 5, num_starts: 1, ils_params: params)
+      [{:ok, native}] = Solver.solve_batch([model], max_iterations: 100, seed: 5, ils_params: params)
+
+      assert result.best.is_feasible and result.best.is_complete
+      assert native.best.is_feasible and native.best.is_complete
+    end
+
     test "respects seed for reproducibility" do
       model = build_cvrp_model(8)
 
@@ -637,6 +637,25 @@ defmodule ExVrp.LocalSearchTest do
       assert result_cost <= initial_cost
     end
 
+    test "works with segment-reversing operators" do
+      model = build_cvrp_model(15)
+      {:ok, problem_data} = Model.to_problem_data(model)
+      {:ok, cost_evaluator} = create_cost_evaluator()
+      {:ok, initial_solution} = Native.create_random_solution(problem_data, seed: 42)
+      initial_cost = Native.solution_penalised_cost(initial_solution, cost_evaluator)
+
+      {:ok, result} =
+        Native.local_search_with_operators(
+          initial_solution,
+          problem_data,
+          cost_evaluator,
+          node_operators: [:two_opt, :or_opt_reverse2, :or_opt_reverse3]
+        )
+
+      result_cost = Native.solution_penalised_cost(result, cost_evaluator)
+      assert result_cost < initial_cost
+    end
+
     test "works with swap_star route operator" do
       model = build_cvrp_model(10)
       {:ok, problem_data} = Model.to_problem_data(model)
@@ -2172,6 +2191,21 @@ defmodule ExVrp.LocalSearchTest do
       assert is_reference(local_search)
     end
 
+    test "create_local_search adds segment-reversing operators" do
+      model = build_cvrp_model(10)
+      {:ok, problem_data} = Model.to_problem_data(model)
+      {:ok, cost_evaluator} = create_cost_evaluator()
+
+      local_search =
+        Native.create_local_search(problem_data, 42, node_operators: [:two_opt, :or_opt_reverse2])
+
+      {:ok, initial_solution} = Native.create_random_solution(problem_data, seed: 42)
+      initial_cost = Native.solution_penalised_cost(initial_solution, cost_evaluator)
+
+      {:ok, improved} = Native.local_search_run(local_search, initial_solution, cost_evaluator)
+      assert Native.solution_penalised_cost(improved, cost_evaluator) <= initial_cost
+    end
+
     test "local_search_run improves solution using persistent resource" do
       model = build_cvrp_model(10)
       {:ok, problem_data} = Model.to_problem_data(model)
@@ -2237,6 +2271,36 @@ defmodule ExVrp.LocalSearchTest do
       assert Native.solution_is_complete(improved1)
       assert Native.solution_is_complete(improved2)
     end
+
+    test "profiling records phase and operator timings" do
+      model = build_cvrp_model(10)
+      {:ok, problem_data} = Model.to_problem_data(model)
+      {:ok, cost_evaluator} = create_cost_evaluator()
+
+      local_search = Native.create_local_search(problem_data, 42)
+      {:ok, sol} = Native.create_random_solution(problem_data, seed: 1)
+
+      # Nothing is recorded while profiling is disabled
+      {:ok, _} = Native.local_search_run(local_search, sol, cost_evaluator)
+      profile = Native.local_search_profile(local_search)
+      assert profile.phases.search.count == 0
+
+      :ok = Native.local_search_set_profiling(local_search, true)
+      {:ok, _} = Native.local_search_run(local_search, sol, cost_evaluator)
+      profile = Native.local_search_profile(local_search)
+
+      assert profile.phases.load.count == 1
+      assert profile.phases.search.count >= 1
+      assert profile.phases.unload.count == 1
+      assert profile.operators.exchange10.count > 0
+      assert profile.operators.exchange10.time_ns > 0
+
+      :ok = Native.local_search_reset_profile(local_search)
+      profile = Native.local_search_profile(local_search)
+
+      assert Enum.all?(profile.phases, fn {_, timing} -> timing.count == 0 end)
+      assert Enum.all?(profile.operators, fn {_, timing} -> timing.time_ns == 0 end)
+    end
   end
 
   describe "local_search_search_only (non-persistent)" do
@@ -0,0 +1,69 @@
+defmodule Mix.Tasks.Benchmark.ScalingTest do
+  use ExUnit.Case, async: true
+
+  import ExUnit.CaptureIO
+
+  alias ExVrp.Benchmark.Generator
+  alias ExVrp.Benchmark.Scaling
+  alias ExVrp.Model
+
+  describe "task structure" do
+    test "task implements Mix.Task behaviour with a shortdoc" do
+      behaviours = Mix.Tasks.Benchmark.Scaling.__info__(:attributes)[:behaviour] || []
+      assert Mix.Task in behaviours
+      assert Mix.Task.shortdoc(Mix.Tasks.Benchmark.Scaling)
+    end
+  end
+
+  describe "Generator.generate/2" do
+    test "is deterministic for a given seed" do
+      opts = Generator.profile(:mixed)
+
+      assert Generator.generate(200, opts) == Generator.generate(200, opts)
+      refute Generator.generate(200, opts) == Generator.generate(200, Keyword.put(opts, :seed, 2))
+    end
+
+    test "every profile gives a valid model" do
+      for profile <- Generator.profiles() do
+        model = Generator.generate(100, Generator.profile(profile))
+
+        assert Model.num_clients(model) == 100
+        assert Model.validate(model) == :ok, "invalid #{profile} model"
+      end
+    end
+
+    test "profiles enable their features" do
+      mixed = Generator.generate(200, Generator.profile(:mixed))
+
+      assert length(mixed.vehicle_types) == 3
+      assert mixed.same_vehicle_groups != []
+      assert Enum.all?(mixed.vehicle_types, &(&1.reload_depots == [0] and &1.forbidden_windows != []))
+      assert Enum.all?(mixed.clients, &(&1.tw_late != :infinity))
+
+      random = Generator.generate(200, Generator.profile(:random))
+      assert [%{reload_depots: [], forbidden_windows: []}] = random.vehicle_types
+      assert Enum.all?(random.clients, &(&1.tw_late == :infinity))
+    end
+  end
+
+  describe "Scaling.run/1" do
+    @tag :tmp_dir
+    test "reports per-run metrics and saves them as JSON", %{tmp_dir: tmp_dir} do
+      path = Path.join(tmp_dir, "scaling.json")
+
+      capture_io(fn ->
+        send(self(), {:results, Scaling.run(sizes: [40], profiles: [:time_windows], iterations: 50, save: path)})
+      end)
+
+      assert_received {:results, [result]}
+      assert result.size == 40
+      assert result.iterations == 50
+      assert result.iterations_per_second > 0
+      assert Map.keys(result.setup_ms) == [:initial_solution, :local_search, :problem_data]
+
+      if result.feasible, do: assert(result.time_to_target_ms >= 0)
+
+      assert %{"results" => [%{"profile" => "time_windows", "size" => 40}]} = path |> File.read!() |> Jason.decode!()
+    end
+  end
+end
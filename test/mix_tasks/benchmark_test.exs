@@ -1,6 +1,8 @@
 defmodule Mix.Tasks.BenchmarkTest do
   use ExUnit.Case, async: true
 
+  import ExUnit.CaptureIO
+
   # Test the determine_instances logic by calling the task with various options
   # Since the task uses IO and actually runs benchmarks, we can't easily test the run/1 function
   # Instead, we test that the module is defined and has the expected structure
@@ -22,4 +24,29 @@ defmodule Mix.Tasks.BenchmarkTest do
       assert Mix.Task.shortdoc(Benchmark)
     end
   end
+
+  describe "ExVrp.Benchmark.run/2" do
+    @tag :tmp_dir
+    test "records performance metrics and compares them to a baseline", %{tmp_dir: tmp_dir} do
+      baseline = Path.join(tmp_dir, "baseline.json")
+
+      capture_io(fn -> ExVrp.Benchmark.run([:ok_small], iterations: 50, save: baseline) end)
+
+      %{"ok_small" => %{"metrics" => metrics, "seeds" => seeds}} = baseline |> File.read!() |> Jason.decode!()
+      assert metrics["iterations_per_second"] > 0
+      assert metrics["nif_ms"] > 0
+      assert seeds |> Map.keys() |> Enum.sort() == ["1", "1337", "42"]
+
+      # A baseline that is much faster flags a regression.
+      fast = put_in(Jason.decode!(File.read!(baseline)), ["ok_small", "metrics", "iterations_per_second"], 1.0e12)
+      File.write!(baseline, Jason.encode!(fast))
+
+      output =
+        capture_io(fn ->
+          ExVrp.Benchmark.run([:ok_small], max_runtime: 0.05, baseline: baseline, tolerance: 0.1)
+        end)
+
+      assert output =~ "PERFORMANCE REGRESSION DETECTED"
+    end
+  end
 end
@@ -578,6 +578,48 @@ defmodule ExVrp.ModelTest do
     end
   end
 
+  describe "hard time windows" do
+    test "are off by default" do
+      refute Model.new().hard_time_windows
+    end
+
+    test "set_hard_time_windows/2 sets the flag" do
+      model = Model.set_hard_time_windows(Model.new(), true)
+
+      assert model.hard_time_windows
+      refute Model.set_hard_time_windows(model, false).hard_time_windows
+    end
+
+    test "window tightening is off by default and independent" do
+      refute Model.new().tighten_time_windows
+
+      model = Model.set_tighten_time_windows(Model.new(), true)
+
+      assert model.tighten_time_windows
+      refute model.hard_time_windows
+    end
+
+    test "solves to a solution without time warp" do
+      # Morning and afternoon clients on a line: no afternoon client can be
+      # served before a morning one.
+      model =
+        Model.new()
+        |> Model.add_depot(x: 0, y: 0)
+        |> Model.add_vehicle_type(num_available: 2, capacity: [100], time_windows: [{0, 20_000}])
+        |> Model.set_hard_time_windows(true)
+
+      model =
+        Enum.reduce(1..8, model, fn i, acc ->
+          {tw_early, tw_late} = if rem(i, 2) == 0, do: {0, 3_000}, else: {10_000, 12_000}
+          Model.add_client(acc, x: 100 * i, y: 0, delivery: [1], tw_early: tw_early, tw_late: tw_late)
+        end)
+
+      assert {:ok, _problem_data} = Model.to_problem_data(model)
+      assert {:ok, result} = ExVrp.Solver.solve(model, max_iterations: 200)
+      assert result.best.is_feasible
+    end
+  end
+
   describe "client with optional attributes" do
     test "client with release time" do
       model = Model.add_client(Model.new(), x: 1, y: 1, release_time: 100)
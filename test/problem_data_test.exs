@@ -324,6 +324,26 @@ defmodule ExVrp.ProblemDataTest do
     end
   end
 
+  describe "problem_data_dump/1" do
+    test "dumps to a versioned binary that grows with the instance" do
+      small =
+        Model.new()
+        |> Model.add_depot(x: 0, y: 0)
+        |> Model.add_client(x: 10, y: 0, delivery: [10])
+        |> Model.add_vehicle_type(num_available: 1, capacity: [100])
+
+      large = Model.add_client(small, x: 0, y: 10, delivery: [5], name: "second")
+
+      {:ok, small_data} = Model.to_problem_data(small)
+      {:ok, large_data} = Model.to_problem_data(large)
+
+      small_dump = Native.problem_data_dump(small_data)
+      assert <<"EXVRPPD", _rest::binary>> = small_dump
+      assert small_dump == Native.problem_data_dump(small_data)
+      assert byte_size(Native.problem_data_dump(large_data)) > byte_size(small_dump)
+    end
+  end
+
   describe "Vehicle type attributes (PyVRP parity)" do
     test "vehicle type with all attributes set" do
       model =
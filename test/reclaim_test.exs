@@ -0,0 +1,63 @@
+defmodule ExVrp.ReclaimTest do
+  # The reclaimer and its threshold are global to the NIF.
+  use ExUnit.Case, async: false
+
+  alias ExVrp.Model
+  alias ExVrp.Native
+
+  setup do
+    %{threshold: threshold} = Native.reclaim_stats()
+    on_exit(fn -> Native.set_reclaim_threshold(threshold) end)
+  end
+
+  defp model do
+    Enum.reduce(1..50, Model.add_depot(Model.new(), x: 0, y: 0), fn i, acc ->
+      Model.add_client(acc, x: rem(i * 17, 100), y: rem(i * 31, 100), delivery: [1])
+    end)
+    |> Model.add_vehicle_type(num_available: 5, capacity: [20])
+  end
+
+  # Creates problem data in a separate process, and waits until that process
+  # has exited, so that the BEAM releases the resource.
+  defp create_and_release(model) do
+    {pid, ref} = spawn_monitor(fn -> {:ok, _data} = Model.to_problem_data(model) end)
+    assert_receive {:DOWN, ^ref, :process, ^pid, :normal}
+  end
+
+  defp eventually(fun, attempts \\ 50) do
+    cond do
+      fun.() -> :ok
+      attempts == 0 -> flunk("condition not met")
+      true ->
+        Process.sleep(10)
+        eventually(fun, attempts - 1)
+    end
+  end
+
+  test "defers resources above the threshold to the background thread" do
+    :ok = Native.set_reclaim_threshold(0)
+    before = Native.reclaim_stats()
+
+    create_and_release(model())
+
+    eventually(fn -> Native.reclaim_stats().deferred > before.deferred end)
+    stats = Native.reclaim_stats()
+    assert stats.threshold == 0
+    assert stats.deferred_bytes > before.deferred_bytes
+    eventually(fn -> Native.reclaim_stats().pending == 0 end)
+  end
+
+  test "destroys resources below the threshold right away" do
+    :ok = Native.set_reclaim_threshold(1_000_000_000_000)
+    before = Native.reclaim_stats()
+
+    create_and_release(model())
+    :erlang.garbage_collect()
+
+    assert Native.reclaim_stats().deferred == before.deferred
+  end
+
+  test "rejects a negative threshold" do
+    assert_raise FunctionClauseError, fn -> Native.set_reclaim_threshold(-1) end
+  end
+end
@@ -195,6 +195,120 @@ defmodule ExVrp.RelocateWithDepotTest do
 
       assert Native.search_route_has_excess_load_nif(route) == false
     end
+
+    test "inserts best reload depot, not the one with the cheapest detour" do
+      # Depots are evaluated in order of their detour cost. Depot 1 is on the
+      # way, but its long service time makes client 4 late; depot 2 costs a
+      # detour of 10 but no time warp, so it is the better depot.
+      mat = [
+        [0, 0, 5, 0, 0],
+        [0, 0, 5, 0, 0],
+        [5, 5, 0, 5, 5],
+        [0, 0, 5, 0, 0],
+        [0, 0, 5, 0, 0]
+      ]
+
+      model =
+        Model.new()
+        |> Model.add_depot(x: 0, y: 0)
+        |> Model.add_depot(x: 0, y: 0, service_duration: 1_000)
+        |> Model.add_depot(x: 0, y: 0)
+        |> Model.add_client(x: 0, y: 0, delivery: [5])
+        |> Model.add_client(x: 0, y: 0, delivery: [5], tw_late: 100)
+        |> Model.add_vehicle_type(
+          num_available: 1,
+          capacity: [5],
+          reload_depots: [1, 2]
+        )
+        |> Model.set_distance_matrices([mat])
+        |> Model.set_duration_matrices([mat])
+
+      {:ok, problem_data} = Model.to_problem_data(model)
+
+      route = Native.make_search_route_nif(problem_data, [3, 4], 0, 0)
+      op = Native.create_relocate_with_depot_nif(problem_data)
+
+      {:ok, cost_eval} =
+        Native.create_cost_evaluator(
+          load_penalties: [500.0],
+          tw_penalty: 1.0,
+          dist_penalty: 0.0
+        )
+
+      node3 = Native.search_route_get_node_nif(route, 1)
+      node4 = Native.search_route_get_node_nif(route, 2)
+
+      # Removes 2500 excess load penalty at a detour of 10. Depot 1 would
+      # instead give 900 time warp, for a delta of -1600.
+      delta = Native.relocate_with_depot_evaluate_nif(op, node4, node3, cost_eval)
+      assert delta == -2490
+
+      :ok = Native.relocate_with_depot_apply_nif(op, node4, node3)
+      Native.search_route_update_nif(route)
+
+      depot = Native.search_route_get_node_nif(route, 2)
+      assert Native.search_node_client_nif(depot) == 2
+      assert Native.search_route_distance_nif(route) == 10
+    end
+  end
+
+  describe "RelocateWithDepot max distance" do
+    test "evaluates all reload depots when the max distance binds" do
+      # Depot 1 has the cheapest detour (a distance of 10), and depot 2 a
+      # reload cost of 20 but no detour. With a max distance of 0, the detour
+      # to depot 1 also costs 10 excess distance, so depot 2 is the better
+      # depot, even though it is ranked after depot 1.
+      mat = [
+        [0, 0, 0, 0, 0],
+        [0, 0, 0, 5, 5],
+        [0, 0, 0, 0, 0],
+        [0, 5, 0, 0, 0],
+        [0, 5, 0, 0, 0]
+      ]
+
+      model =
+        Model.new()
+        |> Model.add_depot(x: 0, y: 0)
+        |> Model.add_depot(x: 0, y: 0)
+        |> Model.add_depot(x: 0, y: 0, reload_cost: 20)
+        |> Model.add_client(x: 0, y: 0, delivery: [5])
+        |> Model.add_client(x: 0, y: 0, delivery: [5])
+        |> Model.add_vehicle_type(
+          num_available: 1,
+          capacity: [5],
+          max_distance: 0,
+          reload_depots: [1, 2]
+        )
+        |> Model.set_distance_matrices([mat])
+        |> Model.set_duration_matrices([mat])
+
+      {:ok, problem_data} = Model.to_problem_data(model)
+
+      route = Native.make_search_route_nif(problem_data, [3, 4], 0, 0)
+      op = Native.create_relocate_with_depot_nif(problem_data)
+
+      {:ok, cost_eval} =
+        Native.create_cost_evaluator(
+          load_penalties: [500.0],
+          tw_penalty: 0.0,
+          dist_penalty: 1000.0
+        )
+
+      node3 = Native.search_route_get_node_nif(route, 1)
+      node4 = Native.search_route_get_node_nif(route, 2)
+
+      # Removes 2500 excess load penalty at a reload cost of 20. Depot 1
+      # would instead add 10 distance and 10_000 excess distance penalty.
+      delta = Native.relocate_with_depot_evaluate_nif(op, node4, node3, cost_eval)
+      assert delta == -2480
+
+      :ok = Native.relocate_with_depot_apply_nif(op, node4, node3)
+      Native.search_route_update_nif(route)
+
+      depot = Native.search_route_get_node_nif(route, 2)
+      assert Native.search_node_client_nif(depot) == 2
+      assert Native.search_route_distance_nif(route) == 0
+    end
   end
 
   describe "RelocateWithDepot fixed vehicle cost (PyVRP parity)" do
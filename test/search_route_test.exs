@@ -580,6 +580,43 @@ defmodule ExVrp.SearchRouteTest do
         assert dist_after == dist_between_after
       end
     end
+
+    test "dist_between in another profile follows route updates" do
+      # Distances in other profiles are cached, and must be recomputed after
+      # the route changes.
+      mat0 = [[0, 1, 2, 3], [1, 0, 1, 2], [2, 1, 0, 1], [3, 2, 1, 0]]
+      mat1 = Enum.map(mat0, fn row -> Enum.map(row, &(&1 * 10)) end)
+
+      model =
+        Model.new()
+        |> Model.add_depot(x: 0, y: 0)
+        |> Model.add_client(x: 1, y: 0, delivery: [0])
+        |> Model.add_client(x: 2, y: 0, delivery: [0])
+        |> Model.add_client(x: 3, y: 0, delivery: [0])
+        |> Model.add_vehicle_type(num_available: 1, capacity: [10], profile: 0)
+        |> Model.add_vehicle_type(num_available: 1, capacity: [10], profile: 1)
+        |> Model.set_distance_matrices([mat0, mat1])
+        |> Model.set_duration_matrices([mat0, mat1])
+
+      {:ok, problem_data} = Model.to_problem_data(model)
+
+      route = Native.make_search_route_nif(problem_data, [1, 3], 0, 0)
+
+      # 0 -> 1 -> 3 -> 0
+      assert Native.search_route_dist_between_nif(route, 0, 3, 0) == 6
+      assert Native.search_route_dist_between_nif(route, 0, 3, 1) == 60
+      assert Native.search_route_dist_between_nif(route, 0, 2, 1) == 30
+      assert Native.search_route_dist_between_nif(route, 1, 1, 1) == 0
+
+      node2 = Native.create_search_node_nif(problem_data, 2)
+      :ok = Native.search_route_insert_nif(route, 2, node2)
+      Native.search_route_update_nif(route)
+
+      # 0 -> 1 -> 2 -> 3 -> 0
+      assert Native.search_route_dist_between_nif(route, 0, 2, 0) == 2
+      assert Native.search_route_dist_between_nif(route, 0, 2, 1) == 20
+      assert Native.search_route_dist_between_nif(route, 2, 4, 1) == 40
+    end
   end
 
   describe "Shift duration and overtime (PyVRP parity)" do
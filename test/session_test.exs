@@ -0,0 +1,95 @@
+defmodule ExVrp.SessionTest do
+  use ExUnit.Case, async: true
+
+  alias ExVrp.Client
+  alias ExVrp.Model
+  alias ExVrp.Session
+  alias ExVrp.Solver
+
+  defp base_model do
+    Enum.reduce(1..8, Model.add_depot(Model.new(), x: 0, y: 0), fn i, acc ->
+      Model.add_client(acc, x: i * 10, y: rem(i, 3) * 10, delivery: [5])
+    end)
+    |> Model.add_vehicle_type(num_available: 2, capacity: [50])
+  end
+
+  setup do
+    {:ok, result} = Solver.solve(base_model(), max_iterations: 100, seed: 1, num_starts: 1)
+    %{session: Session.new(result.best, seed: 1)}
+  end
+
+  test "inserts new clients into the plan", %{session: session} do
+    new_clients = [Client.new(x: 45, y: 5, delivery: [5]), Client.new(x: 15, y: 25, delivery: [5])]
+
+    {:ok, session, solution} = Session.insert(session, new_clients, timeout_ms: 100)
+
+    assert solution.num_clients == 10
+    assert solution.is_complete
+    assert Enum.sort(List.flatten(solution.routes)) == Enum.to_list(1..10)
+    assert session.solution == solution
+  end
+
+  test "successive inserts build on the previous plan", %{session: session} do
+    {:ok, session, _solution} = Session.insert(session, [Client.new(x: 5, y: 5, delivery: [5])])
+    {:ok, _session, solution} = Session.insert(session, [Client.new(x: 75, y: 5, delivery: [5])])
+
+    assert solution.num_clients == 10
+    assert solution.is_feasible
+  end
+
+  test "uses explicit travel rows when given", %{session: session} do
+    # 1 depot + 8 clients + 1 new client
+    row = [3 | List.duplicate(1_000, 8)] ++ [0]
+
+    {:ok, _session, solution} =
+      Session.insert(session, [Client.new(x: 500, y: 500, delivery: [5])],
+        distance_rows: [[row]],
+        duration_rows: [[row]]
+      )
+
+    assert solution.num_clients == 9
+  end
+
+  test "removes cancelled clients from the plan", %{session: session} do
+    {:ok, _session, solution} = Session.update(session, remove: [3, 6])
+
+    assert solution.num_clients == 6
+    assert solution.is_complete
+    assert Enum.sort(List.flatten(solution.routes)) == [1, 2, 4, 5, 7, 8]
+  end
+
+  test "updates client time windows and travel rows", %{session: session} do
+    late_client = Client.new(x: 20, y: 20, delivery: [5], tw_early: 500, tw_late: 1_000)
+    row = [0 | List.duplicate(50, 8)]
+
+    {:ok, _session, solution} =
+      Session.update(session, [clients: [{2, late_client}], distance_rows: [{0, 0, row}]], timeout_ms: 100)
+
+    assert solution.num_clients == 8
+    assert solution.is_feasible
+  end
+
+  test "rejects non-integer travel values", %{session: session} do
+    row = [0 | List.duplicate(50, 7)] ++ [:far]
+
+    assert_raise ArgumentError, ~r/integer values for distance_rows/, fn ->
+      Session.update(session, distance_rows: [{0, 0, row}])
+    end
+  end
+
+  test "locked prefixes stay in place", %{session: session} do
+    prefix_lengths = Enum.map(session.solution.routes, &min(length(&1), 2))
+    prefixes = Enum.map(session.solution.routes, &Enum.take(&1, 2))
+
+    session = Session.lock_prefixes(session, prefix_lengths)
+
+    new_clients = [Client.new(x: 0, y: 5, delivery: [5]), Client.new(x: 5, y: 0, delivery: [5])]
+    {:ok, _session, solution} = Session.insert(session, new_clients, timeout_ms: 100)
+
+    assert solution.num_clients == 10
+
+    for prefix <- prefixes do
+      assert Enum.any?(solution.routes, &(Enum.take(&1, length(prefix)) == prefix))
+    end
+  end
+end
@@ -1092,4 +1092,41 @@ defmodule ExVrp.SolutionTest do
       end
     end
   end
+
+  describe "hash/1 and broken_pairs_distances/2" do
+    setup do
+      model =
+        Enum.reduce(1..6, Model.add_depot(Model.new(), x: 0, y: 0), fn i, acc ->
+          Model.add_client(acc, x: i * 10, y: rem(i * 7, 30), delivery: [1])
+        end)
+        |> Model.add_vehicle_type(num_available: 3, capacity: [10])
+
+      {:ok, problem_data} = Model.to_problem_data(model)
+
+      solution = fn routes ->
+        {:ok, ref} = ExVrp.Native.create_solution_from_routes(problem_data, routes)
+        %Solution{solution_ref: ref}
+      end
+
+      %{solution: solution}
+    end
+
+    test "hash ignores route order but not visit order", %{solution: solution} do
+      first = solution.([[1, 2, 3], [4, 5, 6]])
+
+      assert Solution.hash(first) == Solution.hash(solution.([[4, 5, 6], [1, 2, 3]]))
+      assert Solution.hash(first) != Solution.hash(solution.([[3, 2, 1], [4, 5, 6]]))
+    end
+
+    test "distances are zero for the same routes and batched in order", %{solution: solution} do
+      first = solution.([[1, 2, 3], [4, 5, 6]])
+      pool = [solution.([[4, 5, 6], [1, 2, 3]]), solution.([[1, 2], [3, 4], [5, 6]]), solution.([[6, 5, 4, 3, 2, 1]])]
+
+      distances = Solution.broken_pairs_distances(first, pool)
+
+      assert [+0.0, second, third] = distances
+      assert second > 0 and third > 0 and third <= 1
+      assert Solution.broken_pairs_distance(first, List.last(pool)) == third
+    end
+  end
 end
@@ -0,0 +1,61 @@
+defmodule ExVrp.SolveBatchTest do
+  use ExUnit.Case, async: true
+
+  alias ExVrp.IteratedLocalSearch
+  alias ExVrp.Model
+  alias ExVrp.Solver
+
+  defp tsp_model(offset) do
+    Enum.reduce(1..12, Model.add_depot(Model.new(), x: 0, y: 0), fn i, acc ->
+      Model.add_client(acc, x: rem(i * 17 + offset, 100), y: rem(i * 31 + offset, 100), delivery: [1])
+    end)
+    |> Model.add_vehicle_type(num_available: 1, capacity: [20])
+  end
+
+  test "solves every instance and keeps the order" do
+    models = Enum.map(1..20, &tsp_model/1)
+
+    results = Solver.solve_batch(models, max_iterations: 50, seed: 1, num_workers: 4)
+
+    assert length(results) == 20
+
+    for {{:ok, result}, model} <- Enum.zip(results, models) do
+      assert %IteratedLocalSearch.Result{} = result
+      assert result.best.is_feasible
+      assert result.best.num_clients == Model.num_clients(model)
+      assert result.num_iterations == 50
+    end
+  end
+
+  test "matches across worker counts for the same seeds" do
+    packed = Enum.map(1..8, &Solver.pack_model(tsp_model(&1)))
+
+    routes = fn num_workers ->
+      packed
+      |> Solver.solve_batch(max_iterations: 30, seed: 7, num_workers: num_workers)
+      |> Enum.map(fn {:ok, result} -> result.best.routes end)
+    end
+
+    assert routes.(1) == routes.(3)
+  end
+
+  test "applies per-instance budgets" do
+    results =
+      Solver.solve_batch([{tsp_model(1), max_iterations: 5}, tsp_model(2)], max_iterations: 25, seed: 1)
+
+    assert [{:ok, %{num_iterations: 5}}, {:ok, %{num_iterations: 25}}] = results
+  end
+
+  test "reports invalid instances without failing the batch" do
+    results = Solver.solve_batch([tsp_model(1), "not a model"], max_iterations: 10)
+
+    assert [{:ok, _result}, {:error, message}] = results
+    assert is_binary(message)
+  end
+
+  test "returned solutions can be queried further" do
+    [{:ok, result}] = Solver.solve_batch([tsp_model(3)], max_iterations: 10)
+
+    assert ExVrp.Solution.unassigned(result.best) == []
+  end
+end
@@ -0,0 +1,126 @@
+defmodule ExVrp.TelemetryTest do
+  use ExUnit.Case, async: true
+
+  alias ExVrp.IteratedLocalSearch
+  alias ExVrp.Model
+  alias ExVrp.PenaltyManager
+  alias ExVrp.Solver
+
+  @events [
+    [:ex_vrp, :solve, :start],
+    [:ex_vrp, :solve, :stop],
+    [:ex_vrp, :setup, :problem_data, :stop],
+    [:ex_vrp, :setup, :local_search, :stop],
+    [:ex_vrp, :setup, :initial_solution, :stop],
+    [:ex_vrp, :ils, :restart],
+    [:ex_vrp, :ils, :new_best],
+    [:ex_vrp, :ils, :penalty_update],
+    [:ex_vrp, :ils, :throughput]
+  ]
+
+  defp model do
+    Enum.reduce(1..15, Model.add_depot(Model.new(), x: 0, y: 0), fn i, acc ->
+      Model.add_client(acc, x: rem(i * 17, 100), y: rem(i * 31, 100), delivery: [1])
+    end)
+    |> Model.add_vehicle_type(num_available: 2, capacity: [10])
+  end
+
+  # Forwards this test's events (identified by the :test_ref metadata) to
+  # the test process.
+  defp attach(test_ref) do
+    test_pid = self()
+    handler_id = {__MODULE__, test_ref}
+
+    :telemetry.attach_many(
+      handler_id,
+      @events,
+      fn event, measurements, metadata, _config ->
+        if metadata[:test_ref] == test_ref, do: send(test_pid, {event, measurements, metadata})
+      end,
+      nil
+    )
+
+    on_exit(fn -> :telemetry.detach(handler_id) end)
+  end
+
+  defp collect_new_best_costs(acc) do
+    receive do
+      {[:ex_vrp, :ils, :new_best], %{cost: cost}, _metadata} -> collect_new_best_costs([cost | acc])
+    after
+      0 -> Enum.reverse(acc)
+    end
+  end
+
+  defp solve(test_ref, opts) do
+    opts =
+      Keyword.merge(
+        [
+          max_iterations: 200,
+          seed: 1,
+          num_starts: 1,
+          telemetry_metadata: %{test_ref: test_ref, instance_class: :small}
+        ],
+        opts
+      )
+
+    {:ok, _result} = Solver.solve(model(), opts)
+  end
+
+  test "emits spans for the solve and its setup phases" do
+    test_ref = make_ref()
+    attach(test_ref)
+    solve(test_ref, [])
+
+    assert_received {[:ex_vrp, :solve, :start], _measurements, %{instance_class: :small}}
+    assert_received {[:ex_vrp, :solve, :stop], %{duration: _duration}, _metadata}
+    assert_received {[:ex_vrp, :setup, :problem_data, :stop], _measurements, _metadata}
+
+    for phase <- [:local_search, :initial_solution] do
+      assert_received {[:ex_vrp, :setup, ^phase, :stop], %{duration: _duration}, metadata}
+      assert metadata.num_clients == 15
+      assert metadata.seed == 1
+      assert metadata.instance_class == :small
+    end
+  end
+
+  test "emits restart and penalty update events" do
+    test_ref = make_ref()
+    attach(test_ref)
+
+    solve(test_ref,
+      ils_params: %IteratedLocalSearch.Params{max_no_improvement: 10, history_size: 5},
+      penalty_params: %PenaltyManager.Params{solutions_between_updates: 10}
+    )
+
+    assert_received {[:ex_vrp, :ils, :restart], %{iteration: iteration, restarts: 1}, %{fresh_start: false}}
+    assert iteration > 0
+
+    assert_received {[:ex_vrp, :ils, :penalty_update], measurements, %{load_penalties: [_penalty]}}
+    assert measurements.tw_penalty > 0
+  end
+
+  test "emits new best solutions with decreasing costs" do
+    test_ref = make_ref()
+    attach(test_ref)
+    {:ok, result} = solve(test_ref, [])
+
+    # The initial solution may already be the best one, in which case no
+    # event is emitted; every event is a strict improvement otherwise.
+    costs = collect_new_best_costs([])
+    assert length(costs) <= result.stats.improvements
+    assert costs == costs |> Enum.uniq() |> Enum.sort(:desc)
+    if costs != [], do: assert(List.last(costs) == result.stats.final_cost)
+  end
+
+  test "emits a final throughput sample from native counters" do
+    test_ref = make_ref()
+    attach(test_ref)
+    solve(test_ref, telemetry_interval_ms: 60_000)
+
+    assert_received {[:ex_vrp, :ils, :throughput], measurements, %{instance_class: :small}}
+    assert measurements.iterations == 200
+    assert measurements.moves > 0
+    assert measurements.moves_per_second > 0
+    assert measurements.improving <= measurements.moves
+  end
+end